@@ -342,6 +342,7 @@ __ standard : this type is mandatory in a V3D (*.3d) file.\
 __ standard_dawn : optional model to display at dawn.\
 __ standard_dusk : optional model to display at dusk.\
 __ standard_far : optional model to display from far away. See ##range_far .\
+__ standard_lod1 to standard_lod8 : optional coarser models to display in place of the standard model as the object gets smaller on the screen. See ##range_lod . When none are given, up to three levels are simplified from the standard model if it has 200 primitives or more.\
 __ standard_night : optional model to display at night.\
 __ rotor : (if any). Begins the model block of an aircraft main or tail rotor. See ##rotor_new for rotor settings.\
 __ aileron_left : (if any). Begins the model block of a (wing) left aileron. See ##aileron_left_new for aileron_left settings.\
@@ -2293,6 +2294,24 @@ __range_far 2500\
 __-----\
 \
 __NAME\
+__range_lod\
+__SYNOPSIS\
+__range_lod level value\
+__DESCRIPTION\
+__Defines the range beyond which the standard_lod model of that level (standard_lod1 for level 1, ...) is displayed in place of the standard model. The range is for a 1024 pixels wide view with a 40 degrees field of view and is scaled by the object size on the screen on other views.\
+__ARGUMENTS\
+__level level of detail, from 1 to 8.\
+__value range, in meters. Must be positive.\
+__CONTEXT\
+__3d\
+__EXAMPLE\
+__# Coarser models display ranges\
+__range_lod 1 300\
+__range_lod 2 800\
+\
+__-----\
+\
+__NAME\
 __reg_loc\
 __SEE\
 __##register_location parameter.\
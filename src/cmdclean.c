@@ -74,7 +74,10 @@ void SARCmdClean(SAR_CMD_PROTOTYPE)
 	    objects_deleted = SARSimDeleteEffects(
 		core_ptr, scene,
 		&core_ptr->object, &core_ptr->total_objects,
-		scene->player_obj_num,
+		SARObjGetFromHandle(
+		    scene, core_ptr->object, core_ptr->total_objects,
+		    scene->player_obj_handle
+		),
 		0
 	    );
 	}
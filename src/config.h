@@ -74,6 +74,8 @@ Uso: sar2 [opciones] [opciones_de_la_interfaz]\n\
         --no-keyrepeat          Desactivar repetición de eventos al\n\
                                 dejar las teclas apretadas.\n\
         --recorder <dirección>  Grabar en la dirección proporcionada.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Desactivar sonido al inicio.\n\
         --nomenubg              Desactivar el fondo de los menus.\n\
         --console_quiet         No imprimir mensajes en la salida estándar.\n\
@@ -115,6 +117,8 @@ L'usage: sar2 [options] [GUI_options]\n\
         --window                Start game in windowed mode.\n\
         --no-keyrepeat          Prevent keys from sticking.\n\
         --recorder <address>    Spécifie l'adresse de recorder.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Ne pas connecter pour sembler le serveur\n\
                                 au démarrage.\n\
         --nomenubg              Pas les images d'arrière-plan de menu\n\
@@ -161,6 +165,8 @@ Brauch: sar2 [options] [GUI_options]\n\
         --window                Start game in windowed mode.\n\
         --no-keyrepeat          Prevent keys from sticking.\n\
         --recorder <address>    Gibt recorder Anschrift an.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Verbinden Sie nicht, Diener an Start zu\n\
                                 ertönen.\n\
         --nomenubg              Stellen Sie Menü Hintergrundbildnisse nicht\n\
@@ -205,6 +211,8 @@ L'uso: sar2 [options] [GUI_options]\n\
         --window                Start game in windowed mode.\n\
         --no-keyrepeat          Prevent keys from sticking.\n\
         --recorder <address>    Specifica l'indirizzo di recorder.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Non collegare per sembrare il server\n\
                                 all'avvio.\n\
         --nomenubg              Non mostrare le immagini di sfondo di\n\
@@ -251,6 +259,8 @@ Gebruik: sar2 [options] [GUI_options]\n\
         --window                Start game in windowed mode.\n\
         --no-keyrepeat          Prevent keys from sticking.\n\
         --recorder <address>    Recorder adres specificeert.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Verbind niet om kelner aan start te\n\
                                 klinken.\n\
         --nomenubg              Toon niet menu Achtergrondbeelden.\n\
@@ -293,6 +303,8 @@ O Uso: sar2 [options] [GUI_options]\n\
         --window                Start game in windowed mode.\n\
         --no-keyrepeat          Prevent keys from sticking.\n\
         --recorder <address>    Especifica endereço de recorder.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Nao ligue para soar servidor em startup.\n\
         --nomenubg              Nao exiba imagens de experiência de\n\
                                 cardápio.\n\
@@ -337,6 +349,8 @@ Praksis: sar2 [options] [GUI_options]\n\
         --window                Start game in windowed mode.\n\
         --no-keyrepeat          Prevent keys from sticking.\n\
         --recorder <address>    Spesifiserer recorder adresse.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Forbind ikke lyde tjener på oppstarting.\n\
         --nomenubg              Vis ikke menybakgrunnavbilder.\n\
         --console_quiet         Trykk ikke rutinemessige budskap til\n\
@@ -375,6 +389,8 @@ Usage: sar2 [options] [GUI_options]\n\
         --window                Start game in windowed mode.\n\
         --no-keyrepeat          Prevent keys from sticking.\n\
         --recorder <address>    Specifies recorder address.\n\
+        --record-replay <file>  Record the flights to the replay <file>.\n\
+        --replay <file>         Replay the flights from the replay <file>.\n\
         --nosound               Do not connect to sound server at startup.\n\
         --nomenubg              Do not display menu background images.\n\
         --console_quiet         Do not print routine messages to stdout.\n\
@@ -754,6 +770,111 @@ to the fullest extent of the law."
 #define SAR_DEF_SURFACE_CONTACT_Z_TOLORANCE	0.05f
 
 
+/*
+ *	Simulation Ticks:
+ *
+ *	Default number of simulation ticks per second and the maximum
+ *	number of simulation ticks per main loop, lapsed time beyond
+ *	that is dropped.
+ */
+#define SAR_DEF_SIM_TICK_RATE		60
+#define SAR_DEF_SIM_MAX_TICKS		8
+
+/*
+ *	Object Grids (in meters):
+ *
+ *	Cell size and number of hash buckets of the scene's spatial
+ *	grids of objects that can be crashed into and of objects that
+ *	provide ground or support surfaces, see simgrid.c.
+ */
+#define SAR_DEF_CRASH_GRID_CELL_SIZE		100.0f
+#define SAR_DEF_CRASH_GRID_BUCKETS		4096
+#define SAR_DEF_SUPPORT_GRID_CELL_SIZE		100.0f
+#define SAR_DEF_SUPPORT_GRID_BUCKETS		4096
+
+/*
+ *	Cell size and number of hash buckets of the scene's spatial
+ *	grid of objects that can be picked up by hoists, see
+ *	SARSimHoistDeploymentContactCheck().
+ */
+#define SAR_DEF_RESCUE_GRID_CELL_SIZE		25.0f
+#define SAR_DEF_RESCUE_GRID_BUCKETS		1024
+
+/*
+ *	Object Slots:
+ *
+ *	Initial number of slots allocated on the objects list, the list
+ *	is grown by doubling its size when all slots are in use, see
+ *	SARObjNew().
+ */
+#define SAR_DEF_OBJECT_SLOTS			256
+
+/*
+ *	Visual Model Levels Of Detail:
+ *
+ *	Level of detail ranges are for a SAR_LOD_REF_WIDTH pixels wide
+ *	view with a SAR_LOD_REF_FOVZ_UM field of view (in unit meters,
+ *	40 degrees), on other views they are scaled by the object's
+ *	size on the screen. A coarser level is switched to when the
+ *	object is SAR_LOD_HYSTERESIS (coefficient of the range) past
+ *	its range and a finer level when it is that much within it,
+ *	so that objects about a range do not flicker between levels.
+ *
+ *	Objects that declare no levels of detail and have at least
+ *	SAR_LOD_GENERATE_MIN_PRIMITIVES primitives on their standard
+ *	visual model get up to SAR_LOD_GENERATE_LEVELS levels
+ *	simplified from it when loaded. The first level is drawn when
+ *	the object is smaller than SAR_LOD_GENERATE_SIZE pixels and
+ *	each further level at half the size of the one before it,
+ *	each level is simplified to about SAR_LOD_GENERATE_ERROR
+ *	pixels.
+ */
+#define SAR_LOD_LEVELS_MAX			8
+#define SAR_LOD_REF_WIDTH			1024.0f
+#define SAR_LOD_REF_FOVZ_UM			0.728f
+#define SAR_LOD_HYSTERESIS			0.1f
+#define SAR_LOD_GENERATE_LEVELS			3
+#define SAR_LOD_GENERATE_MIN_PRIMITIVES		200
+#define SAR_LOD_GENERATE_SIZE			200.0f
+#define SAR_LOD_GENERATE_ERROR			2.0f
+
+/*
+ *	Occlusion Culling:
+ *
+ *	The boxes of up to SAR_OCCLUSION_OCCLUDERS_MAX of the nearest
+ *	premodeled buildings are rasterized each frame into a
+ *	SAR_OCCLUSION_WIDTH by SAR_OCCLUSION_HEIGHT depth buffer,
+ *	objects entirely behind them are not drawn. Only buildings
+ *	at least SAR_OCCLUSION_OCCLUDER_MIN_SIZE (coefficient of the
+ *	view's width) wide on the screen are used as occluders.
+ */
+#define SAR_OCCLUSION_WIDTH			128
+#define SAR_OCCLUSION_HEIGHT			72
+#define SAR_OCCLUSION_OCCLUDERS_MAX		32
+#define SAR_OCCLUSION_OCCLUDER_MIN_SIZE		0.05f
+
+/*
+ *	Light Batches:
+ *
+ *	The lights of all the objects are drawn after the objects.
+ *
+ *	Where GL 1.4 point parameters are available all the lights are
+ *	drawn in one draw with the point size SAR_DRAW_LIGHT_POINT_SIZE
+ *	attenuated by the distance d from the camera to
+ *	size / sqrt(1 + (linear * d) + (quadratic * d^2)), but no
+ *	smaller than 1 pixel. Lights with smaller sizes are drawn with
+ *	their alpha reduced in proportion instead.
+ *
+ *	Otherwise the lights are drawn one draw per point size. Point
+ *	sizes are then rounded to SAR_DRAW_LIGHT_SIZE_STEP pixels so
+ *	that strobes fading in and out share a few point sizes.
+ */
+#define SAR_DRAW_LIGHT_SIZE_STEP		0.5f
+#define SAR_DRAW_LIGHT_POINT_SIZE		6.0f
+#define SAR_DRAW_LIGHT_ATTENUATION_LINEAR	0.0f
+#define SAR_DRAW_LIGHT_ATTENUATION_QUADRATIC	1.0e-6f
+
+
 /*
  *	Helipad Visual Range (in meters):
  */
@@ -769,6 +890,23 @@ to the fullest extent of the law."
  */
 #define SAR_HUMAN_ANIM_RATE		50000
 
+/*
+ *	Actors/Victims/Human Drawing:
+ *
+ *	The human bodies are recorded into GL lists keyed by build,
+ *	colors, pose, and animation frame, each animation cycle is
+ *	drawn in SAR_HUMAN_DRAW_ANIM_FRAMES frames. At most
+ *	SAR_HUMAN_DRAW_CACHE_MAX GL lists are kept, the cache is
+ *	flushed when it becomes 3/4 full.
+ *
+ *	Standing humans farther than SAR_HUMAN_IMPOSTOR_DISTANCE (in
+ *	meters) from the camera are drawn as flat camera facing
+ *	impostors.
+ */
+#define SAR_HUMAN_DRAW_ANIM_FRAMES	32
+#define SAR_HUMAN_DRAW_CACHE_MAX	256
+#define SAR_HUMAN_IMPOSTOR_DISTANCE	150.0f
+
 
 /*
  *	Mission map and log map default meters to pixels coefficient
@@ -785,6 +923,22 @@ to the fullest extent of the law."
 #define SAR_DEF_TEMPERATURE_AIRCRAFT	0.7f
 
 
+/*
+ *	Horizon Gradients:
+ *
+ *	The horizon gradients for every time of day are kept on one
+ *	SAR_HORIZON_TEXTURE_SIZE square texture, each row has
+ *	SAR_HORIZON_BANDS gradients (from brightest to darkest) of
+ *	SAR_HORIZON_GRADIENT_WIDTH pixels. Each gradient blends half
+ *	way to its bottom color at SAR_HORIZON_GRADIENT_MIDPOINT
+ *	(coefficient of its width).
+ */
+#define SAR_HORIZON_TEXTURE_SIZE	256
+#define SAR_HORIZON_BANDS		7
+#define SAR_HORIZON_GRADIENT_WIDTH	32
+#define SAR_HORIZON_GRADIENT_MIDPOINT	0.88f
+
+
 /*
  *	FLIR Color (in r, g, b, a):
  */
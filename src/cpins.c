@@ -14,8 +14,14 @@
 *   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
 ***********************************************************************/
 
+/* Frame buffer object functions are only declared with the
+ * prototypes from glext.h
+ */
+#define GL_GLEXT_PROTOTYPES
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <sys/types.h>
 #ifdef __MSW__
@@ -31,6 +37,12 @@
 #include "cp.h"
 
 
+static void CPInsFramebufferCreate(CPIns *ins);
+static void CPInsFramebufferDelete(CPIns *ins);
+static GLboolean CPInsValuesChanged(
+	const ControlPanelValues *a, const ControlPanelValues *b
+);
+
 void CPInsSetName(CPIns *ins, const char *name);
 void CPInsSetPosition(CPIns *ins, float x, float y);
 void CPInsSetSize(CPIns *ins, float width, float height);
@@ -70,6 +82,8 @@ void CPInsDelete(CPIns *ins);
 #define MIN(a,b)        (((a) < (b)) ? (a) : (b))
 #define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
 
+#define ABSOLUTE(x)     (((x) < 0) ? ((x) * -1) : (x))
+
 #define RADTODEG(r)     ((r) * 180.0 / PI)
 #define DEGTORAD(d)     ((d) * PI / 180.0)
 
@@ -100,6 +114,105 @@ void CPInsDelete(CPIns *ins);
                         ))
 
 
+/*
+ *	Creates the instrument's frame buffer object with the
+ *	instrument's texture as its color buffer.
+ *
+ *	If frame buffer objects are not available then the
+ *	instrument's frame buffer is left 0 and the instrument will be
+ *	drawn to the GL back buffer and copied to the texture.
+ */
+static void CPInsFramebufferCreate(CPIns *ins)
+{
+#ifdef STATE_GL_VERSION_3_0
+	gw_display_struct *display = CONTROL_PANEL_DISPLAY(
+	    CONTROL_PANEL(ins->cp)
+	);
+	v3d_texture_ref_struct *tex = ins->tex;
+
+	CPInsFramebufferDelete(ins);
+
+	if(tex == NULL)
+	    return;
+	if((tex->data == NULL) || (tex->total_frames < 1))
+	    return;
+
+	/* Frame buffer objects need GL 3.0 */
+	if(!StateGLVersionAtLeast(
+	    (display != NULL) ? &display->state_gl : NULL, 3, 0
+	))
+	    return;
+
+	glGenFramebuffers(1, &ins->framebuffer);
+	if(ins->framebuffer == 0)
+	    return;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, ins->framebuffer);
+	glFramebufferTexture2D(
+	    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+	    GL_TEXTURE_2D, (GLuint)(uintptr_t)(tex->data[0]), 0
+	);
+	if(glCheckFramebufferStatus(GL_FRAMEBUFFER) !=
+	    GL_FRAMEBUFFER_COMPLETE
+	)
+	{
+	    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	    CPInsFramebufferDelete(ins);
+	    return;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+#endif
+}
+
+/*
+ *	Deletes the instrument's frame buffer object.
+ */
+static void CPInsFramebufferDelete(CPIns *ins)
+{
+#ifdef STATE_GL_VERSION_3_0
+	if(ins->framebuffer != 0)
+	    glDeleteFramebuffers(1, &ins->framebuffer);
+#endif
+	ins->framebuffer = 0;
+}
+
+/*
+ *	Checks if the values b differ from the values a by more than
+ *	what can be seen on the instruments.
+ */
+static GLboolean CPInsValuesChanged(
+	const ControlPanelValues *a, const ControlPanelValues *b
+)
+{
+#define CHANGED(m,q)	(ABSOLUTE(b->m - a->m) > (q))
+	if((a->tod_code != b->tod_code) ||
+	   (a->fullscreen != b->fullscreen) ||
+	   (a->color_state != b->color_state)
+	)
+	    return(GL_TRUE);
+
+	if(CHANGED(vel_x, CPINS_QUANTUM_SPEED) ||
+	   CHANGED(vel_y, CPINS_QUANTUM_SPEED) ||
+	   CHANGED(vel_z, CPINS_QUANTUM_SPEED) ||
+	   CHANGED(speed, CPINS_QUANTUM_SPEED)
+	)
+	    return(GL_TRUE);
+
+	if(CHANGED(heading, CPINS_QUANTUM_ANGLE) ||
+	   CHANGED(pitch, CPINS_QUANTUM_ANGLE) ||
+	   CHANGED(bank, CPINS_QUANTUM_ANGLE)
+	)
+	    return(GL_TRUE);
+
+	if(CHANGED(alt_feet, CPINS_QUANTUM_ALT) ||
+	   CHANGED(gear_coeff, CPINS_QUANTUM_COEFF)
+	)
+	    return(GL_TRUE);
+#undef CHANGED
+
+	return(GL_FALSE);
+}
+
 /*
  *	Sets name of instrument.
  */
@@ -147,6 +260,7 @@ void CPInsSetTextureBG(CPIns *ins, const char *path)
 
         V3DTextureDestroy(ins->tex_bg);
         ins->tex_bg = NULL;
+	ins->values_drawn_valid = GL_FALSE;
 
         if((path != NULL) ? (*path == '\0') : GL_TRUE)
             return;
@@ -167,6 +281,7 @@ void CPInsSetTextureFG(CPIns *ins, const char *path)
 
         V3DTextureDestroy(ins->tex_fg);
         ins->tex_fg = NULL;
+	ins->values_drawn_valid = GL_FALSE;
 
         if((path != NULL) ? (*path == '\0') : GL_TRUE)
             return;
@@ -197,9 +312,11 @@ void CPInsSetResolution(
 	    ins->res_width = res_width;
 	    ins->res_height = res_height;
 
-	    /* Destroy texture. */
+	    /* Destroy frame buffer object and texture. */
+	    CPInsFramebufferDelete(ins);
 	    V3DTextureDestroy(ins->tex);
 	    ins->tex = NULL;
+	    ins->values_drawn_valid = GL_FALSE;
 
 	    /* Recreate texture if resolution is positive. */
 	    if((res_width > 0) && (res_height > 0))
@@ -217,6 +334,11 @@ void CPInsSetResolution(
 		);
 		free(data);
 		V3DTexturePriority(ins->tex, 1.0);
+
+		/* Draw to the texture with a frame buffer object
+		 * if possible.
+		 */
+		CPInsFramebufferCreate(ins);
 	    }
 	}
 }
@@ -290,6 +412,10 @@ void CPInsResetTimmers(CPIns *ins, time_t t)
 
 /*
  *	Change values of instrument.
+ *
+ *	The instrument's texture is only redrawn if the values changed
+ *	by more than the CPINS_QUANTUM_* amounts since it was last
+ *	drawn or if the instrument's update interval has elapsed.
  */
 void CPInsChangeValues(CPIns *ins, ControlPanelValues *v)
 {
@@ -305,6 +431,34 @@ void CPInsChangeValues(CPIns *ins, ControlPanelValues *v)
 	    if((display == NULL) || (width <= 1) || (height < 1))
 		return;
 
+	    /* Texture is still up to date? */
+	    if(ins->values_drawn_valid &&
+	       !CPInsValuesChanged(&ins->values_drawn, v)
+	    )
+	    {
+		if(ins->update_int <= 0)
+		    return;
+		if(v->current_time < ins->update_next)
+		    return;
+	    }
+	    if(ins->update_int > 0)
+		ins->update_next = v->current_time + ins->update_int;
+
+	    /* Create the texture now if it was not created yet so that
+	     * its frame buffer object exists before the first draw.
+	     */
+	    if(ins->tex == NULL)
+	    {
+		CPInsSetResolution(ins, 0, 0);
+		CPInsSetResolution(ins, width, height);
+	    }
+
+#ifdef STATE_GL_VERSION_3_0
+	    /* Draw directly to the texture? */
+	    if(ins->framebuffer != 0)
+		glBindFramebuffer(GL_FRAMEBUFFER, ins->framebuffer);
+#endif
+
 	    /* Set up GL states for 2d drawing before calling the
 	     * "values_changed" function. This is for convience so that
 	     * the GL state is all ready for drawing of the texture.
@@ -343,6 +497,14 @@ void CPInsChangeValues(CPIns *ins, ControlPanelValues *v)
 		v,
 		ins->values_changed_func_data
 	    );
+
+#ifdef STATE_GL_VERSION_3_0
+	    if(ins->framebuffer != 0)
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+#endif
+
+	    memcpy(&ins->values_drawn, v, sizeof(ControlPanelValues));
+	    ins->values_drawn_valid = GL_TRUE;
 	}
 }
 
@@ -478,6 +640,9 @@ void CPInsManage(CPIns *ins, ControlPanelValues *v)
 /*
  *	Gets the texture from the drawn up back buffer of the GL frame 
  *	buffer.
+ *
+ *	Does nothing if the instrument has a frame buffer object since
+ *	it was drawn directly to the texture.
  */
 void CPInsRealizeTexture(CPIns *ins)
 {
@@ -489,6 +654,9 @@ void CPInsRealizeTexture(CPIns *ins)
         if(ins == NULL)
             return;
 
+	if(ins->framebuffer != 0)
+	    return;
+
         cp = CONTROL_PANEL(ins->cp);
         display = CONTROL_PANEL_DISPLAY(cp);
         if(display == NULL)
@@ -657,6 +825,7 @@ void CPInsDelete(CPIns *ins)
 	/* Begin deleting instrument. */
         V3DTextureDestroy(ins->tex_bg);
         V3DTextureDestroy(ins->tex_fg);
+	CPInsFramebufferDelete(ins);
 	V3DTextureDestroy(ins->tex);
 	free(ins->name);
 	free(ins);
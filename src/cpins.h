@@ -33,6 +33,16 @@
 #define CPINS_TYPE_INS		1
 
 
+/*
+ *	Smallest changes of the control panel values that redraw the
+ *	instrument's texture, see CPInsChangeValues():
+ */
+#define CPINS_QUANTUM_ANGLE	0.004363f	/* Radians (0.25 degrees) */
+#define CPINS_QUANTUM_SPEED	0.5f		/* Miles per hour */
+#define CPINS_QUANTUM_ALT	1.0f		/* Feet */
+#define CPINS_QUANTUM_COEFF	0.01f
+
+
 /*
  *	Control Panel Instrument structure:
  *
@@ -61,12 +71,24 @@ struct _CPIns {
 
 	/* Texture that will be used when drawing the instrument, this
 	 * texture should be created in the "values_changed" function
-	 * using the GL back buffer.  The size of this texture is
+	 * using the GL back buffer (or the frame buffer object).  The size of this texture is
 	 * determined by res_width and res_height, this will also be
 	 * the size of the GL back buffer when drawing for this texture.
 	 */
 	v3d_texture_ref_struct  *tex;
 
+	/* GL frame buffer object with the texture tex as its color
+	 * buffer, the instrument is drawn into it instead of into
+	 * the GL back buffer when it is not 0.
+	 */
+	GLuint	framebuffer;
+
+	/* Values that the texture was last drawn with, values_drawn
+	 * is only valid if values_drawn_valid is GL_TRUE.
+	 */
+	ControlPanelValues	values_drawn;
+	GLboolean	values_drawn_valid;
+
 	/* Last time instrument was updated and the update interval. */
 	time_t	update_next,		/* In milliseconds. */
 		update_int;
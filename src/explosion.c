@@ -145,7 +145,9 @@ int ExplosionCreate(
 	);
  
 	/* Set reference object */
-	explosion->ref_object = ref_object;
+	explosion->ref_object = SARObjGetHandle(
+	    scene, *ptr, *total, ref_object
+	);
 
 	return(obj_num);
 }
@@ -233,7 +235,9 @@ int SplashCreate(
 	);
 
 	/* Set reference object */
-	explosion->ref_object = ref_object;
+	explosion->ref_object = SARObjGetHandle(
+	    scene, *ptr, *total, ref_object
+	);
 
 	return(obj_num);
 }
@@ -138,9 +138,11 @@ int FireCreate(
 #if 0
 	/* Set reference object */
 /* Not used */
-	fire->ref_object = ref_object;
+	fire->ref_object = SARObjGetHandle(
+	    scene, *ptr, *total, ref_object
+	);
 #endif
-	fire->ref_object = -1;
+	fire->ref_object = SAR_OBJ_HANDLE_NONE;
 
 	return(obj_num);
 }
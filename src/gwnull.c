@@ -0,0 +1,171 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+	Graphics Wrapper without a display, used by the headless
+	simulation runner (see sarheadless.c) in place of gwx.c.
+
+	There is never a display so only the functions that the
+	simulation, scene and mission modules call are provided and
+	they all do nothing.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gw.h"
+
+
+int GWContextCurrent(gw_display_struct *display);
+int GWContextGet(
+	gw_display_struct *display, int ctx_num,
+	void **window_id_rtn, void **gl_context_rtn,
+	int *x_rtn, int *y_rtn, int *width_rtn, int *height_rtn
+);
+void GWPostRedraw(gw_display_struct *display);
+void GWSwapBuffer(gw_display_struct *display);
+void GWOrtho2D(gw_display_struct *display);
+void GWOrtho2DCoord(
+	gw_display_struct *display,
+	float left, float right, float top, float bottom
+);
+void GWSetPointerCursor(
+	gw_display_struct *display, gw_pointer_cursor cursor
+);
+void GWSetFont(gw_display_struct *display, GWFont *font);
+int GWGetFontSize(
+	GWFont *font,
+	int *width, int *height,
+	int *character_spacing, int *line_spacing
+);
+void GWDrawString(
+	gw_display_struct *display,
+	int x, int y,
+	const char *string
+);
+void GWDrawCharacter(
+	gw_display_struct *display,
+	int x, int y,
+	char c
+);
+
+
+/*
+ *	Returns -1, there is no GL context.
+ */
+int GWContextCurrent(gw_display_struct *display)
+{
+	return(-1);
+}
+
+/*
+ *	Returns all values as 0 and returns -1, there is no GL context.
+ */
+int GWContextGet(
+	gw_display_struct *display, int ctx_num,
+	void **window_id_rtn, void **gl_context_rtn,
+	int *x_rtn, int *y_rtn, int *width_rtn, int *height_rtn
+)
+{
+	if(window_id_rtn != NULL)
+	    *window_id_rtn = NULL;
+	if(gl_context_rtn != NULL)
+	    *gl_context_rtn = NULL;
+	if(x_rtn != NULL)
+	    *x_rtn = 0;
+	if(y_rtn != NULL)
+	    *y_rtn = 0;
+	if(width_rtn != NULL)
+	    *width_rtn = 0;
+	if(height_rtn != NULL)
+	    *height_rtn = 0;
+
+	return(-1);
+}
+
+void GWPostRedraw(gw_display_struct *display)
+{
+
+}
+
+void GWSwapBuffer(gw_display_struct *display)
+{
+
+}
+
+void GWOrtho2D(gw_display_struct *display)
+{
+
+}
+
+void GWOrtho2DCoord(
+	gw_display_struct *display,
+	float left, float right, float top, float bottom
+)
+{
+
+}
+
+void GWSetPointerCursor(
+	gw_display_struct *display, gw_pointer_cursor cursor
+)
+{
+
+}
+
+void GWSetFont(gw_display_struct *display, GWFont *font)
+{
+
+}
+
+/*
+ *	Returns all sizes as 0 and returns -1, there are no fonts.
+ */
+int GWGetFontSize(
+	GWFont *font,
+	int *width, int *height,
+	int *character_spacing, int *line_spacing
+)
+{
+	if(width != NULL)
+	    *width = 0;
+	if(height != NULL)
+	    *height = 0;
+	if(character_spacing != NULL)
+	    *character_spacing = 0;
+	if(line_spacing != NULL)
+	    *line_spacing = 0;
+
+	return(-1);
+}
+
+void GWDrawString(
+	gw_display_struct *display,
+	int x, int y,
+	const char *string
+)
+{
+
+}
+
+void GWDrawCharacter(
+	gw_display_struct *display,
+	int x, int y,
+	char c
+)
+{
+
+}
@@ -20,15 +20,22 @@
 #include "v3dtex.h"
 #include "obj.h"
 #include "horizon.h"
+#include "config.h"
 
 
-v3d_texture_ref_struct *SARCreateHorizonTexture(
-	const char *name,
+static void SARHorizonRenderGradient(
+	u_int8_t *data,
 	const sar_color_struct *start_color,	/* Top color */
 	const sar_color_struct *end_color,	/* Bottom color */
 	int height,				/* Width in pixels */
 	float midpoint
 );
+v3d_texture_ref_struct *SARCreateHorizonTexture(
+	const char *name,
+	const sar_scene_struct *scene
+);
+float SARHorizonTexCoordT(float tod);
+void SARHorizonTexCoordS(int band, float *s_top, float *s_bottom);
 
 
 #define ATOI(s)		(((s) != NULL) ? atoi(s) : 0)
@@ -45,13 +52,16 @@ v3d_texture_ref_struct *SARCreateHorizonTexture(
 #define RADTODEG(r)	((r) * 180.0 / PI)
 #define DEGTORAD(d)	((d) * PI / 180.0)
 
+/* Converts hours into seconds */
+#define HTOS(h)	((h) * 3600.0)
+
 
 /*
- *	Returns a 1D gradient horizon texture generated by the
- *	given colors.
+ *	Renders a gradient of height RGB pixels into data, going from
+ *	the start color to the end color.
  */
-v3d_texture_ref_struct *SARCreateHorizonTexture(
-	const char *name,
+static void SARHorizonRenderGradient(
+	u_int8_t *data,
 	const sar_color_struct *start_color,	/* Top color */
 	const sar_color_struct *end_color,	/* Bottom color */
 	int height,				/* Width in pixels */
@@ -60,100 +70,219 @@ v3d_texture_ref_struct *SARCreateHorizonTexture(
 {
 	int y, y_midpoint;
 	float dr, dg, db;
-	int bits_per_pixel = 32;
+	u_int8_t r, g, b;
+	u_int8_t *ptr8 = data;
+
+	y_midpoint = (int)MIN(midpoint * height, height - 1);
+	dr = end_color->r - start_color->r;	/* Color delta coeffs */
+	dg = end_color->g - start_color->g;
+	db = end_color->b - start_color->b;
+	for(y = 0; y < height; y++)
+	{
+	    if(y < y_midpoint)
+	    {
+		float coeff = (float)((y_midpoint > 0) ?
+		    (float)y / (float)y_midpoint : 0.0
+		);
+
+		r = (u_int8_t)CLIP(
+		    (start_color->r + (dr / 2 * coeff)) *
+		    0xff, 0x00, 0xff
+		);
+		g = (u_int8_t)CLIP(
+		    (start_color->g + (dg / 2 * coeff)) *
+		    0xff, 0x00, 0xff
+		);
+		b = (u_int8_t)CLIP(
+		    (start_color->b + (db / 2 * coeff)) *
+		    0xff, 0x00, 0xff
+		);
+	    }
+	    else
+	    {
+		float coeff = (float)(((height - y_midpoint) > 0) ?
+		    (float)(y - y_midpoint) /
+		    (float)(height - y_midpoint) :
+		    1.0
+		);
+
+		r = (u_int8_t)CLIP(
+		    (start_color->r + (dr / 2) + (dr / 2 * coeff)) *
+		    0xff, 0x00, 0xff
+		);
+		g = (u_int8_t)CLIP(
+		    (start_color->g + (dg / 2) + (dg / 2 * coeff)) *
+		    0xff, 0x00, 0xff
+		);
+		b = (u_int8_t)CLIP(
+		    (start_color->b + (db / 2) + (db / 2 * coeff)) *
+		    0xff, 0x00, 0xff
+		);
+	    }
+
+	    *ptr8++ = r;
+	    *ptr8++ = g;
+	    *ptr8++ = b;
+	}
+}
+
+/*
+ *	Returns a 2D texture of the horizon gradients of the given
+ *	scene's sky colors for every time of day.
+ *
+ *	Each row of the texture is a time of day, from noon on the
+ *	first row to midnight on the last (the afternoon mirrors the
+ *	morning), see SARHorizonTexCoordT(). Each row has
+ *	SAR_HORIZON_BANDS gradients of SAR_HORIZON_GRADIENT_WIDTH
+ *	pixels from the brightest to the darkest band, see
+ *	SARHorizonTexCoordS().
+ *
+ *	No lumination or gamma is added to the gradients, the light
+ *	color is multiplied with them when they are drawn.
+ */
+v3d_texture_ref_struct *SARCreateHorizonTexture(
+	const char *name,
+	const sar_scene_struct *scene
+)
+{
+	const int	size = SAR_HORIZON_TEXTURE_SIZE,
+			bands = SAR_HORIZON_BANDS,
+			width = SAR_HORIZON_GRADIENT_WIDTH;
+	int i, row;
+	float rc, gc, bc;		/* Coefficient color change */
+	float x, sat_coeff, darken_coeff;
+	sar_color_struct end_color;
 	u_int8_t *data;
 	v3d_texture_ref_struct *t;
-	u_int8_t r, g, b;
-	u_int8_t *ptr8;
 
 
-	if((start_color == NULL) || (end_color == NULL) ||
-           (height <= 0)
-	)
+	if(scene == NULL)
 	    return(NULL);
 
-	/* Allocate tempory image data that will be rendered and used
-	 * to create the texture
-	 *
-	 * Note that we are allocating more bytes since the data passed
-	 * for creation is only 24 bits (3 bytes)
-	 */
-	data = (u_int8_t *)malloc(
-            height * (bits_per_pixel >> 3)
-        );
-
+	data = (u_int8_t *)calloc(size * size * 3, sizeof(u_int8_t));
+	if(data == NULL)
+	    return(NULL);
 
-	/* Render the image */
-	y_midpoint = (int)MIN(midpoint * height, height - 1);
-	dr = end_color->r - start_color->r;	/* Color delta coeffs */
-        dg = end_color->g - start_color->g;
-        db = end_color->b - start_color->b;
-	switch(bits_per_pixel)
+	for(row = 0; row < size; row++)
 	{
-	  case 32:
-	    ptr8 = (u_int8_t *)(&data[0]);
-	    for(y = 0; y < height; y++)
+	    /* Horizon saturation coefficient, the amount of dawn/dusk
+	     * saturation on the horizon, from the time of day linearly
+	     * from 0.0 at noon to 1.0 at 4:00 and 20:00 (with power
+	     * of 2)
+	     */
+	    x = (float)((double)row / (double)(size - 1) * HTOS(12.0) /
+		HTOS(8.0));
+	    sat_coeff = (float)CLIP(1.0 - (x * x), 0.0, 1.0);
+
+	    for(i = 0; i < bands; i++)
 	    {
-		if(y < y_midpoint)
-		{
-		    float coeff = (float)((y_midpoint > 0) ?
-			(float)y / (float)y_midpoint : 0.0
-		    );
-
-		    r = (u_int8_t)CLIP(
-			(start_color->r + (dr / 2 * coeff)) *
-			0xff, 0x00, 0xff
-		    );
-                    g = (u_int8_t)CLIP(
-                        (start_color->g + (dg / 2 * coeff)) *
-                        0xff, 0x00, 0xff
-                    );
-                    b = (u_int8_t)CLIP(
-                        (start_color->b + (db / 2 * coeff)) *
-                        0xff, 0x00, 0xff
-                    );
-		}
-		else
-		{
-                    float coeff = (float)(((height - y_midpoint) > 0) ?
-                        (float)(y - y_midpoint) / 
-			(float)(height - y_midpoint) :
-			1.0
-                    );
-
-                    r = (u_int8_t)CLIP(
-			(start_color->r + (dr / 2) + (dr / 2 * coeff)) *
-			0xff, 0x00, 0xff
-		    );
-                    g = (u_int8_t)CLIP(
-			(start_color->g + (dg / 2) + (dg / 2 * coeff)) *
-			0xff, 0x00, 0xff
-                    );
-                    b = (u_int8_t)CLIP(
-			(start_color->b + (db / 2) + (db / 2 * coeff)) *
-			0xff, 0x00, 0xff
-                    );
-		}
-
-		*ptr8++ = r;
-		*ptr8++ = g;
-                *ptr8++ = b;
+		/* Calculate darken coefficient based on index of
+		 * the band
+		 */
+		darken_coeff = (float)i / (float)(bands - 1);
+
+		/* Calculate rgb blend values from 1.0 to 2.0 */
+		rc = (float)MIN(
+		    (scene->sky_brighten_color.r * (1.0 - darken_coeff)) +
+		    (scene->sky_darken_color.r * darken_coeff),
+		    1.0
+		);
+		gc = (float)MIN(
+		    (scene->sky_brighten_color.g * (1.0 - darken_coeff)) +
+		    (scene->sky_darken_color.g * darken_coeff),
+		    1.0
+		);
+		bc = (float)MIN(
+		    (scene->sky_brighten_color.b * (1.0 - darken_coeff)) +
+		    (scene->sky_darken_color.b * darken_coeff),
+		    1.0
+		);
+
+		/* Calculate end color */
+		end_color.a = 1.0f;
+		end_color.r = (float)MIN(
+		    sat_coeff + (rc * (1.0 - sat_coeff)), 1.0
+		);
+		end_color.g = (float)MIN(
+		    sat_coeff + (gc * (1.0 - sat_coeff)), 1.0
+		);
+		end_color.b = (float)MIN(
+		    sat_coeff + (bc * (1.0 - sat_coeff)), 1.0
+		);
+
+		SARHorizonRenderGradient(
+		    &data[((row * size) + (i * width)) * 3],
+		    &scene->sky_nominal_color, &end_color,
+		    width, SAR_HORIZON_GRADIENT_MIDPOINT
+		);
 	    }
-	    break;
 	}
 
 	/* Create texture from image data */
-	t = V3DTextureLoadFromData1D(
+	t = V3DTextureLoadFromData2D(
 	    data, name,
-	    height,
-	    bits_per_pixel,
+	    size, size,
+	    3,
 	    V3D_TEX_FORMAT_RGB,
 	    NULL, NULL
 	);
 	V3DTexturePriority(t, 0.98f);
 
+	/* The rows and bands must not be blended with each other or
+	 * with the unused columns, so do not use the mipmaps and do
+	 * not wrap around at the edges
+	 */
+	if(t != NULL)
+	{
+	    V3DTextureSelect(t);
+	    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+#ifdef GL_CLAMP_TO_EDGE
+	    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#else
+	    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+	    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+#endif
+	    V3DTextureSelect(NULL);
+	}
+
 	/* Delete the tempory image data */
 	free(data);
 
 	return(t);
 }
+
+/*
+ *	Returns the t texture coordinate of the horizon texture's row
+ *	for the given time of day (in seconds since midnight).
+ */
+float SARHorizonTexCoordT(float tod)
+{
+	const int size = SAR_HORIZON_TEXTURE_SIZE;
+	const float x = (float)CLIP(
+	    ((tod > HTOS(12.0)) ? (tod - HTOS(12.0)) : (HTOS(12.0) - tod)) /
+		HTOS(12.0),
+	    0.0, 1.0
+	);
+
+	/* Keep within the centers of the first and last rows */
+	return((0.5f + (x * (float)(size - 1))) / (float)size);
+}
+
+/*
+ *	Returns the s texture coordinates of the top and bottom of the
+ *	given band's gradient on the horizon texture, where band 0 is
+ *	the brightest and SAR_HORIZON_BANDS - 1 the darkest.
+ *
+ *	The coordinates are at the centers of the gradient's first and
+ *	last pixels so that the neighbouring bands are never sampled.
+ */
+void SARHorizonTexCoordS(int band, float *s_top, float *s_bottom)
+{
+	const int	size = SAR_HORIZON_TEXTURE_SIZE,
+			width = SAR_HORIZON_GRADIENT_WIDTH;
+
+	band = CLIP(band, 0, SAR_HORIZON_BANDS - 1);
+	*s_top = ((float)(band * width) + 0.5f) / (float)size;
+	*s_bottom = ((float)((band + 1) * width) - 0.5f) / (float)size;
+}
@@ -22,12 +22,11 @@
 
 
 extern v3d_texture_ref_struct *SARCreateHorizonTexture(
-        const char *name,
-	const sar_color_struct *start_color,	/* Top color */
-	const sar_color_struct *end_color,	/* Bottom color */
-        int height,
-	float midpoint
+	const char *name,
+	const sar_scene_struct *scene
 );
+extern float SARHorizonTexCoordT(float tod);
+extern void SARHorizonTexCoordS(int band, float *s_top, float *s_bottom);
 
 
 #endif	/* HORIZON_H */
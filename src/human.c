@@ -53,6 +53,10 @@ void SARHumanSetObjectPreset(
 	sar_object_struct *obj_ptr,
 	const char *name
 );
+static void SARHumanSetAssistingPresets(
+	sar_human_data_struct *hd,
+	sar_object_human_struct *human
+);
 
 
 #define ATOI(s)		(((s) != NULL) ? atoi(s) : 0)
@@ -146,6 +150,10 @@ void SARHumanPresetsShutdown(sar_human_data_struct *hd)
 	hd->preset = NULL;
 	hd->total_presets = 0;
 
+	free(hd->draw_cache);
+	hd->draw_cache = NULL;
+	hd->total_draw_cache = 0;
+
 	free(hd);
 }
 
@@ -235,7 +243,7 @@ int SARHumanCreate(
 	);
 
 	/* Reset other human object values here */
-	human->intercepting_object = -1;
+	human->intercepting_object = SAR_OBJ_HANDLE_NONE;
 
 	human->intercepting_object_distance2d =
 	    human->intercepting_object_distance3d = 0.0;
@@ -257,6 +265,11 @@ int SARHumanCreate(
 	    hd, obj_ptr, name
 	);
 
+	/* Match the assisting humans presets once here so that they
+	 * need not be looked up each time the human is drawn.
+	 */
+	SARHumanSetAssistingPresets(hd, human);
+
 	return(obj_num);
 }
 
@@ -330,3 +343,39 @@ void SARHumanSetObjectPreset(
 
 
 }
+
+/*
+ *	Sets the assisting humans presets on the given human to the
+ *	human presets data entries that match their preset names, the
+ *	default assisting human preset is used when the name is not
+ *	set or could not be matched.
+ */
+static void SARHumanSetAssistingPresets(
+	sar_human_data_struct *hd,
+	sar_object_human_struct *human
+)
+{
+	int i;
+	sar_human_data_entry_struct *entry;
+
+	if((hd == NULL) || (human == NULL))
+	    return;
+
+	for(i = 0; i < SAR_ASSISTING_HUMANS_MAX; i++)
+	{
+	    entry = NULL;
+	    if(i < human->assisting_humans)
+	    {
+		if(human->assisting_human_preset_name[i] != NULL)
+		    entry = SARHumanMatchEntryByName(
+			hd, human->assisting_human_preset_name[i]
+		    );
+		/* Human preset name not found? */
+		if(entry == NULL)
+		    entry = SARHumanMatchEntryByName(
+			hd, SAR_HUMAN_PRESET_NAME_ASSISTING_HUMAN
+		    );
+	    }
+	    human->assisting_human_preset[i] = entry;
+	}
+}
@@ -52,6 +52,30 @@ typedef struct {
 #define SAR_HUMAN_DATA_ENTRY(p)	((sar_human_data_entry_struct *)(p))
 
 
+/*
+ *	Human Draw Cache Entry:
+ *
+ *	A GL list of a human body and everything that it was recorded
+ *	from, see SARDrawHumanIterate().
+ */
+typedef struct {
+
+	float		height, mass;
+	sar_human_flags	flags;
+	int		anim_frame;	/* -1 if the pose is not animated */
+	int		flir;
+	sar_color_struct	color[SAR_HUMAN_COLORS_MAX];
+
+} sar_human_draw_key_struct;
+
+typedef struct {
+
+	sar_human_draw_key_struct	key;
+	unsigned int	list;		/* GL list, 0 if the entry is unused */
+
+} sar_human_draw_cache_struct;
+
+
 /*
  *	Human Data Presets:
  */
@@ -62,6 +86,14 @@ typedef struct {
 	sar_human_data_entry_struct	**preset;
 	int				total_presets;
 
+	/* GL lists of the drawn human bodies, a hash table of
+	 * SAR_HUMAN_DRAW_CACHE_MAX entries allocated on the first
+	 * draw. The GL lists must be deleted with
+	 * SARDrawHumanCacheClear() while the GL context exists.
+	 */
+	sar_human_draw_cache_struct	*draw_cache;
+	int				total_draw_cache;
+
 } sar_human_data_struct;
 #define SAR_HUMAN_DATA(p)	((sar_human_data_struct *)(p))
 
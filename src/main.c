@@ -64,6 +64,7 @@
 #include "sarmenumanage.h"
 #include "sarmenucodes.h"
 #include "sarsimend.h"
+#include "sarreplay.h"
 #include "config.h"
 
 #include "fonts/6x10.fnt"
@@ -99,6 +100,9 @@ void SARCloseCB(int ctx_num, void *ptr, void *data);
 void SARResetTimmersCB(sar_core_struct *core_ptr, time_t t_new);
 
 sar_core_struct *SARInit(int argc, char **argv);
+static void SARManageSimulation(
+	sar_core_struct *core_ptr, sar_scene_struct *scene
+);
 void SARManage(void *ptr);
 void SARShutdown(sar_core_struct *core_ptr);
 
@@ -726,6 +730,12 @@ void SARKeyBoardCB(void *ptr, int c, Boolean state, unsigned long t)
 	if(display == NULL)
 	    return;
 
+	/* Record the key event or ignore it if a replay is being
+	 * played back
+	 */
+	if(SARReplayKey(core_ptr->replay, c, state, t))
+	    return;
+
 	alt_key_state = display->alt_key_state;
 	ctrl_key_state = display->ctrl_key_state;
 	shift_key_state = display->shift_key_state;
@@ -1056,9 +1066,9 @@ void SARResetTimmersCB(sar_core_struct *core_ptr, time_t t_new)
 	lapsed_millitime = 0l;
 	time_compensation = 1.0f;
 
-
-	/* Update random seed */
-	srand((unsigned int)cur_millitime);
+	/* Reset the simulation ticks */
+	core_ptr->sim_tick_lapsed = 0l;
+	core_ptr->sim_tick_coeff = 1.0f;
 
 
 	/* Reset global next timmers */
@@ -1217,6 +1227,8 @@ sar_core_struct *SARInit(int argc, char **argv)
 	float		aspect_offset = 0.0f;
 	Boolean		startup_no_sound = False;
 	const char	*sound_server_connect_arg = NULL;
+	const char	*replay_file = NULL;
+	int		replay_mode = SAR_REPLAY_MODE_NONE;
 
 	Boolean notify_install_local_error = False,
 		notify_install_local_success = False;
@@ -1268,6 +1280,7 @@ sar_core_struct *SARInit(int argc, char **argv)
 	core_ptr->recorder = NULL;
 	core_ptr->audio_mode_name = NULL;
 	core_ptr->gctl = NULL;
+	core_ptr->replay = NULL;
 
 	core_ptr->cur_music_id = -1;
 	core_ptr->music_ref = NULL;
@@ -1400,6 +1413,8 @@ GCTL_JS_AXIS_ROLE_AS_THROTTLE_AND_RUDDER;
 	opt->damage_resistance_coeff = 1.0f;
 	opt->flight_physics_level = FLIGHT_PHYSICS_REALISTIC;	/* Make it hard */
 	opt->wind = True;
+	opt->sim_tick_rate = SAR_DEF_SIM_TICK_RATE;
+	opt->sim_max_ticks = SAR_DEF_SIM_MAX_TICKS;
 
 	opt->last_selected_player = 0;
 	opt->last_selected_mission = 0;
@@ -1797,6 +1812,32 @@ GCTL_JS_AXIS_ROLE_AS_THROTTLE_AND_RUDDER;
 		    );
 		}
 	    }
+	    /* Record or play back a replay */
+	    else if(!strcasecmp(arg, "--record-replay") ||
+		    !strcasecmp(arg, "-record-replay") ||
+		    !strcasecmp(arg, "--replay") ||
+		    !strcasecmp(arg, "-replay")
+	    )
+	    {
+		if(!strcasecmp(arg, "--replay") || !strcasecmp(arg, "-replay"))
+		    replay_mode = SAR_REPLAY_MODE_PLAY;
+		else
+		    replay_mode = SAR_REPLAY_MODE_RECORD;
+		i++;
+		arg = (i < argc) ? argv[i] : NULL;
+		if(arg != NULL)
+		{
+		    replay_file = arg;
+		}
+		else
+		{
+		    fprintf(
+			stderr,
+			"%s: Requires argument.\n",
+			argv[i - 1]
+		    );
+		}
+	    }
 	    /* No sound */
 	    else if(!strcasecmp(arg, "--no_sound") ||
 		    !strcasecmp(arg, "--nosound") ||
@@ -2003,6 +2044,9 @@ PROG_NAME_FULL " was unable to complete the installation of local data files in:
 	}
 	dpy = core_ptr->display;
 
+	/* Record the texture bindings on the display's GL states */
+	V3DTextureSetStateGL(&dpy->state_gl);
+
 	/* Check if we have OpenGL 1.1 or newer */
 	if((dpy->gl_version_major < 1) ?
 	    True : ((dpy->gl_version_major == 1) ?
@@ -2044,6 +2088,15 @@ that was detected is 0 bits in size.\n"
 	GWSetCloseCB(dpy, SARCloseCB, core_ptr);
 	GWSetTimeoutCB(dpy, SARManage, core_ptr);
 
+	/* Open the replay file, the scenes are recorded or played back
+	 * from when they begin to when they end
+	 */
+	if(replay_file != NULL)
+	    core_ptr->replay = SARReplayNew(
+		replay_file, replay_mode,
+		dpy, SARKeyBoardCB, core_ptr
+	    );
+
 
 	/* Do splash */
 	SARSplash(core_ptr);
@@ -2227,6 +2280,89 @@ to exist before."
 	return(core_ptr);
 }
 
+/*
+ *	Updates the simulation for the time lapsed since the last loop.
+ *
+ *	If the simulation tick rate option is set then the simulation
+ *	is updated in fixed ticks of that rate, each tick sees
+ *	cur_millitime, lapsed_millitime and time_compensation for the
+ *	tick instead of the loop. Lapsed time that is less than a tick
+ *	is kept for the next loop and sets the core's sim_tick_coeff,
+ *	which is how far between the last two ticks the objects are
+ *	drawn. No more than the maximum ticks option are done per
+ *	loop, the rest of the lapsed time is dropped so that a slow
+ *	loop does not cause even more ticks on the next loop.
+ *
+ *	Otherwise the simulation is updated once for the time lapsed
+ *	since the last loop.
+ */
+static void SARManageSimulation(
+	sar_core_struct *core_ptr, sar_scene_struct *scene
+)
+{
+	int ticks;
+	time_t tick_ms, t_loop, lapsed_loop;
+	float compensation_loop;
+	const sar_option_struct *opt = &core_ptr->option;
+
+	/* Update once per loop? */
+	if(opt->sim_tick_rate <= 0)
+	{
+	    core_ptr->sim_tick_lapsed = 0l;
+	    core_ptr->sim_tick_coeff = 1.0f;
+	    SARSimUpdateScene(core_ptr, scene);
+	    SARSimUpdateSceneObjects(core_ptr, scene);
+	    return;
+	}
+
+	/* Record this loop's timings, they will be restored after the
+	 * ticks
+	 */
+	t_loop = cur_millitime;
+	lapsed_loop = lapsed_millitime;
+	compensation_loop = time_compensation;
+
+	tick_ms = (time_t)MAX(1000 / opt->sim_tick_rate, 1);
+	core_ptr->sim_tick_lapsed += lapsed_loop;
+
+	/* Set the timings for the ticks, starting from the time of
+	 * the last tick
+	 */
+	cur_millitime = t_loop - core_ptr->sim_tick_lapsed;
+	lapsed_millitime = tick_ms;
+	time_compensation = (float)tick_ms / (float)CYCLE_LAPSE_MS;
+
+	for(ticks = 0;
+	    (core_ptr->sim_tick_lapsed >= tick_ms) &&
+	    (ticks < MAX(opt->sim_max_ticks, 1));
+	    ticks++
+	)
+	{
+	    cur_millitime += tick_ms;
+	    core_ptr->sim_tick_lapsed -= tick_ms;
+
+	    SARSimUpdatePrevious(core_ptr);
+	    SARSimUpdateScene(core_ptr, scene);
+	    SARSimUpdateSceneObjects(core_ptr, scene);
+
+	    /* Stop if the simulation was ended during this tick */
+	    if((core_ptr->scene != scene) ||
+	       SARIsMenuAllocated(core_ptr, core_ptr->cur_menu)
+	    )
+		break;
+	}
+
+	/* Drop the lapsed time that could not be simulated */
+	core_ptr->sim_tick_lapsed %= tick_ms;
+	core_ptr->sim_tick_coeff = (float)core_ptr->sim_tick_lapsed /
+	    (float)tick_ms;
+
+	/* Restore this loop's timings */
+	cur_millitime = t_loop;
+	lapsed_millitime = lapsed_loop;
+	time_compensation = compensation_loop;
+}
+
 /*
  *	SAR management, this is called once per loop as the timeout
  *	function.
@@ -2246,8 +2382,10 @@ void SARManage(void *ptr)
 
 	opt = &core_ptr->option;
 
-	/* Get current time in milliseconds */
-	t_new = SARGetCurMilliTime();
+	/* Get current time in milliseconds, or the recorded one if a
+	 * replay is being played back
+	 */
+	t_new = SARReplayTime(core_ptr->replay, SARGetCurMilliTime());
 
 	/* Check if the new current time has "warped" to a smaller value
 	 * than the previous current time.
@@ -2284,6 +2422,7 @@ void SARManage(void *ptr)
 	    (Boolean)((opt->flight_physics_level == FLIGHT_PHYSICS_EASY) ? True : False),	/* Bank nullzone? */
 	    cur_millitime, lapsed_millitime, time_compensation
 	);
+	SARReplayGCtl(core_ptr->replay, core_ptr->gctl);
 
 
 	/* Check if a current menu is allocated (hence selected) */
@@ -2304,11 +2443,15 @@ void SARManage(void *ptr)
 	     */
 	    scene = core_ptr->scene;
 
-	    SARSimUpdateScene(core_ptr, scene);
-	    SARSimUpdateSceneObjects(core_ptr, scene);
+	    SARManageSimulation(core_ptr, scene);
 
+	    /* Draw the objects between the last two simulation ticks */
 	    if(is_visible)
+	    {
+		SARSimInterpolateBegin(core_ptr, core_ptr->sim_tick_coeff);
 		SARDraw(core_ptr);
+		SARSimInterpolateEnd(core_ptr);
+	    }
 
 	    /* Manage mission */
 	    status = SARMissionManage(core_ptr);
@@ -2571,6 +2714,7 @@ void SARShutdown(sar_core_struct *core_ptr)
 	}
 
 	/* Human Data */
+	SARDrawHumanCacheClear(core_ptr->human_data);
 	SARHumanPresetsShutdown(core_ptr->human_data);
 	core_ptr->human_data = NULL;
 
@@ -2583,6 +2727,17 @@ void SARShutdown(sar_core_struct *core_ptr)
 	GCtlDelete(core_ptr->gctl);
 	core_ptr->gctl = NULL;
 
+	/* Replay */
+	SARReplayDelete(core_ptr->replay);
+	core_ptr->replay = NULL;
+
+	/* Draw queue */
+	SARDrawQueueClear(&core_ptr->draw_queue);
+	SARDrawParticlesClear(&core_ptr->draw_particles);
+	SARDrawLightsClear(&core_ptr->draw_lights);
+	SARDrawShadowsClear(&core_ptr->draw_shadows);
+	SARDrawOcclusionClear(&core_ptr->draw_occlusion);
+
 	/* Music List */
 	SARMusicListDeleteAll(&core_ptr->music_ref, &core_ptr->total_music_refs);
 
@@ -2597,6 +2752,7 @@ void SARShutdown(sar_core_struct *core_ptr)
 	core_ptr->recorder_address = NULL;
 
 	/* Graphics wrapper */
+	V3DTextureSetStateGL(NULL);
 	GWShutdown(core_ptr->display);
 	core_ptr->display = NULL;
 
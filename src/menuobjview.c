@@ -1012,6 +1012,7 @@ int SARMenuObjViewLoad(
 	ov_ptr->obj_list = (void *)list;
 
 	/* Begin recording GL list */
+	V3DTextureInvalidate();
 	glNewList(list, GL_COMPILE);
 
 	/* Generate GL commands from the loaded v3d models, these GL
@@ -1068,6 +1069,7 @@ int SARMenuObjViewLoad(
 
 	/* End gl list recording */
 	glEndList();
+	V3DTextureInvalidate();
 
 
 	/* Delete V3D model data */
@@ -1284,6 +1286,7 @@ void SARMenuObjViewRebufferImage(
 
 	    /* Draw the object */
 	    glCallList(list);
+	    V3DTextureInvalidate();
 	}
 	glPopMatrix();
 
@@ -467,7 +467,6 @@ static int SARMissionDoObjectiveSuccess(
 	sar_mission_struct *mission, sar_scene_struct *scene
 )
 {
-	int player_obj_num;
 	sar_object_struct *player_obj_ptr;
 	sar_mission_objective_struct *objective;
 
@@ -475,7 +474,6 @@ static int SARMissionDoObjectiveSuccess(
 	    return(-1);
 
 	/* Get player object references from scene structure */
-	player_obj_num = scene->player_obj_num;
 	player_obj_ptr = scene->player_obj_ptr;
 
 	/* Get current mission objective */
@@ -641,7 +639,6 @@ void SARMissionDestroyNotify(
 	sar_core_struct *core_ptr, sar_object_struct *obj_ptr
 )
 {
-	int player_obj_num;
 	sar_object_struct *player_obj_ptr;
 	sar_mission_objective_struct *objective;
 	sar_mission_struct *mission = core_ptr->mission;
@@ -658,7 +655,6 @@ void SARMissionDestroyNotify(
 	    );
 
 	/* Get references to player object */
-	player_obj_num = scene->player_obj_num;
 	player_obj_ptr = scene->player_obj_ptr;
 
 	/* Get current mission objective, return if there isn't one */
@@ -1141,7 +1137,6 @@ static void SARMissionObjectiveManage(
 	sar_mission_objective_struct *objective
 )
 {
-	int player_obj_num;
 	sar_object_struct *player_obj_ptr;
 	sar_scene_struct *scene = core_ptr->scene;
 	const sar_option_struct *opt = &core_ptr->option;
@@ -1149,7 +1144,6 @@ static void SARMissionObjectiveManage(
 	    return;
 
 	/* Get pointer to player object */
-	player_obj_num = scene->player_obj_num;
 	player_obj_ptr = scene->player_obj_ptr;
 
 	/* Handle by objective type */
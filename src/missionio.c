@@ -1674,7 +1674,10 @@ sar_mission_struct *SARMissionLoadFromFile(
 		    );
 
 		    /* Update object context pointers */
-		    obj_num = scene->player_obj_num;
+		    obj_num = SARObjGetFromHandle(
+			scene, *ptr, *total,
+			scene->player_obj_handle
+		    );
 		    obj_ptr = scene->player_obj_ptr;
 		    CONTEXT_REGET_SUBSTRUCTURE_PTRS(obj_ptr)
 
@@ -2311,7 +2314,8 @@ sar_mission_struct *SARMissionLoadFromFile(
 		    if(!strcasecmp(ref_name, "player"))
 		    {
 			/* Set special intercept code to intercept the player */
-			obj_human_ptr->intercepting_object = -2;
+			obj_human_ptr->intercepting_object =
+			    SAR_HUMAN_INTERCEPT_PLAYER;
 		    }
 		    else
 		    {
@@ -2320,7 +2324,9 @@ sar_mission_struct *SARMissionLoadFromFile(
 			    scene, *ptr, *total,
 			    ref_name, &human_ref_obj_num
 			);
-			obj_human_ptr->intercepting_object = human_ref_obj_num;
+			obj_human_ptr->intercepting_object = SARObjGetHandle(
+			    scene, *ptr, *total, human_ref_obj_num
+			);
 		    }
 		}
 		break;
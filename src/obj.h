@@ -25,7 +25,10 @@
 
 #include "sfm.h"
 #include "v3dtex.h"
+#include "v3dhf.h"
 #include "sound.h"
+#include "simgrid.h"
+#include "objmesh.h"
 #include <GL/gl.h>
 
 /*
@@ -148,14 +151,53 @@ typedef struct {
 
 	GLuint		data;		/* A GLuint referencing a GL list */
 
+	/* Indexed vertex arrays drawn in place of the GL list, NULL
+	 * if the visual model is drawn from the GL list
+	 */
+	sar_mesh_struct	*mesh;
+
+	/* Heightfield drawn after the GL list or mesh, NULL if the
+	 * visual model has no heightfield or it is in the GL list
+	 */
+	v3d_hf_terrain_struct	*terrain;
+
 	/* Statistics */
 	unsigned long	mem_size;	/* Memory size, in bytes */
 	int		statements,	/* Total GL statements */
 			primitives;	/* Total GL primitives */
 
+	/* Bounding box of all the vertices in the GL list and the
+	 * radius of the bounding sphere about the model's origin (in
+	 * meters), only valid if has_bounds is true. Used to cull
+	 * objects outside of the view frustum
+	 */
+	char		has_bounds;
+	float		x_min, x_max,
+			y_min, y_max,
+			z_min, z_max;
+	float		radius;
+
 } sar_visual_model_struct;
 #define SAR_VISUAL_MODEL(p)	((sar_visual_model_struct *)(p))
 
+/*
+ *	Visual Model Level Of Detail:
+ *
+ *	A coarser version of an object's standard visual model that is
+ *	drawn in its place when the object is farther than range.
+ */
+typedef struct {
+
+	sar_visual_model_struct	*visual_model;
+
+	/* Range beyond which this level is drawn, in meters for a
+	 * view of the reference size (see SAR_LOD_REF_WIDTH)
+	 */
+	float		range;
+
+} sar_visual_model_lod_struct;
+#define SAR_VISUAL_MODEL_LOD(p)	((sar_visual_model_lod_struct *)(p))
+
 
 /*
  *	Position/Velocity:
@@ -540,6 +582,32 @@ typedef struct {
 #define SAR_EXTERNAL_FUELTANK(p)	((sar_external_fueltank_struct *)(p))
 
 
+/*
+ *	Object Handle:
+ *
+ *	An object's index on the objects list in the lower bits and the
+ *	generation of its slot in the upper bits. The generation of a
+ *	slot changes each time the object in it is deleted, so a handle
+ *	to a deleted object stays invalid even after its slot has been
+ *	reused by a new object, see SARObjGetHandle() and
+ *	SARObjGetFromHandle().
+ *
+ *	Slot generations are never 0, so SAR_OBJ_HANDLE_NONE and the
+ *	other handles with a generation of 0 are never valid and may
+ *	be used as special values.
+ */
+typedef u_int32_t sar_obj_handle;
+#define SAR_OBJ_HANDLE_NONE		((sar_obj_handle)0)
+#define SAR_OBJ_HANDLE_INDEX_BITS	20
+#define SAR_OBJ_HANDLE_INDEX_MASK	((1 << SAR_OBJ_HANDLE_INDEX_BITS) - 1)
+#define SAR_OBJ_HANDLE_GENERATION_MASK	\
+ ((1 << (32 - SAR_OBJ_HANDLE_INDEX_BITS)) - 1)
+#define SAR_OBJ_HANDLE_INDEX(h)		\
+ ((int)((h) & SAR_OBJ_HANDLE_INDEX_MASK))
+#define SAR_OBJ_HANDLE_GENERATION(h)	\
+ ((u_int32_t)((h) >> SAR_OBJ_HANDLE_INDEX_BITS))
+
+
 /*
  *	Hoist:
  */
@@ -587,10 +655,10 @@ typedef struct {
 	/* Load capacity, in kg */
 	float		capacity;
 
-	/* Reference to occupant human object index numbers (does not
-	 * include the diver)
+	/* Handles to the occupant human objects (does not include the
+	 * diver)
 	 */
-	int		*occupant;
+	sar_obj_handle	*occupant;
 	int		total_occupants;
 
 	/* Total mass of occupant object(s) in kg, this is to speed up
@@ -1163,10 +1231,10 @@ typedef struct {
 	/* Texture number on scene structure */
 	int		tex_num;
 
-	/* Reference object that this smoke trail is to follow (can be -1
-	 * for none or do not follow)
+	/* Reference object that this smoke trail is to follow (can be
+	 * SAR_OBJ_HANDLE_NONE for none or do not follow)
 	 */
-	int		ref_object;
+	sar_obj_handle	ref_object;
 
 	/* Each smoke unit forming this smoke trail */
 	sar_object_smoke_unit_struct *unit;
@@ -1215,9 +1283,9 @@ typedef struct {
 			ir_tex_num;
 
 	/* Reference object that this explosion is to follow (can be
-	 * -1 for none/do not follow)
+	 * SAR_OBJ_HANDLE_NONE for none/do not follow)
 	 */
-	int		ref_object;
+	sar_obj_handle	ref_object;
 
 } sar_object_explosion_struct;
 #define SAR_OBJECT_EXPLOSION(p)	((sar_object_explosion_struct *)(p))
@@ -1250,10 +1318,10 @@ typedef struct {
 	int		tex_num,
 			ir_tex_num;
 
-	/* Reference object that this fire is to follow (can be -1 for
-	 * none/do not follow)
+	/* Reference object that this fire is to follow (can be
+	 * SAR_OBJ_HANDLE_NONE for none/do not follow)
 	 */
-	int		ref_object;
+	sar_obj_handle	ref_object;
 
 } sar_object_fire_struct;
 #define SAR_OBJECT_FIRE(p)	((sar_object_fire_struct *)(p))
@@ -1272,8 +1340,8 @@ typedef struct {
 
 	sar_chemical_type	chemical_type;
 
-	int		owner;		/* Object that created this spray or -1
-					 * for none */
+	sar_obj_handle	owner;		/* Object that created this spray or
+					 * SAR_OBJ_HANDLE_NONE for none */
 
 	/* Texture number on the scene */
 	int		tex_num;
@@ -1310,10 +1378,10 @@ typedef struct {
 	/* Belly to center height, in meters */
 	float		belly_to_center_height;
 
-	/* Index of object of which this fuel tank fell off of (can be
-	 * -1 for unknown)
+	/* Object of which this fuel tank fell off of (can be
+	 * SAR_OBJ_HANDLE_NONE for unknown)
 	 */
-	int		ref_object;
+	sar_obj_handle	ref_object;
 
 	/* Mass and fuel (in kg) */
 	float		dry_mass,
@@ -1394,6 +1462,33 @@ typedef struct {
 	/* Runway background texture number (on scene structure) */
 	int		tex_num;
 
+	/* Background, dashes, and borders built into a mesh when the
+	 * runway is first drawn up close, NULL until then
+	 */
+	sar_mesh_struct	*surface_mesh;
+
+	/* Edge, alignment, ILS, and threshold lights, each light has
+	 * a position (x, y, z) on light_vertex and a color (r, g, b,
+	 * a) on light_color in GL coordinates
+	 *
+	 * The edge lights are first, then the alignment and ILS
+	 * lights that are drawn within 8 miles, and then the
+	 * threshold lights that are drawn within 4 miles so that the
+	 * lights to draw are always the first ones
+	 *
+	 * The lights are set up again when the edge light spacing or
+	 * light_colors change, light_colors is 0 until they are first
+	 * set up
+	 */
+	GLfloat		*light_vertex,
+			*light_color;
+	int		total_lights,
+			max_lights,
+			total_edge_lights,
+			total_approach_lights;
+	float		light_edge_spacing;
+	int		light_colors;
+
 } sar_object_runway_struct;
 #define SAR_OBJECT_RUNWAY(p)	((sar_object_runway_struct *)(p))
 
@@ -1448,12 +1543,17 @@ typedef struct {
 	 */
 	int		tex_num;
 
+	/* GL display list of the landable area and its sides recorded
+	 * when the helipad is first drawn, 0 until then
+	 */
+	unsigned int	surface_list;
+
 	/* If SAR_HELIPAD_FLAG_REF_OBJECT is set then these members
 	 * will have affect
 	 *
 	 * Note: ref_offset is applied before ref_dir
 	 */
-	int		ref_object;	/* Object that this helipad `follows' */
+	sar_obj_handle	ref_object;	/* Object that this helipad `follows' */
 	sar_position_struct	ref_offset;	/* Relative to ref_object */
 	sar_direction_struct	ref_dir;	/* Relative to ref_object */
 
@@ -1511,20 +1611,21 @@ typedef struct {
 	/* Water ripples texture number on the scene */
 	int		water_ripple_tex_num;
 
-	/* Reference to object running towards or away from, the following
+	/* Handle to object running towards or away from, the following
 	 * values have special meaning:
 	 *
-	 *	-1	No intercepting
-	 *	-2	Intercept player
+	 *	SAR_OBJ_HANDLE_NONE		No intercepting
+	 *	SAR_HUMAN_INTERCEPT_PLAYER	Intercept player
 	 *
 	 * Works when flags SAR_HUMAN_FLAG_RUN_TOWARDS xor
 	 * SAR_HUMAN_FLAG_RUN_AWAY is set and intercepting_object is
 	 * valid and not the human object itself.
 	 */
-	int		intercepting_object;
+#define SAR_HUMAN_INTERCEPT_PLAYER	((sar_obj_handle)1)
+	sar_obj_handle	intercepting_object;
 
 	/* Distance to intercepting object in meters (may be ignored if
-	 * intercepting_object is -1.
+	 * intercepting_object is SAR_OBJ_HANDLE_NONE.
 	 */
 	float		intercepting_object_distance2d,
 			intercepting_object_distance3d;
@@ -1541,6 +1642,12 @@ typedef struct {
 	 */
 	const char	*assisting_human_preset_name[SAR_ASSISTING_HUMANS_MAX];
 
+	/* Assisting human(s) preset, the sar_human_data_entry_struct
+	 * matched from each preset name (or the default assisting human
+	 * preset) when the human was created, can be NULL.
+	 */
+	const void	*assisting_human_preset[SAR_ASSISTING_HUMANS_MAX];
+
 	sar_color_struct	assisting_human_color[SAR_HUMAN_COLORS_MAX];
 
 
@@ -1623,6 +1730,19 @@ typedef struct {
 	sar_position_struct	pos;
 	sar_direction_struct	dir;
 
+	/* Position and direction at the previous simulation tick and
+	 * the simulated position and direction that are kept while the
+	 * object is drawn between the two ticks (see
+	 * SARSimInterpolateBegin())
+	 *
+	 * has_prev is 1 if prev_pos and prev_dir have been set
+	 */
+	sar_position_struct	prev_pos,
+				sim_pos;
+	sar_direction_struct	prev_dir,
+				sim_dir;
+	char		has_prev;
+
 	/* Visible range of this object, in meters
 	 *
 	 * Object is not displayed when the camera is farther is beyond
@@ -1641,6 +1761,11 @@ typedef struct {
 	 */
 	float		ground_elevation_msl;
 
+	/* Ground and support surface objects found under this object's
+	 * support grid cell by the last call to SARSimFindGroundCached()
+	 */
+	sar_grid_cache_struct	ground_cache;
+
 
 	/* Contact bounds */
 	sar_contact_bounds_struct	*contact_bounds;
@@ -1672,6 +1797,14 @@ typedef struct {
 				*visual_model_night,	/* Night */
 				*visual_model_shadow;	/* Shadow */
 
+	/* Levels of detail of the standard visual model in order of
+	 * increasing range, and the level drawn last (0 for the
+	 * standard visual model or 1 to total_lods for lod[lod_level - 1])
+	 */
+	sar_visual_model_lod_struct	*lod;
+	int			total_lods,
+				lod_level;
+
 	/* Lights */
 	sar_light_struct	**light;
 	int			total_lights;
@@ -1726,18 +1859,15 @@ typedef struct {
  */
 typedef struct {
 
-	/* Records the last time of day since midnight from the scene
-	 * in units of 5 minute intervals as a whole number for horizon
-	 * texture regeneration, see SARSimUpdateScene() in simmanage.c
-	 * for when and how this value is updated
+	/* Set to True when the scene's sky colors change so that
+	 * SARSimUpdateScene() in simmanage.c regenerates the texture
 	 */
-	int		last_tod;
+	int		regenerate;
 
-	/* Gradient textures, 0 is most highlighted and
-	 * total_textures - 1 is darkest
+	/* Gradients texture for every time of day, see
+	 * SARCreateHorizonTexture() in horizon.c
 	 */
-	v3d_texture_ref_struct **texture;
-	int		total_textures;
+	v3d_texture_ref_struct *texture;
 
 } sar_scene_horizon_struct;
 #define SAR_SCENE_HORIZON(p)	((sar_scene_horizon_struct *)(p))
@@ -1892,7 +2022,7 @@ typedef struct {
 	float		rain_density_coeff;
 
 	/* Reference to player object */
-	int			player_obj_num;
+	sar_obj_handle		player_obj_handle;
 	sar_object_struct	*player_obj_ptr;
 	char			player_has_crashed;	/* 1 if player object has crashed */
 
@@ -1908,6 +2038,48 @@ typedef struct {
 	sar_object_struct	**human_need_rescue_object;
 	int			total_human_need_rescue_objects;
 
+	/* Spatial grid of objects that other objects can crash into
+	 * (objects who's contact bounds specify the crash flag
+	 * SAR_CRASH_FLAG_CRASH_CAUSE), used by SARSimCrashContactCheck()
+	 * to only check objects near the source object. Entries are
+	 * maintained by SARObjNew(), SARObjDelete(), and
+	 * SARSimUpdateSceneObjects()
+	 */
+	sar_grid_struct		*crash_grid;
+
+	/* Spatial grid of objects that provide ground, objects of type
+	 * SAR_OBJ_TYPE_GROUND and objects who's contact bounds specify
+	 * the crash flag SAR_CRASH_FLAG_SUPPORT_SURFACE, used by
+	 * SARSimFindGround(). Entries are maintained the same way as
+	 * crash_grid
+	 */
+	sar_grid_struct		*support_grid;
+
+	/* Spatial grid of objects that can be picked up by hoists
+	 * (humans who's flags specify SAR_HUMAN_FLAG_NEED_RESCUE),
+	 * used by SARSimHoistDeploymentContactCheck() to only check
+	 * the candidates near the hoist deployment. Entries are
+	 * maintained the same way as crash_grid and are removed by
+	 * SARSimDoPickUpHuman()
+	 */
+	sar_grid_struct		*rescue_grid;
+
+	/* Object slots, the objects list is allocated in
+	 * total_object_slots sized steps and the indices of deleted
+	 * objects are kept on the free_object_slot stack so that new
+	 * objects reuse them without reallocating or searching the
+	 * list. The structures of deleted objects are kept in
+	 * object_slot_storage to be reused by the next object created
+	 * in that slot, and object_slot_generation is the generation
+	 * of each slot used by object handles. Maintained by
+	 * SARObjNew() and SARObjDelete()
+	 */
+	int			total_object_slots;
+	int			*free_object_slot;
+	int			total_free_object_slots;
+	u_int32_t		*object_slot_generation;
+	sar_object_struct	**object_slot_storage;
+
 
 	/* Camera reference */
 	sar_camera_ref	camera_ref;
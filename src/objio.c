@@ -141,6 +141,18 @@ int SARObjLoadHeightField(
 	GLuint list
 );
 
+static void SARObjLoadGLBegin(GLenum mode);
+static void SARObjLoadGLEnd(void);
+static void SARObjLoadGLNormal(GLfloat x, GLfloat y, GLfloat z);
+static void SARObjLoadGLTexCoord(GLfloat s, GLfloat t);
+static void SARObjLoadGLVertex(GLfloat x, GLfloat y, GLfloat z);
+static void SARObjLoadTextureSelect(v3d_texture_ref_struct *t);
+static Boolean SARObjLoadUseMesh(
+	v3d_model_struct *v3d_model, state_gl_struct *state_gl
+);
+static Boolean SARObjLoadUseTerrain(
+	v3d_model_struct *v3d_model, state_gl_struct *state_gl
+);
 static void SARObjLoadProcessVisualPrimitive(
 	sar_core_struct *core_ptr,
 	int obj_num, sar_object_struct *obj_ptr,
@@ -156,6 +168,20 @@ static void SARObjLoadProcessVisualModel(
 	const char *filename, int line_num
 );
 
+static sar_visual_model_lod_struct *SARObjLoadGetLOD(
+	sar_object_struct *obj_ptr, int level
+);
+static void SARObjLoadFinishLODs(
+	sar_core_struct *core_ptr, sar_object_struct *obj_ptr,
+	const char *filename
+);
+static void SARObjLoadGenerateLODs(
+	sar_core_struct *core_ptr,
+	int obj_num, sar_object_struct *obj_ptr,
+	v3d_model_struct *v3d_model,
+	const char *filename
+);
+
 static void SARObjLoadLine(
 	sar_core_struct *core_ptr,
 	int obj_num, sar_object_struct *obj_ptr,
@@ -192,6 +218,17 @@ int SARObjLoadFromFile(
 
 static int last_begin_primitive_type;
 
+/* Mesh that the visual model being processed is built into, NULL
+ * if it is being recorded into a GL display list
+ */
+static sar_mesh_struct *load_mesh;
+
+/* True if the heightfield of the visual model being processed is to
+ * be drawn as a terrain instead of being recorded into the GL
+ * display list
+ */
+static Boolean load_terrain;
+
 
 /*
  *	Texture plane orientation codes:
@@ -1338,7 +1375,9 @@ int SARObjLoadHelipad(
 	    }
 	}
 	/* Set reference object */
-	helipad->ref_object = ref_obj_num;
+	helipad->ref_object = SARObjGetHandle(
+	    scene, core_ptr->object, core_ptr->total_objects, ref_obj_num
+	);
 	/* Make sure reference object is not this object */
 	if(ref_obj_ptr == obj_ptr)
 	{
@@ -1348,7 +1387,7 @@ int SARObjLoadHelipad(
 	    helipad->flags &= ~SAR_HELIPAD_FLAG_REF_OBJECT;
 	    helipad->flags &= ~SAR_HELIPAD_FLAG_FOLLOW_REF_OBJECT;
 
-	    helipad->ref_object = -1;
+	    helipad->ref_object = SAR_OBJ_HANDLE_NONE;
 	}
 
 	/* Set reference offset relative to the reference object */
@@ -1737,6 +1776,10 @@ int SARObjLoadSmoke(
  *
  *	If the GL display list is 0 then no GL commands will be issued
  *	and only the z height points will be recorded on the object.
+ *
+ *	If load_terrain is True then the heightfield is not recorded
+ *	into the GL display list, a terrain is created on the vmodel
+ *	instead.
  */
 int SARObjLoadHeightField(
 	sar_core_struct *core_ptr,
@@ -1746,11 +1789,13 @@ int SARObjLoadHeightField(
 	GLuint list			/* Can be 0 */
 )
 {
-	int status, grid_points_total;
+	int i, status, grid_points_total;
 	float x_length, y_length, z_length;
 	int num_grids_x, num_grids_y;
 	double grid_space_x, grid_space_y;
 	double *zpoints = NULL;
+	Boolean use_terrain = (load_terrain && (vmodel != NULL) &&
+	    (list != 0)) ? True : False;
 
 	char *full_path;
 	sar_object_ground_struct *ground = NULL;
@@ -1807,7 +1852,7 @@ int SARObjLoadHeightField(
 		&num_grids_x, &num_grids_y,	/* Number of grids */
 		&grid_space_x, &grid_space_y,	/* Grid spacing in meters */
 		&zpoints,			/* Heightfield points return */
-		list,			/* GL display list */
+		use_terrain ? 0 : list,	/* GL display list */
 		&hfopt
 	    );
 	    if(status)
@@ -1820,18 +1865,67 @@ int SARObjLoadHeightField(
 	}
 	glPopMatrix();
 
+	/* Create the terrain from the heightfield points */
+	if(use_terrain)
+	{
+	    V3DHFTerrainDelete(vmodel->terrain);
+	    vmodel->terrain = V3DHFTerrainNew(
+		zpoints,
+		num_grids_x, num_grids_y,
+		x_length, y_length,
+		(GLfloat)mp_heightfield_load->x,
+		(GLfloat)mp_heightfield_load->z,
+		(GLfloat)-mp_heightfield_load->y,
+		&hfopt,
+		&core_ptr->display->state_gl
+	    );
+	    if(vmodel->terrain == NULL)
+		fprintf(
+		    stderr,
+"%s: Warning: Unable to create the terrain for heightfield \"%s\".\n",
+		    filename, mp_heightfield_load->path
+		);
+	}
+
 	/* Calculate total number of points */
 	grid_points_total = num_grids_x * num_grids_y;
 
 	/* Calculate statistics */
 	if((vmodel != NULL) && (list != 0))
 	{
-	    vmodel->mem_size += grid_points_total * (
-		(2 * 3 * 8 * sizeof(GLfloat)) +
-		(3 * sizeof(GLuint))
-	    );
-	    vmodel->statements += (grid_points_total * 8) + 2;
+	    if(use_terrain && (vmodel->terrain != NULL))
+	    {
+		const v3d_hf_terrain_struct *terrain = vmodel->terrain;
+		vmodel->mem_size += (terrain->total_vertices * 8 *
+		    sizeof(GLfloat)) +
+		    (terrain->total_indices * sizeof(GLuint));
+		vmodel->statements += terrain->total_chunks;
+	    }
+	    else
+	    {
+		vmodel->mem_size += grid_points_total * (
+		    (2 * 3 * 8 * sizeof(GLfloat)) +
+		    (3 * sizeof(GLuint))
+		);
+		vmodel->statements += (grid_points_total * 8) + 2;
+	    }
 	    vmodel->primitives += grid_points_total * 2;
+
+	    /* The heightfield is centered about its translation and
+	     * its base is at the translation's z, all eight corners
+	     * are added since the bounds' radius comes from each
+	     * point's distance to the model's origin
+	     */
+	    for(i = 0; i < 8; i++)
+		SARVisualModelAddBounds(
+		    vmodel,
+		    (float)mp_heightfield_load->x +
+			(((i & 1) ? x_length : -x_length) / 2.0f),
+		    (float)mp_heightfield_load->y +
+			(((i & 2) ? y_length : -y_length) / 2.0f),
+		    (float)mp_heightfield_load->z +
+			((i & 4) ? z_length : 0.0f)
+		);
 	}
 
 	/* Set newly loaded values to object */
@@ -1866,6 +1960,141 @@ int SARObjLoadHeightField(
 	return(0);
 }
 
+/*
+ *	GL commands used by SARObjLoadProcessVisualPrimitive() and
+ *	SARObjLoadProcessVisualModel(), they are put into load_mesh if
+ *	it is not NULL or called on the GL otherwise.
+ */
+static void SARObjLoadGLBegin(GLenum mode)
+{
+	if(load_mesh != NULL)
+	    SARMeshBegin(load_mesh, mode);
+	else
+	    glBegin(mode);
+}
+
+static void SARObjLoadGLEnd(void)
+{
+	if(load_mesh != NULL)
+	    SARMeshEnd(load_mesh);
+	else
+	    glEnd();
+}
+
+static void SARObjLoadGLNormal(GLfloat x, GLfloat y, GLfloat z)
+{
+	if(load_mesh != NULL)
+	    SARMeshNormal(load_mesh, x, y, z);
+	else
+	    glNormal3f(x, y, z);
+}
+
+static void SARObjLoadGLTexCoord(GLfloat s, GLfloat t)
+{
+	if(load_mesh != NULL)
+	    SARMeshTexCoord(load_mesh, s, t);
+	else
+	    glTexCoord2f(s, t);
+}
+
+static void SARObjLoadGLVertex(GLfloat x, GLfloat y, GLfloat z)
+{
+	if(load_mesh != NULL)
+	    SARMeshVertex(load_mesh, x, y, z);
+	else
+	    glVertex3f(x, y, z);
+}
+
+static void SARObjLoadTextureSelect(v3d_texture_ref_struct *t)
+{
+	if(load_mesh != NULL)
+	    SARMeshSetTexture(load_mesh, t);
+	else
+	    V3DTextureSelect(t);
+}
+
+/*
+ *	Checks if the V3D Visual Model can be built into a mesh.
+ *
+ *	Heightfields are drawn with their own GL commands so any model
+ *	that loads one is recorded into a GL display list.
+ */
+static Boolean SARObjLoadUseMesh(
+	v3d_model_struct *v3d_model, state_gl_struct *state_gl
+)
+{
+	int pn;
+
+	if(!SARMeshAvailable(state_gl))
+	    return(False);
+
+	for(pn = 0; pn < v3d_model->total_primitives; pn++)
+	{
+	    void *p = v3d_model->primitive[pn];
+	    if(p == NULL)
+		continue;
+
+	    if(V3DMPGetType(p) == V3DMP_TYPE_HEIGHTFIELD_LOAD)
+		return(False);
+	}
+
+	return(True);
+}
+
+/*
+ *	Checks if the heightfield on the V3D Visual Model can be drawn
+ *	as a terrain.
+ *
+ *	The terrain is drawn after the GL display list so the
+ *	heightfield must be the last primitive that draws anything.
+ */
+static Boolean SARObjLoadUseTerrain(
+	v3d_model_struct *v3d_model, state_gl_struct *state_gl
+)
+{
+	int pn, ptype;
+	Boolean got_heightfield = False;
+
+	if(!SARMeshAvailable(state_gl))
+	    return(False);
+
+	for(pn = 0; pn < v3d_model->total_primitives; pn++)
+	{
+	    void *p = v3d_model->primitive[pn];
+	    if(p == NULL)
+		continue;
+
+	    ptype = V3DMPGetType(p);
+	    switch(ptype)
+	    {
+	      case V3DMP_TYPE_HEIGHTFIELD_LOAD:
+		if(got_heightfield)
+		    return(False);
+		got_heightfield = True;
+		break;
+
+	      case V3DMP_TYPE_POINT:
+	      case V3DMP_TYPE_LINE:
+	      case V3DMP_TYPE_LINE_STRIP:
+	      case V3DMP_TYPE_LINE_LOOP:
+	      case V3DMP_TYPE_TRIANGLE:
+	      case V3DMP_TYPE_TRIANGLE_STRIP:
+	      case V3DMP_TYPE_TRIANGLE_FAN:
+	      case V3DMP_TYPE_QUAD:
+	      case V3DMP_TYPE_QUAD_STRIP:
+	      case V3DMP_TYPE_POLYGON:
+	      case V3DMP_TYPE_COLOR:
+	      case V3DMP_TYPE_TEXTURE_SELECT:
+	      case V3DMP_TYPE_TEXTURE_OFF:
+		if(got_heightfield)
+		    return(False);
+		break;
+	    }
+	}
+
+	return(got_heightfield);
+}
+
 /*
  *	Called by SARObjLoadProcessVisualModel().
  *
@@ -1911,7 +2140,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    {
 		vmodel->statements++;
 		vmodel->mem_size += 2 * sizeof(GLuint);
-		glBegin(GL_POINTS);
+		SARObjLoadGLBegin(GL_POINTS);
 		last_begin_primitive_type = ptype;
 	    }
 	    ns = &mp_point->n[0];
@@ -1926,7 +2155,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    {
 		vmodel->statements++;
 		vmodel->mem_size += 2 * sizeof(GLuint);
-		glBegin(GL_LINES);
+		SARObjLoadGLBegin(GL_LINES);
 		last_begin_primitive_type = ptype;
 	    }
 	    ns = &mp_line->n[0];
@@ -1939,7 +2168,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    mp_line_strip = (mp_line_strip_struct *)p;
 	    vmodel->statements++;
 	    vmodel->mem_size += 2 * sizeof(GLuint);
-	    glBegin(GL_LINE_STRIP);
+	    SARObjLoadGLBegin(GL_LINE_STRIP);
 	    need_end_primitive = True;
 	    nd = mp_line_strip->n;
 	    vd = mp_line_strip->v;
@@ -1951,7 +2180,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    mp_line_loop = (mp_line_loop_struct *)p;
 	    vmodel->statements++;
 	    vmodel->mem_size += 2 * sizeof(GLuint);
-	    glBegin(GL_LINE_LOOP);
+	    SARObjLoadGLBegin(GL_LINE_LOOP);
 	    need_end_primitive = True;
 	    nd = mp_line_loop->n;
 	    vd = mp_line_loop->v;
@@ -1965,7 +2194,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    {
 		vmodel->statements++;
 		vmodel->mem_size += 2 * sizeof(GLuint);
-		glBegin(GL_TRIANGLES);
+		SARObjLoadGLBegin(GL_TRIANGLES);
 		last_begin_primitive_type = ptype;
 	    }
 	    ns = &mp_triangle->n[0];
@@ -1978,7 +2207,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    mp_triangle_strip = (mp_triangle_strip_struct *)p;
 	    vmodel->statements++;
 	    vmodel->mem_size += 2 * sizeof(GLuint);
-	    glBegin(GL_TRIANGLE_STRIP);
+	    SARObjLoadGLBegin(GL_TRIANGLE_STRIP);
 	    need_end_primitive = True;
 	    nd = mp_triangle_strip->n;
 	    vd = mp_triangle_strip->v;
@@ -1990,7 +2219,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    mp_triangle_fan = (mp_triangle_fan_struct *)p;
 	    vmodel->statements++;
 	    vmodel->mem_size += 2 * sizeof(GLuint);
-	    glBegin(GL_TRIANGLE_FAN);
+	    SARObjLoadGLBegin(GL_TRIANGLE_FAN);
 	    need_end_primitive = True;
 	    nd = mp_triangle_fan->n;
 	    vd = mp_triangle_fan->v;
@@ -2004,7 +2233,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    {
 		vmodel->statements++;
 		vmodel->mem_size += 2 * sizeof(GLuint);
-		glBegin(GL_QUADS);
+		SARObjLoadGLBegin(GL_QUADS);
 		last_begin_primitive_type = ptype;
 	    }
 	    ns = &mp_quad->n[0];
@@ -2017,7 +2246,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    mp_quad_strip = (mp_quad_strip_struct *)p;
 	    vmodel->statements++;
 	    vmodel->mem_size += 2 * sizeof(GLuint);
-	    glBegin(GL_QUAD_STRIP);
+	    SARObjLoadGLBegin(GL_QUAD_STRIP);
 	    need_end_primitive = True;
 	    nd = mp_quad_strip->n;
 	    vd = mp_quad_strip->v;   
@@ -2029,7 +2258,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	    mp_polygon = (mp_polygon_struct *)p;
 	    vmodel->statements++;
 	    vmodel->mem_size += 2 * sizeof(GLuint);
-	    glBegin(GL_POLYGON);
+	    SARObjLoadGLBegin(GL_POLYGON);
 	    need_end_primitive = True;
 	    nd = mp_polygon->n;
 	    vd = mp_polygon->v;
@@ -2098,7 +2327,9 @@ static void SARObjLoadProcessVisualPrimitive(
 	    {
 		vmodel->statements++;
 		vmodel->mem_size += sizeof(GLuint) + (3 * sizeof(GLfloat));
-		glNormal3d(n_ptr->x, n_ptr->z, -n_ptr->y);
+		SARObjLoadGLNormal(
+		    (GLfloat)n_ptr->x, (GLfloat)n_ptr->z, (GLfloat)-n_ptr->y
+		);
 	    }
 
 	    /* Texture enabled? */
@@ -2118,7 +2349,7 @@ static void SARObjLoadProcessVisualPrimitive(
 			ty = 0.0f;
 		    vmodel->statements++;
 		    vmodel->mem_size += sizeof(GLuint) + (2 * sizeof(GLfloat));
-		    glTexCoord2f(tx, 1.0f - ty);
+		    SARObjLoadGLTexCoord(tx, 1.0f - ty);
 		    break;
 
 		  case TEX_ORIENT_YZ:
@@ -2132,7 +2363,7 @@ static void SARObjLoadProcessVisualPrimitive(
 			ty = 0.0f;
 		    vmodel->statements++;
 		    vmodel->mem_size += sizeof(GLuint) + (2 * sizeof(GLfloat));
-		    glTexCoord2f(tx, 1.0f - ty);
+		    SARObjLoadGLTexCoord(tx, 1.0f - ty);
 		    break;
 
 		  case TEX_ORIENT_XZ:
@@ -2146,7 +2377,7 @@ static void SARObjLoadProcessVisualPrimitive(
 			ty = 0.0f;
 		    vmodel->statements++;
 		    vmodel->mem_size += sizeof(GLuint) + (2 * sizeof(GLfloat));
-		    glTexCoord2f(tx, 1.0f - ty);
+		    SARObjLoadGLTexCoord(tx, 1.0f - ty);
 		    break;
 
 		  default:
@@ -2166,7 +2397,7 @@ static void SARObjLoadProcessVisualPrimitive(
 
 		    vmodel->statements++;
 		    vmodel->mem_size += sizeof(GLuint) + (2 * sizeof(GLfloat));
-		    glTexCoord2f(tx, 1.0f - ty);
+		    SARObjLoadGLTexCoord(tx, 1.0f - ty);
 		    break;
 		}
 	    }
@@ -2174,7 +2405,8 @@ static void SARObjLoadProcessVisualPrimitive(
 	    /* Set vertex */
 	    vmodel->statements++;
 	    vmodel->mem_size += sizeof(GLuint) + (3 * sizeof(GLfloat));
-	    glVertex3d(x, z, -y);
+	    SARObjLoadGLVertex(x, z, -y);
+	    SARVisualModelAddBounds(vmodel, x, y, z);
 	}
 
 	/* End primitive as needed */
@@ -2182,7 +2414,7 @@ static void SARObjLoadProcessVisualPrimitive(
 	{
 	    vmodel->statements++;
 	    vmodel->mem_size += sizeof(GLuint);
-	    glEnd();
+	    SARObjLoadGLEnd();
 	    need_end_primitive = False;
 	}
 } 
@@ -2193,6 +2425,10 @@ static void SARObjLoadProcessVisualPrimitive(
  *	Processes the visual primitives in the V3D Visual Model into GL
  *	commands (suitable for GL list recording).
  *
+ *	If the GL can draw vertex arrays then the primitives are built
+ *	into a mesh instead, the GL display list is deleted and the
+ *	mesh is set on the vmodel.
+ *
  *	The vmodel's memory size statistics will be updated.
  */
 static void SARObjLoadProcessVisualModel(
@@ -2215,8 +2451,15 @@ static void SARObjLoadProcessVisualModel(
 	sar_scene_struct *scene = core_ptr->scene;
 
 
+	/* Build a mesh instead of recording the GL display list? */
+	load_mesh = SARObjLoadUseMesh(v3d_model, state_gl) ?
+	    SARMeshNew(state_gl) : NULL;
+
+	/* Draw the heightfield (if any) as a terrain? */
+	load_terrain = SARObjLoadUseTerrain(v3d_model, state_gl);
+
 	/* Reset GL states */
-	V3DTextureSelect(NULL);
+	SARObjLoadTextureSelect(NULL);
 	tex_on = False;
 	tex_orient = TEX_ORIENT_NONE;
 /* Do not reset color, model file should set it, if not then it means
@@ -2253,7 +2496,7 @@ static void SARObjLoadProcessVisualModel(
 	       (last_begin_primitive_type > -1)
 	    )
 	    {
-		glEnd();
+		SARObjLoadGLEnd();
 		vmodel->mem_size += sizeof(GLuint);
 		vmodel->statements++;
 		last_begin_primitive_type = -1;
@@ -2295,6 +2538,17 @@ static void SARObjLoadProcessVisualModel(
 		mp_color = (mp_color_struct *)p;
 		if(process_as_ir)
 		    break;
+		if(load_mesh != NULL)
+		{
+		    SARMeshSetColor(
+			load_mesh,
+			(GLfloat)mp_color->r,
+			(GLfloat)mp_color->g,
+			(GLfloat)mp_color->b,
+			(GLfloat)mp_color->a
+		    );
+		    break;
+		}
 		vmodel->mem_size += 4 * sizeof(GLfloat);
 		vmodel->statements++;
 		glColor4f(
@@ -2346,7 +2600,7 @@ static void SARObjLoadProcessVisualModel(
 		    if(STRISEMPTY(texture_name))
 		    {
 			/* Empty string implies unselect texture */
-			V3DTextureSelect(NULL);
+			SARObjLoadTextureSelect(NULL);
 			tex_on = False;
 			tex_orient = TEX_ORIENT_NONE;
 		    }
@@ -2369,7 +2623,7 @@ static void SARObjLoadProcessVisualModel(
 			else
 			{
 			    tex_on = True;
-			    V3DTextureSelect(t);
+			    SARObjLoadTextureSelect(t);
 			}
 		    }
 		}
@@ -2413,7 +2667,7 @@ static void SARObjLoadProcessVisualModel(
 		    break;
 		vmodel->mem_size += 2 * sizeof(GLuint);
 		vmodel->statements++;
-		V3DTextureSelect(NULL);
+		SARObjLoadTextureSelect(NULL);
 		tex_on = False;
 		tex_orient = TEX_ORIENT_NONE;
 		break;
@@ -2437,7 +2691,7 @@ static void SARObjLoadProcessVisualModel(
 	{
 	    vmodel->mem_size += sizeof(GLuint);
 	    vmodel->statements++;
-	    glEnd();
+	    SARObjLoadGLEnd();
 	    last_begin_primitive_type = -1;
 	}
 
@@ -2451,8 +2705,43 @@ static void SARObjLoadProcessVisualModel(
 	    blend_state = False;
 	}
 
-	/* End GL display list */
+	/* End GL display list, the textures selected while recording
+	 * it were not actually selected
+	 */
 	glEndList();
+	V3DTextureInvalidate();
+
+	/* Replace the GL display list with the mesh */
+	if(load_mesh != NULL)
+	{
+	    sar_mesh_struct *mesh = load_mesh;
+	    load_mesh = NULL;
+	    if(SARMeshFinish(mesh))
+	    {
+		/* Nothing to draw, keep the empty GL display list */
+		SARMeshDelete(mesh);
+	    }
+	    else
+	    {
+		if(list > 0)
+		    glDeleteLists(list, 1);
+		vmodel->data = 0;
+		vmodel->mesh = mesh;
+
+		/* The statistics are of the batches drawn, one
+		 * glDrawElements() each
+		 */
+		vmodel->statements = mesh->total_batches;
+		vmodel->primitives = mesh->total_primitives;
+		vmodel->mem_size = (unsigned long)(
+		    (mesh->total_vertices * SAR_MESH_VERTEX_SIZE *
+			sizeof(GLfloat)) +
+		    (mesh->total_indices * sizeof(GLuint))
+		);
+	    }
+	}
+
+	load_terrain = False;
 
 	/* Mark this SAR Visual Model as finished loading */
 	vmodel->load_state = SAR_VISUAL_MODEL_LOADED;
@@ -2737,6 +3026,38 @@ static void SARObjLoadLine(
 
 		obj_ptr->range_far = (float)MAX(range_far, 0.0);
 	    }
+	    /* Range Level Of Detail */
+	    else if(!strcasecmp(parm, "range_lod"))
+	    {
+		/* Arguments:
+		 *
+		 * <level> <range>
+		 */
+		int level = 0;
+		float range = 0.0f;
+		sar_visual_model_lod_struct *lod;
+
+		arg = GET_ARG_I(arg, &level);
+		arg = GET_ARG_F(arg, &range);
+
+		lod = SARObjLoadGetLOD(obj_ptr, level);
+		if(lod == NULL)
+		    fprintf(stderr,
+ "%s: Line %i: Warning:\
+ Value for %s argument level=%i should be 1 to %i.\n",
+			filename, line_num,
+			parm, level, SAR_LOD_LEVELS_MAX
+		    );
+		else if(range <= 0.0f)
+		    fprintf(stderr,
+ "%s: Line %i: Warning:\
+ Value for %s argument range=%f should be positive.\n",
+			filename, line_num,
+			parm, range
+		    );
+		else
+		    lod->range = range;
+	    }
 	    /* No Depth Test */
 	    else if(!strcasecmp(parm, "no_depth_test"))
 	    {
@@ -4678,6 +4999,198 @@ static void SARObjLoadLine(
 	}
 }
 
+/*
+ *	Returns the level of detail (1 to SAR_LOD_LEVELS_MAX) on the
+ *	object, adding the levels up to it as needed.
+ *
+ *	Returns NULL if level is out of range or on error.
+ */
+static sar_visual_model_lod_struct *SARObjLoadGetLOD(
+	sar_object_struct *obj_ptr, int level
+)
+{
+	if((level < 1) || (level > SAR_LOD_LEVELS_MAX))
+	    return(NULL);
+
+	if(level > obj_ptr->total_lods)
+	{
+	    sar_visual_model_lod_struct *lod = (sar_visual_model_lod_struct *)realloc(
+		obj_ptr->lod,
+		level * sizeof(sar_visual_model_lod_struct)
+	    );
+	    if(lod == NULL)
+		return(NULL);
+
+	    memset(
+		&lod[obj_ptr->total_lods], 0x00,
+		(level - obj_ptr->total_lods) * sizeof(sar_visual_model_lod_struct)
+	    );
+	    obj_ptr->lod = lod;
+	    obj_ptr->total_lods = level;
+	}
+
+	return(&obj_ptr->lod[level - 1]);
+}
+
+/*
+ *	Removes the levels of detail on the object that do not have
+ *	both a visual model and a range and sorts the rest by range.
+ */
+static void SARObjLoadFinishLODs(
+	sar_core_struct *core_ptr, sar_object_struct *obj_ptr,
+	const char *filename
+)
+{
+	int i, j, n;
+	sar_visual_model_lod_struct *lod, t;
+
+	for(i = 0, n = 0; i < obj_ptr->total_lods; i++)
+	{
+	    lod = &obj_ptr->lod[i];
+	    if((lod->visual_model == NULL) || (lod->range <= 0.0f))
+	    {
+		if(lod->visual_model != NULL)
+		    fprintf(
+			stderr,
+ "%s: Warning: Level of detail %i has no range_lod.\n",
+			filename, i + 1
+		    );
+		else if(lod->range > 0.0f)
+		    fprintf(
+			stderr,
+ "%s: Warning: Level of detail %i has no standard_lod%i model.\n",
+			filename, i + 1, i + 1
+		    );
+		SARVisualModelUnref(core_ptr->scene, lod->visual_model);
+		continue;
+	    }
+
+	    /* Insert by range */
+	    t = *lod;
+	    j = n;
+	    while((j > 0) && (obj_ptr->lod[j - 1].range > t.range))
+	    {
+		obj_ptr->lod[j] = obj_ptr->lod[j - 1];
+		j--;
+	    }
+	    obj_ptr->lod[j] = t;
+	    n++;
+	}
+	obj_ptr->total_lods = n;
+	if(n == 0)
+	{
+	    free(obj_ptr->lod);
+	    obj_ptr->lod = NULL;
+	}
+	obj_ptr->lod_level = 0;
+}
+
+/*
+ *	Generates up to SAR_LOD_GENERATE_LEVELS levels of detail on the
+ *	object by simplifying a copy of the standard V3D model, each
+ *	level is simplified from the one before it.
+ *
+ *	Objects of type SAR_OBJ_TYPE_GROUND and objects with less
+ *	than SAR_LOD_GENERATE_MIN_PRIMITIVES primitives are skipped.
+ */
+static void SARObjLoadGenerateLODs(
+	sar_core_struct *core_ptr,
+	int obj_num, sar_object_struct *obj_ptr,
+	v3d_model_struct *v3d_model,
+	const char *filename
+)
+{
+	int i, level, total_primitives, type;
+	float size, pixels;
+	char name[80];
+	sar_scene_struct *scene = core_ptr->scene;
+	const sar_visual_model_struct *standard = obj_ptr->visual_model;
+	sar_visual_model_struct *vmodel;
+	sar_visual_model_lod_struct *lod;
+	v3d_model_struct *m;
+
+	if(obj_ptr->type == SAR_OBJ_TYPE_GROUND)
+	    return;
+	if((standard == NULL) ? True : !standard->has_bounds)
+	    return;
+
+	/* Count the drawn primitives */
+	total_primitives = 0;
+	for(i = 0; i < v3d_model->total_primitives; i++)
+	{
+	    type = V3DMPGetType(v3d_model->primitive[i]);
+	    if(type == V3DMP_TYPE_HEIGHTFIELD_LOAD)
+		return;
+	    if((type >= V3DMP_TYPE_POINT) && (type <= V3DMP_TYPE_POLYGON))
+		total_primitives++;
+	}
+	if(total_primitives < SAR_LOD_GENERATE_MIN_PRIMITIVES)
+	    return;
+
+	/* Size of the standard visual model, in meters */
+	size = standard->radius * 2.0f;
+	if(size <= 0.0f)
+	    return;
+
+	m = V3DModelDup(v3d_model);
+	if(m == NULL)
+	    return;
+
+	pixels = SAR_LOD_GENERATE_SIZE;
+	for(level = 1; level <= SAR_LOD_GENERATE_LEVELS; level++)
+	{
+	    /* Simplify to SAR_LOD_GENERATE_ERROR pixels at the size
+	     * that this level is drawn at, stop when that no longer
+	     * removes any primitives
+	     */
+	    if(V3DModelSimplify(
+		m, size * SAR_LOD_GENERATE_ERROR / pixels
+	    ) <= 0)
+		break;
+
+	    lod = SARObjLoadGetLOD(obj_ptr, level);
+	    if(lod == NULL)
+		break;
+	    lod->range = size * SAR_LOD_REF_WIDTH /
+		(pixels * SAR_LOD_REF_FOVZ_UM);
+
+	    /* Create a new or return the existing SAR Visual Model,
+	     * it already exists when another object was loaded from
+	     * the same file
+	     */
+	    sprintf(name, "standard_lod%i_generated", level);
+	    lod->visual_model = vmodel = SARVisualModelNew(
+		scene, filename, name
+	    );
+	    if(SARVisualModelGetRefCount(vmodel) == 1)
+	    {
+		GLuint list = (GLuint)SARVisualModelNewList(vmodel);
+		if(list != 0)
+		{
+		    vmodel->load_state = SAR_VISUAL_MODEL_LOADING;
+		    V3DTextureInvalidate();
+		    glNewList(list, GL_COMPILE);
+		    SARObjLoadProcessVisualModel(
+			core_ptr, obj_num, obj_ptr,
+			vmodel,
+			m,
+			False,		/* Not process as IR */
+			filename, 0
+		    );
+		    glEndList();
+		    vmodel->load_state = SAR_VISUAL_MODEL_LOADED;
+		}
+	    }
+
+	    pixels /= 2.0f;
+	}
+
+	V3DModelDestroy(m);
+
+	/* Remove the last level if it could not be made */
+	SARObjLoadFinishLODs(core_ptr, obj_ptr, filename);
+}
+
 /*
  *	Loads a V3D model file specified by filename and applies the
  *	loaded data to the object specified by obj_num.
@@ -4695,7 +5208,8 @@ int SARObjLoadFromFile(
 	void *h;
 	int hn, htype, total_v3d_h = 0;
 
-	v3d_model_struct *v3d_model_ptr, **v3d_model = NULL;
+	v3d_model_struct *v3d_model_ptr, **v3d_model = NULL,
+			 *v3d_model_standard = NULL;
 	int v3d_model_num, total_v3d_models = 0;
 
 	gw_display_struct *display = core_ptr->display;
@@ -5114,6 +5628,7 @@ int SARObjLoadFromFile(
 	    /* Standard */
 	    if(!strcasecmp(v3d_model_name, "standard"))
 	    {
+		v3d_model_standard = v3d_model_ptr;
 		sar_vmodel = &obj_ptr->visual_model;
 		sar_vmodel_ir = &obj_ptr->visual_model_ir;
 		free(sar_vmodel_name);
@@ -5126,6 +5641,19 @@ int SARObjLoadFromFile(
 		free(sar_vmodel_name);
 		sar_vmodel_name = STRDUP("standard_far");
 	    }
+	    /* Standard Level Of Detail */
+	    else if(!strncasecmp(v3d_model_name, "standard_lod", 12))
+	    {
+		sar_visual_model_lod_struct *lod = SARObjLoadGetLOD(
+		    obj_ptr, ATOI(v3d_model_name + 12)
+		);
+		if(lod != NULL)
+		{
+		    sar_vmodel = &lod->visual_model;
+		    free(sar_vmodel_name);
+		    sar_vmodel_name = STRDUP(v3d_model_name);
+		}
+	    }
 	    /* Standard Dusk */ 
 	    else if(!strcasecmp(v3d_model_name, "standard_dusk"))
 	    {
@@ -5424,6 +5952,7 @@ int SARObjLoadFromFile(
 		     * recording the GL display list
 		     */
 		    vmodel->load_state = SAR_VISUAL_MODEL_LOADING;
+		    V3DTextureInvalidate();
 		    glNewList(list, GL_COMPILE);
 
 		    /* Process this V3D model into GL commands */
@@ -5514,6 +6043,7 @@ int SARObjLoadFromFile(
 			 * recording the GL display list
 			 */
 			vmodel->load_state = SAR_VISUAL_MODEL_LOADING;
+			V3DTextureInvalidate();
 			glNewList(list, GL_COMPILE);
 
 			/* Process this V3D model into GL commands */
@@ -5543,6 +6073,16 @@ int SARObjLoadFromFile(
 	}
 
 
+	/* Check the levels of detail and generate them from the
+	 * standard V3D model if there are none
+	 */
+	SARObjLoadFinishLODs(core_ptr, obj_ptr, filename);
+	if((obj_ptr->total_lods == 0) && (v3d_model_standard != NULL))
+	    SARObjLoadGenerateLODs(
+		core_ptr, obj_num, obj_ptr,
+		v3d_model_standard, filename
+	    );
+
 	/* Delete V3D models and V3D header items (no longer needed) */
 	V3DMHListDeleteAll(&v3d_h, &total_v3d_h);
 	V3DModelListDeleteAll(&v3d_model, &total_v3d_models);
@@ -5571,6 +6111,12 @@ int SARObjLoadFromFile(
 		    fdm->stopped = True;
 
 		    SFMModelAdd(scene->realm, fdm);
+
+		    /* Refer the FDM back to this object so that the
+		     * SFM callbacks can find it directly
+		     */
+		    fdm->owner = obj_ptr;
+		    fdm->owner_index = obj_num;
 		}
 		aircraft->fdm = fdm;
 	    }
@@ -0,0 +1,687 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/* Buffer object functions are only declared with the prototypes
+ * from glext.h
+ */
+#define GL_GLEXT_PROTOTYPES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+
+#include "v3dtex.h"
+#include "stategl.h"
+#include "objmesh.h"
+
+
+static int SARMeshAddVertex(sar_mesh_struct *mesh);
+static int SARMeshAddIndex(sar_mesh_struct *mesh, GLuint i);
+static int SARMeshAddBatch(sar_mesh_struct *mesh, GLenum mode);
+static void SARMeshSetBlend(sar_mesh_struct *mesh, char blend);
+
+int SARMeshAvailable(state_gl_struct *state_gl);
+sar_mesh_struct *SARMeshNew(state_gl_struct *state_gl);
+void SARMeshDelete(sar_mesh_struct *mesh);
+void SARMeshSetColor(
+	sar_mesh_struct *mesh,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+);
+void SARMeshSetTexture(
+	sar_mesh_struct *mesh, v3d_texture_ref_struct *t
+);
+void SARMeshBegin(sar_mesh_struct *mesh, GLenum mode);
+void SARMeshNormal(
+	sar_mesh_struct *mesh,
+	GLfloat x, GLfloat y, GLfloat z
+);
+void SARMeshTexCoord(sar_mesh_struct *mesh, GLfloat s, GLfloat t);
+void SARMeshVertex(
+	sar_mesh_struct *mesh,
+	GLfloat x, GLfloat y, GLfloat z
+);
+void SARMeshEnd(sar_mesh_struct *mesh);
+int SARMeshFinish(sar_mesh_struct *mesh);
+void SARMeshDraw(sar_mesh_struct *mesh);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)        (((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
+
+/*
+ *	Returns the address of vertex member n (in GLfloats) for the
+ *	vertex arrays, base is NULL when drawing from buffer objects.
+ */
+#define SAR_MESH_VERTEX_OFFSET(base,n)	\
+ ((const GLvoid *)((const char *)(base) + ((n) * sizeof(GLfloat))))
+
+
+/*
+ *	Appends a vertex with the current normal and texture
+ *	coordinates, the position is left for the calling function
+ *	to set.
+ *
+ *	Returns the new vertex's index or -1 on error.
+ */
+static int SARMeshAddVertex(sar_mesh_struct *mesh)
+{
+	int n = mesh->total_vertices;
+	GLfloat *v;
+
+	if(n >= mesh->max_vertices)
+	{
+	    const int max_vertices = MAX(mesh->max_vertices * 2, 64);
+
+	    v = (GLfloat *)realloc(
+		mesh->vertex,
+		max_vertices * SAR_MESH_VERTEX_SIZE * sizeof(GLfloat)
+	    );
+	    if(v == NULL)
+		return(-1);
+
+	    mesh->vertex = v;
+	    mesh->max_vertices = max_vertices;
+	}
+
+	v = &mesh->vertex[n * SAR_MESH_VERTEX_SIZE];
+	v[3] = mesh->cur_normal[0];
+	v[4] = mesh->cur_normal[1];
+	v[5] = mesh->cur_normal[2];
+	v[6] = mesh->cur_texcoord[0];
+	v[7] = mesh->cur_texcoord[1];
+
+	mesh->total_vertices = n + 1;
+
+	return(n);
+}
+
+/*
+ *	Appends index i.
+ */
+static int SARMeshAddIndex(sar_mesh_struct *mesh, GLuint i)
+{
+	if(mesh->total_indices >= mesh->max_indices)
+	{
+	    const int max_indices = MAX(mesh->max_indices * 2, 128);
+	    GLuint *index = (GLuint *)realloc(
+		mesh->index,
+		max_indices * sizeof(GLuint)
+	    );
+	    if(index == NULL)
+		return(-1);
+
+	    mesh->index = index;
+	    mesh->max_indices = max_indices;
+	}
+
+	mesh->index[mesh->total_indices] = i;
+	mesh->total_indices++;
+
+	return(0);
+}
+
+/*
+ *	Makes sure that the last batch is drawn with the given mode
+ *	and the current texture, color, and blending, appending a new
+ *	batch that starts at the current index if it is not.
+ */
+static int SARMeshAddBatch(sar_mesh_struct *mesh, GLenum mode)
+{
+	const sar_mesh_batch_struct *cur = &mesh->cur;
+	sar_mesh_batch_struct *b;
+
+	if(mesh->total_batches > 0)
+	{
+	    b = &mesh->batch[mesh->total_batches - 1];
+	    if((b->mode == mode) &&
+	       (b->texture == cur->texture) &&
+	       (b->color_set == cur->color_set) &&
+	       (b->blend == cur->blend) &&
+	       (!cur->color_set ||
+		!memcmp(b->color, cur->color, sizeof(b->color))
+	       )
+	    )
+		return(0);
+	}
+
+	b = (sar_mesh_batch_struct *)realloc(
+	    mesh->batch,
+	    (mesh->total_batches + 1) * sizeof(sar_mesh_batch_struct)
+	);
+	if(b == NULL)
+	    return(-1);
+
+	mesh->batch = b;
+
+	b = &mesh->batch[mesh->total_batches];
+	memcpy(b, cur, sizeof(sar_mesh_batch_struct));
+	b->mode = mode;
+	b->first = mesh->total_indices;
+	b->count = 0;
+	mesh->total_batches++;
+
+	return(0);
+}
+
+/*
+ *	Enables or disables GL_BLEND the same way as the visual model
+ *	loader does when recording a GL display list.
+ */
+static void SARMeshSetBlend(sar_mesh_struct *mesh, char blend)
+{
+	state_gl_struct *state_gl = mesh->state_gl;
+
+	if(blend)
+	{
+	    if(state_gl != NULL)
+	    {
+		StateGLEnableF(state_gl, GL_BLEND, GL_TRUE);
+		StateGLDisableF(state_gl, GL_ALPHA_TEST, GL_TRUE);
+	    }
+	    else
+	    {
+		glEnable(GL_BLEND);
+		glDisable(GL_ALPHA_TEST);
+	    }
+	    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	else
+	{
+	    if(state_gl != NULL)
+	    {
+		StateGLDisableF(state_gl, GL_BLEND, GL_TRUE);
+		StateGLEnableF(state_gl, GL_ALPHA_TEST, GL_TRUE);
+	    }
+	    else
+	    {
+		glDisable(GL_BLEND);
+		glEnable(GL_ALPHA_TEST);
+	    }
+	}
+}
+
+
+/*
+ *	Checks if meshes can be drawn with the current GL context.
+ *
+ *	Returns 0 if there is no current GL context, in which case
+ *	visual models should be recorded into GL display lists.
+ */
+int SARMeshAvailable(state_gl_struct *state_gl)
+{
+	/* Vertex arrays and glDrawElements() need GL 1.1 */
+	return(StateGLVersionAtLeast(state_gl, 1, 1) ? 1 : 0);
+}
+
+/*
+ *	Creates a new empty mesh.
+ *
+ *	The state_gl is used to enable and disable blending when the
+ *	mesh is drawn, it may be NULL.
+ */
+sar_mesh_struct *SARMeshNew(state_gl_struct *state_gl)
+{
+	sar_mesh_struct *mesh = SAR_MESH(calloc(
+	    1, sizeof(sar_mesh_struct)
+	));
+	if(mesh == NULL)
+	    return(NULL);
+
+	mesh->cur.texture = NULL;
+	mesh->cur.color_set = 0;
+	mesh->cur.blend = 0;
+	mesh->cur_normal[0] = 0.0f;
+	mesh->cur_normal[1] = 0.0f;
+	mesh->cur_normal[2] = 1.0f;
+	mesh->begin_mode = 0;
+	mesh->begin_vertex = -1;
+	mesh->state_gl = state_gl;
+
+	return(mesh);
+}
+
+/*
+ *	Deletes the mesh and its GL buffer objects.
+ */
+void SARMeshDelete(sar_mesh_struct *mesh)
+{
+	if(mesh == NULL)
+	    return;
+
+#ifdef STATE_GL_VERSION_1_5
+	if(mesh->vertex_buffer != 0)
+	    glDeleteBuffers(1, &mesh->vertex_buffer);
+	if(mesh->index_buffer != 0)
+	    glDeleteBuffers(1, &mesh->index_buffer);
+#endif
+
+	free(mesh->vertex);
+	free(mesh->index);
+	free(mesh->batch);
+	free(mesh);
+}
+
+/*
+ *	Sets the color of the next primitives, blending will be
+ *	enabled for them if the alpha is less than 1.0.
+ */
+void SARMeshSetColor(
+	sar_mesh_struct *mesh,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+)
+{
+	if(mesh == NULL)
+	    return;
+
+	mesh->cur.color_set = 1;
+	mesh->cur.color[0] = r;
+	mesh->cur.color[1] = g;
+	mesh->cur.color[2] = b;
+	mesh->cur.color[3] = a;
+	mesh->cur.blend = (a < 1.0f) ? 1 : 0;
+}
+
+/*
+ *	Sets the texture of the next primitives, t may be NULL to
+ *	unselect the texture.
+ */
+void SARMeshSetTexture(
+	sar_mesh_struct *mesh, v3d_texture_ref_struct *t
+)
+{
+	if(mesh == NULL)
+	    return;
+
+	mesh->cur.texture = t;
+}
+
+/*
+ *	Begins a primitive, mode is any of the modes accepted by
+ *	glBegin().
+ */
+void SARMeshBegin(sar_mesh_struct *mesh, GLenum mode)
+{
+	if(mesh == NULL)
+	    return;
+
+	mesh->begin_mode = mode;
+	mesh->begin_vertex = mesh->total_vertices;
+}
+
+/*
+ *	Sets the normal of the next vertices.
+ */
+void SARMeshNormal(
+	sar_mesh_struct *mesh,
+	GLfloat x, GLfloat y, GLfloat z
+)
+{
+	if(mesh == NULL)
+	    return;
+
+	mesh->cur_normal[0] = x;
+	mesh->cur_normal[1] = y;
+	mesh->cur_normal[2] = z;
+}
+
+/*
+ *	Sets the texture coordinates of the next vertices.
+ */
+void SARMeshTexCoord(sar_mesh_struct *mesh, GLfloat s, GLfloat t)
+{
+	if(mesh == NULL)
+	    return;
+
+	mesh->cur_texcoord[0] = s;
+	mesh->cur_texcoord[1] = t;
+}
+
+/*
+ *	Adds a vertex to the primitive being built.
+ */
+void SARMeshVertex(
+	sar_mesh_struct *mesh,
+	GLfloat x, GLfloat y, GLfloat z
+)
+{
+	int n;
+	GLfloat *v;
+
+	if(mesh == NULL)
+	    return;
+
+	if(mesh->begin_vertex < 0)
+	    return;
+
+	n = SARMeshAddVertex(mesh);
+	if(n < 0)
+	    return;
+
+	v = &mesh->vertex[n * SAR_MESH_VERTEX_SIZE];
+	v[0] = x;
+	v[1] = y;
+	v[2] = z;
+}
+
+/*
+ *	Ends the primitive being built, its vertices are indexed as
+ *	triangles, lines, or points on the current batch.
+ *
+ *	The triangles are ordered so that the vertex that GL would
+ *	have used for flat shading is the last vertex of each triangle.
+ */
+void SARMeshEnd(sar_mesh_struct *mesh)
+{
+	int i, n, v0;
+	GLenum mode;
+
+	if(mesh == NULL)
+	    return;
+
+	v0 = mesh->begin_vertex;
+	n = mesh->total_vertices - v0;
+	mode = mesh->begin_mode;
+	mesh->begin_mode = 0;
+	mesh->begin_vertex = -1;
+	if((v0 < 0) || (n <= 0))
+	    return;
+
+#define ADD_TRI(a,b,c)	{				\
+ SARMeshAddIndex(mesh, (GLuint)(v0 + (a)));		\
+ SARMeshAddIndex(mesh, (GLuint)(v0 + (b)));		\
+ SARMeshAddIndex(mesh, (GLuint)(v0 + (c)));		\
+ mesh->total_primitives++;				\
+}
+#define ADD_LINE(a,b)	{				\
+ SARMeshAddIndex(mesh, (GLuint)(v0 + (a)));		\
+ SARMeshAddIndex(mesh, (GLuint)(v0 + (b)));		\
+ mesh->total_primitives++;				\
+}
+
+	switch(mode)
+	{
+	  case GL_POINTS:
+	    if(SARMeshAddBatch(mesh, GL_POINTS))
+		break;
+	    for(i = 0; i < n; i++)
+	    {
+		SARMeshAddIndex(mesh, (GLuint)(v0 + i));
+		mesh->total_primitives++;
+	    }
+	    break;
+
+	  case GL_LINES:
+	    if(SARMeshAddBatch(mesh, GL_LINES))
+		break;
+	    for(i = 0; (i + 1) < n; i += 2)
+		ADD_LINE(i, i + 1);
+	    break;
+
+	  case GL_LINE_STRIP:
+	  case GL_LINE_LOOP:
+	    if(SARMeshAddBatch(mesh, GL_LINES))
+		break;
+	    for(i = 0; (i + 1) < n; i++)
+		ADD_LINE(i, i + 1);
+	    if((mode == GL_LINE_LOOP) && (n > 2))
+		ADD_LINE(n - 1, 0);
+	    break;
+
+	  case GL_TRIANGLES:
+	    if(SARMeshAddBatch(mesh, GL_TRIANGLES))
+		break;
+	    for(i = 0; (i + 2) < n; i += 3)
+		ADD_TRI(i, i + 1, i + 2);
+	    break;
+
+	  case GL_TRIANGLE_STRIP:
+	    if(SARMeshAddBatch(mesh, GL_TRIANGLES))
+		break;
+	    for(i = 0; (i + 2) < n; i++)
+	    {
+		if(i & 1)
+		    ADD_TRI(i + 1, i, i + 2)
+		else
+		    ADD_TRI(i, i + 1, i + 2)
+	    }
+	    break;
+
+	  case GL_TRIANGLE_FAN:
+	    if(SARMeshAddBatch(mesh, GL_TRIANGLES))
+		break;
+	    for(i = 1; (i + 1) < n; i++)
+		ADD_TRI(0, i, i + 1);
+	    break;
+
+	  case GL_QUADS:
+	    if(SARMeshAddBatch(mesh, GL_TRIANGLES))
+		break;
+	    for(i = 0; (i + 3) < n; i += 4)
+	    {
+		ADD_TRI(i, i + 1, i + 3);
+		ADD_TRI(i + 1, i + 2, i + 3);
+	    }
+	    break;
+
+	  case GL_QUAD_STRIP:
+	    if(SARMeshAddBatch(mesh, GL_TRIANGLES))
+		break;
+	    for(i = 0; (i + 3) < n; i += 2)
+	    {
+		ADD_TRI(i, i + 1, i + 3);
+		ADD_TRI(i + 2, i, i + 3);
+	    }
+	    break;
+
+	  case GL_POLYGON:
+	    /* Flat shaded polygons use the first vertex */
+	    if(SARMeshAddBatch(mesh, GL_TRIANGLES))
+		break;
+	    for(i = 1; (i + 1) < n; i++)
+		ADD_TRI(i, i + 1, 0);
+	    break;
+	}
+
+#undef ADD_TRI
+#undef ADD_LINE
+
+	/* Update the count of the last batch */
+	if(mesh->total_batches > 0)
+	{
+	    sar_mesh_batch_struct *b = &mesh->batch[mesh->total_batches - 1];
+	    b->count = mesh->total_indices - b->first;
+	}
+}
+
+/*
+ *	Finishes building the mesh, the vertices and indices are put
+ *	into GL buffer objects if the GL supports them.
+ *
+ *	Returns non-zero if the mesh is empty or could not be built.
+ */
+int SARMeshFinish(sar_mesh_struct *mesh)
+{
+	if(mesh == NULL)
+	    return(-2);
+
+	if(mesh->begin_vertex > -1)
+	    SARMeshEnd(mesh);
+
+	if((mesh->vertex == NULL) || (mesh->index == NULL) ||
+	   (mesh->batch == NULL)
+	)
+	    return(-1);
+
+#ifdef STATE_GL_VERSION_1_5
+	/* Buffer objects need GL 1.5 */
+	if(!StateGLVersionAtLeast(mesh->state_gl, 1, 5))
+	    return(0);
+
+	glGenBuffers(1, &mesh->vertex_buffer);
+	glGenBuffers(1, &mesh->index_buffer);
+	if((mesh->vertex_buffer == 0) || (mesh->index_buffer == 0))
+	{
+	    if(mesh->vertex_buffer != 0)
+		glDeleteBuffers(1, &mesh->vertex_buffer);
+	    if(mesh->index_buffer != 0)
+		glDeleteBuffers(1, &mesh->index_buffer);
+	    mesh->vertex_buffer = mesh->index_buffer = 0;
+	    return(0);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, mesh->vertex_buffer);
+	glBufferData(
+	    GL_ARRAY_BUFFER,
+	    mesh->total_vertices * SAR_MESH_VERTEX_SIZE * sizeof(GLfloat),
+	    mesh->vertex,
+	    GL_STATIC_DRAW
+	);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->index_buffer);
+	glBufferData(
+	    GL_ELEMENT_ARRAY_BUFFER,
+	    mesh->total_indices * sizeof(GLuint),
+	    mesh->index,
+	    GL_STATIC_DRAW
+	);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	/* The arrays are no longer needed now that they are on the
+	 * buffer objects
+	 */
+	free(mesh->vertex);
+	mesh->vertex = NULL;
+	mesh->max_vertices = 0;
+	free(mesh->index);
+	mesh->index = NULL;
+	mesh->max_indices = 0;
+#endif
+
+	return(0);
+}
+
+/*
+ *	Draws the mesh.
+ *
+ *	The texture, color, and blending are left as the last batch
+ *	set them, the same as calling a GL display list recorded from
+ *	the same primitives would.
+ */
+void SARMeshDraw(sar_mesh_struct *mesh)
+{
+	int i;
+	char blend = 0;
+	const GLsizei stride = SAR_MESH_VERTEX_SIZE * sizeof(GLfloat);
+	const GLvoid *vertex_base, *index_base;
+	v3d_texture_ref_struct *texture = NULL;
+	const sar_mesh_batch_struct *b;
+
+	if(mesh == NULL)
+	    return;
+
+	if(mesh->total_batches <= 0)
+	    return;
+
+#ifdef STATE_GL_VERSION_1_5
+	if(mesh->vertex_buffer != 0)
+	{
+	    glBindBuffer(GL_ARRAY_BUFFER, mesh->vertex_buffer);
+	    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->index_buffer);
+	    vertex_base = NULL;
+	    index_base = NULL;
+	}
+	else
+#endif
+	{
+	    if((mesh->vertex == NULL) || (mesh->index == NULL))
+		return;
+	    vertex_base = mesh->vertex;
+	    index_base = mesh->index;
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(
+	    3, GL_FLOAT, stride, SAR_MESH_VERTEX_OFFSET(vertex_base, 0)
+	);
+	glNormalPointer(
+	    GL_FLOAT, stride, SAR_MESH_VERTEX_OFFSET(vertex_base, 3)
+	);
+	glTexCoordPointer(
+	    2, GL_FLOAT, stride, SAR_MESH_VERTEX_OFFSET(vertex_base, 6)
+	);
+
+	/* Display lists begin by unselecting the texture */
+	V3DTextureSelect(NULL);
+
+	for(i = 0; i < mesh->total_batches; i++)
+	{
+	    b = &mesh->batch[i];
+	    if(b->count <= 0)
+		continue;
+
+	    if(b->texture != texture)
+	    {
+		V3DTextureSelect(b->texture);
+		texture = b->texture;
+	    }
+	    if(b->color_set)
+		glColor4fv(b->color);
+	    if(b->blend != blend)
+	    {
+		SARMeshSetBlend(mesh, b->blend);
+		blend = b->blend;
+	    }
+
+	    glDrawElements(
+		b->mode, b->count, GL_UNSIGNED_INT,
+		(const GLvoid *)((const char *)index_base +
+		    (b->first * sizeof(GLuint)))
+	    );
+	}
+
+	/* Leave the texture and color as set by the last primitive
+	 * in the visual model, even if it had no vertices
+	 */
+	if(mesh->cur.texture != texture)
+	    V3DTextureSelect(mesh->cur.texture);
+	if(mesh->cur.color_set)
+	    glColor4fv(mesh->cur.color);
+
+	/* Blending is always disabled at the end */
+	if(blend)
+	    SARMeshSetBlend(mesh, 0);
+
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+
+#ifdef STATE_GL_VERSION_1_5
+	if(mesh->vertex_buffer != 0)
+	{
+	    glBindBuffer(GL_ARRAY_BUFFER, 0);
+	    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+#endif
+}
@@ -0,0 +1,148 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+		      SAR Visual Model Meshes
+
+	Indexed vertex arrays that a visual model is drawn from in
+	place of a GL display list. A mesh is built with calls that
+	mirror glBegin(), glNormal*(), glTexCoord*(), glVertex*(), and
+	glEnd(), every primitive is converted into triangles, lines,
+	or points and consecutive primitives drawn with the same
+	texture, color, and blending are put into one batch that is
+	drawn with a single glDrawElements().
+
+	The vertices and indices are put into GL buffer objects when
+	the GL supports them, otherwise they are drawn as client side
+	vertex arrays.
+ */
+
+#ifndef OBJMESH_H
+#define OBJMESH_H
+
+#include <GL/gl.h>
+#include "v3dtex.h"
+#include "stategl.h"
+
+
+/*
+ *	Number of GLfloats per vertex, the position (x, y, z), normal
+ *	(x, y, z), and texture coordinates (s, t) interleaved and all
+ *	in GL coordinates.
+ */
+#define SAR_MESH_VERTEX_SIZE		8
+
+/*
+ *	Mesh Batch:
+ *
+ *	A range of indices drawn with one glDrawElements().
+ */
+typedef struct {
+
+	GLenum		mode;		/* GL_TRIANGLES, GL_LINES, or
+					 * GL_POINTS */
+	int		first,		/* First index */
+			count;		/* Number of indices */
+
+	/* Texture to select, NULL to unselect the texture */
+	v3d_texture_ref_struct	*texture;
+
+	/* Color to set if color_set is 1, otherwise the current
+	 * GL color is used
+	 */
+	char		color_set;
+	GLfloat		color[4];
+
+	/* 1 if GL_BLEND is to be enabled */
+	char		blend;
+
+} sar_mesh_batch_struct;
+#define SAR_MESH_BATCH(p)	((sar_mesh_batch_struct *)(p))
+
+/*
+ *	Mesh:
+ */
+typedef struct {
+
+	/* Vertices, each SAR_MESH_VERTEX_SIZE GLfloats */
+	GLfloat		*vertex;
+	int		total_vertices,
+			max_vertices;
+
+	GLuint		*index;
+	int		total_indices,
+			max_indices;
+
+	sar_mesh_batch_struct	*batch;
+	int		total_batches;
+
+	/* Total number of triangles, lines, and points */
+	int		total_primitives;
+
+	/* Texture, color, and blending set for the next primitive
+	 * and the current normal and texture coordinates, while
+	 * building the mesh
+	 */
+	sar_mesh_batch_struct	cur;
+	GLfloat		cur_normal[3],
+			cur_texcoord[2];
+
+	/* Mode and first vertex of the primitive being built, the
+	 * mode is 0 when not between SARMeshBegin() and SARMeshEnd()
+	 */
+	GLenum		begin_mode;
+	int		begin_vertex;
+
+	/* GL buffer objects, 0 if the vertex arrays above are used */
+	GLuint		vertex_buffer,
+			index_buffer;
+
+	/* GL states used to enable and disable blending */
+	state_gl_struct	*state_gl;
+
+} sar_mesh_struct;
+#define SAR_MESH(p)		((sar_mesh_struct *)(p))
+
+
+extern int SARMeshAvailable(state_gl_struct *state_gl);
+
+extern sar_mesh_struct *SARMeshNew(state_gl_struct *state_gl);
+extern void SARMeshDelete(sar_mesh_struct *mesh);
+
+extern void SARMeshSetColor(
+	sar_mesh_struct *mesh,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+);
+extern void SARMeshSetTexture(
+	sar_mesh_struct *mesh, v3d_texture_ref_struct *t
+);
+
+extern void SARMeshBegin(sar_mesh_struct *mesh, GLenum mode);
+extern void SARMeshNormal(
+	sar_mesh_struct *mesh,
+	GLfloat x, GLfloat y, GLfloat z
+);
+extern void SARMeshTexCoord(sar_mesh_struct *mesh, GLfloat s, GLfloat t);
+extern void SARMeshVertex(
+	sar_mesh_struct *mesh,
+	GLfloat x, GLfloat y, GLfloat z
+);
+extern void SARMeshEnd(sar_mesh_struct *mesh);
+
+extern int SARMeshFinish(sar_mesh_struct *mesh);
+extern void SARMeshDraw(sar_mesh_struct *mesh);
+
+#endif	/* OBJMESH_H */
@@ -51,6 +51,16 @@ sar_object_struct *SARObjGetPtr(
 	sar_object_struct **ptr, int total,
 	int n
 );
+sar_obj_handle SARObjGetHandle(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	int n
+);
+int SARObjGetFromHandle(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	sar_obj_handle handle
+);
 int SARGetObjectNumberFromPointer(
 	sar_scene_struct *scene,
 	sar_object_struct **ptr, int total,
@@ -96,6 +106,10 @@ sar_visual_model_struct *SARVisualModelNew(
 	const char *filename, const char *name
 );
 GLuint SARVisualModelNewList(sar_visual_model_struct *vmodel);
+void SARVisualModelAddBounds(
+	sar_visual_model_struct *vmodel,
+	float x, float y, float z
+);
 int SARVisualModelGetRefCount(sar_visual_model_struct *vmodel);  
 void SARVisualModelRef(sar_visual_model_struct *vmodel);
 void SARVisualModelUnref(
@@ -141,6 +155,23 @@ void SARObjRemoveFromHumanRescueList(
 	sar_scene_struct *scene, sar_object_struct *obj_ptr
 );
 
+float SARObjContactBoundsFlatRadius(
+	const sar_contact_bounds_struct *cb
+);
+static int SARObjGetSupportBounds(
+	sar_object_struct *obj_ptr,
+	float *x, float *y, float *radius
+);
+static float SARObjGetRescueRadius(sar_object_struct *obj_ptr);
+void SARObjUpdateGrids(
+	sar_scene_struct *scene,
+	sar_object_struct *obj_ptr, int obj_num
+);
+void SARObjUpdateGridsAll(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total
+);
+
 int SARObjAddContactBoundsSpherical(
 	sar_object_struct *obj_ptr,
 	sar_obj_flags_t crash_flags, int crash_type,
@@ -296,6 +327,66 @@ sar_object_struct *SARObjGetPtr(
 	    return(ptr[n]);
 }
 
+/*
+ *	Returns a handle to object n that stays valid until object n
+ *	is deleted.
+ *
+ *	Returns SAR_OBJ_HANDLE_NONE if object n is not allocated.
+ */
+sar_obj_handle SARObjGetHandle(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	int n
+)
+{
+	if((scene == NULL) || !SARObjIsAllocated(ptr, total, n))
+	    return(SAR_OBJ_HANDLE_NONE);
+
+	if((n >= scene->total_object_slots) ||
+	   (n > SAR_OBJ_HANDLE_INDEX_MASK) ||
+	   (scene->object_slot_generation == NULL)
+	)
+	    return(SAR_OBJ_HANDLE_NONE);
+
+	return(
+	    ((sar_obj_handle)scene->object_slot_generation[n] <<
+		SAR_OBJ_HANDLE_INDEX_BITS) |
+	    (sar_obj_handle)n
+	);
+}
+
+/*
+ *	Returns the number of the object referenced by the given handle.
+ *
+ *	Returns -1 if the handle is SAR_OBJ_HANDLE_NONE or the object
+ *	has been deleted since the handle was obtained (even if its
+ *	slot is now used by another object).
+ */
+int SARObjGetFromHandle(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	sar_obj_handle handle
+)
+{
+	const int n = SAR_OBJ_HANDLE_INDEX(handle);
+
+	if((scene == NULL) || (handle == SAR_OBJ_HANDLE_NONE))
+	    return(-1);
+
+	if(!SARObjIsAllocated(ptr, total, n) ||
+	   (n >= scene->total_object_slots) ||
+	   (scene->object_slot_generation == NULL)
+	)
+	    return(-1);
+
+	if(scene->object_slot_generation[n] !=
+	    SAR_OBJ_HANDLE_GENERATION(handle)
+	)
+	    return(-1);
+
+	return(n);
+}
+
 
 /*
  *	Returns the number of the object pointer in the given pointer
@@ -817,6 +908,8 @@ sar_visual_model_struct *SARVisualModelNew(
 	    vmodel->name = STRDUP(name);
 
 	    vmodel->data = 0;
+	    vmodel->mesh = NULL;
+	    vmodel->terrain = NULL;
 
 	    vmodel->mem_size = 0;
 	    vmodel->statements = 0;
@@ -851,6 +944,19 @@ GLuint SARVisualModelNewList(sar_visual_model_struct *vmodel)
 	    vmodel->data = 0;
 	}
 
+	/* Delete the mesh if any, it is built again when the visual
+	 * model is loaded into the new GL display list
+	 */
+	SARMeshDelete(vmodel->mesh);
+	vmodel->mesh = NULL;
+	V3DHFTerrainDelete(vmodel->terrain);
+	vmodel->terrain = NULL;
+
+	/* Reset the bounds, they will be set again as the new GL
+	 * display list is recorded
+	 */
+	vmodel->has_bounds = 0;
+
 	/* Create new GL display list */
 	list = glGenLists(1);
 
@@ -862,6 +968,46 @@ GLuint SARVisualModelNewList(sar_visual_model_struct *vmodel)
 	return list;
 }
 
+/*
+ *	Grows the visual model's bounds to include the point x, y, z
+ *	(in meters, relative to the model's origin).
+ *
+ *	Should be called for every vertex recorded into the visual
+ *	model's GL display list.
+ */
+void SARVisualModelAddBounds(
+	sar_visual_model_struct *vmodel,
+	float x, float y, float z
+)
+{
+	float r;
+
+	if(vmodel == NULL)
+	    return;
+
+	if(vmodel->has_bounds)
+	{
+	    vmodel->x_min = MIN(vmodel->x_min, x);
+	    vmodel->x_max = MAX(vmodel->x_max, x);
+	    vmodel->y_min = MIN(vmodel->y_min, y);
+	    vmodel->y_max = MAX(vmodel->y_max, y);
+	    vmodel->z_min = MIN(vmodel->z_min, z);
+	    vmodel->z_max = MAX(vmodel->z_max, z);
+	}
+	else
+	{
+	    vmodel->x_min = vmodel->x_max = x;
+	    vmodel->y_min = vmodel->y_max = y;
+	    vmodel->z_min = vmodel->z_max = z;
+	    vmodel->radius = 0.0f;
+	    vmodel->has_bounds = 1;
+	}
+
+	r = (float)sqrt((x * x) + (y * y) + (z * z));
+	if(r > vmodel->radius)
+	    vmodel->radius = r;
+}
+
 /*
  *	Returns number of ref counts on visual model.
  *
@@ -953,13 +1099,33 @@ Visual model \"%s\" has less than 1 reference count.\n",
 }
 
 /*
- *      Calls the GL list on the visual model if it is not 0.  
+ *      Draws the mesh on the visual model if it has one, otherwise
+ *	calls the GL list on the visual model if it is not 0. The
+ *	terrain on the visual model (if any) is drawn after.
  */
 void SARVisualModelCallList(sar_visual_model_struct *vmodel)
 {
-	GLuint list = (vmodel != NULL) ? (GLuint)vmodel->data : 0;
-	if(list > 0)
-	    glCallList(list);
+	GLuint list;
+
+	if(vmodel == NULL)
+	    return;
+
+	if(vmodel->mesh != NULL)
+	{
+	    SARMeshDraw(vmodel->mesh);
+	}
+	else
+	{
+	    list = (GLuint)vmodel->data;
+	    if(list > 0)
+	    {
+		glCallList(list);
+		V3DTextureInvalidate();
+	    }
+	}
+
+	if(vmodel->terrain != NULL)
+	    V3DHFTerrainDraw(vmodel->terrain);
 }
 
 /*
@@ -989,6 +1155,9 @@ Visual model `%s' still has %i reference counts.\n",
 	if(list > 0)
 	    glDeleteLists(list, 1);
 
+	SARMeshDelete(vmodel->mesh);
+	V3DHFTerrainDelete(vmodel->terrain);
+
 	free(vmodel);
 }
 
@@ -1072,6 +1241,7 @@ sar_cloud_layer_struct *SARCloudLayerNew(
 	    (*vmodel)->load_state = SAR_VISUAL_MODEL_LOADING;
 
 	    /* Begin recording GL list */
+	    V3DTextureInvalidate();
 	    glNewList(list, GL_COMPILE);
 	    {
 		/* Select texture if defined */
@@ -1086,6 +1256,7 @@ sar_cloud_layer_struct *SARCloudLayerNew(
 		);
 	    }
 	    glEndList();
+	    V3DTextureInvalidate();
 
 	    /* Mark as done loading */
 	    (*vmodel)->load_state = SAR_VISUAL_MODEL_LOADED;
@@ -1331,6 +1502,211 @@ void SARObjRemoveFromHumanRescueList(
 }
 
 
+/*
+ *	Returns the radius (in meters) on the XY plane of the circle
+ *	that encloses the contact bounds about the object's center.
+ *
+ *	For SAR_CONTACT_SHAPE_RECTANGULAR the circle encloses the
+ *	rectangle at any heading.
+ */
+float SARObjContactBoundsFlatRadius(
+	const sar_contact_bounds_struct *cb
+)
+{
+	if(cb == NULL)
+	    return(0.0f);
+
+	switch(cb->contact_shape)
+	{
+	  case SAR_CONTACT_SHAPE_SPHERICAL:
+	  case SAR_CONTACT_SHAPE_CYLENDRICAL:
+	    return(cb->contact_radius);
+
+	  case SAR_CONTACT_SHAPE_RECTANGULAR:
+	    return((float)SFMHypot2(
+		MAX(fabs(cb->contact_x_min), fabs(cb->contact_x_max)),
+		MAX(fabs(cb->contact_y_min), fabs(cb->contact_y_max))
+	    ));
+	}
+
+	return(0.0f);
+}
+
+/*
+ *	Gets the center and flat radius (in meters) of the area in
+ *	which the object provides ground or a support surface.
+ *
+ *	Objects of type SAR_OBJ_TYPE_GROUND cover their contact radius
+ *	and their heightfield, objects who's contact bounds specify
+ *	SAR_CRASH_FLAG_SUPPORT_SURFACE cover their contact bounds.
+ *
+ *	Returns 1 if the object provides ground or a support surface.
+ */
+static int SARObjGetSupportBounds(
+	sar_object_struct *obj_ptr,
+	float *x, float *y, float *radius
+)
+{
+	int status = 0;
+	float r = 0.0f;
+	const sar_contact_bounds_struct *cb = obj_ptr->contact_bounds;
+	const sar_object_ground_struct *ground = SAR_OBJ_GET_GROUND(obj_ptr);
+
+	if(((cb != NULL) ? cb->crash_flags : 0) &
+	    SAR_CRASH_FLAG_SUPPORT_SURFACE
+	)
+	{
+	    r = SARObjContactBoundsFlatRadius(cb);
+	    status = 1;
+	}
+
+	if(ground != NULL)
+	{
+	    /* Ground objects use the full rectangular size as their
+	     * contact radius for rectangular contact bounds (see
+	     * SARSimGetFlatContactRadius()), the contact radius and
+	     * heightfield are centered at the translated position
+	     */
+	    float gr = (float)SFMHypot2(ground->x_len, ground->y_len) / 2.0f;
+	    if(cb != NULL)
+	    {
+		gr = MAX(gr, SARObjContactBoundsFlatRadius(cb));
+		if(cb->contact_shape == SAR_CONTACT_SHAPE_RECTANGULAR)
+		    gr = MAX(gr, MAX(
+			cb->contact_x_max - cb->contact_x_min,
+			cb->contact_y_max - cb->contact_y_min
+		    ));
+	    }
+	    gr += (float)SFMHypot2(ground->x_trans, ground->y_trans);
+
+	    r = MAX(r, gr);
+	    status = 1;
+	}
+
+	*x = obj_ptr->pos.x;
+	*y = obj_ptr->pos.y;
+	*radius = r;
+
+	return(status);
+}
+
+/*
+ *	Gets the flat radius (in meters) within which the object can
+ *	be picked up by a hoist, this matches the target radius used by
+ *	SARSimHoistDeploymentContactCheck().
+ *
+ *	Returns -1.0 if the object can not be picked up.
+ */
+static float SARObjGetRescueRadius(sar_object_struct *obj_ptr)
+{
+	float r;
+	const sar_contact_bounds_struct *cb = obj_ptr->contact_bounds;
+	const sar_object_human_struct *human = SAR_OBJ_GET_HUMAN(obj_ptr);
+
+	if((cb == NULL) || (human == NULL))
+	    return(-1.0f);
+
+	if(!(human->flags & SAR_HUMAN_FLAG_NEED_RESCUE))
+	    return(-1.0f);
+
+	r = SARObjContactBoundsFlatRadius(cb);
+	if(cb->contact_shape == SAR_CONTACT_SHAPE_RECTANGULAR)
+	    r = MAX(r, cb->contact_x_max - cb->contact_x_min);
+
+	return(r);
+}
+
+/*
+ *	Updates the object's entries in the scene's crash grid, support
+ *	grid and rescue grid.
+ *
+ *	If the object's contact bounds specify the crash flag
+ *	SAR_CRASH_FLAG_CRASH_CAUSE then it is put into (or moved in)
+ *	the crash grid, otherwise it is removed from the crash grid.
+ *
+ *	If the object provides ground or a support surface then it is
+ *	put into (or moved in) the support grid, otherwise it is
+ *	removed from the support grid.
+ *
+ *	If the object can be picked up by a hoist then it is put into
+ *	(or moved in) the rescue grid, otherwise it is removed from the
+ *	rescue grid.
+ *
+ *	This is cheap when the object has not moved to other cells
+ *	so it may be called for each object on each cycle.
+ */
+void SARObjUpdateGrids(
+	sar_scene_struct *scene,
+	sar_object_struct *obj_ptr, int obj_num
+)
+{
+	float x, y, r;
+	const sar_contact_bounds_struct *cb;
+
+	if(scene == NULL)
+	    return;
+
+	if(obj_ptr == NULL)
+	{
+	    SARGridRemove(scene->crash_grid, obj_num);
+	    SARGridRemove(scene->support_grid, obj_num);
+	    SARGridRemove(scene->rescue_grid, obj_num);
+	    return;
+	}
+
+	cb = obj_ptr->contact_bounds;
+	if(((cb != NULL) ? cb->crash_flags : 0) &
+	    SAR_CRASH_FLAG_CRASH_CAUSE
+	)
+	    SARGridSet(
+		scene->crash_grid, obj_num,
+		obj_ptr->pos.x, obj_ptr->pos.y,
+		SARObjContactBoundsFlatRadius(cb)
+	    );
+	else
+	    SARGridRemove(scene->crash_grid, obj_num);
+
+	if(SARObjGetSupportBounds(obj_ptr, &x, &y, &r))
+	    SARGridSet(scene->support_grid, obj_num, x, y, r);
+	else
+	    SARGridRemove(scene->support_grid, obj_num);
+
+	r = SARObjGetRescueRadius(obj_ptr);
+	if(r >= 0.0f)
+	    SARGridSet(
+		scene->rescue_grid, obj_num,
+		obj_ptr->pos.x, obj_ptr->pos.y, r
+	    );
+	else
+	    SARGridRemove(scene->rescue_grid, obj_num);
+}
+
+/*
+ *	Updates the entries of all the objects in the scene's grids
+ *	and marks the grids as synchronized.
+ */
+void SARObjUpdateGridsAll(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total
+)
+{
+	int i;
+
+	if(scene == NULL)
+	    return;
+
+	for(i = 0; i < total; i++)
+	    SARObjUpdateGrids(scene, ptr[i], i);
+
+	if(scene->crash_grid != NULL)
+	    scene->crash_grid->need_sync = 0;
+	if(scene->support_grid != NULL)
+	    scene->support_grid->need_sync = 0;
+	if(scene->rescue_grid != NULL)
+	    scene->rescue_grid->need_sync = 0;
+}
+
+
 /*
  *	Allocate (as needed) contact bounds structure to object
  *	for shape SAR_CONTACT_SHAPE_SPHERICAL.
@@ -1815,55 +2191,156 @@ int SARObjNew(
 	int type
 )
 {
-	int i, n, len;
-	sar_object_struct *obj_ptr;
+	int i, n, len, *slot;
+	u_int32_t *generation;
+	sar_object_struct *obj_ptr, **list;
 
 	if((scene == NULL) || (ptr == NULL) || (total == NULL) ||
 	   (type <= SAR_OBJ_TYPE_GARBAGE)
 	)
 	    return(-1);
 
-	for(i = 0; i < *total; i++)
+	/* Reuse the slot of the most recently deleted object or, if
+	 * there are none, append a new slot to the list
+	 */
+	n = -1;
+	while(scene->total_free_object_slots > 0)
 	{
-	    if((*ptr)[i] == NULL)
-		break;
-
-	    if((*ptr)[i]->type <= SAR_OBJ_TYPE_GARBAGE)
+	    scene->total_free_object_slots--;
+	    i = scene->free_object_slot[scene->total_free_object_slots];
+	    if((i >= 0) && (i < *total) && ((*ptr)[i] == NULL))
+	    {
+		n = i;
 		break;
+	    }
 	}
-	if(i < *total)
-	{
-	    n = i;
-	}
-	else
+	if(n < 0)
 	{
 	    n = MAX(*total, 0);
-	    (*total) = n + 1;
 
-	    *ptr = (sar_object_struct **)realloc(
-		*ptr,
-		(*total) * sizeof(sar_object_struct *)
-	    );
-	    if(*ptr == NULL)
+	    /* Grow the list and the slot arrays as needed, doubling
+	     * their size so that they are rarely reallocated
+	     */
+	    if(n >= scene->total_object_slots)
 	    {
-		*total = 0;
-		return(-1);
+		const int	prev_total_slots = scene->total_object_slots;
+		int		total_slots = MAX(
+		    prev_total_slots * 2, SAR_DEF_OBJECT_SLOTS
+		);
+
+		while(total_slots <= n)
+		    total_slots *= 2;
+
+		/* Each array that did grow is kept even if a later one
+		 * fails, total_object_slots is only updated once all of
+		 * them have grown so the next call grows the rest
+		 */
+		list = (sar_object_struct **)realloc(
+		    *ptr,
+		    total_slots * sizeof(sar_object_struct *)
+		);
+		if(list == NULL)
+		    return(-1);
+		*ptr = list;
+
+		slot = (int *)realloc(
+		    scene->free_object_slot,
+		    total_slots * sizeof(int)
+		);
+		if(slot == NULL)
+		    return(-1);
+		scene->free_object_slot = slot;
+
+		generation = (u_int32_t *)realloc(
+		    scene->object_slot_generation,
+		    total_slots * sizeof(u_int32_t)
+		);
+		if(generation == NULL)
+		    return(-1);
+		scene->object_slot_generation = generation;
+
+		list = (sar_object_struct **)realloc(
+		    scene->object_slot_storage,
+		    total_slots * sizeof(sar_object_struct *)
+		);
+		if(list == NULL)
+		    return(-1);
+		scene->object_slot_storage = list;
+
+		for(i = prev_total_slots; i < total_slots; i++)
+		{
+		    scene->object_slot_generation[i] = 1;
+		    scene->object_slot_storage[i] = NULL;
+		}
+		scene->total_object_slots = total_slots;
 	    }
 
+	    (*total) = n + 1;
 	    (*ptr)[n] = NULL;
 	}
 
-	/* Allocate object structure as needed */
-	if((*ptr)[n] == NULL)
+	/* Allocate the object structure or reuse the structure of the
+	 * last object deleted from this slot
+	 */
+	obj_ptr = scene->object_slot_storage[n];
+	if(obj_ptr != NULL)
 	{
-	    (*ptr)[n] = (sar_object_struct *)calloc(
+	    scene->object_slot_storage[n] = NULL;
+	    memset(obj_ptr, 0x00, sizeof(sar_object_struct));
+	}
+	else
+	{
+	    obj_ptr = (sar_object_struct *)calloc(
 		1, sizeof(sar_object_struct)
 	    );
-	    if((*ptr)[n] == NULL)
+	    if(obj_ptr == NULL)
+	    {
+		/* Put the slot back on the free slots stack */
+		scene->free_object_slot[
+		    scene->total_free_object_slots++
+		] = n;
 		return(-1);
+	    }
 	}
+	(*ptr)[n] = obj_ptr;
 
-	obj_ptr = (*ptr)[n];
+
+	/* Reset this object's entries in the scene's grids, the
+	 * object will be put into the grids once its position and
+	 * contact bounds have been set up (the grids are synchronized
+	 * on the next call to SARSimUpdateSceneObjects() or
+	 * SARSimFindGround())
+	 */
+	if(scene->crash_grid == NULL)
+	    scene->crash_grid = SARGridNew(
+		SAR_DEF_CRASH_GRID_CELL_SIZE,
+		SAR_DEF_CRASH_GRID_BUCKETS
+	    );
+	if(scene->crash_grid != NULL)
+	{
+	    SARGridRemove(scene->crash_grid, n);
+	    scene->crash_grid->need_sync = 1;
+	}
+	if(scene->support_grid == NULL)
+	    scene->support_grid = SARGridNew(
+		SAR_DEF_SUPPORT_GRID_CELL_SIZE,
+		SAR_DEF_SUPPORT_GRID_BUCKETS
+	    );
+	if(scene->support_grid != NULL)
+	{
+	    SARGridRemove(scene->support_grid, n);
+	    scene->support_grid->need_sync = 1;
+	}
+	if(scene->rescue_grid == NULL)
+	    scene->rescue_grid = SARGridNew(
+		SAR_DEF_RESCUE_GRID_CELL_SIZE,
+		SAR_DEF_RESCUE_GRID_BUCKETS
+	    );
+	if(scene->rescue_grid != NULL)
+	{
+	    SARGridRemove(scene->rescue_grid, n);
+	    scene->rescue_grid->need_sync = 1;
+	}
 
 
 	/* Set object type */
@@ -2126,7 +2603,7 @@ void SARObjDelete(
 	if(SARObjIsAllocated(*ptr, *total, n))
 	{
 	    int i;
-	    sar_object_struct *obj_ptr, *obj_ptr2;
+	    sar_object_struct *obj_ptr;
 	    sar_object_aircraft_struct *aircraft;
 	    sar_object_runway_struct *runway;
 	    sar_object_helipad_struct *helipad;
@@ -2260,6 +2737,9 @@ void SARObjDelete(
 		        VISUAL_MODEL_UNREF(
 			    runway->south_displaced_threshold_vmodel
 		        );
+		        SARMeshDelete(runway->surface_mesh);
+		        free(runway->light_vertex);
+		        free(runway->light_color);
 		    }
 		    break;
 		  case SAR_OBJ_TYPE_HELIPAD:
@@ -2268,6 +2748,8 @@ void SARObjDelete(
 		    {
 		        free(helipad->label);
 		        VISUAL_MODEL_UNREF(helipad->label_vmodel);
+		        if(helipad->surface_list != 0)
+			    glDeleteLists((GLuint)helipad->surface_list, 1);
 		    }
 		    break;
 		  case SAR_OBJ_TYPE_HUMAN:
@@ -2304,7 +2786,7 @@ void SARObjDelete(
 		    chemical_spray = SAR_OBJ_GET_CHEMICAL_SPRAY(obj_ptr);
 		    if(chemical_spray != NULL)
 		    {
-		        chemical_spray->owner = -1;
+		        chemical_spray->owner = SAR_OBJ_HANDLE_NONE;
 		        chemical_spray->tex_num = -1;
 		    }
 		    break;
@@ -2337,6 +2819,14 @@ void SARObjDelete(
 	    VISUAL_MODEL_UNREF(obj_ptr->visual_model_ir);
 	    VISUAL_MODEL_UNREF(obj_ptr->visual_model);
 
+	    /* Delete levels of detail */
+	    for(i = 0; i < obj_ptr->total_lods; i++)
+		VISUAL_MODEL_UNREF(obj_ptr->lod[i].visual_model);
+	    free(obj_ptr->lod);
+	    obj_ptr->lod = NULL;
+	    obj_ptr->total_lods = 0;
+	    obj_ptr->lod_level = 0;
+
 	    /* Delete contact bounds */
 	    if(obj_ptr->contact_bounds != NULL)
 	    {
@@ -2358,99 +2848,45 @@ void SARObjDelete(
 	    obj_ptr->total_sndsrcs = 0;
 
 
+	    /* Delete ground query cache */
+	    SARGridCacheReset(&obj_ptr->ground_cache);
+
 	    /* Delete name */
 	    free(obj_ptr->name);
 	    obj_ptr->name = NULL;
 
-	    /* Delete the Object itself */
-	    free(obj_ptr);
-	    (*ptr)[n] = NULL;
-
-
-	    /* Object has now been deleted, now we need to check if
-	     * any other objects are referencing this object
-	     *
-	     * If so, then we need to reset those references
+	    /* Delete the Object itself, its structure is kept on the
+	     * scene for reuse by the next object created in this slot
 	     */
-	    for(i = 0; i < *total; i++)
+	    (*ptr)[n] = NULL;
+	    if(n < scene->total_object_slots)
 	    {
-		obj_ptr2 = (*ptr)[i];
-		if(obj_ptr2 == NULL)
-		    continue;
+		u_int32_t *generation = &scene->object_slot_generation[n];
 
-		/* Skip this object */
-		if(i == n)
-		    continue;
+		/* Invalidate all handles to this object, this is how
+		 * the references to it from other objects (and from
+		 * the scene) become invalid
+		 */
+		*generation = ((*generation) + 1) &
+		    SAR_OBJ_HANDLE_GENERATION_MASK;
+		if(*generation == 0)
+		    *generation = 1;
+	    }
+	    if((n < scene->total_object_slots) &&
+	       (scene->object_slot_storage != NULL) &&
+	       (scene->object_slot_storage[n] == NULL)
+	    )
+	    {
+		scene->object_slot_storage[n] = obj_ptr;
 
-		switch(obj_ptr2->type)
-		{
-		  case SAR_OBJ_TYPE_GARBAGE:
-		  case SAR_OBJ_TYPE_STATIC:
-		  case SAR_OBJ_TYPE_AUTOMOBILE:
-		  case SAR_OBJ_TYPE_WATERCRAFT:
-		  case SAR_OBJ_TYPE_AIRCRAFT:
-		  case SAR_OBJ_TYPE_GROUND:
-		  case SAR_OBJ_TYPE_RUNWAY:
-		    break;
-		  case SAR_OBJ_TYPE_HELIPAD:
-		    helipad = SAR_OBJ_GET_HELIPAD(obj_ptr2);
-		    if(helipad != NULL)
-		    {
-			if(helipad->ref_object == n)
-			    helipad->ref_object = -1;
-		    }
-		    break;
-		  case SAR_OBJ_TYPE_HUMAN:
-		    human = SAR_OBJ_GET_HUMAN(obj_ptr2);
-		    if(human != NULL)
-		    {
-			if(human->intercepting_object == n)
-			    human->intercepting_object = -1;
-		    }
-		    break;
-		  case SAR_OBJ_TYPE_SMOKE:
-		    smoke = SAR_OBJ_GET_SMOKE(obj_ptr2);
-		    if(smoke != NULL)
-		    {
-			if(smoke->ref_object == n)
-			    smoke->ref_object = -1;
-		    }
-		    break;
-		  case SAR_OBJ_TYPE_FIRE:
-		    fire = SAR_OBJ_GET_FIRE(obj_ptr2);
-		    if(fire != NULL)
-		    {
-			if(fire->ref_object == n)
-			    fire->ref_object = -1;
-		    }
-		    break;
-		  case SAR_OBJ_TYPE_EXPLOSION:
-		    explosion = SAR_OBJ_GET_EXPLOSION(obj_ptr2);
-		    if(explosion != NULL)
-		    {
-			if(explosion->ref_object == n)
-			    explosion->ref_object = -1;
-		    }
-		    break;
-		  case SAR_OBJ_TYPE_CHEMICAL_SPRAY:
-		    chemical_spray = SAR_OBJ_GET_CHEMICAL_SPRAY(obj_ptr2);
-		    if(chemical_spray != NULL)
-		    {
-			if(chemical_spray->owner == n)
-			    chemical_spray->owner = -1;
-		    }
-		    break;
-		  case SAR_OBJ_TYPE_FUELTANK:
-		    fueltank = SAR_OBJ_GET_FUELTANK(obj_ptr2);
-		    if(fueltank != NULL)
-		    {
-			if(fueltank->ref_object == n)
-			    fueltank->ref_object = -1;
-		    }
-		    break;
-		  case SAR_OBJ_TYPE_PREMODELED:
-		    break;
-		}
+		/* Put the slot on the free slots stack */
+		scene->free_object_slot[
+		    scene->total_free_object_slots++
+		] = n;
+	    }
+	    else
+	    {
+		free(obj_ptr);
 	    }
 
 	    /* Unreference this object from the scene structure so that
@@ -2463,9 +2899,6 @@ void SARObjDelete(
 		if(obj_ptr == scene->player_obj_ptr)
 		    scene->player_obj_ptr = NULL;
 
-		if(n == scene->player_obj_num)
-		    scene->player_obj_num = -1;
-
 		/* Was this referenced as the camera target? */
 		if(n == scene->camera_target)
 		    scene->camera_target = -1;
@@ -2475,6 +2908,11 @@ void SARObjDelete(
 
 		/* Remove this object from human need rescue list as needed */
 		SARObjRemoveFromHumanRescueList(scene, obj_ptr);
+
+		/* Remove this object from the grids */
+		SARGridRemove(scene->crash_grid, n);
+		SARGridRemove(scene->support_grid, n);
+		SARGridRemove(scene->rescue_grid, n);
 	    }
 
 #undef VISUAL_MODEL_UNREF
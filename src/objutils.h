@@ -27,6 +27,16 @@ extern sar_object_struct *SARObjGetPtr(
 	sar_object_struct **ptr, int total,
 	int n
 );
+extern sar_obj_handle SARObjGetHandle(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	int n
+);
+extern int SARObjGetFromHandle(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	sar_obj_handle handle
+);
 extern int SARGetObjectNumberFromPointer(
 	sar_scene_struct *scene,
 	sar_object_struct **ptr, int total,
@@ -75,6 +85,10 @@ extern sar_visual_model_struct *SARVisualModelNew(
 	const char *filename, const char *name
 );
 extern GLuint SARVisualModelNewList(sar_visual_model_struct *vmodel);
+extern void SARVisualModelAddBounds(
+	sar_visual_model_struct *vmodel,
+	float x, float y, float z
+);
 extern int SARVisualModelGetRefCount(sar_visual_model_struct *vmodel);
 extern void SARVisualModelRef(sar_visual_model_struct *vmodel);
 extern void SARVisualModelUnref(
@@ -123,6 +137,18 @@ extern void SARObjRemoveFromHumanRescueList(
 	sar_object_struct *obj_ptr
 );
 
+extern float SARObjContactBoundsFlatRadius(
+	const sar_contact_bounds_struct *cb
+);
+extern void SARObjUpdateGrids(
+	sar_scene_struct *scene,
+	sar_object_struct *obj_ptr, int obj_num
+);
+extern void SARObjUpdateGridsAll(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total
+);
+
 extern int SARObjAddContactBoundsSpherical(
 	sar_object_struct *obj_ptr,
 	sar_obj_flags_t crash_flags, int crash_type,
@@ -468,6 +468,20 @@ int SAROptionsLoadFromFile(
 		FGetValuesF(fp, vf, 1);
 		opt->wind = (Boolean)vf[0];
 	    }
+	    /* SimulationTickRate */
+	    else if(!strcasecmp(buf, "SimulationTickRate"))
+	    {
+		double vf[1];
+		FGetValuesF(fp, vf, 1);
+		opt->sim_tick_rate = (int)CLIP(vf[0], 0, 1000);
+	    }
+	    /* SimulationMaxTicks */
+	    else if(!strcasecmp(buf, "SimulationMaxTicks"))
+	    {
+		double vf[1];
+		FGetValuesF(fp, vf, 1);
+		opt->sim_max_ticks = (int)MAX(vf[0], 1);
+	    }
 
 	    /* Last selected player */
 	    else if(!strcasecmp(buf, "LastSelectedPlayer"))
@@ -924,6 +938,19 @@ int SAROptionsSaveToFile(
 	    opt->wind
 	);
 	PUTCR
+	/* Simulation ticks */
+	fprintf(
+	    fp,
+	    "SimulationTickRate = %i",
+	    opt->sim_tick_rate
+	);
+	PUTCR
+	fprintf(
+	    fp,
+	    "SimulationMaxTicks = %i",
+	    opt->sim_max_ticks
+	);
+	PUTCR
 	PUTCR
 
 	/* Last selected player */
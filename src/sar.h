@@ -36,12 +36,18 @@
 #include "human.h"
 #include "weather.h"
 #include "gctl.h"
+#include "sarreplay.h"
 #include "menu.h"
 #include "sound.h"
 #include "musiclistio.h"
 #include "mission.h"
 #include "texturelistio.h"
 #include "sarfps.h"
+#include "sardrawqueue.h"
+#include "sardrawparticles.h"
+#include "sardrawlights.h"
+#include "sardrawshadows.h"
+#include "sardrawocclusion.h"
 #include "sarfio.h"
 
 
@@ -203,6 +209,13 @@ typedef struct {
 	sar_flight_physics_level	flight_physics_level;
 	Boolean				wind;
 
+	/* Simulation ticks per second (0 for one simulation update
+	 * per main loop with the main loop's lapsed time) and the
+	 * maximum number of simulation ticks per main loop
+	 */
+	int		sim_tick_rate,
+			sim_max_ticks;
+
 	/* Last run selections */
 	int		last_selected_player,
 			last_selected_mission,	/* Matches menu list obj sel pos */
@@ -344,6 +357,7 @@ typedef struct {
 	snd_recorder_struct	*recorder;	/* Sound Server Connection */
 	char		*audio_mode_name;	/* Sound Server's current Audio Mode */
 	gctl_struct	*gctl;			/* Game Controller */
+	sar_replay_struct	*replay;	/* Flight Replay */
 
 	/* Our code to indicate what background music is currently being
 	 * played (one of SAR_MUSIC_ID_*).
@@ -458,6 +472,14 @@ typedef struct {
 		const char *		/* Value */
 	);
 
+	/* Simulation time that has lapsed but has not been simulated
+	 * yet (less than one tick) in milliseconds, and how far
+	 * between the last two simulation ticks the objects are drawn
+	 * (0.0 to 1.0)
+	 */
+	time_t		sim_tick_lapsed;
+	float		sim_tick_coeff;
+
 	/* Options */
 	sar_option_struct	option;
 
@@ -468,6 +490,21 @@ typedef struct {
 	 */
 	sar_fps_struct	fps;
 
+	/* Objects to draw on the current frame, see SARDraw() */
+	sar_draw_queue_struct	draw_queue;
+
+	/* Smoke puffs and sparks to draw on the current frame */
+	sar_draw_particles_struct	draw_particles;
+
+	/* Lights of the objects drawn on the current frame */
+	sar_draw_lights_struct	draw_lights;
+
+	/* Shadows of the objects drawn on the current frame */
+	sar_draw_shadows_struct	draw_shadows;
+
+	/* Occluders of the current frame, see SARDraw() */
+	sar_draw_occlusion_struct	draw_occlusion;
+
 } sar_core_struct;
 
 #define SAR_CORE(p)	((sar_core_struct *)(p))
@@ -43,10 +43,12 @@
 #include "simop.h"
 #include "simutils.h"
 #include "sar.h"
+#include "horizon.h"
 #include "sardraw.h"
 #include "sardrawselect.h"
 #include "sardrawpm.h"
 #include "sardrawdefs.h"
+#include "cp.h"
 #include "config.h"
 
 
@@ -131,11 +133,13 @@ static void SARDrawMapCrossHairs(sar_dc_struct *dc);
 
 /* Lights */
 static void SARDrawLights(
-	sar_dc_struct *dc,
-	sar_light_struct **ptr, int total
+	sar_dc_struct *dc, sar_object_struct *obj_ptr
 );
 
 /* Cockpit */
+static void SARDrawControlPanelUpdate(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr
+);
 static void SARDrawObjectCockpit(
 	sar_dc_struct *dc, sar_object_struct *obj_ptr
 );
@@ -144,6 +148,26 @@ static void SARDrawObjectCockpit(
 static void SARDrawObjectShadow(
 	sar_dc_struct *dc, sar_object_struct *obj_ptr
 );
+static void SARDrawObjectStaticShadow(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr, float distance
+);
+
+/* View Frustum Culling */
+static float SARDrawObjectCullRadius(sar_object_struct *obj_ptr);
+
+/* Occlusion Culling */
+static void SARDrawOccludersUpdate(sar_dc_struct *dc);
+static Boolean SARDrawObjectOccluded(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr, float cull_radius
+);
+
+/* Levels Of Detail */
+static sar_visual_model_struct *SARDrawObjectLODSelect(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr, float distance
+);
+static sar_visual_model_struct *SARDrawObjectLODModel(
+	const sar_object_struct *obj_ptr
+);
 
 /* Scene Foundation (Ground) */
 static void SARDrawSceneFoundations(sar_dc_struct *dc);
@@ -157,11 +181,10 @@ static void SARDrawCloudBBIterate(
 	sar_dc_struct *dc,
 	const sar_position_struct *pos,
 	float hw, float height,
-	const GLfloat *c,
-	v3d_texture_ref_struct *t,
-	float lightening_intensity_coeff,
+	GLfloat *quad_v,
 	const sar_position_struct *lightening_point,
-	int lightening_points
+	int lightening_points,
+	GLfloat *line_v
 );
 static void SARDrawCloudBB(
 	sar_dc_struct *dc,
@@ -173,6 +196,7 @@ static void SARDrawSceneHorizon(sar_dc_struct *dc);
 static void SARDrawSceneCelestialAdditive(sar_dc_struct *dc);
 
 /* Main  */
+static void SARDrawReportStats(sar_core_struct *core_ptr);
 void SARDraw(sar_core_struct *core_ptr);
 void SARDrawMap(
 	sar_core_struct *core_ptr,
@@ -435,7 +459,10 @@ static void SARSetCamera(sar_dc_struct *dc)
 	    }
 	    else
 	    {
-		obj_num = scene->player_obj_num;
+		obj_num = SARObjGetFromHandle(
+		    scene, dc->object, dc->total_objects,
+		    scene->player_obj_handle
+		);
 		obj_ptr = scene->player_obj_ptr;
 	    }
 	    if(obj_ptr != NULL)
@@ -505,7 +532,10 @@ static void SARSetCamera(sar_dc_struct *dc)
 	    }
 	    else
 	    {
-		obj_num = scene->player_obj_num;
+		obj_num = SARObjGetFromHandle(
+		    scene, dc->object, dc->total_objects,
+		    scene->player_obj_handle
+		);
 		obj_ptr = scene->player_obj_ptr;
 	    }
 	    if(obj_ptr != NULL)
@@ -2268,22 +2298,30 @@ static void SARDrawHoistDeployment(
 }
 
 /*
- *	Draws smoke trail object, all translations and rotations will
- *	be handled within this function.
+ *	Adds the smoke trail object's units to the particle batches,
+ *	they are drawn with the units of all the other smoke trail
+ *	objects after all the objects are drawn.
  */
 static void SARDrawSmoke(
 	sar_dc_struct *dc,
 	sar_object_struct *obj_ptr, sar_object_smoke_struct *obj_smoke_ptr
 )
 {
-	gw_display_struct *display = dc->display;
-	state_gl_struct *state = &display->state_gl;
 	sar_scene_struct *scene = dc->scene;
-	const sar_position_struct *cam_pos = &dc->camera_pos;
-	int tex_num = obj_smoke_ptr->tex_num;
+	sar_draw_particles_struct *particles = &dc->core_ptr->draw_particles;
+	int i, tex_num = obj_smoke_ptr->tex_num;
 	v3d_texture_ref_struct *t;
-	GLenum shade_model_mode = state->shade_model_mode;
-	StateGLBoolean lighting = state->lighting;
+	const sar_object_smoke_unit_struct *u;
+	const sar_position_struct *pos;
+	const sar_color_struct *c;
+
+	/* This smoke object has no individual smoke units? */
+	if(obj_smoke_ptr->unit == NULL)
+	    return;
+
+	/* Do not draw smoke in FLIR mode */
+	if((obj_smoke_ptr->type == SAR_SMOKE_TYPE_SMOKE) && dc->flir)
+	    return;
 
 	/* Get texture for this smoke trail */
 	if(SARIsTextureAllocated(scene, tex_num))
@@ -2291,135 +2329,54 @@ static void SARDrawSmoke(
 	else
 	    t = NULL;
 
-	/* Select texture (if any) */
-	V3DTextureSelect(t);
-	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
-	/* Set up GL states */
-	switch(obj_smoke_ptr->type)
-	{
-	  case SAR_SMOKE_TYPE_SMOKE:
-	    /* Do not draw smoke in FLIR mode */
-	    if(dc->flir)
-		return;
-	    StateGLShadeModel(state, GL_FLAT);
-	    break;
-	  case SAR_SMOKE_TYPE_SPARKS:
-	    StateGLShadeModel(state, GL_FLAT);
-	    StateGLDisable(state, GL_LIGHTING);
-	    break;
-	  case SAR_SMOKE_TYPE_DEBRIS:
-	    /* TODO */
-	    StateGLShadeModel(state, GL_FLAT);
-	    break;
-	}
-
-	/* This smoke object has individual smoke units? */
-	if(obj_smoke_ptr->unit != NULL)
+	/* Iterate through each unit */
+	for(i = 0; i < obj_smoke_ptr->total_units; i++)
 	{
-	    int i;
-	    float r;
-	    const sar_object_smoke_unit_struct *u;
-	    const sar_position_struct *pos;
-	    sar_direction_struct to_dir;
-	    const sar_color_struct *c;
+	    u = &obj_smoke_ptr->unit[i];
 
-	    /* Iterate through each unit */
-	    for(i = 0; i < obj_smoke_ptr->total_units; i++)
-	    {
-		u = &obj_smoke_ptr->unit[i];
+	    /* Do not draw units that are not visible */
+	    if(u->visibility <= 0.0f)
+		continue;
 
-		/* Do not draw units that are not visible */
-		if(u->visibility <= 0.0f)
-		    continue;
+	    c = &u->color;
+	    pos = &u->pos;
 
-		r = u->radius;
-		c = &u->color;
-		pos = &u->pos;
+	    /* Add by smoke type */
+	    switch(obj_smoke_ptr->type)
+	    {
+	      case SAR_SMOKE_TYPE_SMOKE:
+		SARDrawParticlesAddQuad(
+		    particles, t,
+		    pos->x, pos->z, -pos->y,
+		    u->radius
+		);
+		break;
 
-		/* Draw by smoke type */
-		switch(obj_smoke_ptr->type)
+	      case SAR_SMOKE_TYPE_SPARKS:
+		if(dc->flir)
 		{
-		  case SAR_SMOKE_TYPE_SMOKE:
-		    glPushMatrix();
-		    {
-			/* Translate */
-			glTranslatef(pos->x, pos->z, -pos->y);
-
-			/* Adjust heading to camera heading */
-			SARDrawGetDirFromPos(
-			    cam_pos, pos, &to_dir
-			);
-			if(to_dir.heading != 0)
-			    glRotatef(
-				(GLfloat)-SFMRadiansToDegrees(to_dir.heading),
-				0.0f, 1.0f, 0.0f
-			    );
-			if(to_dir.pitch != 0)
-			    glRotatef(
-				(GLfloat)-SFMRadiansToDegrees(to_dir.pitch),
-				1.0f, 0.0f, 0.0f
-			    );
-
-		        /* Begin drawing smoke puff */
-		        glBegin(GL_QUADS);
-		        {
-			    glNormal3f(0.0f, 1.0f, 0.0f);
-			    glTexCoord2f(0.0f, 1.0f - 0.0f);
-			    glVertex3f(-r, -r, 0.0f);
-			    glTexCoord2f(1.0f, 1.0f - 0.0f);
-			    glVertex3f(r, -r, 0.0f);
-			    glTexCoord2f(1.0f, 1.0f - 1.0f);
-			    glVertex3f(r, r, 0.0f);
-			    glTexCoord2f(0.0f, 1.0f - 1.0f);
-			    glVertex3f(-r, r, 0.0f);
-		        }
-		        glEnd();
-		    }
-		    glPopMatrix();
-		    break;
-
-		  case SAR_SMOKE_TYPE_SPARKS:
-		    StateGLEnable(state, GL_POINT_SMOOTH);
-		    StateGLPointSize(state, 2.0f);
-		    if(dc->flir)
-		    {
-			float g = MAX(MAX(c->r, c->g), c->b);
-			glColor4f(g, g, g, c->a);
-		    }
-		    else
-		    {
-			glColor4f(c->r, c->g, c->b, c->a);
-		    }
-
-		    glPushMatrix();
-		    {
-			/* Translate */
-			glTranslatef(pos->x, pos->z, -pos->y);
-
-			glBegin(GL_POINTS);
-			{
-			    glNormal3f(0.0f, 1.0f, 0.0f);
-			    glVertex3f(0.0f, 0.0f, 0.0f);
-			}
-			glEnd();
-		    }
-		    glPopMatrix();
-		    StateGLDisable(state, GL_POINT_SMOOTH);
-		    StateGLPointSize(state, 1.0f);
-		    break;
-
-		  case SAR_SMOKE_TYPE_DEBRIS:
-		    /* TODO */
-		    break;
-		}	/* Draw by smoke trail type */
-	    }	/* Iterate through each unit */
-	}
+		    float g = MAX(MAX(c->r, c->g), c->b);
+		    SARDrawParticlesAddPoint(
+			particles,
+			pos->x, pos->z, -pos->y,
+			g, g, g, c->a
+		    );
+		}
+		else
+		{
+		    SARDrawParticlesAddPoint(
+			particles,
+			pos->x, pos->z, -pos->y,
+			c->r, c->g, c->b, c->a
+		    );
+		}
+		break;
 
-	/* Restore GL states */ 
-	StateGLShadeModel(state, shade_model_mode);
-	if(lighting)
-	    StateGLEnable(state, GL_LIGHTING);
+	      case SAR_SMOKE_TYPE_DEBRIS:
+		/* TODO */
+		break;
+	    }	/* Add by smoke trail type */
+	}	/* Iterate through each unit */
 }
 
 /*
@@ -4175,40 +4132,46 @@ static void SARDrawMapCrossHairs(sar_dc_struct *dc)
 
 
 /*
- *	Draws the lights.
+ *	Adds the lights on the object to the light batches, they are
+ *	drawn after all the objects.
+ *
+ *	The positions of the lights are relative to the object, they
+ *	are moved and rotated with the object's position and direction
+ *	the same way as the object's visual models are.
  */
 static void SARDrawLights(
-	sar_dc_struct *dc,
-	sar_light_struct **ptr, int total
+	sar_dc_struct *dc, sar_object_struct *obj_ptr
 )
 {
-	gw_display_struct *display = dc->display;
-	StateGLBoolean lighting = display->state_gl.lighting;
-	StateGLBoolean alpha_test = display->state_gl.alpha_test;
-	int i;
-	float intensity_coeff;
+	sar_draw_lights_struct *lights = &dc->core_ptr->draw_lights;
+	const sar_position_struct *obj_pos = &obj_ptr->pos;
+	const sar_direction_struct *dir = &obj_ptr->dir;
+	int i, total = obj_ptr->total_lights;
+	float	intensity_coeff,
+		sh, ch, sp, cp, sb, cb,
+		x, y, z, t;
+	GLfloat r, g, b;
 	const sar_color_struct *c;
 	const sar_position_struct *pos;
 	const sar_light_struct *light;
 
 
 	/* No lights to draw? */
-	if(total <= 0)
+	if((obj_ptr->light == NULL) || (total <= 0))
 	    return;
 
-	/* Set up GL states */
-	StateGLDisable(&display->state_gl, GL_LIGHTING);
-	StateGLDisable(&display->state_gl, GL_ALPHA_TEST);
-	StateGLEnable(&display->state_gl, GL_BLEND);
-	StateGLBlendFunc(
-	    &display->state_gl, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
-	);
-	StateGLEnable(&display->state_gl, GL_POINT_SMOOTH);
+	/* Rotations of the object */
+	sh = (float)sin(dir->heading);
+	ch = (float)cos(dir->heading);
+	sp = (float)sin(dir->pitch);
+	cp = (float)cos(dir->pitch);
+	sb = (float)sin(dir->bank);
+	cb = (float)cos(dir->bank);
 
-	/* Draw each light */
+	/* Add each light */
 	for(i = 0; i < total; i++)
 	{
-	    light = ptr[i];
+	    light = obj_ptr->light[i];
 	    if(light == NULL)
 		continue;
 
@@ -4259,72 +4222,136 @@ static void SARDrawLights(
 		intensity_coeff = 1.0f;
 	    }
 
-	    /* Get position and color or light */
-	    pos = &light->pos;
+	    /* Get color of light */
 	    c = &light->color;
+	    if(dc->flir)
+	    {
+		r = g = b = MAX(MAX(c->r, c->g), c->b);
+	    }
+	    else
+	    {
+		r = c->r;
+		g = c->g;
+		b = c->b;
+	    }
+
+	    /* Get position of light in GL coordinates and rotate it
+	     * by the object's bank, pitch, and heading
+	     */
+	    pos = &light->pos;
+	    x = pos->x;
+	    y = pos->z;
+	    z = -pos->y;
 
-	    /* Begin drawing center point intense part of light (for
-	     * strobes only)
+	    t = (x * cb) + (y * sb);
+	    y = (y * cb) - (x * sb);
+	    x = t;
+
+	    t = (y * cp) + (z * sp);
+	    z = (z * cp) - (y * sp);
+	    y = t;
+
+	    t = (x * ch) - (z * sh);
+	    z = (z * ch) + (x * sh);
+	    x = t;
+
+	    x += obj_pos->x;
+	    y += obj_pos->z;
+	    z += -obj_pos->y;
+
+	    /* Add center point intense part of light (for strobes
+	     * only)
 	     */
 	    if((light->flags & SAR_LIGHT_FLAG_STROBE) &&
 	       (intensity_coeff >= 0.5f)
 	    )
-	    {
-		StateGLPointSize(
-		    &display->state_gl,
-		    (GLfloat)MAX(light->radius, 1.0)
+		SARDrawLightsAdd(
+		    lights,
+		    (GLfloat)light->radius,
+		    x, y, z,
+		    r, g, b, c->a
 		);
-		if(dc->flir)
-		{
-		    float g = MAX(MAX(c->r, c->g), c->b);
-		    glColor4f(g, g, g, c->a);
-		}
-		else
-		{
-		    glColor4f(c->r, c->g, c->b, c->a);
-		}
-		glBegin(GL_POINTS);
-		{
-		    glVertex3f(pos->x, pos->z, -pos->y);
-		}
-		glEnd();
-	    }
 
-	    /* Set point size */
-	    StateGLPointSize(
-		&display->state_gl,
-		(GLfloat)MAX(light->radius * 2.0 * intensity_coeff, 1.0)
+	    /* Add light */
+	    SARDrawLightsAdd(
+		lights,
+		(GLfloat)(light->radius * 2.0 * intensity_coeff),
+		x, y, z,
+		r, g, b, c->a * intensity_coeff
 	    );
+	}
+}
 
-	    /* Set color */
-	    if(dc->flir)
-	    {
-		float g = MAX(MAX(c->r, c->g), c->b);
-		glColor4f(g, g, g, c->a * intensity_coeff);
-	    }
-	    else
-	    {
-		glColor4f(c->r, c->g, c->b, c->a * intensity_coeff);
-	    }
 
-	    /* Draw light */
-	    glBegin(GL_POINTS);
-	    {
-		glVertex3f(pos->x, pos->z, -pos->y);
-	    }
-	    glEnd();
+/*
+ *	Updates the values of the player's control panel from the
+ *	player object, the control panel's instruments redraw their
+ *	textures as needed.
+ *
+ *	This must be called before the frame is cleared since the
+ *	instruments may be drawn to the GL back buffer.
+ */
+static void SARDrawControlPanelUpdate(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr
+)
+{
+	ControlPanel *cp;
+	ControlPanelValues v;
+	sar_scene_struct *scene = dc->scene;
+	const sar_position_struct *airspeed;
+	sar_object_aircraft_struct *aircraft = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
+	if((aircraft == NULL) || (scene->player_control_panel == NULL))
+	    return;
+
+	cp = CONTROL_PANEL(scene->player_control_panel);
+	airspeed = &aircraft->airspeed;
+
+	memset(&v, 0x00, sizeof(ControlPanelValues));
+	v.current_time = cur_millitime;
+	v.time_compensation = time_compensation;
+	v.tod = scene->tod;
+	switch(scene->tod_code)
+	{
+	  case SAR_TOD_CODE_DAWN:
+	    v.tod_code = CP_TOD_CODE_DAWN;
+	    v.color_state = CP_COLOR_STATE_DIM;
+	    break;
+	  case SAR_TOD_CODE_NIGHT:
+	    v.tod_code = CP_TOD_CODE_NIGHT;
+	    v.color_state = CP_COLOR_STATE_DARK;
+	    break;
+	  case SAR_TOD_CODE_DUSK:
+	    v.tod_code = CP_TOD_CODE_DUSK;
+	    v.color_state = CP_COLOR_STATE_DIM;
+	    break;
+	  default:
+	    v.tod_code = CP_TOD_CODE_DAY;
+	    v.color_state = CP_COLOR_STATE_NORMAL;
+	    break;
 	}
+	v.fullscreen = GL_FALSE;
+
+	/* Velocity and speed in miles per hour */
+	v.vel_x = (GLfloat)SFMMPCToMPH(aircraft->vel.x);
+	v.vel_y = (GLfloat)SFMMPCToMPH(aircraft->vel.y);
+	v.vel_z = (GLfloat)SFMMPCToMPH(aircraft->vel.z);
+	v.speed = (GLfloat)SFMMPCToMPH(aircraft->landed ?
+	    airspeed->y : SFMHypot2(airspeed->y, airspeed->z)
+	);
 
-	/* Restore GL states */
-	StateGLDisable(&display->state_gl, GL_POINT_SMOOTH);
-	StateGLPointSize(&display->state_gl, 1.0f);
-	StateGLDisable(&display->state_gl, GL_BLEND);
-	if(alpha_test)
-	    StateGLEnable(&display->state_gl, GL_ALPHA_TEST);
-	if(lighting)
-	    StateGLEnable(&display->state_gl, GL_LIGHTING);
-}
+	v.heading = (GLfloat)obj_ptr->dir.heading;
+	v.pitch = (GLfloat)obj_ptr->dir.pitch;
+	v.bank = (GLfloat)obj_ptr->dir.bank;
+
+	v.alt = (GLfloat)obj_ptr->pos.z;
+	v.alt_feet = (GLfloat)SFMMetersToFeet(obj_ptr->pos.z);
+
+	v.gear_coeff = (SARObjLandingGearState(obj_ptr) == 1) ?
+	    1.0f : 0.0f;
 
+	CPManage(cp, &v);
+	CPChangeValues(cp, &v);
+}
 
 /*
  *	Draws the cockpit on the given object, which must be an
@@ -4462,6 +4489,12 @@ static void SARDrawObjectCockpit(
 		aircraft->visual_model_cockpit
 	    );
 
+	    /* Draw the control panel relative to the center of the
+	     * cockpit
+	     */
+	    if(scene->player_control_panel != NULL)
+		CPDraw(CONTROL_PANEL(scene->player_control_panel));
+
 	    SAR_DRAW_POST_CALLLIST_RESET_STATES
 
 /* Technically we should reset the persepective, but since no
@@ -4473,66 +4506,330 @@ static void SARDrawObjectCockpit(
 }
 
 /*
- *	Draws shadow (if available) on the object. Translation
- *	is already assumed to be at the object's center and heading
- *	(except pitch and bank) of object is already set.
- *
- *	Also draws rotor and prop wash if they are relivent for the
- *	given object's values.
+ *	Selects the level of detail that the object's standard visual
+ *	model is drawn at from the object's distance to the camera (in
+ *	meters) and the size of the view, and returns its visual model.
  *
- *	Inputs assumed valid.
+ *	The object is only moved to the next coarser or finer level
+ *	when it is SAR_LOD_HYSTERESIS past that level's range.
  */
-static void SARDrawObjectShadow(
-	sar_dc_struct *dc, sar_object_struct *obj_ptr
+static sar_visual_model_struct *SARDrawObjectLODSelect(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr, float distance
 )
 {
-	gw_display_struct *display = dc->display;
-	state_gl_struct *state = &display->state_gl;
-	const sar_option_struct *opt = dc->option;
-	sar_scene_struct *scene = dc->scene;
-	sar_object_aircraft_struct *aircraft = NULL;
-	sar_object_fueltank_struct *obj_fueltank_ptr = NULL;
-	Boolean on_water = False, is_crashed = False;
-	float	throttle = 1.0f,
-		center_to_ground_height = 0.0f;
-	sar_visual_model_struct *vmodel = obj_ptr->visual_model_shadow;
+	int level;
+	const sar_visual_model_lod_struct *lod = obj_ptr->lod;
+
+	if(obj_ptr->total_lods <= 0)
+	    return(obj_ptr->visual_model);
+
+	/* Scale the distance to the reference view, the object is
+	 * smaller on the screen of a narrower view or a wider field
+	 * of view
+	 */
+	if((dc->width > 0) && (dc->fovz_um > 0.0f))
+	    distance *= (dc->fovz_um * SAR_LOD_REF_WIDTH) /
+		(SAR_LOD_REF_FOVZ_UM * (float)dc->width);
+
+	level = CLIP(obj_ptr->lod_level, 0, obj_ptr->total_lods);
+	while((level < obj_ptr->total_lods) &&
+	      (distance > (lod[level].range * (1.0f + SAR_LOD_HYSTERESIS)))
+	)
+	    level++;
+	while((level > 0) &&
+	      (distance < (lod[level - 1].range * (1.0f - SAR_LOD_HYSTERESIS)))
+	)
+	    level--;
+	obj_ptr->lod_level = level;
+
+	return(SARDrawObjectLODModel(obj_ptr));
+}
+
+/*
+ *	Returns the visual model of the object's standard visual model
+ *	at the level of detail last selected by
+ *	SARDrawObjectLODSelect().
+ */
+static sar_visual_model_struct *SARDrawObjectLODModel(
+	const sar_object_struct *obj_ptr
+)
+{
+	const int level = obj_ptr->lod_level;
+
+	if((level > 0) && (level <= obj_ptr->total_lods))
+	    return(obj_ptr->lod[level - 1].visual_model);
+	else
+	    return(obj_ptr->visual_model);
+}
+
+/*
+ *	Returns the radius about the object's center (in meters) that
+ *	contains all of the object's visual models, lights, and
+ *	shadow, for testing the object against the view frustum.
+ *
+ *	Returns -1.0 if the object's size is not known (such as when
+ *	any of its visual models have no bounds), in which case the
+ *	object should not be culled.
+ */
+static float SARDrawObjectCullRadius(sar_object_struct *obj_ptr)
+{
+	int i;
+	float r = 0.0f;
+	const sar_position_struct *pos;
+	const sar_light_struct *light;
+	const sar_object_premodeled_struct *premodeled;
+	const sar_visual_model_struct *vmodel[7];
 
 	switch(obj_ptr->type)
 	{
-	  case SAR_OBJ_TYPE_AIRCRAFT:
-	    aircraft = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
-	    if(aircraft != NULL)
-	    {
-		center_to_ground_height =
-		    aircraft->center_to_ground_height;
-		throttle = aircraft->throttle;
-		on_water = aircraft->on_water ? True : False;
-		is_crashed = (aircraft->air_worthy_state == SAR_AIR_WORTHY_NOT_FLYABLE) ?
-		    True : False;
-	    }
+	  case SAR_OBJ_TYPE_PREMODELED:
+	    /* Only buildings are drawn within their size, the other
+	     * premodeled objects have wires and other parts beyond it
+	     */
+	    premodeled = SAR_OBJ_GET_PREMODELED(obj_ptr);
+	    if(premodeled == NULL)
+		return(-1.0f);
+	    if(premodeled->type != SAR_OBJ_PREMODELED_BUILDING)
+		return(-1.0f);
+	    r = (float)sqrt(
+		(premodeled->length * premodeled->length / 4.0f) +
+		(premodeled->width * premodeled->width / 4.0f) +
+		(premodeled->height * premodeled->height)
+	    );
 	    break;
-	  case SAR_OBJ_TYPE_FUELTANK:
-	    obj_fueltank_ptr = SAR_OBJ_GET_FUELTANK(obj_ptr);
-	    if(obj_fueltank_ptr != NULL)
+
+	  default:
+	    vmodel[0] = obj_ptr->visual_model;
+	    vmodel[1] = obj_ptr->visual_model_ir;
+	    vmodel[2] = obj_ptr->visual_model_far;
+	    vmodel[3] = obj_ptr->visual_model_dawn;
+	    vmodel[4] = obj_ptr->visual_model_dusk;
+	    vmodel[5] = obj_ptr->visual_model_night;
+	    vmodel[6] = obj_ptr->visual_model_shadow;
+	    for(i = 0; i < 7; i++)
 	    {
-/* TODO */
+		if(vmodel[i] == NULL)
+		    continue;
+
+		if(!vmodel[i]->has_bounds)
+		    return(-1.0f);
+
+		r = MAX(r, vmodel[i]->radius);
 	    }
-	    break;
-	  default:
-	    /* Calculate center to ground height for all other object
-	     * types based on it's ground elevation and current
-	     * position.
+
+	    /* Add the height above ground since the shadow is drawn
+	     * on the ground below the object
 	     */
-	    center_to_ground_height = obj_ptr->ground_elevation_msl -
-		obj_ptr->pos.z;
+	    if(obj_ptr->visual_model_shadow != NULL)
+		r += MAX(obj_ptr->pos.z - obj_ptr->ground_elevation_msl, 0.0f);
 	    break;
 	}
 
+	/* Lights */
+	for(i = 0; i < obj_ptr->total_lights; i++)
+	{
+	    light = obj_ptr->light[i];
+	    if(light == NULL)
+		continue;
 
-	/* Draw prop wash if the object is an aircraft and it center
-	 * to ground height is with in the shadow visibility
-	 */
-	if(!dc->flir && (aircraft != NULL) &&
+	    pos = &light->pos;
+	    r = MAX(
+		r,
+		(float)sqrt(
+		    (pos->x * pos->x) + (pos->y * pos->y) + (pos->z * pos->z)
+		)
+	    );
+	}
+
+	return(r);
+}
+
+/*
+ *	Rasterizes the nearest premodeled buildings that are drawn on
+ *	this frame into the occlusion buffer, the buffer must already
+ *	be reset with the camera's model view matrix.
+ *
+ *	Only buildings that are upright, within the view frustum, and
+ *	large enough on the screen are used, up to
+ *	SAR_OCCLUSION_OCCLUDERS_MAX of them.
+ */
+static void SARDrawOccludersUpdate(sar_dc_struct *dc)
+{
+	int i;
+	float distance, distance3d, r;
+	sar_object_struct *obj_ptr;
+	const sar_position_struct *pos;
+	const sar_object_premodeled_struct *premodeled;
+	sar_core_struct *core_ptr = dc->core_ptr;
+	sar_draw_occlusion_struct *occlusion = &core_ptr->draw_occlusion;
+
+	for(i = 0; i < core_ptr->total_objects; i++)
+	{
+	    obj_ptr = core_ptr->object[i];
+	    if(obj_ptr == NULL)
+		continue;
+	    if(obj_ptr->type != SAR_OBJ_TYPE_PREMODELED)
+		continue;
+	    if(obj_ptr->flags & SAR_OBJ_FLAG_NO_DEPTH_TEST)
+		continue;
+	    if((obj_ptr->dir.pitch != 0.0f) || (obj_ptr->dir.bank != 0.0f))
+		continue;
+
+	    premodeled = SAR_OBJ_GET_PREMODELED(obj_ptr);
+	    if(premodeled == NULL)
+		continue;
+	    if(premodeled->type != SAR_OBJ_PREMODELED_BUILDING)
+		continue;
+
+	    /* Leave out the buildings that SARDraw() does not draw */
+	    pos = &obj_ptr->pos;
+	    distance = (float)SFMHypot2(
+		pos->x - dc->camera_pos.x, pos->y - dc->camera_pos.y
+	    );
+	    if(distance > obj_ptr->range)
+		continue;
+	    if(dc->lowest_cloud_layer_ptr != NULL)
+	    {
+		if((dc->camera_pos.z > dc->lowest_cloud_layer_ptr->z) &&
+		   (pos->z < dc->lowest_cloud_layer_ptr->z)
+		)
+		    continue;
+	    }
+
+	    r = SARDrawObjectCullRadius(obj_ptr);
+	    if(!SARDrawFrustumSphereVisible(dc, pos, r))
+		continue;
+
+	    /* Too small on the screen to hide much? */
+	    distance3d = (float)SFMHypot2(distance, pos->z - dc->camera_pos.z);
+	    if((distance3d > r) &&
+	       ((2.0f * r) < (distance3d * dc->fovz_um *
+		SAR_OCCLUSION_OCCLUDER_MIN_SIZE))
+	    )
+		continue;
+
+	    SARDrawOcclusionAddOccluder(occlusion, i, distance3d);
+	}
+	SARDrawOcclusionSortOccluders(occlusion);
+
+	for(i = 0; i < MIN(occlusion->total_occluders,
+	    SAR_OCCLUSION_OCCLUDERS_MAX); i++
+	)
+	{
+	    obj_ptr = core_ptr->object[occlusion->occluder[i].obj_num];
+	    premodeled = SAR_OBJ_GET_PREMODELED(obj_ptr);
+	    pos = &obj_ptr->pos;
+
+	    /* Anything seen below the building's base is under the
+	     * ground that the building stands on, so the box is
+	     * extended below the base to also hide the objects on the
+	     * ground right behind the building (whose bounding
+	     * spheres reach below the ground)
+	     */
+	    SARDrawOcclusionAddBox(
+		occlusion,
+		pos->x, pos->y, pos->z - premodeled->height,
+		obj_ptr->dir.heading,
+		premodeled->length, premodeled->width,
+		2.0f * premodeled->height
+	    );
+	}
+	occlusion->frame_occluders = occlusion->total_drawn;
+}
+
+/*
+ *	Checks if the object is entirely hidden behind the occluders
+ *	rasterized by SARDrawOccludersUpdate(), cull_radius is the
+ *	object's radius from SARDrawObjectCullRadius().
+ *
+ *	Objects drawn without depth testing are never occluded.
+ */
+static Boolean SARDrawObjectOccluded(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr, float cull_radius
+)
+{
+	sar_draw_occlusion_struct *occlusion = &dc->core_ptr->draw_occlusion;
+	const sar_position_struct *pos = &obj_ptr->pos;
+
+	if(cull_radius < 0.0f)
+	    return(False);
+	if(obj_ptr->flags & SAR_OBJ_FLAG_NO_DEPTH_TEST)
+	    return(False);
+	if(occlusion->total_drawn <= 0)
+	    return(False);
+
+	occlusion->frame_tested++;
+	if(SARDrawOcclusionSphereVisible(
+	    occlusion, pos->x, pos->y, pos->z, cull_radius
+	))
+	    return(False);
+
+	occlusion->frame_occluded++;
+	return(True);
+}
+
+/*
+ *	Queues the shadow (if available) of the object, see
+ *	SARDrawShadowsDraw(). Translation is already assumed to be at
+ *	the object's center and heading (except pitch and bank) of
+ *	object is already set.
+ *
+ *	Also draws rotor and prop wash if they are relivent for the
+ *	given object's values.
+ *
+ *	Inputs assumed valid.
+ */
+static void SARDrawObjectShadow(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr
+)
+{
+	gw_display_struct *display = dc->display;
+	state_gl_struct *state = &display->state_gl;
+	const sar_option_struct *opt = dc->option;
+	sar_scene_struct *scene = dc->scene;
+	sar_object_aircraft_struct *aircraft = NULL;
+	sar_object_fueltank_struct *obj_fueltank_ptr = NULL;
+	Boolean on_water = False, is_crashed = False;
+	float	throttle = 1.0f,
+		center_to_ground_height = 0.0f;
+	sar_visual_model_struct *vmodel = obj_ptr->visual_model_shadow;
+
+	switch(obj_ptr->type)
+	{
+	  case SAR_OBJ_TYPE_AIRCRAFT:
+	    aircraft = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
+	    if(aircraft != NULL)
+	    {
+		center_to_ground_height =
+		    aircraft->center_to_ground_height;
+		throttle = aircraft->throttle;
+		on_water = aircraft->on_water ? True : False;
+		is_crashed = (aircraft->air_worthy_state == SAR_AIR_WORTHY_NOT_FLYABLE) ?
+		    True : False;
+	    }
+	    break;
+	  case SAR_OBJ_TYPE_FUELTANK:
+	    obj_fueltank_ptr = SAR_OBJ_GET_FUELTANK(obj_ptr);
+	    if(obj_fueltank_ptr != NULL)
+	    {
+/* TODO */
+	    }
+	    break;
+	  default:
+	    /* Calculate center to ground height for all other object
+	     * types based on it's ground elevation and current
+	     * position.
+	     */
+	    center_to_ground_height = obj_ptr->ground_elevation_msl -
+		obj_ptr->pos.z;
+	    break;
+	}
+
+
+	/* Draw prop wash if the object is an aircraft and it center
+	 * to ground height is with in the shadow visibility
+	 */
+	if(!dc->flir && (aircraft != NULL) &&
 	   (center_to_ground_height >= -SAR_SHADOW_VISIBILITY_HEIGHT) &&
 	   (opt->textured_objects && opt->prop_wash)
 	)
@@ -4644,50 +4941,80 @@ static void SARDrawObjectShadow(
 	    glPopMatrix();
 	}
 
-	/* Draw shadow using the visual model? */
+	/* Queue the shadow using the visual model, the shadows of all
+	 * the objects are drawn after the objects (static objects
+	 * have their shadows queued by SARDrawObjectStaticShadow())
+	 */
 	if((vmodel != NULL) &&
+	   (obj_ptr->type != SAR_OBJ_TYPE_STATIC) &&
 	   (center_to_ground_height >= -SAR_SHADOW_VISIBILITY_HEIGHT) &&
 	   (on_water ? !is_crashed : True)
 	)
 	{
-	    GLboolean lighting = display->state_gl.lighting;
-	    GLboolean depth_mask_flag = display->state_gl.depth_mask_flag;
-	    GLenum shade_model_mode = display->state_gl.shade_model_mode;
-	    float z = center_to_ground_height;
+	    const sar_position_struct *pos = &obj_ptr->pos;
 
-	    /* Set up GL states */
-	    StateGLDisable(state, GL_LIGHTING);
-	    StateGLEnable(state, GL_BLEND);
-	    StateGLDisable(state, GL_ALPHA_TEST);
-	    StateGLDepthMask(state, GL_FALSE);
-	    StateGLEnable(state, GL_POLYGON_OFFSET_FILL);
-	    StateGLBlendFunc(
-		state, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
+	    SARDrawShadowsAdd(
+		&dc->core_ptr->draw_shadows,
+		vmodel,
+		(GLfloat)pos->x,
+		(GLfloat)(pos->z + center_to_ground_height),
+		(GLfloat)-pos->y,
+		(GLfloat)-SFMRadiansToDegrees(obj_ptr->dir.heading)
 	    );
-	    StateGLPolygonOffset(
-		state, 
-		(GLfloat)opt->gl_polygon_offset_factor, -1.0f
-	    );
-	    StateGLShadeModel(state, GL_FLAT);
+	}
+}
 
-	    /* Draw shadow */
-	    glPushMatrix();
-	    {
-		glTranslatef(0.0f, z, 0.0f);
-		glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
-		SARVisualModelCallList(vmodel);
-	    }
-	    glPopMatrix();
 
-	    /* Restore GL states */
-	    if(lighting)
-		StateGLEnable(state, GL_LIGHTING);
-	    StateGLDisable(state, GL_POLYGON_OFFSET_FILL);
-	    StateGLDisable(state, GL_BLEND);
-	    StateGLDepthMask(state, depth_mask_flag);
-	    StateGLEnable(state, GL_ALPHA_TEST);
-	    StateGLShadeModel(state, shade_model_mode);
+/*
+ *	Queues the shadow (if available) of the static object as a
+ *	static shadow, see SARDrawShadowsAddStatic().
+ *
+ *	The shadow is queued whenever the object is in range to be
+ *	drawn with its closeup models, even if the object is outside
+ *	of the view frustum or hidden, so that the static shadows
+ *	only change when the camera moves in or out of range of an
+ *	object.
+ *
+ *	Inputs assumed valid.
+ */
+static void SARDrawObjectStaticShadow(
+	sar_dc_struct *dc, sar_object_struct *obj_ptr, float distance
+)
+{
+	const sar_position_struct *pos = &obj_ptr->pos;
+	sar_visual_model_struct *vmodel = obj_ptr->visual_model_shadow;
+	float center_to_ground_height;
+
+	if(vmodel == NULL)
+	    return;
+
+	/* Drawn with the far model (which has no shadow)? */
+	if((obj_ptr->visual_model_far != NULL) ?
+	   (distance > obj_ptr->range_far) : (distance > obj_ptr->range)
+	)
+	    return;
+
+	/* Is camera above and object below lowest cloud layer? */
+	if(dc->lowest_cloud_layer_ptr != NULL)
+	{
+	    if((dc->camera_pos.z > dc->lowest_cloud_layer_ptr->z) &&
+	       (pos->z < dc->lowest_cloud_layer_ptr->z)
+	    )
+		return;
 	}
+
+	center_to_ground_height = obj_ptr->ground_elevation_msl - pos->z;
+	if(center_to_ground_height < -SAR_SHADOW_VISIBILITY_HEIGHT)
+	    return;
+
+	SARDrawShadowsAddStatic(
+	    &dc->core_ptr->draw_shadows,
+	    vmodel,
+	    (GLfloat)pos->x,
+	    (GLfloat)(pos->z + center_to_ground_height),
+	    (GLfloat)-pos->y,
+	    (GLfloat)-SFMRadiansToDegrees(obj_ptr->dir.heading)
+	);
 }
 
 
@@ -4852,131 +5179,104 @@ static void SARDrawCloudLayer(
 }
 
 /*
- *	Called by SARDrawCloudBB() to draw one cloud billboard and its
- *	lightening (if any).
+ *	Called by SARDrawCloudBB() to put one cloud billboard facing
+ *	the camera into the vertex arrays.
+ *
+ *	The billboard's quad is put into quad_v as 4 vertices in the
+ *	GL_T2F_V3F interleaved array format. If line_v is not NULL
+ *	then the lightening is put into it as (lightening_points - 1)
+ *	GL_LINES segments in the GL_V3F format.
  */
 static void SARDrawCloudBBIterate(
 	sar_dc_struct *dc,
 	const sar_position_struct *pos, float hw, float height,
-	const GLfloat *c,
-	v3d_texture_ref_struct *t,
-	float lightening_intensity_coeff,
+	GLfloat *quad_v,
 	const sar_position_struct *lightening_point,
-	int lightening_points
+	int lightening_points,
+	GLfloat *line_v
 )
 {
-	gw_display_struct *display = dc->display;
-	state_gl_struct *state = &display->state_gl;
+	int i;
+	float r, sin_h, cos_h;
 	const sar_position_struct *cam_pos = &dc->camera_pos;
+	const GLfloat	x = pos->x,
+			y = pos->z,
+			z = -pos->y;
 
-	glColor4f(c[0], c[1], c[2], 1.0f);
-	V3DTextureSelect(t);
-	glPushMatrix();
+	/* Get the sine and cosine of the heading to face the camera,
+	 * the billboard is not pitched so that it is always at a
+	 * right angle with the horizon
+	 */
+	r = (float)SFMHypot2(pos->x - cam_pos->x, pos->y - cam_pos->y);
+	if(r > 0.0f)
 	{
-	    sar_direction_struct dir;
-
-	    /* Get direction to face the camera */
-	    SARDrawGetDirFromPos(cam_pos, pos, &dir);
+	    sin_h = (pos->x - cam_pos->x) / r;
+	    cos_h = (pos->y - cam_pos->y) / r;
+	}
+	else
+	{
+	    sin_h = 0.0f;
+	    cos_h = 1.0f;
+	}
 
-	    /* Translate to the base of the cloud billboard and rotate
-	     * in order to place the cloud billboard to be facing the
-	     * camera
-	     */
-	    glTranslatef(
-		pos->x, pos->z, -pos->y
-	    );
-	    if(dir.heading != 0)
-		glRotatef(
-		    (GLfloat)-SFMRadiansToDegrees(dir.heading),
-		    0.0f, 1.0f, 0.0f
-		);
-#if 0
-/* Do not pitch the billboard even if camera is pitched, it should be 
- * facing at a right angle with the horizon at all times
- */
-	    if(dir.pitch != 0)
-		glRotatef(
-		    (GLfloat)-SFMRadiansToDegrees(dir.pitch),
-		    1.0f, 0.0f, 0.0f
-		);
-#endif
-	    /* Draw the Cloud Billboard */
-	    if(!dc->flir)
-	    {
-		glBegin(GL_QUADS);
-		{
-		    glTexCoord2f(0.0f, 1.0f - 0.0f);
-		    glVertex3f(-hw, 0.0f, 0.0f);
-		    glTexCoord2f(1.0f, 1.0f - 0.0f);
-		    glVertex3f(hw, 0.0f, 0.0f);
-		    glTexCoord2f(1.0f, 1.0f - 1.0f);
-		    glVertex3f(hw, height, 0.0f);
-		    glTexCoord2f(0.0f, 1.0f - 1.0f);
-		    glVertex3f(-hw, height, 0.0f);
-		}
-		glEnd();
-	    }
+	/* Cloud Billboard, the base is at pos and the quad is
+	 * rotated about the GL Y axis by the heading
+	 */
+	quad_v[0] = 0.0f;
+	quad_v[1] = 1.0f - 0.0f;
+	quad_v[2] = x - (hw * cos_h);
+	quad_v[3] = y;
+	quad_v[4] = z - (hw * sin_h);
+
+	quad_v[5] = 1.0f;
+	quad_v[6] = 1.0f - 0.0f;
+	quad_v[7] = x + (hw * cos_h);
+	quad_v[8] = y;
+	quad_v[9] = z + (hw * sin_h);
+
+	quad_v[10] = 1.0f;
+	quad_v[11] = 1.0f - 1.0f;
+	quad_v[12] = x + (hw * cos_h);
+	quad_v[13] = y + height;
+	quad_v[14] = z + (hw * sin_h);
+
+	quad_v[15] = 0.0f;
+	quad_v[16] = 1.0f - 1.0f;
+	quad_v[17] = x - (hw * cos_h);
+	quad_v[18] = y + height;
+	quad_v[19] = z - (hw * sin_h);
+
+	/* Lightening */
+	if(line_v != NULL)
+	{
+	    GLfloat lx, lz, prev[3];
+	    const sar_position_struct *pt;
 
-	    /* Draw the Lightening */
-	    if(lightening_intensity_coeff > 0.0f)
+	    for(i = 0; i < lightening_points; i++)
 	    {
-		StateGLBoolean	fog = state->fog,
-				alpha_test = state->alpha_test,
-				blend = state->blend;
-
-		/* Turn off texturing and set lightening color */
-		V3DTextureSelect(NULL);
-		if(dc->flir)
-		    glColor4f(
-			1.0f * lightening_intensity_coeff,
-			1.0f * lightening_intensity_coeff,
-			1.0f * lightening_intensity_coeff,
-			1.0f
-		    );
-		else
-		    glColor4f(
-			0.93f * lightening_intensity_coeff,
-			0.75f * lightening_intensity_coeff,
-			1.00f * lightening_intensity_coeff,
-			1.0f
-		    );
-
-		/* Set up GL states */
-		StateGLDisable(state, GL_FOG);
-		StateGLDisable(state, GL_ALPHA_TEST);
-		StateGLEnable(state, GL_BLEND);
-		StateGLBlendFunc(
-		    state,
-		    GL_ONE, GL_ONE
-		);
-		StateGLEnable(state, GL_LINE_SMOOTH);
-		StateGLLineWidth(state, 1.0f);
-
-		/* Draw lightening */
-		glBegin(GL_LINE_STRIP);
+		GLfloat cur[3];
+
+		pt = &lightening_point[i];
+		lx = pt->x;
+		lz = -pt->y;
+		cur[0] = x + (lx * cos_h) - (lz * sin_h);
+		cur[1] = y + pt->z;
+		cur[2] = z + (lx * sin_h) + (lz * cos_h);
+		if(i > 0)
 		{
-		    int i;
-		    const sar_position_struct *pt;
-		    for(i = 0; i < lightening_points; i++)
-		    {
-			pt = &lightening_point[i];
-			glVertex3f(pt->x, pt->z, -pt->y);
-		    }
+		    line_v[0] = prev[0];
+		    line_v[1] = prev[1];
+		    line_v[2] = prev[2];
+		    line_v[3] = cur[0];
+		    line_v[4] = cur[1];
+		    line_v[5] = cur[2];
+		    line_v += 6;
 		}
-		glEnd();
-
-		/* Restore GL states */
-		if(fog)
-		    StateGLEnable(state, GL_FOG);
-		if(alpha_test)
-		    StateGLEnable(state, GL_ALPHA_TEST);
-		if(!blend)
-		    StateGLDisable(state, GL_BLEND);
-		StateGLDisable(state, GL_LINE_SMOOTH);
-		StateGLLineWidth(state, 1.0f);
+		prev[0] = cur[0];
+		prev[1] = cur[1];
+		prev[2] = cur[2];
 	    }
 	}
-	glPopMatrix();
 }
 
 /*
@@ -5005,6 +5305,12 @@ static void SARDrawCloudBB(
 	float ligntening_intensity_coeff;
 	v3d_texture_ref_struct *t;
 	const GLfloat *c = dc->light_color;
+	/* Vertex arrays of the 9 tiles, the quads in the GL_T2F_V3F
+	 * format and the lightening lines in the GL_V3F format
+	 */
+	GLfloat	quad_v[9 * 4 * 5],
+		line_v[9 * (SAR_LIGHTENING_POINTS_MAX - 1) * 2 * 3];
+	int tiles = 0;
 
 	/* Get cloud billboard texture */
 	if(SARIsTextureAllocated(scene, tex_num))
@@ -5056,19 +5362,16 @@ static void SARDrawCloudBB(
 	    ligntening_intensity_coeff = 0.0f;
 	}
 
-	/* Set up GL states */
-	StateGLEnable(state, GL_ALPHA_TEST);
-	StateGLAlphaFunc(state, GL_GREATER, 0.5);
-
-	/* Begin drawing cloud billboards */
-
+	/* Put the cloud billboards into the vertex arrays */
 #define DRAW_CLOUD	{		\
  SARDrawCloudBBIterate(			\
   dc, &pos, hw, cloud_bb_ptr->height,	\
-  c, t,					\
-  ligntening_intensity_coeff,		\
-  lightening_point, lightening_points	\
+  &quad_v[tiles * 4 * 5],		\
+  lightening_point, lightening_points,	\
+  (ligntening_intensity_coeff > 0.0f) ?	\
+   &line_v[tiles * (SAR_LIGHTENING_POINTS_MAX - 1) * 2 * 3] : NULL \
  );					\
+ tiles++;				\
 }
 	/* Draw center oriented tile */
 	DRAW_CLOUD
@@ -5102,6 +5405,73 @@ static void SARDrawCloudBB(
 	DRAW_CLOUD
 #undef DRAW_CLOUD
 
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+	/* Draw the Cloud Billboards */
+	if(!dc->flir)
+	{
+	    /* Set up GL states */
+	    StateGLEnable(state, GL_ALPHA_TEST);
+	    StateGLAlphaFunc(state, GL_GREATER, 0.5);
+
+	    glColor4f(c[0], c[1], c[2], 1.0f);
+	    V3DTextureSelect(t);
+	    glInterleavedArrays(GL_T2F_V3F, 0, quad_v);
+	    glDrawArrays(GL_QUADS, 0, tiles * 4);
+	}
+
+	/* Draw the Lightening */
+	if(ligntening_intensity_coeff > 0.0f)
+	{
+	    StateGLBoolean	fog = state->fog,
+				blend = state->blend;
+
+	    /* Turn off texturing and set lightening color */
+	    V3DTextureSelect(NULL);
+	    if(dc->flir)
+		glColor4f(
+		    1.0f * ligntening_intensity_coeff,
+		    1.0f * ligntening_intensity_coeff,
+		    1.0f * ligntening_intensity_coeff,
+		    1.0f
+		);
+	    else
+		glColor4f(
+		    0.93f * ligntening_intensity_coeff,
+		    0.75f * ligntening_intensity_coeff,
+		    1.00f * ligntening_intensity_coeff,
+		    1.0f
+		);
+
+	    /* Set up GL states */
+	    StateGLDisable(state, GL_FOG);
+	    StateGLDisable(state, GL_ALPHA_TEST);
+	    StateGLEnable(state, GL_BLEND);
+	    StateGLBlendFunc(
+		state,
+		GL_ONE, GL_ONE
+	    );
+	    StateGLEnable(state, GL_LINE_SMOOTH);
+	    StateGLLineWidth(state, 1.0f);
+
+	    /* Draw lightening */
+	    glInterleavedArrays(GL_V3F, 0, line_v);
+	    glDrawArrays(
+		GL_LINES, 0,
+		tiles * (lightening_points - 1) * 2
+	    );
+
+	    /* Restore GL states */
+	    if(fog)
+		StateGLEnable(state, GL_FOG);
+	    if(!blend)
+		StateGLDisable(state, GL_BLEND);
+	    StateGLDisable(state, GL_LINE_SMOOTH);
+	    StateGLLineWidth(state, 1.0f);
+	}
+
+	glPopClientAttrib();
+
 	/* Restore GL states */
 	if(alpha_test)
 	    StateGLEnable(state, GL_ALPHA_TEST);
@@ -5126,9 +5496,9 @@ static void SARDrawSceneHorizon(sar_dc_struct *dc)
 	GLenum shade_model_mode = state->shade_model_mode;
 	Boolean afternoon = False;
 	int	i, n,
-		total_horizon_textures = 7,
+		total_horizon_bands = SAR_HORIZON_BANDS,
 		total_horizon_panels = 12;
-	float h_min, h_max, r;
+	float h_min, h_max, r, s_top, s_bottom, t;
 	const GLfloat *c = dc->light_color;
 	const sar_scene_horizon_struct *horizon = &scene->horizon;
 	const sar_cloud_layer_struct *cloud_layer = NULL;
@@ -5149,12 +5519,9 @@ static void SARDrawSceneHorizon(sar_dc_struct *dc)
 	}
 
 
-	/* Check if horizon has all 7 textures allocated */
-	if(horizon->total_textures < total_horizon_textures)
-	{
-	    /* Not enough textures allocated */
+	/* Check if horizon has its texture allocated */
+	if(horizon->texture == NULL)
 	    return;
-	}
 
 	/* Calculate horizon radius r, this is the distance from camera
 	 * to each horizon panel
@@ -5187,8 +5554,12 @@ static void SARDrawSceneHorizon(sar_dc_struct *dc)
 	if(dc->flir)
 	    c = flir_c;
 
-	SAR_DRAW_TEXTURE_1D_ON
-	SAR_DRAW_TEXTURE_2D_OFF
+	/* Row of the horizon texture for the time of day */
+	t = SARHorizonTexCoordT(scene->tod);
+
+	SAR_DRAW_TEXTURE_1D_OFF
+	SAR_DRAW_TEXTURE_2D_ON
+	V3DTextureSelect(horizon->texture);
 
 	/* Set up gl states */
 	StateGLShadeModel(state, GL_FLAT);
@@ -5229,8 +5600,8 @@ static void SARDrawSceneHorizon(sar_dc_struct *dc)
 	    /* Begin drawing each horizon panel
 	     *
 	     * Iterate through horizon panels, note that this more than
-	     * the actual number of horizon textures so one texture may 
-	     * be used more than once
+	     * the number of horizon bands so one band may be used more
+	     * than once
 	     */
 	    for(i = 0; i < total_horizon_panels; i++)
 	    {
@@ -5245,21 +5616,19 @@ static void SARDrawSceneHorizon(sar_dc_struct *dc)
 		dy[1] = (float)(r * cos(theta));
 
 
-		/* Calculate horizon texture index based on horizon panel
+		/* Calculate horizon band index based on horizon panel
 		 * index. Remember that there are more horizon panels than
-		 * horizon textures.
+		 * horizon bands.
 		 */
-		if(i >= total_horizon_textures)
-		    n = total_horizon_textures -
-			i + total_horizon_textures - 2;
+		if(i >= total_horizon_bands)
+		    n = total_horizon_bands -
+			i + total_horizon_bands - 2;
 		else
 		    n = i;
-		/* Flip texture index n if time is before noon */
+		/* Flip band index n if time is before noon */
 		if(!afternoon)
-		    n = total_horizon_textures - n - 1;
-		/* Clip */
-		if((n >= 0) && (n < total_horizon_textures))
-		    V3DTextureSelect(horizon->texture[n]);
+		    n = total_horizon_bands - n - 1;
+		SARHorizonTexCoordS(n, &s_top, &s_bottom);
 
 		/* Calculate normal theta */
 		n_theta = (float)SFMSanitizeRadians(
@@ -5272,19 +5641,19 @@ static void SARDrawSceneHorizon(sar_dc_struct *dc)
 		glBegin(GL_QUADS);
 		/* No lighting so no normal needed */
 
-		glTexCoord2f(1.0f, 0.0f);
+		glTexCoord2f(s_bottom, t);
 		glVertex3f(
 		    dx[0], h_min, -dy[0]
 		);
-		glTexCoord2f(1.0f, 0.0f);
+		glTexCoord2f(s_bottom, t);
 		glVertex3f(
 		    dx[1], h_min, -dy[1]
 		);
-		glTexCoord2f(0.0f, 0.0f);
+		glTexCoord2f(s_top, t);
 		glVertex3f(
 		    dx[1], h_max, -dy[1]
 		);
-		glTexCoord2f(0.0f, 0.0f);
+		glTexCoord2f(s_top, t);
 		glVertex3f(
 		    dx[0], h_max, -dy[0]
 		);
@@ -5725,12 +6094,59 @@ printf("\r Result %.0f %.0f %.0f | %.2f %.2f",
 
 
 
+/*
+ *	Counts the frame drawn and, once every second, prints the
+ *	frame rate and the renderer's counters of the last frame.
+ */
+static void SARDrawReportStats(sar_core_struct *core_ptr)
+{
+	sar_fps_struct *fps = &core_ptr->fps;
+	const sar_draw_queue_struct *queue = &core_ptr->draw_queue;
+	const sar_draw_occlusion_struct *occlusion =
+	    &core_ptr->draw_occlusion;
+	const sar_draw_particles_struct *particles =
+	    &core_ptr->draw_particles;
+	const sar_draw_lights_struct *lights = &core_ptr->draw_lights;
+	const sar_draw_shadows_struct *shadows = &core_ptr->draw_shadows;
+	const state_gl_struct *state = (core_ptr->display != NULL) ?
+	    &core_ptr->display->state_gl : NULL;
+
+	fps->fc.frame++;
+	fps->fc.total++;
+	if(cur_millitime < fps->next_tally)
+	    return;
+
+	/* Tally the frames counted since the last reset */
+	memcpy(&fps->ft, &fps->fc, sizeof(sar_fps_frames_struct));
+	memset(&fps->fc, 0x00, sizeof(sar_fps_frames_struct));
+	fps->last_frames_reset = cur_millitime;
+	fps->next_tally = fps->last_frames_reset + 1000;
+
+	printf(
+"SARDraw(): %i fps, %i objects queued (%i state %i model switches),\
+ %i occluders %i tested %i occluded, %i particle quads %i points in\
+ %i draws, %i lights in %i draws, %i shadows (%i static),\
+ %ld texture binds (%ld saved).\n",
+	    (int)fps->ft.frame,
+	    queue->frame_items, queue->frame_state_switches,
+	    queue->frame_model_switches,
+	    occlusion->frame_occluders, occlusion->frame_tested,
+	    occlusion->frame_occluded,
+	    particles->frame_quads, particles->frame_points,
+	    particles->frame_draws,
+	    lights->frame_lights, lights->frame_draws,
+	    shadows->frame_shadows, shadows->frame_static_shadows,
+	    (state != NULL) ? (long)state->texture_binds : 0l,
+	    (state != NULL) ? (long)state->texture_binds_saved : 0l
+	);
+}
+
 /*
  *	Redraws scene.
  */
 void SARDraw(sar_core_struct *core_ptr)
 {
-	int i, n, *total;
+	int i, n, item_num, *total;
 	int width, height;
 	float fovz_um, view_aspect;
 	Boolean need_clear_color = True;
@@ -5752,8 +6168,10 @@ void SARDraw(sar_core_struct *core_ptr)
 	sar_cloud_layer_struct *cloud_layer_ptr;
 	sar_cloud_bb_struct *cloud_bb_ptr;
 	float far_model_range, distance, distance3d, visibility_max;
-	GLfloat light_val[4], mat_val[4];
+	float cull_radius;
+	GLfloat light_val[4], mat_val[4], camera_matrix[16];
 	const sar_option_struct *opt = &core_ptr->option;
+	sar_draw_queue_struct *queue = &core_ptr->draw_queue;
 	sar_dc_struct _dc, *dc;
 
 
@@ -5792,6 +6210,12 @@ void SARDraw(sar_core_struct *core_ptr)
 
 	state = &display->state_gl;
 
+	/* Count the texture binds made and saved on this frame, the
+	 * last frame's counts were printed by SARDrawReportStats()
+	 */
+	state->texture_binds = 0;
+	state->texture_binds_saved = 0;
+
 	GWContextGet(
 	    display, GWContextCurrent(display),
 	    NULL, NULL,
@@ -5818,6 +6242,15 @@ void SARDraw(sar_core_struct *core_ptr)
 	    100.0
 	);
 
+	/* Update the player's control panel before the viewport is
+	 * reset, its instruments may change the viewport and draw to
+	 * the GL back buffer
+	 */
+	if((scene->camera_ref == SAR_CAMERA_REF_COCKPIT) &&
+	   (scene->player_obj_ptr != NULL)
+	)
+	    SARDrawControlPanelUpdate(dc, scene->player_obj_ptr);
+
 	/* Reset viewport */
 	SARReshapeCB(0, core_ptr, -1, -1, -1, -1);
 
@@ -5855,6 +6288,27 @@ void SARDraw(sar_core_struct *core_ptr)
 	 */
 	SARSetCamera(dc);
 
+	/* Update the view frustum for culling objects */
+	SARDrawFrustumUpdate(
+	    dc,
+	    scene->camera_fovz, view_aspect,
+	    0.8f, visibility_max
+	);
+
+	/* Reset the occlusion buffer with the camera's model view
+	 * matrix, the occluders are rasterized once the objects are
+	 * about to be queued
+	 */
+	glGetFloatv(GL_MODELVIEW_MATRIX, camera_matrix);
+	SARDrawOcclusionReset(
+	    &core_ptr->draw_occlusion,
+	    SAR_OCCLUSION_WIDTH, SAR_OCCLUSION_HEIGHT,
+	    camera_matrix, scene->camera_fovz, view_aspect, 0.8f
+	);
+	core_ptr->draw_occlusion.frame_occluders = 0;
+	core_ptr->draw_occlusion.frame_tested = 0;
+	core_ptr->draw_occlusion.frame_occluded = 0;
+
 
 	/* Get pointers to lowest (first) and highest (last) cloud
 	 * layers on the scene
@@ -6432,16 +6886,127 @@ void SARDraw(sar_core_struct *core_ptr)
  }								\
 }
 
-	/* Iterate through each object, checking if the object is valid
-	 * and if it is in bounds to be drawn. If it should be drawn then
-	 * appropriate matrix rotations, translations, and GL state
-	 * changes will be made and the object will be drawn.
+	/* Rasterize the nearest buildings that hide the objects behind
+	 * them, objects that pass the view frustum test are then tested
+	 * against them as they are drawn
 	 */
+	SARDrawOccludersUpdate(dc);
+
+	/* Queue the objects to draw, objects out of range with the
+	 * camera are left out except for aircraft (which mute their
+	 * sounds when out of range)
+	 *
+	 * Objects that do not write depth (no depth test or polygon
+	 * offsetting without depth writes) rely on being drawn after
+	 * the objects before them and before the objects after them,
+	 * so each one gets its own segment and the opaque objects are
+	 * only sorted with the other objects between them
+	 */
+	SARDrawQueueReset(queue);
+	SARDrawParticlesReset(&core_ptr->draw_particles);
+	SARDrawLightsReset(&core_ptr->draw_lights, state);
+	SARDrawShadowsReset(&core_ptr->draw_shadows);
+	n = 0;
 	for(i = 0; i < core_ptr->total_objects; i++)
 	{
+	    unsigned int draw_state = 0;
+	    int pass = SAR_DRAW_PASS_OPAQUE;
+	    const sar_visual_model_struct *vmodel;
+	    Boolean ordered;
+
 	    obj_ptr = core_ptr->object[i];
 	    if(obj_ptr == NULL)
 		continue;
+	    if(obj_ptr->type == SAR_OBJ_TYPE_GARBAGE)
+		continue;
+
+	    pos = &obj_ptr->pos;
+	    distance = (float)SFMHypot2(
+		pos->x - dc->camera_pos.x, pos->y - dc->camera_pos.y
+	    );
+	    if((obj_ptr->type != SAR_OBJ_TYPE_AIRCRAFT) &&
+	       (distance > obj_ptr->range)
+	    )
+		continue;
+
+	    /* Static objects never move, their shadows are queued here
+	     * in the same order on each frame
+	     */
+	    if(obj_ptr->type == SAR_OBJ_TYPE_STATIC)
+		SARDrawObjectStaticShadow(dc, obj_ptr, distance);
+
+	    if(obj_ptr->flags & SAR_OBJ_FLAG_NO_DEPTH_TEST)
+		draw_state |= SAR_DRAW_STATE_NO_DEPTH_TEST;
+	    if(obj_ptr->flags & SAR_OBJ_FLAG_SHADE_MODEL_SMOOTH)
+		draw_state |= SAR_DRAW_STATE_SHADE_SMOOTH;
+	    if(obj_ptr->flags & SAR_OBJ_FLAG_POLYGON_OFFSET)
+		draw_state |= SAR_DRAW_STATE_POLYGON_OFFSET;
+	    else if(obj_ptr->flags & SAR_OBJ_FLAG_POLYGON_OFFSET_REVERSE)
+		draw_state |= SAR_DRAW_STATE_POLYGON_OFFSET_REVERSE;
+
+	    switch(obj_ptr->type)
+	    {
+	      case SAR_OBJ_TYPE_SMOKE:
+	      case SAR_OBJ_TYPE_FIRE:
+	      case SAR_OBJ_TYPE_EXPLOSION:
+		pass = SAR_DRAW_PASS_TRANSLUCENT;
+		break;
+	      default:
+		break;
+	    }
+
+	    /* Select the standard visual model's level of detail, draw
+	     * far model instead if beyond the far model range
+	     */
+	    distance3d = (float)SFMHypot2(distance, pos->z - dc->camera_pos.z);
+	    vmodel = SARDrawObjectLODSelect(dc, obj_ptr, distance3d);
+	    if((obj_ptr->visual_model_far != NULL) &&
+	       (distance > obj_ptr->range_far)
+	    )
+		vmodel = obj_ptr->visual_model_far;
+
+	    ordered = ((draw_state & SAR_DRAW_STATE_NO_DEPTH_TEST) ||
+		(((draw_state & (SAR_DRAW_STATE_POLYGON_OFFSET |
+		    SAR_DRAW_STATE_POLYGON_OFFSET_REVERSE)) != 0) &&
+		 !(obj_ptr->flags & SAR_OBJ_FLAG_POLYGON_OFFSET_WRITE_DEPTH)
+		)
+	    ) ? True : False;
+	    if(ordered)
+		n++;
+
+	    SARDrawQueueAdd(
+		queue, i, pass, n, draw_state, vmodel,
+		distance3d
+	    );
+
+	    if(ordered)
+		n++;
+	}
+	SARDrawQueueSort(queue);
+	queue->frame_items = queue->total_items;
+	queue->frame_state_switches = 0;
+	queue->frame_model_switches = 0;
+
+	/* Iterate through each queued object, checking if the object
+	 * is in bounds to be drawn. If it should be drawn then
+	 * appropriate matrix rotations, translations, and GL state
+	 * changes will be made and the object will be drawn.
+	 */
+	for(item_num = 0; item_num < queue->total_items; item_num++)
+	{
+	    const sar_draw_item_struct *item = &queue->item[item_num];
+
+	    /* Count the GL state and visual model switches */
+	    if(item_num > 0)
+	    {
+		if(item->state != queue->item[item_num - 1].state)
+		    queue->frame_state_switches++;
+		if(item->model != queue->item[item_num - 1].model)
+		    queue->frame_model_switches++;
+	    }
+
+	    i = item->obj_num;
+	    obj_ptr = core_ptr->object[i];
 
 	    /* Get pointer to position of object */
 	    pos = &obj_ptr->pos;
@@ -6650,9 +7215,7 @@ void SARDraw(sar_core_struct *core_ptr)
 			}
 
 			/* Draw lights */
-			SARDrawLights(
-			    dc, obj_ptr->light, obj_ptr->total_lights
-			);
+			SARDrawLights(dc, obj_ptr);
 
 			DISABLE_POLYGON_OFFSET_AS_NEEDED
 			SAR_DRAW_POST_CALLLIST_RESET_STATES
@@ -6773,7 +7336,7 @@ void SARDraw(sar_core_struct *core_ptr)
 				if(dc->flir)
 				    SAR_DRAW_FLIR_COLOR_MASK_SET
 #endif
-				SARVisualModelCallList(obj_ptr->visual_model);
+				SARVisualModelCallList(SARDrawObjectLODModel(obj_ptr));
 				if(dc->flir)
 				    SAR_DRAW_COLOR_MASK_UNSET
 			    }
@@ -6864,9 +7427,7 @@ void SARDraw(sar_core_struct *core_ptr)
 			}
 
 			/* Draw lights */
-			SARDrawLights(  
-			    dc, obj_ptr->light, obj_ptr->total_lights  
-			);
+			SARDrawLights(dc, obj_ptr);
 
 			/* Draw rotors/propellars */
 			for(n = 0; n < aircraft->total_rotors; n++)
@@ -6949,7 +7510,7 @@ void SARDraw(sar_core_struct *core_ptr)
 			    if(dc->flir)
 				SAR_DRAW_FLIR_COLOR_MASK_SET
 #endif
-			    SARVisualModelCallList(obj_ptr->visual_model);
+			    SARVisualModelCallList(SARDrawObjectLODModel(obj_ptr));
 			    if(dc->flir)
 				SAR_DRAW_COLOR_MASK_UNSET
 			}
@@ -7020,9 +7581,7 @@ void SARDraw(sar_core_struct *core_ptr)
 		    }
 
 		    /* Draw lights */
-		    SARDrawLights(
-			dc, obj_ptr->light, obj_ptr->total_lights
-		    );
+		    SARDrawLights(dc, obj_ptr);
 
 		    DISABLE_POLYGON_OFFSET_AS_NEEDED
 		    SAR_DRAW_POST_CALLLIST_RESET_STATES
@@ -7232,12 +7791,11 @@ void SARDraw(sar_core_struct *core_ptr)
 		/* Get direction */
 		dir = &obj_ptr->dir;
 
-		/* Do not push matrix to translate or rotate, the call
-		 * to SARDrawSmoke() will do that for us.
+		/* Add the smoke units to the particle batches, they
+		 * are drawn after all the objects
 		 */
 		if((obj_ptr->data != NULL) && opt->smoke_trails)
 		    SARDrawSmoke(dc, obj_ptr, SAR_OBJ_GET_SMOKE(obj_ptr));
-		SAR_DRAW_POST_CALLLIST_RESET_STATES
 		break;
 
 	      case SAR_OBJ_TYPE_FIRE:
@@ -7347,6 +7905,17 @@ void SARDraw(sar_core_struct *core_ptr)
 			break;
 		}
 
+		/* Is object outside of the view frustum? */
+		cull_radius = SARDrawObjectCullRadius(obj_ptr);
+		if((cull_radius >= 0.0f) &&
+		   !SARDrawFrustumSphereVisible(dc, pos, cull_radius)
+		)
+		    break;
+
+		/* Is object hidden behind the nearest buildings? */
+		if(SARDrawObjectOccluded(dc, obj_ptr, cull_radius))
+		    break;
+
 		/* Get direction */
 		dir = &obj_ptr->dir;
 
@@ -7382,9 +7951,7 @@ void SARDraw(sar_core_struct *core_ptr)
 		    );
 
 		    /* Draw lights */
-		    SARDrawLights(
-			dc, obj_ptr->light, obj_ptr->total_lights
-		    );
+		    SARDrawLights(dc, obj_ptr);
 
 		    SAR_DRAW_POST_CALLLIST_RESET_STATES
 		}
@@ -7411,6 +7978,17 @@ void SARDraw(sar_core_struct *core_ptr)
 			break;
 		}
 
+		/* Is object outside of the view frustum? */
+		cull_radius = SARDrawObjectCullRadius(obj_ptr);
+		if((cull_radius >= 0.0f) &&
+		   !SARDrawFrustumSphereVisible(dc, pos, cull_radius)
+		)
+		    break;
+
+		/* Is object hidden behind the nearest buildings? */
+		if(SARDrawObjectOccluded(dc, obj_ptr, cull_radius))
+		    break;
+
 		/* Get direction */
 		dir = &obj_ptr->dir;
 
@@ -7458,9 +8036,7 @@ void SARDraw(sar_core_struct *core_ptr)
 			}
 
 			/* Draw lights */
-			SARDrawLights(
-			    dc, obj_ptr->light, obj_ptr->total_lights
-			);
+			SARDrawLights(dc, obj_ptr);
 
 			DISABLE_POLYGON_OFFSET_AS_NEEDED
 			SAR_DRAW_POST_CALLLIST_RESET_STATES
@@ -7518,7 +8094,7 @@ void SARDraw(sar_core_struct *core_ptr)
 				if(dc->flir)
 				    SAR_DRAW_FLIR_COLOR_MASK_SET
 #endif
-				SARVisualModelCallList(obj_ptr->visual_model);
+				SARVisualModelCallList(SARDrawObjectLODModel(obj_ptr));
 				if(dc->flir)
 				    SAR_DRAW_COLOR_MASK_UNSET
 			    }
@@ -7589,9 +8165,7 @@ void SARDraw(sar_core_struct *core_ptr)
 			}
 
 			/* Draw lights */
-			SARDrawLights(
-			    dc, obj_ptr->light, obj_ptr->total_lights
-			);
+			SARDrawLights(dc, obj_ptr);
 
 			DISABLE_POLYGON_OFFSET_AS_NEEDED
 			SAR_DRAW_POST_CALLLIST_RESET_STATES
@@ -7602,6 +8176,26 @@ void SARDraw(sar_core_struct *core_ptr)
 	    }
 	}	/* Iterate through each object */
 
+	/* Draw the shadows of all the objects */
+	SAR_DRAW_DEPTH_TEST_ON
+	SARDrawShadowsDraw(
+	    &core_ptr->draw_shadows, state,
+	    (GLfloat)opt->gl_polygon_offset_factor
+	);
+
+	/* Draw the lights of all the objects */
+	SAR_DRAW_DEPTH_TEST_ON
+	StateGLDepthMask(state, GL_TRUE);
+	SARDrawLightsDraw(&core_ptr->draw_lights, state);
+
+	/* Draw the smoke puffs and sparks of all the smoke trail
+	 * objects
+	 */
+	SAR_DRAW_DEPTH_TEST_ON
+	StateGLDepthMask(state, GL_TRUE);
+	SARDrawParticlesDraw(&core_ptr->draw_particles, state);
+	SAR_DRAW_POST_CALLLIST_RESET_STATES
+
 
 	StateGLDisable(state, GL_FOG);
 
@@ -7673,12 +8267,14 @@ void SARDraw(sar_core_struct *core_ptr)
 	/* Put GL buffer to window */
 	GWSwapBuffer(display);
 
-	/* Report any errors */
+	/* Report any errors and the renderer's statistics */
 	if(opt->runtime_debug)
 	{
 	    GLenum error_code = glGetError();
 	    if(error_code != GL_NO_ERROR)
 		SARReportGLError(core_ptr, error_code);
+
+	    SARDrawReportStats(core_ptr);
 	}
 
 #undef ENABLE_POLYGON_OFFSET_AS_NEEDED
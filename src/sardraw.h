@@ -65,6 +65,14 @@ typedef struct {
 	sar_position_struct	camera_pos;
 	sar_direction_struct	camera_dir;
 
+	/* View frustum planes (left, right, bottom, top, near, and
+	 * far) in GL world coordinates, each plane is a, b, c, d
+	 * with a unit normal pointing into the frustum. Only valid
+	 * if frustum_valid is True, see SARDrawFrustumUpdate()
+	 */
+	GLfloat		frustum[6][4];
+	Boolean		frustum_valid;
+
 	float		map_dxm,	/* Map view visible size, in meters */
 			map_dym;
 
@@ -118,6 +126,7 @@ extern void SARDrawHuman(
 	sar_dc_struct *dc, sar_object_struct *obj_ptr,
 	sar_object_human_struct *human
 );
+extern void SARDrawHumanCacheClear(sar_human_data_struct *hd);
 
 /* sardrawrunway.c */
 extern void SARDrawRunway(
@@ -150,6 +159,15 @@ extern void SARDrawBoxBaseNS(
 	float x_len, float y_len, float z_len,
 	Boolean draw_base
 );
+extern void SARDrawFrustumUpdate(
+	sar_dc_struct *dc,
+	float fovz, float aspect,
+	float near_clip, float far_clip
+);
+extern Boolean SARDrawFrustumSphereVisible(
+	const sar_dc_struct *dc,
+	const sar_position_struct *pos, float radius
+);
 
 /* sardraw.c */
 extern void SARDraw(sar_core_struct *core_ptr);
@@ -33,6 +33,8 @@
 #include "config.h"
 
 
+static int SARDrawHelipadSurfaceBegin(sar_object_helipad_struct *helipad);
+static void SARDrawHelipadSurfaceEnd(sar_object_helipad_struct *helipad);
 static void SARDrawHelipadEdgeLighting(
 	sar_dc_struct *dc, sar_object_struct *obj_ptr,
 	sar_object_helipad_struct *helipad,
@@ -88,6 +90,58 @@ void SARDrawHelipadMap(
 static GLfloat edge_lighting_point_size = 1.0f;
 
 
+/*
+ *	Calls the GL display list of the helipad's landable area and
+ *	its sides, if it has not been recorded yet then recording is
+ *	started.
+ *
+ *	Returns 1 if the calling function needs to draw the landable
+ *	area and its sides followed by a call to
+ *	SARDrawHelipadSurfaceEnd() or 0 if the GL display list was
+ *	called.
+ *
+ *	The landable area and its sides may only be drawn with GL
+ *	commands and V3DTextureSelect(), no GL states may be set with
+ *	the StateGL*() functions while recording.
+ */
+static int SARDrawHelipadSurfaceBegin(sar_object_helipad_struct *helipad)
+{
+	GLuint list = (GLuint)helipad->surface_list;
+
+	if(list != 0)
+	{
+	    glCallList(list);
+	    V3DTextureInvalidate();
+	    return(0);
+	}
+
+	/* Record the GL display list while drawing, if it could not
+	 * be created then just draw
+	 */
+	list = glGenLists(1);
+	if(list != 0)
+	{
+	    V3DTextureInvalidate();
+	    glNewList(list, GL_COMPILE_AND_EXECUTE);
+	    helipad->surface_list = (unsigned int)list;
+	}
+
+	return(1);
+}
+
+/*
+ *	Ends the recording of the GL display list started by
+ *	SARDrawHelipadSurfaceBegin().
+ */
+static void SARDrawHelipadSurfaceEnd(sar_object_helipad_struct *helipad)
+{
+	if(helipad->surface_list == 0)
+	    return;
+
+	glEndList();
+	V3DTextureInvalidate();
+}
+
 /*
  *	Draws standard square edge lighting, a light in each corner.
  *
@@ -156,56 +210,64 @@ static void SARDrawHelipadPaved(
 	GLenum shade_model_mode = state->shade_model_mode;
 	const sar_option_struct *opt = dc->option;
 
-	/* Texture for landable area available? */
-	if(t == NULL)
-	{
-	    /* No texture available, unselect texture and set color
-	     * greyish.
-	     */
-	    V3DTextureSelect(NULL);
-	    glColor4f(0.6f, 0.6f, 0.6f, 1.0f);
-	}
-	else
-	{
-	    V3DTextureSelect(t);
-	    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	}
-
 	/* Set up gl states */
 	StateGLShadeModel(state, opt->gl_shade_model);
 
-	/* Draw main landable area */
-	glBegin(GL_QUADS);
+	/* Draw the landable area from the GL display list, recording
+	 * it the first time
+	 */
+	if(SARDrawHelipadSurfaceBegin(helipad))
 	{
-	    glNormal3f(-0.33f, 0.88f, -0.33f);
-	    glTexCoord2f(0.0f, 1.0f - 0.0f);
-	    glVertex3f(
-		x_min, z_max, -y_max
-	    );
+	    /* Texture for landable area available? */
+	    if(t == NULL)
+	    {
+		/* No texture available, unselect texture and set color
+		 * greyish.
+		 */
+		V3DTextureSelect(NULL);
+		glColor4f(0.6f, 0.6f, 0.6f, 1.0f);
+	    }
+	    else
+	    {
+		V3DTextureSelect(t);
+		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+	    }
 
-	    glNormal3f(-0.33f, 0.88f, 0.33f);
-	    glTexCoord2f(0.0f, 1.0f - 1.0f);
-	    glVertex3f(
-		x_min, z_max, -y_min
-	    );
+	    /* Draw main landable area */
+	    glBegin(GL_QUADS);
+	    {
+		glNormal3f(-0.33f, 0.88f, -0.33f);
+		glTexCoord2f(0.0f, 1.0f - 0.0f);
+		glVertex3f(
+		    x_min, z_max, -y_max
+		);
 
-	    glNormal3f(0.33f, 0.88f, 0.33f);
-	    glTexCoord2f(1.0f, 1.0f - 1.0f);
-	    glVertex3f(
-		x_max, z_max, -y_min
-	    );
+		glNormal3f(-0.33f, 0.88f, 0.33f);
+		glTexCoord2f(0.0f, 1.0f - 1.0f);
+		glVertex3f(
+		    x_min, z_max, -y_min
+		);
 
-	    glNormal3f(0.33f, 0.88f, -0.33f); 
-	    glTexCoord2f(1.0f, 1.0f - 0.0f);
-	    glVertex3f(
-		x_max, z_max, -y_max
-	    );
-	}
-	glEnd();
+		glNormal3f(0.33f, 0.88f, 0.33f);
+		glTexCoord2f(1.0f, 1.0f - 1.0f);
+		glVertex3f(
+		    x_max, z_max, -y_min
+		);
 
-	/* Unselect texture */
-	if(t != NULL)
-	    V3DTextureSelect(NULL);
+		glNormal3f(0.33f, 0.88f, -0.33f); 
+		glTexCoord2f(1.0f, 1.0f - 0.0f);
+		glVertex3f(
+		    x_max, z_max, -y_max
+		);
+	    }
+	    glEnd();
+
+	    /* Unselect texture */
+	    if(t != NULL)
+		V3DTextureSelect(NULL);
+
+	    SARDrawHelipadSurfaceEnd(helipad);
+	}
 
 	/* Draw label? */
 	if(helipad->label_vmodel != NULL)
@@ -267,56 +329,64 @@ static void SARDrawHelipadBare(
 	GLenum shade_model_mode = state->shade_model_mode;
 	const sar_option_struct *opt = dc->option;
 
-	/* Texture for landable area available? */
-	if(t == NULL)
-	{
-	    /* No texture available, unselect texture and set color
-	     * light beige.
-	     */
-	    V3DTextureSelect(NULL);
-	    glColor4f(0.75f, 0.72f, 0.62f, 1.0f);
-	}
-	else
-	{
-	    V3DTextureSelect(t);
-	    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	}
-
 	/* Set up gl states */
 	StateGLShadeModel(state, opt->gl_shade_model);
 
-	/* Draw main landable area */
-	glBegin(GL_QUADS);
+	/* Draw the landable area from the GL display list, recording
+	 * it the first time
+	 */
+	if(SARDrawHelipadSurfaceBegin(helipad))
 	{
-	    glNormal3f(-0.33f, 0.88f, -0.33f);
-	    glTexCoord2f(0.0f, 1.0f - 0.0f);
-	    glVertex3f(
-		x_min, z_max, -y_max
-	    );
+	    /* Texture for landable area available? */
+	    if(t == NULL)
+	    {
+		/* No texture available, unselect texture and set color
+		 * light beige.
+		 */
+		V3DTextureSelect(NULL);
+		glColor4f(0.75f, 0.72f, 0.62f, 1.0f);
+	    }
+	    else
+	    {
+		V3DTextureSelect(t);
+		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+	    }
 
-	    glNormal3f(-0.33f, 0.88f, 0.33f);
-	    glTexCoord2f(0.0f, 1.0f - 1.0f);
-	    glVertex3f(
-		x_min, z_max, -y_min
-	    );
+	    /* Draw main landable area */
+	    glBegin(GL_QUADS);
+	    {
+		glNormal3f(-0.33f, 0.88f, -0.33f);
+		glTexCoord2f(0.0f, 1.0f - 0.0f);
+		glVertex3f(
+		    x_min, z_max, -y_max
+		);
 
-	    glNormal3f(0.33f, 0.88f, 0.33f);
-	    glTexCoord2f(1.0f, 1.0f - 1.0f);
-	    glVertex3f(
-		x_max, z_max, -y_min
-	    );
+		glNormal3f(-0.33f, 0.88f, 0.33f);
+		glTexCoord2f(0.0f, 1.0f - 1.0f);
+		glVertex3f(
+		    x_min, z_max, -y_min
+		);
 
-	    glNormal3f(0.33f, 0.88f, -0.33f);
-	    glTexCoord2f(1.0f, 1.0f - 0.0f);
-	    glVertex3f(
-		x_max, z_max, -y_max
-	    );
-	}
-	glEnd();
+		glNormal3f(0.33f, 0.88f, 0.33f);
+		glTexCoord2f(1.0f, 1.0f - 1.0f);
+		glVertex3f(
+		    x_max, z_max, -y_min
+		);
 
-	/* Unselect texture */
-	if(t != NULL)
-	    V3DTextureSelect(NULL);
+		glNormal3f(0.33f, 0.88f, -0.33f);
+		glTexCoord2f(1.0f, 1.0f - 0.0f);
+		glVertex3f(
+		    x_max, z_max, -y_max
+		);
+	    }
+	    glEnd();
+
+	    /* Unselect texture */
+	    if(t != NULL)
+		V3DTextureSelect(NULL);
+
+	    SARDrawHelipadSurfaceEnd(helipad);
+	}
 
 	/* Draw label? */
 	if(helipad->label_vmodel != NULL)
@@ -378,137 +448,193 @@ static void SARDrawHelipadBuilding(
 	GLenum shade_model_mode = state->shade_model_mode;
 	const sar_option_struct *opt = dc->option;
 
-	V3DTextureSelect(NULL);
-
 	/* Set up gl states */
 	StateGLShadeModel(state, opt->gl_shade_model);
 
-	/* Draw recession struts as needed */
-	if(z_min < 0.0f)
+	/* Draw the landable area and its struts from the GL display
+	 * list, recording it the first time
+	 */
+	if(SARDrawHelipadSurfaceBegin(helipad))
 	{
-	  glColor4f(0.3f, 0.3f, 0.3f, 1.0f);
-
-	  glBegin(GL_QUADS);
-	  {
-	    float x[2], y[2], z[2], coeff = 0.6f;
-
-	    x[0] = x_min * coeff;
-	    x[1] = x_max * coeff;
-	    y[0] = y_min * coeff;
-	    y[1] = y_max * coeff;
-	    z[0] = z_min;
-	    z[1] = z_max;
-
-	    /* North */
-	    glNormal3f(0.0f, 0.0f, -1.0f);
-	    glVertex3f(x[1], z[1], -y[1]);
-	    glVertex3f(x[1], z[0], -y[1]);
-	    glVertex3f(x[0], z[0], -y[1]);
-	    glVertex3f(x[0], z[1], -y[1]);
-
-	    /* East */
-	    glNormal3f(1.0f, 0.0f, 0.0f);
-	    glVertex3f(x[1], z[1], -y[0]);
-	    glVertex3f(x[1], z[0], -y[0]);
-	    glVertex3f(x[1], z[0], -y[1]);
-	    glVertex3f(x[1], z[1], -y[1]);
-
-	    /* South */
-	    glNormal3f(0.0f, 0.0f, 1.0f);
-	    glVertex3f(x[0], z[1], -y[0]);
-	    glVertex3f(x[0], z[0], -y[0]);
-	    glVertex3f(x[1], z[0], -y[0]);  
-	    glVertex3f(x[1], z[1], -y[0]);  
-
-	    /* West */
-	    glNormal3f(-1.0f, 0.0f, 0.0f);
-	    glVertex3f(x[0], z[1], -y[1]);  
-	    glVertex3f(x[0], z[0], -y[1]);
-	    glVertex3f(x[0], z[0], -y[0]);
-	    glVertex3f(x[0], z[1], -y[0]);
-	  }
-	  glEnd();
-
-	  /* Ramp down to recession on south side (this will protrude
-	   * out of the helipad's bounds though.
-	   */
-	  glColor4f(0.75f, 0.75f, 0.75f, 1.0f);
-	  glBegin(GL_QUADS);
-	  {
-	    float coeff = 0.2f;	/* Of width */
-
-	    glNormal3f(0.0f, 0.7f, 0.7f);
-	    glVertex3f(
-		x_min * coeff,
-		z_max,
-		-(y_min * 0.9f)
-	    );
-	    glVertex3f(
-		x_min * coeff,
-		z_min,
-		-(y_min * 1.2f)
-	    );
-	    glVertex3f(
-		x_max * coeff,
-		z_min,
-		-(y_min * 1.2f)
-	    );
-	    glVertex3f(   
-		x_max * coeff,
-		z_max,
-		-(y_min * 0.9f)
-	    );
+	    V3DTextureSelect(NULL);
 
-	    glNormal3f(0.0f, 0.7f, -0.7f);
-	    glVertex3f(
-		x_min * coeff,
-		z_min,
-		-(y_max * 1.2f)
-	    );
-	    glVertex3f(
-		x_min * coeff,
-		z_max,
-		-(y_max * 0.9f)
-	    );
-	    glVertex3f(
-		x_max * coeff,
-		z_max,
-		-(y_max * 0.9f)
-	    );
-	    glVertex3f(
-		x_max * coeff,
-		z_min,
-		-(y_max * 1.2f)
-	    );
-	  }
-	  glEnd();
-	}
+	    /* Draw recession struts as needed */
+	    if(z_min < 0.0f)
+	    {
+	      glColor4f(0.3f, 0.3f, 0.3f, 1.0f);
+
+	      glBegin(GL_QUADS);
+	      {
+		float x[2], y[2], z[2], coeff = 0.6f;
+
+		x[0] = x_min * coeff;
+		x[1] = x_max * coeff;
+		y[0] = y_min * coeff;
+		y[1] = y_max * coeff;
+		z[0] = z_min;
+		z[1] = z_max;
+
+		/* North */
+		glNormal3f(0.0f, 0.0f, -1.0f);
+		glVertex3f(x[1], z[1], -y[1]);
+		glVertex3f(x[1], z[0], -y[1]);
+		glVertex3f(x[0], z[0], -y[1]);
+		glVertex3f(x[0], z[1], -y[1]);
+
+		/* East */
+		glNormal3f(1.0f, 0.0f, 0.0f);
+		glVertex3f(x[1], z[1], -y[0]);
+		glVertex3f(x[1], z[0], -y[0]);
+		glVertex3f(x[1], z[0], -y[1]);
+		glVertex3f(x[1], z[1], -y[1]);
+
+		/* South */
+		glNormal3f(0.0f, 0.0f, 1.0f);
+		glVertex3f(x[0], z[1], -y[0]);
+		glVertex3f(x[0], z[0], -y[0]);
+		glVertex3f(x[1], z[0], -y[0]);  
+		glVertex3f(x[1], z[1], -y[0]);  
+
+		/* West */
+		glNormal3f(-1.0f, 0.0f, 0.0f);
+		glVertex3f(x[0], z[1], -y[1]);  
+		glVertex3f(x[0], z[0], -y[1]);
+		glVertex3f(x[0], z[0], -y[0]);
+		glVertex3f(x[0], z[1], -y[0]);
+	      }
+	      glEnd();
+
+	      /* Ramp down to recession on south side (this will protrude
+	       * out of the helipad's bounds though.
+	       */
+	      glColor4f(0.75f, 0.75f, 0.75f, 1.0f);
+	      glBegin(GL_QUADS);
+	      {
+		float coeff = 0.2f;	/* Of width */
+
+		glNormal3f(0.0f, 0.7f, 0.7f);
+		glVertex3f(
+		    x_min * coeff,
+		    z_max,
+		    -(y_min * 0.9f)
+		);
+		glVertex3f(
+		    x_min * coeff,
+		    z_min,
+		    -(y_min * 1.2f)
+		);
+		glVertex3f(
+		    x_max * coeff,
+		    z_min,
+		    -(y_min * 1.2f)
+		);
+		glVertex3f(   
+		    x_max * coeff,
+		    z_max,
+		    -(y_min * 0.9f)
+		);
 
-	/* Draw underside of landable area if have recession */
-	if(z_min < 0.0f)
-	{
-	    GLboolean depth_mask_flag = state->depth_mask_flag;
-	    StateGLBoolean polygon_offset_fill = state->polygon_offset_fill;
+		glNormal3f(0.0f, 0.7f, -0.7f);
+		glVertex3f(
+		    x_min * coeff,
+		    z_min,
+		    -(y_max * 1.2f)
+		);
+		glVertex3f(
+		    x_min * coeff,
+		    z_max,
+		    -(y_max * 0.9f)
+		);
+		glVertex3f(
+		    x_max * coeff,
+		    z_max,
+		    -(y_max * 0.9f)
+		);
+		glVertex3f(
+		    x_max * coeff,
+		    z_min,
+		    -(y_max * 1.2f)
+		);
+	      }
+	      glEnd();
+	    }
 
+	    /* Draw underside of landable area if have recession */
+	    if(z_min < 0.0f)
+	    {
+		glColor4f(0.6f, 0.6f, 0.6f, 1.0f);
+		glBegin(GL_POLYGON);
+		{
+		    float theta;
+
+		    glNormal3f(0.0f, -1.0f, 0.0f);
+
+		    /* Draw a circular area, starting from 12 o'clock */
+		    for(theta = 0.0f; theta < 2.0f; theta += 0.1f)
+			glVertex3f(
+			    (float)(x_max * sin(theta * PI)),
+			    z_max,
+			    (float)-(y_max * cos(theta * PI))
+			);
+		}
+		glEnd();
+	    }
 
-	    glColor4f(0.6f, 0.6f, 0.6f, 1.0f);
+	    /* Texture for main landable area available? */
+	    if(t == NULL)
+	    {
+		/* No texture available, unselect texture and set color
+		 * light grey.
+		 */
+		glColor4f(0.84f, 0.84f, 0.84f, 1.0f);
+	    }
+	    else
+	    {
+		V3DTextureSelect(t);
+		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+	    }
+
+	    /* Draw main landable area */
 	    glBegin(GL_POLYGON);
 	    {
 		float theta;
 
-		glNormal3f(0.0f, -1.0f, 0.0f);
-
 		/* Draw a circular area, starting from 12 o'clock */
-		for(theta = 0.0f; theta < 2.0f; theta += 0.1f)
+		for(theta = 2.0f; theta > 0.0f; theta -= 0.1f)
+		{
+		    glNormal3f(
+			(float)(0.33 * sin(theta * PI)),
+			(float)0.88,
+			(float)-(0.33 * cos(theta * PI))
+		    );
+		    glTexCoord2f(
+			(float)((sin(theta * PI) + 1.0) / 2.0),
+			1.0f - (float)((cos(theta * PI) + 1.0) / 2.0)
+		    );
 		    glVertex3f(
 			(float)(x_max * sin(theta * PI)),
-			z_max,
+			(float)z_max,
 			(float)-(y_max * cos(theta * PI))
 		    );
+		}
 	    }
 	    glEnd();
 
-	    /* Shadow of helipad */
+	    /* Unselect texture */
+	    if(t != NULL)
+		V3DTextureSelect(NULL);
+
+	    SARDrawHelipadSurfaceEnd(helipad);
+	}
+
+	/* Draw shadow of helipad if have recession, it sets the
+	 * depth mask and polygon offset so it is not on the GL display
+	 * list
+	 */
+	if(z_min < 0.0f)
+	{
+	    GLboolean depth_mask_flag = state->depth_mask_flag;
+	    StateGLBoolean polygon_offset_fill = state->polygon_offset_fill;
 
 	    /* Set up gl states */
 	    StateGLDepthMask(state, GL_FALSE);
@@ -543,51 +669,6 @@ static void SARDrawHelipadBuilding(
 		StateGLDisable(state, GL_POLYGON_OFFSET_FILL);
 	}
 
-
-	/* Texture for main landable area available? */
-	if(t == NULL)
-	{
-	    /* No texture available, unselect texture and set color
-	     * light grey.
-	     */
-	    glColor4f(0.84f, 0.84f, 0.84f, 1.0f);
-	}
-	else
-	{
-	    V3DTextureSelect(t);
-	    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	}
-
-	/* Draw main landable area */
-	glBegin(GL_POLYGON);
-	{
-	    float theta;
-
-	    /* Draw a circular area, starting from 12 o'clock */
-	    for(theta = 2.0f; theta > 0.0f; theta -= 0.1f)
-	    {
-		glNormal3f(
-		    (float)(0.33 * sin(theta * PI)),
-		    (float)0.88,
-		    (float)-(0.33 * cos(theta * PI))
-		);
-		glTexCoord2f(
-		    (float)((sin(theta * PI) + 1.0) / 2.0),
-		    1.0f - (float)((cos(theta * PI) + 1.0) / 2.0)
-		);
-		glVertex3f(
-		    (float)(x_max * sin(theta * PI)),
-		    (float)z_max,
-		    (float)-(y_max * cos(theta * PI))
-		);
-	    }
-	}
-	glEnd();
-
-	/* Unselect texture */
-	if(t != NULL)
-	    V3DTextureSelect(NULL);
-
 	/* Draw label? */
 	if(helipad->label_vmodel != NULL)
 	{
@@ -680,274 +761,282 @@ static void SARDrawHelipadVehicle(
 	GLenum shade_model_mode = state->shade_model_mode;
 	const sar_option_struct *opt = dc->option;
 
-	V3DTextureSelect(NULL);
-
 	/* Set up gl states */
 	StateGLShadeModel(state, opt->gl_shade_model);
 
-	/* Draw recessed side walls */
-	glColor4f(0.6f, 0.6f, 0.6f, 1.0f);
-
-	glBegin(GL_QUADS);
+	/* Draw the landable area, side walls, and fence from the GL
+	 * display list, recording it the first time
+	 */
+	if(SARDrawHelipadSurfaceBegin(helipad))
 	{
-	    float x[2], y[2], z[2] /*, coeff = 0.4 */;
-
-	    x[0] = x_min;
-	    x[1] = x_max;
-	    y[0] = y_min;
-	    y[1] = y_max;
-	    z[0] = z_min;
-	    z[1] = z_max;
-
-	    /* North */
-	    glNormal3f(0.0f, 0.0f, -1.0f);
-	    glVertex3f(x[1], z[1], -y[1]);
-	    glVertex3f(x[1], z[0], -y[1]);
-	    glVertex3f(x[0], z[0], -y[1]);
-	    glVertex3f(x[0], z[1], -y[1]);
-
-	    /* East */
-	    glNormal3f(1.0f, 0.0f, 0.0f);
-	    glVertex3f(x[1], z[1], -y[0]);
-	    glVertex3f(x[1], z[0], -y[0]);
-	    glVertex3f(x[1], z[0], -y[1]);
-	    glVertex3f(x[1], z[1], -y[1]);
-
-	    /* South */
-	    glNormal3f(0.0f, 0.0f, 1.0f);
-	    glVertex3f(x[0], z[1], -y[0]);
-	    glVertex3f(x[0], z[0], -y[0]);
-	    glVertex3f(x[1], z[0], -y[0]);
-	    glVertex3f(x[1], z[1], -y[0]);
-
-	    /* West */
-	    glNormal3f(-1.0f, 0.0f, 0.0f);
-	    glVertex3f(x[0], z[1], -y[1]);
-	    glVertex3f(x[0], z[0], -y[1]);
-	    glVertex3f(x[0], z[0], -y[0]);
-	    glVertex3f(x[0], z[1], -y[0]);
+	    V3DTextureSelect(NULL);
 
-#if 0
-	    /* Lower struts */
-	    glColor4f(0.3f, 0.3f, 0.3f, 1.0f);
-
-	    coeff = 0.9f;
-	    x[0] = x_min * coeff;
-	    x[1] = x_max * coeff;
-	    y[0] = y_min * coeff;
-	    y[1] = y_max * coeff;
-	    z[0] = z_min;
-	    z[1] = z_max;
-
-	    /* North */
-	    glNormal3f(0.0f, 0.0f, -1.0f);
-	    glVertex3f(x[1], z[1], -y[1]);
-	    glVertex3f(x[1], z[0], -y[1]);
-	    glVertex3f(x[0], z[0], -y[1]);
-	    glVertex3f(x[0], z[1], -y[1]);
-	 
-	    /* East */
-	    glNormal3f(1.0f, 0.0f, 0.0f);
-	    glVertex3f(x[1], z[1], -y[0]);
-	    glVertex3f(x[1], z[0], -y[0]);
-	    glVertex3f(x[1], z[0], -y[1]);
-	    glVertex3f(x[1], z[1], -y[1]);  
-
-	    /* South */
-	    glNormal3f(0.0f, 0.0f, 1.0f);
-	    glVertex3f(x[0], z[1], -y[0]);
-	    glVertex3f(x[0], z[0], -y[0]);
-	    glVertex3f(x[1], z[0], -y[0]);
-	    glVertex3f(x[1], z[1], -y[0]);
-
-	    /* West */
-	    glNormal3f(-1.0f, 0.0f, 0.0f);
-	    glVertex3f(x[0], z[1], -y[1]);
-	    glVertex3f(x[0], z[0], -y[1]);
-	    glVertex3f(x[0], z[0], -y[0]);
-	    glVertex3f(x[0], z[1], -y[0]);
-#endif
-	}
-	glEnd();
+	    /* Draw recessed side walls */
+	    glColor4f(0.6f, 0.6f, 0.6f, 1.0f);
 
+	    glBegin(GL_QUADS);
+	    {
+		float x[2], y[2], z[2] /*, coeff = 0.4 */;
+
+		x[0] = x_min;
+		x[1] = x_max;
+		y[0] = y_min;
+		y[1] = y_max;
+		z[0] = z_min;
+		z[1] = z_max;
+
+		/* North */
+		glNormal3f(0.0f, 0.0f, -1.0f);
+		glVertex3f(x[1], z[1], -y[1]);
+		glVertex3f(x[1], z[0], -y[1]);
+		glVertex3f(x[0], z[0], -y[1]);
+		glVertex3f(x[0], z[1], -y[1]);
+
+		/* East */
+		glNormal3f(1.0f, 0.0f, 0.0f);
+		glVertex3f(x[1], z[1], -y[0]);
+		glVertex3f(x[1], z[0], -y[0]);
+		glVertex3f(x[1], z[0], -y[1]);
+		glVertex3f(x[1], z[1], -y[1]);
+
+		/* South */
+		glNormal3f(0.0f, 0.0f, 1.0f);
+		glVertex3f(x[0], z[1], -y[0]);
+		glVertex3f(x[0], z[0], -y[0]);
+		glVertex3f(x[1], z[0], -y[0]);
+		glVertex3f(x[1], z[1], -y[0]);
+
+		/* West */
+		glNormal3f(-1.0f, 0.0f, 0.0f);
+		glVertex3f(x[0], z[1], -y[1]);
+		glVertex3f(x[0], z[0], -y[1]);
+		glVertex3f(x[0], z[0], -y[0]);
+		glVertex3f(x[0], z[1], -y[0]);
 
 #if 0
-	/* Ramp down to recession on north and south side (this will
-	 * protrude out of the helipad's bounds).
-	 */
-	glColor4f(0.7f, 0.7f, 0.7f, 1.0f);
-	glBegin(GL_QUADS);
-	{
-	    float coeff = 0.2f;		/* Of width */
-
-	    glNormal3f(0.0f, 0.7f, 0.7f);
-	    glVertex3f(
-		x_min * coeff,
-		z_max,
-		-y_min
-	    );
-	    glVertex3f(
-		x_min * coeff,
-		z_min,
-		-(y_min * 1.1f)
-	    );
-	    glVertex3f(   
-		x_max * coeff,
-		z_min,
-		-(y_min * 1.1f)
-	    );
-	    glVertex3f(
-		x_max * coeff,
-		z_max,
-		-(y_min)
-	    );
-
-	    glNormal3f(0.0f, 0.7f, -0.7f);
-	    glVertex3f(
-		x_min * coeff,
-		z_min,
-		-(y_max * 1.1f)
-	    );
-	    glVertex3f(
-		x_min * coeff,
-		z_max,
-		-(y_max * 1.0f)
-	    );
-	    glVertex3f(
-		x_max * coeff,
-		z_max,
-		-(y_max * 1.0f)
-	    );
-	    glVertex3f(
-		x_max * coeff,
-		z_min,
-		-(y_max * 1.1f)
-	    );
-	}
-	glEnd();
+		/* Lower struts */
+		glColor4f(0.3f, 0.3f, 0.3f, 1.0f);
+
+		coeff = 0.9f;
+		x[0] = x_min * coeff;
+		x[1] = x_max * coeff;
+		y[0] = y_min * coeff;
+		y[1] = y_max * coeff;
+		z[0] = z_min;
+		z[1] = z_max;
+
+		/* North */
+		glNormal3f(0.0f, 0.0f, -1.0f);
+		glVertex3f(x[1], z[1], -y[1]);
+		glVertex3f(x[1], z[0], -y[1]);
+		glVertex3f(x[0], z[0], -y[1]);
+		glVertex3f(x[0], z[1], -y[1]);
+	 
+		/* East */
+		glNormal3f(1.0f, 0.0f, 0.0f);
+		glVertex3f(x[1], z[1], -y[0]);
+		glVertex3f(x[1], z[0], -y[0]);
+		glVertex3f(x[1], z[0], -y[1]);
+		glVertex3f(x[1], z[1], -y[1]);  
+
+		/* South */
+		glNormal3f(0.0f, 0.0f, 1.0f);
+		glVertex3f(x[0], z[1], -y[0]);
+		glVertex3f(x[0], z[0], -y[0]);
+		glVertex3f(x[1], z[0], -y[0]);
+		glVertex3f(x[1], z[1], -y[0]);
+
+		/* West */
+		glNormal3f(-1.0f, 0.0f, 0.0f);
+		glVertex3f(x[0], z[1], -y[1]);
+		glVertex3f(x[0], z[0], -y[1]);
+		glVertex3f(x[0], z[0], -y[0]);
+		glVertex3f(x[0], z[1], -y[0]);
 #endif
+	    }
+	    glEnd();
 
 
-	/* Texture for landable area available? */
-	if(t == NULL)
-	{
-	    /* No texture available, unselect texture and set color
-	     * light grey.
+#if 0
+	    /* Ramp down to recession on north and south side (this will
+	     * protrude out of the helipad's bounds).
 	     */
-	    V3DTextureSelect(NULL);
-	    glColor4f(0.84f, 0.84f, 0.84f, 1.0f);
-	}
-	else
-	{
-	    V3DTextureSelect(t);
-	    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	}
-
-	/* Draw main landable area */
-	glBegin(GL_QUADS);
-	{
-	    glNormal3f(-0.33f, 0.88f, -0.33f);
-	    glTexCoord2f(0.0f, 1.0f - 0.0f);
-	    glVertex3f(
-		x_min, z_max, -y_max
-	    );
-
-	    glNormal3f(-0.33f, 0.88f, 0.33f);
-	    glTexCoord2f(0.0f, 1.0f - 1.0f);
-	    glVertex3f(
-		x_min, z_max, -y_min
-	    );
-
-	    glNormal3f(0.33f, 0.88f, 0.33f);
-	    glTexCoord2f(1.0f, 1.0f - 1.0f);
-	    glVertex3f(
-		x_max, z_max, -y_min
-	    );
-
-	    glNormal3f(0.33f, 0.88f, -0.33f);
-	    glTexCoord2f(1.0f, 1.0f - 0.0f);
-	    glVertex3f(
-		x_max, z_max, -y_max
-	    );
-	}
-	glEnd();
-
-	/* Unselect texture */
-	if(t != NULL)
-	    V3DTextureSelect(NULL);
-
-	/* Draw fence */
-	if(1)
-	{
-	    float coeff = 1.1f, zabove = z_max + 0.8f;
-
-	    glColor4f(0.3f, 0.3f, 0.3f, 1.0f);
-
-	    /* East fence */
-	    glBegin(GL_LINE_LOOP);
+	    glColor4f(0.7f, 0.7f, 0.7f, 1.0f);
+	    glBegin(GL_QUADS);
 	    {
-		glNormal3f(0.33f, 0.88f, -0.33f);
+		float coeff = 0.2f;		/* Of width */
+
+		glNormal3f(0.0f, 0.7f, 0.7f);
+		glVertex3f(
+		    x_min * coeff,
+		    z_max,
+		    -y_min
+		);
 		glVertex3f(
+		    x_min * coeff,
+		    z_min,
+		    -(y_min * 1.1f)
+		);
+		glVertex3f(   
 		    x_max * coeff,
-		    zabove,
-		    -(y_min * coeff)
+		    z_min,
+		    -(y_min * 1.1f)
 		);
-
-		glNormal3f(0.33f, 0.88f, 0.33f);
 		glVertex3f(
 		    x_max * coeff,
-		    zabove,
-		    -(y_max * coeff)
+		    z_max,
+		    -(y_min)
 		);
 
-		glNormal3f(-0.33f, 0.88f, 0.33f);
+		glNormal3f(0.0f, 0.7f, -0.7f);
+		glVertex3f(
+		    x_min * coeff,
+		    z_min,
+		    -(y_max * 1.1f)
+		);
 		glVertex3f(
-		    x_max,
+		    x_min * coeff,
 		    z_max,
-		    -(y_max)
+		    -(y_max * 1.0f)
 		);
-
-		glNormal3f(-0.33f, 0.88f, -0.33f);
 		glVertex3f(
-		    x_max,
+		    x_max * coeff,
 		    z_max,
-		    -(y_min)
+		    -(y_max * 1.0f)
+		);
+		glVertex3f(
+		    x_max * coeff,
+		    z_min,
+		    -(y_max * 1.1f)
 		);
 	    }
 	    glEnd();
+#endif
+
+
+	    /* Texture for landable area available? */
+	    if(t == NULL)
+	    {
+		/* No texture available, unselect texture and set color
+		 * light grey.
+		 */
+		V3DTextureSelect(NULL);
+		glColor4f(0.84f, 0.84f, 0.84f, 1.0f);
+	    }
+	    else
+	    {
+		V3DTextureSelect(t);
+		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+	    }
 
-	    /* West fence */
-	    glBegin(GL_LINE_LOOP);
+	    /* Draw main landable area */
+	    glBegin(GL_QUADS);
 	    {
 		glNormal3f(-0.33f, 0.88f, -0.33f);
+		glTexCoord2f(0.0f, 1.0f - 0.0f);
 		glVertex3f(
-		    x_min * coeff,
-		    zabove,
-		    -(y_max * coeff)
+		    x_min, z_max, -y_max
 		);
 
 		glNormal3f(-0.33f, 0.88f, 0.33f);
-		glVertex3f(   
-		    x_min * coeff,
-		    zabove,
-		    -(y_min * coeff)
+		glTexCoord2f(0.0f, 1.0f - 1.0f);
+		glVertex3f(
+		    x_min, z_max, -y_min
 		);
 
 		glNormal3f(0.33f, 0.88f, 0.33f);
+		glTexCoord2f(1.0f, 1.0f - 1.0f);
 		glVertex3f(
-		    x_min,
-		    z_max,
-		    -(y_min)
+		    x_max, z_max, -y_min
 		);
 
 		glNormal3f(0.33f, 0.88f, -0.33f);
+		glTexCoord2f(1.0f, 1.0f - 0.0f);
 		glVertex3f(
-		    x_min,
-		    z_max,
-		    -(y_max)
+		    x_max, z_max, -y_max
 		);
 	    }
 	    glEnd();
+
+	    /* Unselect texture */
+	    if(t != NULL)
+		V3DTextureSelect(NULL);
+
+	    /* Draw fence */
+	    if(1)
+	    {
+		float coeff = 1.1f, zabove = z_max + 0.8f;
+
+		glColor4f(0.3f, 0.3f, 0.3f, 1.0f);
+
+		/* East fence */
+		glBegin(GL_LINE_LOOP);
+		{
+		    glNormal3f(0.33f, 0.88f, -0.33f);
+		    glVertex3f(
+			x_max * coeff,
+			zabove,
+			-(y_min * coeff)
+		    );
+
+		    glNormal3f(0.33f, 0.88f, 0.33f);
+		    glVertex3f(
+			x_max * coeff,
+			zabove,
+			-(y_max * coeff)
+		    );
+
+		    glNormal3f(-0.33f, 0.88f, 0.33f);
+		    glVertex3f(
+			x_max,
+			z_max,
+			-(y_max)
+		    );
+
+		    glNormal3f(-0.33f, 0.88f, -0.33f);
+		    glVertex3f(
+			x_max,
+			z_max,
+			-(y_min)
+		    );
+		}
+		glEnd();
+
+		/* West fence */
+		glBegin(GL_LINE_LOOP);
+		{
+		    glNormal3f(-0.33f, 0.88f, -0.33f);
+		    glVertex3f(
+			x_min * coeff,
+			zabove,
+			-(y_max * coeff)
+		    );
+
+		    glNormal3f(-0.33f, 0.88f, 0.33f);
+		    glVertex3f(   
+			x_min * coeff,
+			zabove,
+			-(y_min * coeff)
+		    );
+
+		    glNormal3f(0.33f, 0.88f, 0.33f);
+		    glVertex3f(
+			x_min,
+			z_max,
+			-(y_min)
+		    );
+
+		    glNormal3f(0.33f, 0.88f, -0.33f);
+		    glVertex3f(
+			x_min,
+			z_max,
+			-(y_max)
+		    );
+		}
+		glEnd();
+	    }
+
+	    SARDrawHelipadSurfaceEnd(helipad);
 	}
 
 	/* Draw label? */
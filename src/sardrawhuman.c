@@ -15,6 +15,8 @@
 ***********************************************************************/
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 
 #ifdef __MSW__
@@ -27,12 +29,67 @@
 #include "stategl.h"
 #include "obj.h"
 #include "objutils.h"
+#include "human.h"
 #include "sar.h"
 #include "sardraw.h"
 #include "sardrawdefs.h"
 #include "config.h"
 
 
+/*
+ *	Human Pose:
+ *
+ *	Appendage lengths and rotations of one human body, all
+ *	zero radians indicates standing upright with hands to side.
+ */
+typedef struct {
+
+	float		thigh_len,
+			calf_len,
+			foot_height,
+			foot_length,
+			torso_len,
+			bisep_len,
+			trisep_len,
+			base_to_torso,		/* Ground to bottom of torso */
+			stretcher_height;	/* Ground to bed of stretcher */
+
+	float		height_coef,		/* Height / standard height */
+			width_coef,		/* Body width by mass */
+			thick_coef;		/* Body thickness by mass */
+
+	float		torso_angle,
+			left_bisep_angle, right_bisep_angle,
+			left_shoulder_angle, right_shoulder_angle,
+			left_trisep_angle, right_trisep_angle,
+			left_hip_to_thigh_angle, right_hip_to_thigh_angle,
+			left_knee_to_calv_angle, right_knee_to_calv_angle;
+
+} sar_draw_human_pose_struct;
+
+
+static void SARDrawHumanBody(
+	sar_dc_struct *dc,
+	sar_human_flags flags,
+	const sar_color_struct *palette,
+	const sar_draw_human_pose_struct *pose
+);
+static void SARDrawHumanCacheFlush(sar_human_data_struct *hd);
+static void SARDrawHumanBodyList(
+	sar_dc_struct *dc,
+	float height, float mass,
+	sar_human_flags flags,
+	const sar_color_struct *palette,
+	int anim_frame,
+	const sar_draw_human_pose_struct *pose
+);
+void SARDrawHumanCacheClear(sar_human_data_struct *hd);
+static void SARDrawHumanImpostor(
+	sar_dc_struct *dc,
+	float height, float mass,
+	const sar_color_struct *palette,
+	float heading
+);
 void SARDrawHumanIterate(
 	sar_dc_struct *dc,
 	float height, float mass,
@@ -48,67 +105,46 @@ void SARDrawHuman(
 
 
 /*
- *	Called by SARDrawHuman() to draw one human.
+ *	Draws the body of one human (and its stretcher) in the given
+ *	pose.
+ *
+ *	Only GL primitives, colors, and matrix operations are issued
+ *	(no GL state changes) so that the body can be recorded into a
+ *	GL list.
  *
  *	All inputs assumed valid.
  */
-void SARDrawHumanIterate(
+static void SARDrawHumanBody(
 	sar_dc_struct *dc,
-	float height, float mass,
 	sar_human_flags flags,
-	const sar_color_struct *palette,	/* Human colors */
-	int water_ripple_tex_num,
-	sar_grad_anim_t anim_pos
+	const sar_color_struct *palette,
+	const sar_draw_human_pose_struct *pose
 )
 {
-	gw_display_struct *display = dc->display;
-	state_gl_struct *state = &display->state_gl;
-	const sar_option_struct *opt = dc->option;
-	sar_scene_struct *scene = dc->scene;
-	StateGLBoolean lighting = state->lighting;
-	GLenum shade_model_mode = state->shade_model_mode;
-	StateGLBoolean texture_2d_state = state->texture_2d;
-	float anim_coeff = (float)anim_pos /
-	    (float)((sar_grad_anim_t)-1);
-
-	float torso_angle;
-	float left_bisep_angle, right_bisep_angle;
-	float left_shoulder_angle, right_shoulder_angle;
-	float left_trisep_angle, right_trisep_angle;
-	float left_hip_to_thigh_angle, right_hip_to_thigh_angle;
-	float left_knee_to_calv_angle, right_knee_to_calv_angle;
-
-	float thigh_len = 0.3f;
-	float calf_len = 0.4f;
-	float foot_height = 0.08f;
-	float foot_length;
-	float torso_len = 0.8f;
-	float bisep_len = 0.3f;
-	float trisep_len = 0.4f;
-	float base_to_torso = 0.0f;	/* Ground to bottom of torso
-					 * (calculated later).
-					 */
-	float stretcher_height = 0.8f;	/* Ground to bed of stretcher. */
-
+	const float	thigh_len = pose->thigh_len,
+			calf_len = pose->calf_len,
+			foot_height = pose->foot_height,
+			foot_length = pose->foot_length,
+			torso_len = pose->torso_len,
+			bisep_len = pose->bisep_len,
+			trisep_len = pose->trisep_len,
+			base_to_torso = pose->base_to_torso,
+			stretcher_height = pose->stretcher_height,
+			height_coef = pose->height_coef,
+			width_coef = pose->width_coef,
+			thick_coef = pose->thick_coef;
+	const float	torso_angle = pose->torso_angle,
+			left_bisep_angle = pose->left_bisep_angle,
+			right_bisep_angle = pose->right_bisep_angle,
+			left_shoulder_angle = pose->left_shoulder_angle,
+			right_shoulder_angle = pose->right_shoulder_angle,
+			left_trisep_angle = pose->left_trisep_angle,
+			right_trisep_angle = pose->right_trisep_angle,
+			left_hip_to_thigh_angle = pose->left_hip_to_thigh_angle,
+			right_hip_to_thigh_angle = pose->right_hip_to_thigh_angle,
+			left_knee_to_calv_angle = pose->left_knee_to_calv_angle,
+			right_knee_to_calv_angle = pose->right_knee_to_calv_angle;
 	const sar_color_struct *c;
-	Boolean draw_shadow_std = False;
-
-	/* Body segments length depends of human total height */
-	float height_coef = height / 1.9f; // SarII standard human height is 1.9m
-	thigh_len   *= height_coef;
-	calf_len    *= height_coef;
-	foot_height *= height_coef;
-	foot_length = 1.90f * 0.13f * height_coef;
-	torso_len   *= height_coef;
-	bisep_len   *= height_coef;
-	trisep_len  *= height_coef;
-
-	/* Body width and thick depends of human mass: let's consider
-	 * that standard is 1.9m / 90kg => BMI is ~25.
-	 */
-	float bmi = mass / (height * height);
-	float width_coef = (bmi * 0.66f) / 25;
-	float thick_coef = (bmi * 1.2f) / 25;
 
 /* Macro to set the color pointed to by c.  The color must be specifying
  * a color on the human's body, because dc->flir will be checked and if
@@ -122,338 +158,54 @@ void SARDrawHumanIterate(
  glColor4f(c->r, c->g, c->b, c->a);			\
 } }
 
-	/* Set up gl states. */
-	if(dc->flir)
-	    StateGLDisable(state, GL_LIGHTING);
-	StateGLDisable(state, GL_TEXTURE_2D);
-	V3DTextureSelect(NULL);
-	StateGLShadeModel(state, GL_SMOOTH);
-
-	/* Calculate angles of body parts. Note that all zero radians
-	 * indicates human is standing upright with hands to side.
-	 */
-	if(flags & SAR_HUMAN_FLAG_LYING)
+	/* Draw stretcher? */
+	if(flags & SAR_HUMAN_FLAG_ON_STRETCHER)
 	{
-	    torso_angle = (float)(1.5 * PI);
-	    left_shoulder_angle = (float)(0.0 * PI);
-	    right_shoulder_angle = (float)(0.0 * PI);
-	    left_bisep_angle = (float)(0.0 * PI);
-	    right_bisep_angle = (float)(0.0 * PI);
-	    left_trisep_angle = (float)(0.0 * PI);
-	    right_trisep_angle = (float)(0.0 * PI);
-	    left_hip_to_thigh_angle = (float)(0.0 * PI);
-	    right_hip_to_thigh_angle = (float)(0.0 * PI);
-	    left_knee_to_calv_angle = (float)(0.0 * PI);
-	    right_knee_to_calv_angle = (float)(0.0 * PI);
+	    float x = 0.35f, y = 1.05f;
+	    float h = stretcher_height - 0.1f, hl = 0.1f;
 
-	    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
+	    glColor4f(0.8f, 0.8f, 0.8f, 1.0f);
 
-	    if(flags & SAR_HUMAN_FLAG_ON_STRETCHER)
+	    /* Bed of stretcher. */
+	    glBegin(GL_QUADS);
 	    {
-		/* Some translating will be done later. */
-	    }
-	}
-	else if(flags & SAR_HUMAN_FLAG_SIT)
-	{
-	    /* Sitting base at tush. */
-	    torso_angle = (float)(0.0 * PI);
-	    left_shoulder_angle = (float)(0.0 * PI);
-	    right_shoulder_angle = (float)(0.0 * PI);
-	    left_bisep_angle = (float)(0.0 * PI);
-	    right_bisep_angle = (float)(0.0 * PI);
-	    left_trisep_angle = (float)(1.75 * PI);
-	    right_trisep_angle = (float)(1.75 * PI);
-	    left_hip_to_thigh_angle = (float)(1.5 * PI);
-	    right_hip_to_thigh_angle = (float)(1.5 * PI);
-	    left_knee_to_calv_angle = (float)(0.5 * PI);
-	    right_knee_to_calv_angle = (float)(0.5 * PI);
-
-	    base_to_torso = 0.0f;
-	}
-	else if(flags & SAR_HUMAN_FLAG_SIT_DOWN)
-	{
-	    torso_angle = (float)(0.0 * PI);
-	    left_shoulder_angle = (float)(0.0 * PI);
-	    right_shoulder_angle = (float)(0.0 * PI);
-	    left_bisep_angle = (float)(0.0 * PI);
-	    right_bisep_angle = (float)(0.0 * PI);
-	    left_trisep_angle = (float)(1.75 * PI);
-	    right_trisep_angle = (float)(1.75 * PI);
-	    left_hip_to_thigh_angle = (float)(1.5 * PI);
-	    right_hip_to_thigh_angle = (float)(1.5 * PI);
-	    left_knee_to_calv_angle = (float)(0.0 * PI);
-	    right_knee_to_calv_angle = (float)(0.0 * PI);
-
-	    base_to_torso = 0.0f;
-	}
-	else if(flags & SAR_HUMAN_FLAG_SIT_UP)
-	{
-	    /* Sitting base at feet. */
-	    torso_angle = (float)(0.0 * PI);
-	    left_shoulder_angle = (float)(0.0 * PI);
-	    right_shoulder_angle = (float)(0.0 * PI);
-	    left_bisep_angle = (float)(0.0 * PI);
-	    right_bisep_angle = (float)(0.0 * PI);
-	    left_trisep_angle = (float)(1.75 * PI);
-	    right_trisep_angle = (float)(1.75 * PI);
-	    left_hip_to_thigh_angle = (float)(1.5 * PI);
-	    right_hip_to_thigh_angle = (float)(1.5 * PI);
-	    left_knee_to_calv_angle = (float)(0.5 * PI);
-	    right_knee_to_calv_angle = (float)(0.5 * PI);
+		glNormal3f(0.0f, 1.0f, 0.0f);
+		glVertex3f(x, h, -y);
+		glVertex3f(-x, h, -y);
+		glVertex3f(-x, h, y);
+		glVertex3f(x, h, y);
 
-	    base_to_torso = calf_len + foot_height * height_coef;
-	}
-	else if(flags & SAR_HUMAN_FLAG_DIVER_CATCHER)
-	{
-	    /* Diver catching victim, used for hoist rescue end drawing. */
-	    torso_angle = (float)(0.0 * PI);
-	    left_shoulder_angle = (float)(0.1 * PI);
-	    right_shoulder_angle = (float)(1.9 * PI);
-	    left_bisep_angle = (float)(1.8 * PI);
-	    right_bisep_angle = (float)(1.8 * PI);
-	    left_trisep_angle = (float)(1.8 * PI);
-	    right_trisep_angle = (float)(1.8 * PI);
-	    left_hip_to_thigh_angle = (float)(1.9 * PI);
-	    right_hip_to_thigh_angle = (float)(1.9 * PI);
-	    left_knee_to_calv_angle = (float)(0.2 * PI);
-	    right_knee_to_calv_angle = (float)(0.2 * PI);
+		glNormal3f(0.0f, -1.0f, 0.0f);
+		glVertex3f(-x, h, -y);
+		glVertex3f(x, h, -y);
+		glVertex3f(x, h, y);
+		glVertex3f(-x, h, y);
+	    }
+	    glEnd();
 
-	    /* If gripped it implies on end of rescue hoist rope. */
-	    if(flags & SAR_HUMAN_FLAG_GRIPPED)
-		base_to_torso = torso_len;
-	    else if(flags & SAR_HUMAN_FLAG_IN_WATER)
-		base_to_torso = torso_len * -0.92f;
-	    else
-		base_to_torso = thigh_len + calf_len + foot_height * height_coef;
-	}
-	/* Run should be checked last since lying and setting have
-	 * precidence.
-	 */
-	else if(flags & SAR_HUMAN_FLAG_RUN)
-	{
-	    if(anim_coeff > 0.5f)
-		anim_coeff = (1.0f - anim_coeff) / 0.5f;
-	    else
-		anim_coeff = anim_coeff / 0.5f;
+	    glColor4f(0.7f, 0.7f, 0.7f, 1.0f);
 
-	    torso_angle = (float)(0.1 * PI);
-	    left_shoulder_angle = (float)(0.0 * PI);
-	    right_shoulder_angle = (float)(0.0 * PI);
-	    if(flags & SAR_HUMAN_FLAG_PUSHING)
+	    /* Left grids. */
+	    glBegin(GL_LINE_LOOP);
 	    {
-		left_bisep_angle = (float)(1.7 * PI);
-		right_bisep_angle = (float)(1.7 * PI);
-		left_trisep_angle = (float)(1.6 * PI);
-		right_trisep_angle = (float)(1.6 * PI);
+		glNormal3f(-1.0f, 0.0f, 0.0f);
+		glVertex3f(-x, hl, -y);
+		glVertex3f(-x, h, y);
+		glVertex3f(-x, hl, y);
+		glVertex3f(-x, h, -y);
 	    }
-	    else
+	    glEnd();
+
+	    /* Right grids. */
+	    glBegin(GL_LINE_LOOP);
 	    {
-		left_bisep_angle = (float)(
-		    (1.7 + (0.35 * (1.0 - anim_coeff))) * PI
-		);
-		right_bisep_angle = (float)(
-		    (1.7 + (0.35 * anim_coeff)) * PI
-		);
-		left_trisep_angle = (float)(
-		    (1.6 + (0.15 * (1.0 - anim_coeff))) * PI
-		);
-		right_trisep_angle = (float)(
-		    (1.6 + (0.15 * anim_coeff)) * PI
-		);
+		glNormal3f(1.0, 0.0, 0.0);
+		glVertex3f(x, hl, -y);
+		glVertex3f(x, h, y);
+		glVertex3f(x, hl, y);
+		glVertex3f(x, h, -y);
 	    }
-	    left_hip_to_thigh_angle = (float)(
-		(0.2 - (0.5 * anim_coeff)) * PI
-	    );
-	    right_hip_to_thigh_angle = (float)(
-		(0.2 - (0.5 * (1.0 - anim_coeff))) * PI
-	    );
-	    left_knee_to_calv_angle = (float)(0.2 * PI);
-	    right_knee_to_calv_angle = (float)(0.2 * PI);
-
-	    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
-
-	    draw_shadow_std = True;
-	}
-	/* All else assume just standing. */
-	else
-	{
-	    /* Standing in water? */
-	    if(flags & SAR_HUMAN_FLAG_IN_WATER)
-	    {
-		/* Standing in water, arms fore and moving. */
-		if(anim_coeff > 0.5f)
-		    anim_coeff = (float)((1.0 - anim_coeff) / 0.5);
-		else
-		    anim_coeff = (float)(anim_coeff / 0.5);
-
-		torso_angle = (float)(0.0 * PI);
-		left_shoulder_angle = (float)((0.4 * anim_coeff) * PI);
-		right_shoulder_angle = (float)((2 - (0.4 * anim_coeff)) * PI);
-		left_bisep_angle = (float)(1.5 * PI);
-		right_bisep_angle = (float)(1.5 * PI);
-		left_trisep_angle = (float)(0.0 * PI);
-		right_trisep_angle = (float)(0.0 * PI);
-		left_hip_to_thigh_angle = (float)(0.0 * PI);
-		right_hip_to_thigh_angle = (float)(0.0 * PI);
-		left_knee_to_calv_angle = (float)(0.0 * PI);
-		right_knee_to_calv_angle = (float)(0.0 * PI);
-
-		/* Since in water, move torso down. */
-		base_to_torso = torso_len * -0.92f;
-	    }
-	    else
-	    {
-		/* Standing on ground and aware? */
-		if(((flags & SAR_HUMAN_FLAG_NEED_RESCUE) &&
-		    (flags & SAR_HUMAN_FLAG_AWARE)) ||
-		   (flags & SAR_HUMAN_FLAG_ALERT)
-		)
-		{
-		    /* Need rescue and aware that rescuer is
-		     * near by, move arms fore and wave.
-		     */
-		    /* As well if we just want to alert */
-		    if(anim_coeff > 0.5f)
-			anim_coeff = (float)((1.0 - anim_coeff) / 0.5);
-		    else
-			anim_coeff = (float)(anim_coeff / 0.5);
-
-		    torso_angle = (float)(0.0 * PI);
-		    left_shoulder_angle = (float)(
-			(0.7 + (0.4 * anim_coeff)) * PI
-		    );
-		    right_shoulder_angle = (float)(
-			(1.3 - (0.4 * anim_coeff)) * PI
-		    );
-		    left_bisep_angle = (float)(0.0 * PI);
-		    right_bisep_angle = (float)(0.0 * PI);
-		    left_trisep_angle = (float)(0.0 * PI);
-		    right_trisep_angle = (float)(0.0 * PI);
-		    left_hip_to_thigh_angle = (float)(0.0 * PI);
-		    right_hip_to_thigh_angle = (float)(0.0 * PI);
-		    left_knee_to_calv_angle = (float)(0.0 * PI);
-		    right_knee_to_calv_angle = (float)(0.0 * PI);
-
-		    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
-		}
-		else
-		{
-		    /* Just standing on ground. */
-		    torso_angle = (float)(0.0 * PI);
-		    left_shoulder_angle = (float)(0.0 * PI);
-		    right_shoulder_angle = (float)(0.0 * PI);
-		    left_bisep_angle = (float)(0.0 * PI);
-		    right_bisep_angle = (float)(0.0 * PI);
-		    left_trisep_angle = (float)(0.0 * PI);
-		    right_trisep_angle = (float)(0.0 * PI);
-		    left_hip_to_thigh_angle = (float)(0.0 * PI);
-		    right_hip_to_thigh_angle = (float)(0.0 * PI);
-		    left_knee_to_calv_angle = (float)(0.0 * PI);
-		    right_knee_to_calv_angle = (float)(0.0 * PI);
-
-		    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
-		}
-		draw_shadow_std = True;
-	    }
-	}
-
-	/* At this point the human's appendage length and rotation
-	 * values have now been set up.
-	 */
-
-	/* Draw shadow? */
-	if(draw_shadow_std)
-	{
-	    float theta, r = 0.07f + height / 4.4f;
-	    StateGLBoolean lighting = state->lighting;
-	    StateGLBoolean depth_mask_flag = state->depth_mask_flag;
-	    GLenum shade_model_mode = state->shade_model_mode;
-
-	    /* Set up GL states. */
-	    if(lighting)
-		StateGLDisable(state, GL_LIGHTING);
-	    StateGLEnable(state, GL_BLEND);
-	    StateGLDisable(state, GL_ALPHA_TEST);
-	    StateGLDepthMask(state, GL_FALSE);
-	    StateGLEnable(state, GL_POLYGON_OFFSET_FILL);
-	    StateGLBlendFunc(
-		state, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
-	    );
-	    StateGLPolygonOffset(
-		state,
-		(GLfloat)opt->gl_polygon_offset_factor, -1.0f
-	    );
-	    StateGLShadeModel(state, GL_FLAT);
-
-	    glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
-	    glBegin(GL_TRIANGLE_FAN);
-	    glNormal3f(0.0f, 1.0f, 0.0f);
-	    for(theta = 2.0f; theta > 0.0f; theta -= 0.25f)
-		glVertex3f(
-		    (float)(r * sin(theta * PI)),
-		    0.0f,
-		    (float)-(r * cos(theta * PI))
-		);
-	    glEnd();
-
-	    /* Restore GL states. */
-	    if(lighting)
-		StateGLEnable(state, GL_LIGHTING);
-	    StateGLDisable(state, GL_POLYGON_OFFSET_FILL);
-	    StateGLDisable(state, GL_BLEND);
-	    StateGLDepthMask(state, depth_mask_flag);
-	    StateGLEnable(state, GL_ALPHA_TEST);
-	    StateGLShadeModel(state, shade_model_mode);
-	}
-
-	/* Draw stretcher? */
-	if(flags & SAR_HUMAN_FLAG_ON_STRETCHER)
-	{
-	    float x = 0.35f, y = 1.05f;
-	    float h = stretcher_height - 0.1f, hl = 0.1f;
-
-	    glColor4f(0.8f, 0.8f, 0.8f, 1.0f);
-
-	    /* Bed of stretcher. */
-	    glBegin(GL_QUADS);
-	    {
-		glNormal3f(0.0f, 1.0f, 0.0f);
-		glVertex3f(x, h, -y);
-		glVertex3f(-x, h, -y);
-		glVertex3f(-x, h, y);
-		glVertex3f(x, h, y);
-
-		glNormal3f(0.0f, -1.0f, 0.0f);
-		glVertex3f(-x, h, -y);
-		glVertex3f(x, h, -y);
-		glVertex3f(x, h, y);
-		glVertex3f(-x, h, y);
-	    }
-	    glEnd();
-
-	    glColor4f(0.7f, 0.7f, 0.7f, 1.0f);
-
-	    /* Left grids. */
-	    glBegin(GL_LINE_LOOP);
-	    {
-		glNormal3f(-1.0f, 0.0f, 0.0f);
-		glVertex3f(-x, hl, -y);
-		glVertex3f(-x, h, y);
-		glVertex3f(-x, hl, y);
-		glVertex3f(-x, h, -y);
-	    }
-	    glEnd();
-
-	    /* Right grids. */
-	    glBegin(GL_LINE_LOOP);
-	    {
-		glNormal3f(1.0, 0.0, 0.0);
-		glVertex3f(x, hl, -y);
-		glVertex3f(x, h, y);
-		glVertex3f(x, hl, y);
-		glVertex3f(x, h, -y);
-	    }
-	    glEnd();
+	    glEnd();
 
 
 	    glColor4f(0.1f, 0.1f, 0.1f, 1.0f);
@@ -952,94 +704,720 @@ void SARDrawHumanIterate(
 		c = &palette[SAR_HUMAN_COLOR_HANDS];
 		SET_BODY_COLOR
 
-		glBegin(GL_QUADS);
-		{
-		    SARDrawBoxBaseNS((0.28f * trisep_len + 0.06f) * width_coef, 0.06f * thick_coef, -0.50f * trisep_len, True);
-		}
-		glEnd();
+		glBegin(GL_QUADS);
+		{
+		    SARDrawBoxBaseNS((0.28f * trisep_len + 0.06f) * width_coef, 0.06f * thick_coef, -0.50f * trisep_len, True);
+		}
+		glEnd();
+	    }
+	    glPopMatrix();
+	    /* Back to shoulders. */
+
+
+	    /* Head and hair. */
+	    float head_height = 0.22f * height_coef;
+	    head_height = (head_height >= 0.13) ? (head_height) : (0.13f);
+	    float hairs_height = 0.1f * height_coef;
+	    /* Do not apply whole thick coefficient to head */
+	    float head_thick = 0.18f * (thick_coef / 1.5f);
+
+	    /* Check if hair color is transparent. If true, human is bald (has no head hair). */
+	    if ((&palette[SAR_HUMAN_COLOR_HAIR])->a == 0.0f)
+	    {
+		head_height += hairs_height / 3.0f;
+
+		/* Head */
+		c = &palette[SAR_HUMAN_COLOR_FACE];
+		SET_BODY_COLOR
+
+		glTranslatef(0.0f, 0.05f * torso_len * height_coef, 0.0f);
+		glBegin(GL_QUADS);
+		{
+		    SARDrawBoxBaseNS(0.18f * width_coef, head_thick, head_height, True);
+		}
+		glEnd();
+
+		/* Dont' draw hair. */
+	    }
+	    else
+	    {
+		/* Head */
+		c = &palette[SAR_HUMAN_COLOR_FACE];
+		SET_BODY_COLOR
+
+		glTranslatef(0.0f, 0.05f * torso_len * height_coef, 0.0f);
+		glBegin(GL_QUADS);
+		{
+		    SARDrawBoxBaseNS(0.18f * width_coef, head_thick, head_height, True);
+		}
+		glEnd();
+
+		/* Hair. */
+		glPushMatrix();
+		{
+		    /* Move to head top */
+		    glTranslatef(0.0f, head_height, 0.0f);
+
+		    c = &palette[SAR_HUMAN_COLOR_HAIR];
+		    SET_BODY_COLOR
+
+		    glBegin(GL_QUADS);
+		    {
+			SARDrawBoxBaseNS(0.18f * width_coef,  head_thick,  hairs_height, False);
+		    }
+		    glEnd();
+		}
+		glPopMatrix();
+
+		/* Back of head hair. */
+		glPushMatrix();
+		{
+		    glTranslatef(0.0f,  0.05f * height_coef,  (head_thick / 2.0f) + 0.05f / 2.0f);
+		    glBegin(GL_QUADS);
+		    {
+			SARDrawBoxBaseNS(0.18f * width_coef,  0.05f,  head_height, True);
+		    }
+		    glEnd();
+		}
+		glPopMatrix();
+	    }
+
+
+	    /* Check if on stretcher, if so we need to pop one matrix
+	     * level that was added for translation up on to stretcher.
+	     */
+	    if(flags & SAR_HUMAN_FLAG_ON_STRETCHER)
+	    {
+		glPopMatrix();
+	    }
+	}
+	glPopMatrix();
+
+#undef SET_BODY_COLOR
+}
+
+/*
+ *	Deletes all the GL lists on the human draw cache of the given
+ *	hd, the cache itself is kept.
+ */
+static void SARDrawHumanCacheFlush(sar_human_data_struct *hd)
+{
+	int i;
+	sar_human_draw_cache_struct *entry;
+
+	if(hd->draw_cache == NULL)
+	    return;
+
+	for(i = 0; i < SAR_HUMAN_DRAW_CACHE_MAX; i++)
+	{
+	    entry = &hd->draw_cache[i];
+	    if(entry->list != 0)
+		glDeleteLists((GLuint)entry->list, 1);
+	}
+	memset(
+	    hd->draw_cache, 0x00,
+	    SAR_HUMAN_DRAW_CACHE_MAX * sizeof(sar_human_draw_cache_struct)
+	);
+	hd->total_draw_cache = 0;
+}
+
+/*
+ *	Draws the body of one human by calling the GL list recorded for
+ *	the same build, flags, colors, pose, and animation frame on the
+ *	human draw cache, recording it first if there is none.
+ *
+ *	The anim_frame must be -1 if the pose is not animated.
+ *
+ *	All inputs assumed valid.
+ */
+static void SARDrawHumanBodyList(
+	sar_dc_struct *dc,
+	float height, float mass,
+	sar_human_flags flags,
+	const sar_color_struct *palette,
+	int anim_frame,
+	const sar_draw_human_pose_struct *pose
+)
+{
+	int i, n;
+	GLuint list;
+	unsigned long h;
+	const unsigned char *b;
+	sar_human_draw_key_struct key;
+	sar_human_draw_cache_struct *entry = NULL;
+	sar_human_data_struct *hd = dc->core_ptr->human_data;
+
+	/* Allocate the cache as needed, draw directly if there is no
+	 * cache.
+	 */
+	if((hd != NULL) && (hd->draw_cache == NULL))
+	{
+	    hd->draw_cache = (sar_human_draw_cache_struct *)calloc(
+		SAR_HUMAN_DRAW_CACHE_MAX, sizeof(sar_human_draw_cache_struct)
+	    );
+	    hd->total_draw_cache = 0;
+	}
+	if((hd == NULL) || (hd->draw_cache == NULL))
+	{
+	    SARDrawHumanBody(dc, flags, palette, pose);
+	    return;
+	}
+
+	/* Set up the key, clear it first so that it can be compared
+	 * and hashed as bytes.
+	 */
+	memset(&key, 0x00, sizeof(sar_human_draw_key_struct));
+	key.height = height;
+	key.mass = mass;
+	key.flags = flags;
+	key.anim_frame = anim_frame;
+	key.flir = (dc->flir) ? 1 : 0;
+	memcpy(
+	    &key.color[0], palette,
+	    SAR_HUMAN_COLORS_MAX * sizeof(sar_color_struct)
+	);
+
+	/* FNV-1a hash of the key */
+	h = 2166136261ul;
+	b = (const unsigned char *)&key;
+	for(i = 0; i < (int)sizeof(sar_human_draw_key_struct); i++)
+	{
+	    h ^= (unsigned long)b[i];
+	    h = (h * 16777619ul) & 0xfffffffful;
+	}
+
+	/* Look for the recorded GL list, the table is open addressed
+	 * and never more than 3/4 full so an unused entry ends the
+	 * search.
+	 */
+	i = (int)(h % SAR_HUMAN_DRAW_CACHE_MAX);
+	for(n = 0; n < SAR_HUMAN_DRAW_CACHE_MAX; n++)
+	{
+	    entry = &hd->draw_cache[i];
+	    if(entry->list == 0)
+		break;
+
+	    if(!memcmp(&entry->key, &key, sizeof(sar_human_draw_key_struct)))
+	    {
+		glCallList((GLuint)entry->list);
+		return;
+	    }
+
+	    i = (i + 1) % SAR_HUMAN_DRAW_CACHE_MAX;
+	}
+
+	/* Not recorded, flush the cache if it is getting full */
+	if(hd->total_draw_cache >= (SAR_HUMAN_DRAW_CACHE_MAX * 3 / 4))
+	{
+	    SARDrawHumanCacheFlush(hd);
+	    entry = &hd->draw_cache[h % SAR_HUMAN_DRAW_CACHE_MAX];
+	}
+
+	list = glGenLists(1);
+	if(list == 0)
+	{
+	    SARDrawHumanBody(dc, flags, palette, pose);
+	    return;
+	}
+
+	glNewList(list, GL_COMPILE);
+	SARDrawHumanBody(dc, flags, palette, pose);
+	glEndList();
+
+	entry->key = key;
+	entry->list = (unsigned int)list;
+	hd->total_draw_cache++;
+
+	glCallList(list);
+}
+
+/*
+ *	Deletes all the GL lists on the human draw cache of the given
+ *	hd.
+ *
+ *	This must be called while the GL context still exists, before
+ *	SARHumanPresetsShutdown().
+ */
+void SARDrawHumanCacheClear(sar_human_data_struct *hd)
+{
+	if(hd == NULL)
+	    return;
+
+	SARDrawHumanCacheFlush(hd);
+}
+
+/*
+ *	Draws one far away standing human as an impostor, three flat
+ *	quads colored by the legs, torso, and face colors that are
+ *	turned to face heading (in radians, relative to the human's
+ *	heading).
+ *
+ *	All inputs assumed valid.
+ */
+static void SARDrawHumanImpostor(
+	sar_dc_struct *dc,
+	float height, float mass,
+	const sar_color_struct *palette,
+	float heading
+)
+{
+	gw_display_struct *display = dc->display;
+	state_gl_struct *state = &display->state_gl;
+	StateGLBoolean lighting = state->lighting;
+	StateGLBoolean texture_2d_state = state->texture_2d;
+	GLenum shade_model_mode = state->shade_model_mode;
+	const float bmi = mass / (height * height);
+	const float width_coef = (bmi * 0.66f) / 25;
+	/* Right of the impostor, as seen from the human */
+	const float	rx = (float)cos(heading),
+			rz = (float)sin(heading);
+	/* Bottom and top (coefficients of the height) and half width
+	 * (in meters for the standard human) of each part
+	 */
+	const float part[3][3] = {
+	    { 0.00f, 0.47f, 0.11f },	/* Legs */
+	    { 0.47f, 0.87f, 0.18f },	/* Torso */
+	    { 0.87f, 1.00f, 0.08f }	/* Head */
+	};
+	const int part_color[3] = {
+	    SAR_HUMAN_COLOR_LEGS,
+	    SAR_HUMAN_COLOR_TORSO,
+	    SAR_HUMAN_COLOR_FACE
+	};
+	int i;
+	float y1, y2, w;
+	const sar_color_struct *c;
+
+	/* Set up gl states. */
+	if(dc->flir)
+	    StateGLDisable(state, GL_LIGHTING);
+	StateGLDisable(state, GL_TEXTURE_2D);
+	V3DTextureSelect(NULL);
+	StateGLShadeModel(state, GL_FLAT);
+
+	glBegin(GL_QUADS);
+	glNormal3f(0.0f, 1.0f, 0.0f);
+	for(i = 0; i < 3; i++)
+	{
+	    c = &palette[part_color[i]];
+	    if(dc->flir)
+	    {
+		float g = (float)(((c->r + c->g + c->b) / 3.0) / 2.0);
+		glColor4f(0.5f + g, 1.0f, 0.5f + g, 1.0f);
+	    }
+	    else
+	    {
+		glColor4f(c->r, c->g, c->b, c->a);
+	    }
+
+	    y1 = part[i][0] * height;
+	    y2 = part[i][1] * height;
+	    w = part[i][2] * width_coef * height / 1.9f;
+	    glVertex3f(rx * w, y1, rz * w);
+	    glVertex3f(-rx * w, y1, -rz * w);
+	    glVertex3f(-rx * w, y2, -rz * w);
+	    glVertex3f(rx * w, y2, rz * w);
+	}
+	glEnd();
+
+	/* Restore GL states. */
+	if(texture_2d_state)
+	    StateGLEnable(state, GL_TEXTURE_2D);
+	if(lighting)
+	    StateGLEnable(state, GL_LIGHTING);
+	StateGLShadeModel(state, shade_model_mode);
+}
+
+/*
+ *	Called by SARDrawHuman() to draw one human.
+ *
+ *	All inputs assumed valid.
+ */
+void SARDrawHumanIterate(
+	sar_dc_struct *dc,
+	float height, float mass,
+	sar_human_flags flags,
+	const sar_color_struct *palette,	/* Human colors */
+	int water_ripple_tex_num,
+	sar_grad_anim_t anim_pos
+)
+{
+	gw_display_struct *display = dc->display;
+	state_gl_struct *state = &display->state_gl;
+	const sar_option_struct *opt = dc->option;
+	sar_scene_struct *scene = dc->scene;
+	StateGLBoolean lighting = state->lighting;
+	GLenum shade_model_mode = state->shade_model_mode;
+	StateGLBoolean texture_2d_state = state->texture_2d;
+	/* The animation cycle is drawn in SAR_HUMAN_DRAW_ANIM_FRAMES
+	 * frames so that each frame's pose can be recorded.
+	 */
+	const int anim_frame = (int)anim_pos * SAR_HUMAN_DRAW_ANIM_FRAMES /
+	    ((int)((sar_grad_anim_t)-1) + 1);
+	float anim_coeff = (float)anim_frame /
+	    (float)SAR_HUMAN_DRAW_ANIM_FRAMES;
+	Boolean animated = False;
+	sar_draw_human_pose_struct pose;
+
+	float torso_angle;
+	float left_bisep_angle, right_bisep_angle;
+	float left_shoulder_angle, right_shoulder_angle;
+	float left_trisep_angle, right_trisep_angle;
+	float left_hip_to_thigh_angle, right_hip_to_thigh_angle;
+	float left_knee_to_calv_angle, right_knee_to_calv_angle;
+
+	float thigh_len = 0.3f;
+	float calf_len = 0.4f;
+	float foot_height = 0.08f;
+	float foot_length;
+	float torso_len = 0.8f;
+	float bisep_len = 0.3f;
+	float trisep_len = 0.4f;
+	float base_to_torso = 0.0f;	/* Ground to bottom of torso
+					 * (calculated later).
+					 */
+	float stretcher_height = 0.8f;	/* Ground to bed of stretcher. */
+
+	Boolean draw_shadow_std = False;
+
+	/* Body segments length depends of human total height */
+	float height_coef = height / 1.9f; // SarII standard human height is 1.9m
+	thigh_len   *= height_coef;
+	calf_len    *= height_coef;
+	foot_height *= height_coef;
+	foot_length = 1.90f * 0.13f * height_coef;
+	torso_len   *= height_coef;
+	bisep_len   *= height_coef;
+	trisep_len  *= height_coef;
+
+	/* Body width and thick depends of human mass: let's consider
+	 * that standard is 1.9m / 90kg => BMI is ~25.
+	 */
+	float bmi = mass / (height * height);
+	float width_coef = (bmi * 0.66f) / 25;
+	float thick_coef = (bmi * 1.2f) / 25;
+
+
+	/* Set up gl states. */
+	if(dc->flir)
+	    StateGLDisable(state, GL_LIGHTING);
+	StateGLDisable(state, GL_TEXTURE_2D);
+	V3DTextureSelect(NULL);
+	StateGLShadeModel(state, GL_SMOOTH);
+
+	/* Calculate angles of body parts. Note that all zero radians
+	 * indicates human is standing upright with hands to side.
+	 */
+	if(flags & SAR_HUMAN_FLAG_LYING)
+	{
+	    torso_angle = (float)(1.5 * PI);
+	    left_shoulder_angle = (float)(0.0 * PI);
+	    right_shoulder_angle = (float)(0.0 * PI);
+	    left_bisep_angle = (float)(0.0 * PI);
+	    right_bisep_angle = (float)(0.0 * PI);
+	    left_trisep_angle = (float)(0.0 * PI);
+	    right_trisep_angle = (float)(0.0 * PI);
+	    left_hip_to_thigh_angle = (float)(0.0 * PI);
+	    right_hip_to_thigh_angle = (float)(0.0 * PI);
+	    left_knee_to_calv_angle = (float)(0.0 * PI);
+	    right_knee_to_calv_angle = (float)(0.0 * PI);
+
+	    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
+
+	    if(flags & SAR_HUMAN_FLAG_ON_STRETCHER)
+	    {
+		/* Some translating will be done later. */
+	    }
+	}
+	else if(flags & SAR_HUMAN_FLAG_SIT)
+	{
+	    /* Sitting base at tush. */
+	    torso_angle = (float)(0.0 * PI);
+	    left_shoulder_angle = (float)(0.0 * PI);
+	    right_shoulder_angle = (float)(0.0 * PI);
+	    left_bisep_angle = (float)(0.0 * PI);
+	    right_bisep_angle = (float)(0.0 * PI);
+	    left_trisep_angle = (float)(1.75 * PI);
+	    right_trisep_angle = (float)(1.75 * PI);
+	    left_hip_to_thigh_angle = (float)(1.5 * PI);
+	    right_hip_to_thigh_angle = (float)(1.5 * PI);
+	    left_knee_to_calv_angle = (float)(0.5 * PI);
+	    right_knee_to_calv_angle = (float)(0.5 * PI);
+
+	    base_to_torso = 0.0f;
+	}
+	else if(flags & SAR_HUMAN_FLAG_SIT_DOWN)
+	{
+	    torso_angle = (float)(0.0 * PI);
+	    left_shoulder_angle = (float)(0.0 * PI);
+	    right_shoulder_angle = (float)(0.0 * PI);
+	    left_bisep_angle = (float)(0.0 * PI);
+	    right_bisep_angle = (float)(0.0 * PI);
+	    left_trisep_angle = (float)(1.75 * PI);
+	    right_trisep_angle = (float)(1.75 * PI);
+	    left_hip_to_thigh_angle = (float)(1.5 * PI);
+	    right_hip_to_thigh_angle = (float)(1.5 * PI);
+	    left_knee_to_calv_angle = (float)(0.0 * PI);
+	    right_knee_to_calv_angle = (float)(0.0 * PI);
+
+	    base_to_torso = 0.0f;
+	}
+	else if(flags & SAR_HUMAN_FLAG_SIT_UP)
+	{
+	    /* Sitting base at feet. */
+	    torso_angle = (float)(0.0 * PI);
+	    left_shoulder_angle = (float)(0.0 * PI);
+	    right_shoulder_angle = (float)(0.0 * PI);
+	    left_bisep_angle = (float)(0.0 * PI);
+	    right_bisep_angle = (float)(0.0 * PI);
+	    left_trisep_angle = (float)(1.75 * PI);
+	    right_trisep_angle = (float)(1.75 * PI);
+	    left_hip_to_thigh_angle = (float)(1.5 * PI);
+	    right_hip_to_thigh_angle = (float)(1.5 * PI);
+	    left_knee_to_calv_angle = (float)(0.5 * PI);
+	    right_knee_to_calv_angle = (float)(0.5 * PI);
+
+	    base_to_torso = calf_len + foot_height * height_coef;
+	}
+	else if(flags & SAR_HUMAN_FLAG_DIVER_CATCHER)
+	{
+	    /* Diver catching victim, used for hoist rescue end drawing. */
+	    torso_angle = (float)(0.0 * PI);
+	    left_shoulder_angle = (float)(0.1 * PI);
+	    right_shoulder_angle = (float)(1.9 * PI);
+	    left_bisep_angle = (float)(1.8 * PI);
+	    right_bisep_angle = (float)(1.8 * PI);
+	    left_trisep_angle = (float)(1.8 * PI);
+	    right_trisep_angle = (float)(1.8 * PI);
+	    left_hip_to_thigh_angle = (float)(1.9 * PI);
+	    right_hip_to_thigh_angle = (float)(1.9 * PI);
+	    left_knee_to_calv_angle = (float)(0.2 * PI);
+	    right_knee_to_calv_angle = (float)(0.2 * PI);
+
+	    /* If gripped it implies on end of rescue hoist rope. */
+	    if(flags & SAR_HUMAN_FLAG_GRIPPED)
+		base_to_torso = torso_len;
+	    else if(flags & SAR_HUMAN_FLAG_IN_WATER)
+		base_to_torso = torso_len * -0.92f;
+	    else
+		base_to_torso = thigh_len + calf_len + foot_height * height_coef;
+	}
+	/* Run should be checked last since lying and setting have
+	 * precidence.
+	 */
+	else if(flags & SAR_HUMAN_FLAG_RUN)
+	{
+	    animated = True;
+	    if(anim_coeff > 0.5f)
+		anim_coeff = (1.0f - anim_coeff) / 0.5f;
+	    else
+		anim_coeff = anim_coeff / 0.5f;
+
+	    torso_angle = (float)(0.1 * PI);
+	    left_shoulder_angle = (float)(0.0 * PI);
+	    right_shoulder_angle = (float)(0.0 * PI);
+	    if(flags & SAR_HUMAN_FLAG_PUSHING)
+	    {
+		left_bisep_angle = (float)(1.7 * PI);
+		right_bisep_angle = (float)(1.7 * PI);
+		left_trisep_angle = (float)(1.6 * PI);
+		right_trisep_angle = (float)(1.6 * PI);
 	    }
-	    glPopMatrix();
-	    /* Back to shoulders. */
-
+	    else
+	    {
+		left_bisep_angle = (float)(
+		    (1.7 + (0.35 * (1.0 - anim_coeff))) * PI
+		);
+		right_bisep_angle = (float)(
+		    (1.7 + (0.35 * anim_coeff)) * PI
+		);
+		left_trisep_angle = (float)(
+		    (1.6 + (0.15 * (1.0 - anim_coeff))) * PI
+		);
+		right_trisep_angle = (float)(
+		    (1.6 + (0.15 * anim_coeff)) * PI
+		);
+	    }
+	    left_hip_to_thigh_angle = (float)(
+		(0.2 - (0.5 * anim_coeff)) * PI
+	    );
+	    right_hip_to_thigh_angle = (float)(
+		(0.2 - (0.5 * (1.0 - anim_coeff))) * PI
+	    );
+	    left_knee_to_calv_angle = (float)(0.2 * PI);
+	    right_knee_to_calv_angle = (float)(0.2 * PI);
 
-	    /* Head and hair. */
-	    float head_height = 0.22f * height_coef;
-	    head_height = (head_height >= 0.13) ? (head_height) : (0.13f);
-	    float hairs_height = 0.1f * height_coef;
-	    /* Do not apply whole thick coefficient to head */
-	    float head_thick = 0.18f * (thick_coef / 1.5f);
+	    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
 
-	    /* Check if hair color is transparent. If true, human is bald (has no head hair). */
-	    if ((&palette[SAR_HUMAN_COLOR_HAIR])->a == 0.0f)
+	    draw_shadow_std = True;
+	}
+	/* All else assume just standing. */
+	else
+	{
+	    /* Standing in water? */
+	    if(flags & SAR_HUMAN_FLAG_IN_WATER)
 	    {
-		head_height += hairs_height / 3.0f;
-
-		/* Head */
-		c = &palette[SAR_HUMAN_COLOR_FACE];
-		SET_BODY_COLOR
+		/* Standing in water, arms fore and moving. */
+		animated = True;
+		if(anim_coeff > 0.5f)
+		    anim_coeff = (float)((1.0 - anim_coeff) / 0.5);
+		else
+		    anim_coeff = (float)(anim_coeff / 0.5);
 
-		glTranslatef(0.0f, 0.05f * torso_len * height_coef, 0.0f);
-		glBegin(GL_QUADS);
-		{
-		    SARDrawBoxBaseNS(0.18f * width_coef, head_thick, head_height, True);
-		}
-		glEnd();
+		torso_angle = (float)(0.0 * PI);
+		left_shoulder_angle = (float)((0.4 * anim_coeff) * PI);
+		right_shoulder_angle = (float)((2 - (0.4 * anim_coeff)) * PI);
+		left_bisep_angle = (float)(1.5 * PI);
+		right_bisep_angle = (float)(1.5 * PI);
+		left_trisep_angle = (float)(0.0 * PI);
+		right_trisep_angle = (float)(0.0 * PI);
+		left_hip_to_thigh_angle = (float)(0.0 * PI);
+		right_hip_to_thigh_angle = (float)(0.0 * PI);
+		left_knee_to_calv_angle = (float)(0.0 * PI);
+		right_knee_to_calv_angle = (float)(0.0 * PI);
 
-		/* Dont' draw hair. */
+		/* Since in water, move torso down. */
+		base_to_torso = torso_len * -0.92f;
 	    }
 	    else
 	    {
-		/* Head */
-		c = &palette[SAR_HUMAN_COLOR_FACE];
-		SET_BODY_COLOR
-
-		glTranslatef(0.0f, 0.05f * torso_len * height_coef, 0.0f);
-		glBegin(GL_QUADS);
-		{
-		    SARDrawBoxBaseNS(0.18f * width_coef, head_thick, head_height, True);
-		}
-		glEnd();
-
-		/* Hair. */
-		glPushMatrix();
+		/* Standing on ground and aware? */
+		if(((flags & SAR_HUMAN_FLAG_NEED_RESCUE) &&
+		    (flags & SAR_HUMAN_FLAG_AWARE)) ||
+		   (flags & SAR_HUMAN_FLAG_ALERT)
+		)
 		{
-		    /* Move to head top */
-		    glTranslatef(0.0f, head_height, 0.0f);
+		    /* Need rescue and aware that rescuer is
+		     * near by, move arms fore and wave.
+		     */
+		    /* As well if we just want to alert */
+		    animated = True;
+		    if(anim_coeff > 0.5f)
+			anim_coeff = (float)((1.0 - anim_coeff) / 0.5);
+		    else
+			anim_coeff = (float)(anim_coeff / 0.5);
 
-		    c = &palette[SAR_HUMAN_COLOR_HAIR];
-		    SET_BODY_COLOR
+		    torso_angle = (float)(0.0 * PI);
+		    left_shoulder_angle = (float)(
+			(0.7 + (0.4 * anim_coeff)) * PI
+		    );
+		    right_shoulder_angle = (float)(
+			(1.3 - (0.4 * anim_coeff)) * PI
+		    );
+		    left_bisep_angle = (float)(0.0 * PI);
+		    right_bisep_angle = (float)(0.0 * PI);
+		    left_trisep_angle = (float)(0.0 * PI);
+		    right_trisep_angle = (float)(0.0 * PI);
+		    left_hip_to_thigh_angle = (float)(0.0 * PI);
+		    right_hip_to_thigh_angle = (float)(0.0 * PI);
+		    left_knee_to_calv_angle = (float)(0.0 * PI);
+		    right_knee_to_calv_angle = (float)(0.0 * PI);
 
-		    glBegin(GL_QUADS);
-		    {
-			SARDrawBoxBaseNS(0.18f * width_coef,  head_thick,  hairs_height, False);
-		    }
-		    glEnd();
+		    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
 		}
-		glPopMatrix();
-
-		/* Back of head hair. */
-		glPushMatrix();
+		else
 		{
-		    glTranslatef(0.0f,  0.05f * height_coef,  (head_thick / 2.0f) + 0.05f / 2.0f);
-		    glBegin(GL_QUADS);
-		    {
-			SARDrawBoxBaseNS(0.18f * width_coef,  0.05f,  head_height, True);
-		    }
-		    glEnd();
+		    /* Just standing on ground. */
+		    torso_angle = (float)(0.0 * PI);
+		    left_shoulder_angle = (float)(0.0 * PI);
+		    right_shoulder_angle = (float)(0.0 * PI);
+		    left_bisep_angle = (float)(0.0 * PI);
+		    right_bisep_angle = (float)(0.0 * PI);
+		    left_trisep_angle = (float)(0.0 * PI);
+		    right_trisep_angle = (float)(0.0 * PI);
+		    left_hip_to_thigh_angle = (float)(0.0 * PI);
+		    right_hip_to_thigh_angle = (float)(0.0 * PI);
+		    left_knee_to_calv_angle = (float)(0.0 * PI);
+		    right_knee_to_calv_angle = (float)(0.0 * PI);
+
+		    base_to_torso = thigh_len + calf_len + foot_height * height_coef;
 		}
-		glPopMatrix();
+		draw_shadow_std = True;
 	    }
+	}
 
+	/* At this point the human's appendage length and rotation
+	 * values have now been set up.
+	 */
 
-	    /* Check if on stretcher, if so we need to pop one matrix
-	     * level that was added for translation up on to stretcher.
-	     */
-	    if(flags & SAR_HUMAN_FLAG_ON_STRETCHER)
-	    {
-		glPopMatrix();
-	    }
+	/* Draw shadow? */
+	if(draw_shadow_std)
+	{
+	    float theta, r = 0.07f + height / 4.4f;
+	    StateGLBoolean lighting = state->lighting;
+	    StateGLBoolean depth_mask_flag = state->depth_mask_flag;
+	    GLenum shade_model_mode = state->shade_model_mode;
+
+	    /* Set up GL states. */
+	    if(lighting)
+		StateGLDisable(state, GL_LIGHTING);
+	    StateGLEnable(state, GL_BLEND);
+	    StateGLDisable(state, GL_ALPHA_TEST);
+	    StateGLDepthMask(state, GL_FALSE);
+	    StateGLEnable(state, GL_POLYGON_OFFSET_FILL);
+	    StateGLBlendFunc(
+		state, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
+	    );
+	    StateGLPolygonOffset(
+		state,
+		(GLfloat)opt->gl_polygon_offset_factor, -1.0f
+	    );
+	    StateGLShadeModel(state, GL_FLAT);
+
+	    glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
+	    glBegin(GL_TRIANGLE_FAN);
+	    glNormal3f(0.0f, 1.0f, 0.0f);
+	    for(theta = 2.0f; theta > 0.0f; theta -= 0.25f)
+		glVertex3f(
+		    (float)(r * sin(theta * PI)),
+		    0.0f,
+		    (float)-(r * cos(theta * PI))
+		);
+	    glEnd();
+
+	    /* Restore GL states. */
+	    if(lighting)
+		StateGLEnable(state, GL_LIGHTING);
+	    StateGLDisable(state, GL_POLYGON_OFFSET_FILL);
+	    StateGLDisable(state, GL_BLEND);
+	    StateGLDepthMask(state, depth_mask_flag);
+	    StateGLEnable(state, GL_ALPHA_TEST);
+	    StateGLShadeModel(state, shade_model_mode);
 	}
-	glPopMatrix();
+
+	/* Draw the body from the GL list recorded for the same build,
+	 * colors, pose, and animation frame.
+	 */
+	pose.thigh_len = thigh_len;
+	pose.calf_len = calf_len;
+	pose.foot_height = foot_height;
+	pose.foot_length = foot_length;
+	pose.torso_len = torso_len;
+	pose.bisep_len = bisep_len;
+	pose.trisep_len = trisep_len;
+	pose.base_to_torso = base_to_torso;
+	pose.stretcher_height = stretcher_height;
+	pose.height_coef = height_coef;
+	pose.width_coef = width_coef;
+	pose.thick_coef = thick_coef;
+	pose.torso_angle = torso_angle;
+	pose.left_bisep_angle = left_bisep_angle;
+	pose.right_bisep_angle = right_bisep_angle;
+	pose.left_shoulder_angle = left_shoulder_angle;
+	pose.right_shoulder_angle = right_shoulder_angle;
+	pose.left_trisep_angle = left_trisep_angle;
+	pose.right_trisep_angle = right_trisep_angle;
+	pose.left_hip_to_thigh_angle = left_hip_to_thigh_angle;
+	pose.right_hip_to_thigh_angle = right_hip_to_thigh_angle;
+	pose.left_knee_to_calv_angle = left_knee_to_calv_angle;
+	pose.right_knee_to_calv_angle = right_knee_to_calv_angle;
+	SARDrawHumanBodyList(
+	    dc,
+	    height, mass,
+	    flags, palette,
+	    animated ? anim_frame : -1,
+	    &pose
+	);
 
 	/* Re-enable GL_TEXTURE_2D as needed. */
 	if(texture_2d_state)
@@ -1112,8 +1490,6 @@ void SARDrawHumanIterate(
 	if(lighting)
 	    StateGLEnable(state, GL_LIGHTING);
 	StateGLShadeModel(state, shade_model_mode);
-
-#undef SET_BODY_COLOR
 }
 
 
@@ -1130,16 +1506,52 @@ void SARDrawHuman(
 	sar_object_human_struct *human
 )
 {
+	Boolean impostor = False;
+	float impostor_heading = 0.0f;
+
+	/* Standing humans far away are drawn as impostors facing the
+	 * camera.
+	 */
+	if(!(human->flags & (SAR_HUMAN_FLAG_LYING | SAR_HUMAN_FLAG_SIT |
+	    SAR_HUMAN_FLAG_SIT_DOWN | SAR_HUMAN_FLAG_SIT_UP |
+	    SAR_HUMAN_FLAG_DIVER_CATCHER | SAR_HUMAN_FLAG_IN_WATER |
+	    SAR_HUMAN_FLAG_GRIPPED))
+	)
+	{
+	    const sar_position_struct *pos = &obj_ptr->pos;
+	    const float	dx = pos->x - dc->camera_pos.x,
+			dy = pos->y - dc->camera_pos.y,
+			dz = pos->z - dc->camera_pos.z;
+	    if(((dx * dx) + (dy * dy) + (dz * dz)) >
+		(SAR_HUMAN_IMPOSTOR_DISTANCE * SAR_HUMAN_IMPOSTOR_DISTANCE)
+	    )
+	    {
+		sar_direction_struct to_camera;
+		SARDrawGetDirFromPos(pos, &dc->camera_pos, &to_camera);
+		impostor = True;
+		impostor_heading = (float)(to_camera.heading -
+		    obj_ptr->dir.heading);
+	    }
+	}
+
 	/* Draw main human model for this call first, passing the
 	 * given human object structure's values directly.
 	 */
-	SARDrawHumanIterate(
-	    dc,
-	    human->height, human->mass,
-	    human->flags, human->color,
-	    human->water_ripple_tex_num,
-	    human->anim_pos
-	);
+	if(impostor)
+	    SARDrawHumanImpostor(
+		dc,
+		human->height, human->mass,
+		human->color,
+		impostor_heading
+	    );
+	else
+	    SARDrawHumanIterate(
+		dc,
+		human->height, human->mass,
+		human->flags, human->color,
+		human->water_ripple_tex_num,
+		human->anim_pos
+	    );
 
 	/* Draw assisting humans if any and as appropriate.
 	 * Do not draw assisting humans if this human is being gripped
@@ -1189,15 +1601,9 @@ void SARDrawHuman(
 		    if(human->flags & SAR_HUMAN_FLAG_PUSHING)
 			flags |= SAR_HUMAN_FLAG_PUSHING;
 
-		    assisting_human = SARHumanMatchEntryByName(
-			dc->core_ptr->human_data, human->assisting_human_preset_name[i]
-		    );
-		    /* Human preset name not found? */
-		    if(assisting_human == NULL)
-			/* Use default assisting human preset. */
-			assisting_human = SARHumanMatchEntryByName(
-			    dc->core_ptr->human_data, SAR_HUMAN_PRESET_NAME_ASSISTING_HUMAN
-			);
+		    /* Preset matched when the human was created */
+		    assisting_human = (const sar_human_data_entry_struct *)
+			human->assisting_human_preset[i];
 
 		    if(assisting_human != NULL)
 		    {
@@ -1206,13 +1612,21 @@ void SARDrawHuman(
 			    flags |= SAR_HUMAN_FLAG_GENDER_FEMALE;
 
 		    /* Draw assisting human. */
-			SARDrawHumanIterate(
-			    dc,
-			    assisting_human->height, assisting_human->mass,
-			    flags, assisting_human->color,
-			    human->water_ripple_tex_num,
-			    human->anim_pos
-			);
+			if(impostor)
+			    SARDrawHumanImpostor(
+				dc,
+				assisting_human->height, assisting_human->mass,
+				assisting_human->color,
+				impostor_heading
+			    );
+			else
+			    SARDrawHumanIterate(
+				dc,
+				assisting_human->height, assisting_human->mass,
+				flags, assisting_human->color,
+				human->water_ripple_tex_num,
+				human->anim_pos
+			    );
 		    }
 		}
 		glPopMatrix();
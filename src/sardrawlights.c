@@ -0,0 +1,308 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+#define GL_GLEXT_PROTOTYPES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+
+#include "v3dtex.h"
+#include "stategl.h"
+#include "sardrawlights.h"
+#include "config.h"
+
+
+static sar_draw_light_batch_struct *SARDrawLightsGetBatch(
+	sar_draw_lights_struct *l, GLfloat size
+);
+
+void SARDrawLightsReset(
+	sar_draw_lights_struct *l, state_gl_struct *state
+);
+int SARDrawLightsAdd(
+	sar_draw_lights_struct *l,
+	GLfloat size,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+);
+void SARDrawLightsDraw(
+	sar_draw_lights_struct *l, state_gl_struct *state
+);
+void SARDrawLightsClear(sar_draw_lights_struct *l);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)        (((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
+
+
+/*
+ *	Returns the batch for the point size, a new batch is appended
+ *	if there is no batch for the point size yet.
+ *
+ *	Returns NULL on error.
+ */
+static sar_draw_light_batch_struct *SARDrawLightsGetBatch(
+	sar_draw_lights_struct *l, GLfloat size
+)
+{
+	int i;
+	sar_draw_light_batch_struct *b;
+
+	for(i = 0; i < l->total_batches; i++)
+	{
+	    b = &l->batch[i];
+	    if(b->size == size)
+		return(b);
+	}
+
+	b = SAR_DRAW_LIGHT_BATCH(realloc(
+	    l->batch,
+	    (l->total_batches + 1) * sizeof(sar_draw_light_batch_struct)
+	));
+	if(b == NULL)
+	    return(NULL);
+
+	l->batch = b;
+	b = &l->batch[l->total_batches];
+	memset(b, 0x00, sizeof(sar_draw_light_batch_struct));
+	b->size = size;
+	l->total_batches++;
+
+	return(b);
+}
+
+/*
+ *	Removes all the lights, the allocated arrays are kept for
+ *	the next frame.
+ *
+ *	The GL context that the lights will be drawn in must be
+ *	current, state records its states.
+ */
+void SARDrawLightsReset(
+	sar_draw_lights_struct *l, state_gl_struct *state
+)
+{
+	int i;
+
+	if(l == NULL)
+	    return;
+
+	for(i = 0; i < l->total_batches; i++)
+	    l->batch[i].total_lights = 0;
+
+	/* Point parameters need GL 1.4 */
+#ifdef STATE_GL_VERSION_1_4
+	l->point_parameters = StateGLVersionAtLeast(state, 1, 4) ?
+	    GL_TRUE : GL_FALSE;
+#else
+	l->point_parameters = GL_FALSE;
+#endif
+}
+
+/*
+ *	Appends a light at x, y, z (in GL world coordinates) with the
+ *	point size (in pixels) and the color r, g, b, a.
+ *
+ *	If the lights are drawn with point parameters then the light
+ *	is drawn with the point size SAR_DRAW_LIGHT_POINT_SIZE and its
+ *	alpha is reduced if its point size is smaller. Otherwise the
+ *	point size is rounded to SAR_DRAW_LIGHT_SIZE_STEP pixels and
+ *	is at least 1 pixel.
+ *
+ *	Returns non-zero on error.
+ */
+int SARDrawLightsAdd(
+	sar_draw_lights_struct *l,
+	GLfloat size,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+)
+{
+	GLfloat *v;
+	sar_draw_light_batch_struct *batch;
+
+	if(l == NULL)
+	    return(-2);
+
+	if(l->point_parameters)
+	{
+	    a *= CLIP(size / SAR_DRAW_LIGHT_POINT_SIZE, 0.0f, 1.0f);
+	    size = SAR_DRAW_LIGHT_POINT_SIZE;
+	}
+	else
+	{
+	    size = (GLfloat)MAX(
+		floor((size / SAR_DRAW_LIGHT_SIZE_STEP) + 0.5) *
+		    SAR_DRAW_LIGHT_SIZE_STEP,
+		1.0
+	    );
+	}
+	batch = SARDrawLightsGetBatch(l, size);
+	if(batch == NULL)
+	    return(-3);
+
+	if(batch->total_lights >= batch->max_lights)
+	{
+	    int n = MAX(batch->max_lights * 2, 64);
+	    v = (GLfloat *)realloc(
+		batch->vertex,
+		n * SAR_DRAW_LIGHT_VERTEX_SIZE * sizeof(GLfloat)
+	    );
+	    if(v == NULL)
+		return(-3);
+
+	    batch->vertex = v;
+	    batch->max_lights = n;
+	}
+
+	v = &batch->vertex[batch->total_lights * SAR_DRAW_LIGHT_VERTEX_SIZE];
+	v[0] = r;
+	v[1] = g;
+	v[2] = b;
+	v[3] = a;
+	v[4] = 0.0f;
+	v[5] = 1.0f;
+	v[6] = 0.0f;
+	v[7] = x;
+	v[8] = y;
+	v[9] = z;
+	batch->total_lights++;
+
+	return(0);
+}
+
+/*
+ *	Draws all the lights, one glDrawArrays() per point size (or
+ *	one glDrawArrays() with point parameters).
+ *
+ *	The modelview matrix must only have the camera's rotations and
+ *	translations on it. The lights are drawn blended and without
+ *	lighting.
+ */
+void SARDrawLightsDraw(
+	sar_draw_lights_struct *l, state_gl_struct *state
+)
+{
+	int i;
+	StateGLBoolean lighting, alpha_test;
+	const sar_draw_light_batch_struct *b;
+#ifdef STATE_GL_VERSION_1_4
+	GLfloat size_max = 0.0f;
+#endif
+
+	if(l == NULL)
+	    return;
+
+	l->frame_lights = 0;
+	l->frame_draws = 0;
+
+	for(i = 0; i < l->total_batches; i++)
+	    l->frame_lights += l->batch[i].total_lights;
+	if(l->frame_lights <= 0)
+	    return;
+
+	lighting = state->lighting;
+	alpha_test = state->alpha_test;
+
+	/* Set up GL states */
+	V3DTextureSelect(NULL);
+	StateGLDisable(state, GL_LIGHTING);
+	StateGLDisable(state, GL_ALPHA_TEST);
+	StateGLEnable(state, GL_BLEND);
+	StateGLBlendFunc(state, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	StateGLEnable(state, GL_POINT_SMOOTH);
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+#ifdef STATE_GL_VERSION_1_4
+	/* Attenuate the point size by the distance from the camera */
+	if(l->point_parameters)
+	{
+	    const GLfloat attenuation[3] = {
+		1.0f,
+		SAR_DRAW_LIGHT_ATTENUATION_LINEAR,
+		SAR_DRAW_LIGHT_ATTENUATION_QUADRATIC
+	    };
+	    glGetFloatv(GL_POINT_SIZE_MAX, &size_max);
+	    glPointParameterfv(GL_POINT_DISTANCE_ATTENUATION, attenuation);
+	    glPointParameterf(GL_POINT_SIZE_MIN, 1.0f);
+	    glPointParameterf(GL_POINT_SIZE_MAX, SAR_DRAW_LIGHT_POINT_SIZE);
+	}
+#endif
+
+	for(i = 0; i < l->total_batches; i++)
+	{
+	    b = &l->batch[i];
+	    if(b->total_lights <= 0)
+		continue;
+
+	    StateGLPointSize(state, b->size);
+	    glInterleavedArrays(GL_C4F_N3F_V3F, 0, b->vertex);
+	    glDrawArrays(GL_POINTS, 0, b->total_lights);
+
+	    l->frame_draws++;
+	}
+
+	glPopClientAttrib();
+
+#ifdef STATE_GL_VERSION_1_4
+	if(l->point_parameters)
+	{
+	    const GLfloat attenuation[3] = { 1.0f, 0.0f, 0.0f };
+	    glPointParameterfv(GL_POINT_DISTANCE_ATTENUATION, attenuation);
+	    glPointParameterf(GL_POINT_SIZE_MIN, 0.0f);
+	    glPointParameterf(GL_POINT_SIZE_MAX, size_max);
+	}
+#endif
+
+	/* The current color is undefined after drawing with a color
+	 * array
+	 */
+	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+	/* Restore GL states */
+	StateGLDisable(state, GL_POINT_SMOOTH);
+	StateGLPointSize(state, 1.0f);
+	StateGLDisable(state, GL_BLEND);
+	if(alpha_test)
+	    StateGLEnable(state, GL_ALPHA_TEST);
+	if(lighting)
+	    StateGLEnable(state, GL_LIGHTING);
+}
+
+/*
+ *	Deletes all the lights and batches.
+ */
+void SARDrawLightsClear(sar_draw_lights_struct *l)
+{
+	int i;
+
+	if(l == NULL)
+	    return;
+
+	for(i = 0; i < l->total_batches; i++)
+	    free(l->batch[i].vertex);
+	free(l->batch);
+	l->batch = NULL;
+	l->total_batches = 0;
+}
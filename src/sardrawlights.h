@@ -0,0 +1,105 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			    SAR Light Batches
+
+	The points of the lights of all the objects drawn on a
+	frame, in GL world coordinates. Points are drawn with one
+	GL point size at a time so the lights are put into one
+	vertex array per point size and each array is drawn with a
+	single glDrawArrays() after the objects.
+
+	Where GL 1.4 point parameters are available all the lights
+	are put into one array instead and drawn with one point size
+	that GL attenuates by the distance to each light.
+ */
+
+#ifndef SARDRAWLIGHTS_H
+#define SARDRAWLIGHTS_H
+
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+#include "stategl.h"
+
+
+/*
+ *	Number of GLfloats per light, the color (r, g, b, a), normal
+ *	(x, y, z), and position (x, y, z) as in the GL_C4F_N3F_V3F
+ *	interleaved array format.
+ */
+#define SAR_DRAW_LIGHT_VERTEX_SIZE		10
+
+/*
+ *	Light Batch:
+ *
+ *	The lights drawn with one point size.
+ */
+typedef struct {
+
+	GLfloat		size;		/* Point size in pixels */
+
+	/* Lights, each SAR_DRAW_LIGHT_VERTEX_SIZE GLfloats */
+	GLfloat		*vertex;
+	int		total_lights,
+			max_lights;
+
+} sar_draw_light_batch_struct;
+#define SAR_DRAW_LIGHT_BATCH(p)	((sar_draw_light_batch_struct *)(p))
+
+/*
+ *	Lights:
+ */
+typedef struct {
+
+	/* Light batches, one per point size and kept (with no
+	 * lights) from one frame to the next
+	 */
+	sar_draw_light_batch_struct	*batch;
+	int		total_batches;
+
+	/* Draw all the lights in one batch with the point size
+	 * attenuated by GL (GL 1.4 point parameters), checked on
+	 * each reset
+	 */
+	GLboolean	point_parameters;
+
+	/* Statistics of the last frame drawn */
+	int		frame_lights,
+			frame_draws;
+
+} sar_draw_lights_struct;
+#define SAR_DRAW_LIGHTS(p)	((sar_draw_lights_struct *)(p))
+
+
+extern void SARDrawLightsReset(
+	sar_draw_lights_struct *l, state_gl_struct *state
+);
+extern int SARDrawLightsAdd(
+	sar_draw_lights_struct *l,
+	GLfloat size,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+);
+extern void SARDrawLightsDraw(
+	sar_draw_lights_struct *l, state_gl_struct *state
+);
+extern void SARDrawLightsClear(sar_draw_lights_struct *l);
+
+
+#endif	/* SARDRAWLIGHTS_H */
@@ -0,0 +1,430 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sardrawocclusion.h"
+
+
+static int SARDrawOcclusionOccluderCompare(const void *a, const void *b);
+static void SARDrawOcclusionProject(
+	const sar_draw_occlusion_struct *o,
+	float gx, float gy, float gz,
+	float *sx, float *sy, float *w
+);
+static void SARDrawOcclusionTriangle(
+	sar_draw_occlusion_struct *o,
+	const float *v0, const float *v1, const float *v2
+);
+
+void SARDrawOcclusionReset(
+	sar_draw_occlusion_struct *o,
+	int width, int height,
+	const float *m, float fovz, float aspect, float near_clip
+);
+int SARDrawOcclusionAddOccluder(
+	sar_draw_occlusion_struct *o,
+	int obj_num, float distance
+);
+void SARDrawOcclusionSortOccluders(sar_draw_occlusion_struct *o);
+void SARDrawOcclusionAddBox(
+	sar_draw_occlusion_struct *o,
+	float x, float y, float z, float heading,
+	float length, float width, float height
+);
+int SARDrawOcclusionSphereVisible(
+	sar_draw_occlusion_struct *o,
+	float x, float y, float z, float radius
+);
+void SARDrawOcclusionClear(sar_draw_occlusion_struct *o);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)        (((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
+
+
+/*
+ *	qsort() callback for SARDrawOcclusionSortOccluders().
+ *
+ *	Occluders are sorted nearest first, ties are kept in object
+ *	order.
+ */
+static int SARDrawOcclusionOccluderCompare(const void *a, const void *b)
+{
+	const sar_draw_occluder_struct	*oa = SAR_DRAW_OCCLUDER(a),
+					*ob = SAR_DRAW_OCCLUDER(b);
+
+	if(oa->distance != ob->distance)
+	    return((oa->distance < ob->distance) ? -1 : 1);
+
+	return((oa->obj_num < ob->obj_num) ? -1 :
+	    ((oa->obj_num > ob->obj_num) ? 1 : 0)
+	);
+}
+
+/*
+ *	Projects the point in GL world coordinates onto the occlusion
+ *	buffer, returning its position in pixels and its eye depth
+ *	(in meters, positive in front of the camera).
+ */
+static void SARDrawOcclusionProject(
+	const sar_draw_occlusion_struct *o,
+	float gx, float gy, float gz,
+	float *sx, float *sy, float *w
+)
+{
+	const float *m = o->m;
+	const float	ex = (m[0] * gx) + (m[4] * gy) + (m[8] * gz) + m[12],
+			ey = (m[1] * gx) + (m[5] * gy) + (m[9] * gz) + m[13],
+			ez = (m[2] * gx) + (m[6] * gy) + (m[10] * gz) + m[14];
+
+	*w = -ez;
+	if(*w > 0.0f)
+	{
+	    *sx = ((ex / (*w * o->tx)) * 0.5f + 0.5f) * (float)o->width;
+	    *sy = ((ey / (*w * o->ty)) * 0.5f + 0.5f) * (float)o->height;
+	}
+	else
+	{
+	    *sx = 0.0f;
+	    *sy = 0.0f;
+	}
+}
+
+/*
+ *	Rasterizes the triangle into the occlusion buffer, each
+ *	vertex is the position in pixels and the reciprocal of the
+ *	eye depth (x, y, 1 / w).
+ *
+ *	Only the pixels whose centers are inside the triangle are
+ *	written, keeping the nearest depth on each pixel.
+ */
+static void SARDrawOcclusionTriangle(
+	sar_draw_occlusion_struct *o,
+	const float *v0, const float *v1, const float *v2
+)
+{
+	int x, y, x_min, x_max, y_min, y_max;
+	float area, px, py, e0, e1, e2, iw;
+	float *depth;
+
+	/* Twice the signed area, the edge functions are flipped on
+	 * clockwise triangles so that the inside is always positive
+	 */
+	area = ((v1[0] - v0[0]) * (v2[1] - v0[1])) -
+	    ((v1[1] - v0[1]) * (v2[0] - v0[0]));
+	if(area == 0.0f)
+	    return;
+
+	x_min = (int)floor(MIN(MIN(v0[0], v1[0]), v2[0]));
+	x_max = (int)floor(MAX(MAX(v0[0], v1[0]), v2[0]));
+	y_min = (int)floor(MIN(MIN(v0[1], v1[1]), v2[1]));
+	y_max = (int)floor(MAX(MAX(v0[1], v1[1]), v2[1]));
+	x_min = MAX(x_min, 0);
+	x_max = MIN(x_max, o->width - 1);
+	y_min = MAX(y_min, 0);
+	y_max = MIN(y_max, o->height - 1);
+
+	for(y = y_min; y <= y_max; y++)
+	{
+	    py = (float)y + 0.5f;
+	    depth = &o->depth[y * o->width];
+	    for(x = x_min; x <= x_max; x++)
+	    {
+		px = (float)x + 0.5f;
+		e0 = (((v2[0] - v1[0]) * (py - v1[1])) -
+		    ((v2[1] - v1[1]) * (px - v1[0]))) / area;
+		e1 = (((v0[0] - v2[0]) * (py - v2[1])) -
+		    ((v0[1] - v2[1]) * (px - v2[0]))) / area;
+		e2 = 1.0f - e0 - e1;
+		if((e0 < 0.0f) || (e1 < 0.0f) || (e2 < 0.0f))
+		    continue;
+
+		/* The reciprocal of the depth is linear in screen
+		 * space
+		 */
+		iw = (e0 * v0[2]) + (e1 * v1[2]) + (e2 * v2[2]);
+		if(iw > depth[x])
+		    depth[x] = iw;
+	    }
+	}
+}
+
+/*
+ *	Clears the occlusion buffer and the occluder candidates for
+ *	a new frame.
+ *
+ *	The m specifies the GL model view matrix of the camera (in
+ *	column major order), fovz the field of view about the z axis
+ *	(in radians), aspect the view's aspect, and near_clip the
+ *	near clip distance (in meters).
+ */
+void SARDrawOcclusionReset(
+	sar_draw_occlusion_struct *o,
+	int width, int height,
+	const float *m, float fovz, float aspect, float near_clip
+)
+{
+	if(o == NULL)
+	    return;
+
+	o->total_occluders = 0;
+	o->total_drawn = 0;
+
+	if((m == NULL) || (fovz <= 0.0f) || (aspect <= 0.0f) ||
+	   (width <= 0) || (height <= 0)
+	)
+	{
+	    o->width = 0;
+	    o->height = 0;
+	    return;
+	}
+
+	if((o->depth == NULL) ||
+	   (o->width != width) || (o->height != height)
+	)
+	{
+	    free(o->depth);
+	    o->depth = (float *)malloc(width * height * sizeof(float));
+	    if(o->depth == NULL)
+	    {
+		o->width = 0;
+		o->height = 0;
+		return;
+	    }
+	    o->width = width;
+	    o->height = height;
+	}
+	memset(o->depth, 0x00, width * height * sizeof(float));
+
+	memcpy(o->m, m, 16 * sizeof(float));
+	o->ty = (float)tan(fovz / 2.0f);
+	o->tx = o->ty * aspect;
+	o->near_clip = near_clip;
+}
+
+/*
+ *	Appends an occluder candidate.
+ *
+ *	Returns non-zero on error.
+ */
+int SARDrawOcclusionAddOccluder(
+	sar_draw_occlusion_struct *o,
+	int obj_num, float distance
+)
+{
+	sar_draw_occluder_struct *occluder;
+
+	if(o == NULL)
+	    return(-2);
+
+	if(o->total_occluders >= o->max_occluders)
+	{
+	    int n = MAX(o->max_occluders * 2, 32);
+	    occluder = SAR_DRAW_OCCLUDER(realloc(
+		o->occluder, n * sizeof(sar_draw_occluder_struct)
+	    ));
+	    if(occluder == NULL)
+		return(-3);
+
+	    o->occluder = occluder;
+	    o->max_occluders = n;
+	}
+
+	occluder = &o->occluder[o->total_occluders];
+	occluder->obj_num = obj_num;
+	occluder->distance = distance;
+	o->total_occluders++;
+
+	return(0);
+}
+
+/*
+ *	Sorts the occluder candidates nearest first.
+ */
+void SARDrawOcclusionSortOccluders(sar_draw_occlusion_struct *o)
+{
+	if(o == NULL)
+	    return;
+
+	if(o->total_occluders > 1)
+	    qsort(
+		o->occluder, o->total_occluders,
+		sizeof(sar_draw_occluder_struct),
+		SARDrawOcclusionOccluderCompare
+	    );
+}
+
+/*
+ *	Rasterizes the box at the given position with the given
+ *	heading (in radians) into the occlusion buffer.
+ *
+ *	The box is length long along its heading's x axis, width
+ *	wide, and height tall above the position, as a premodeled
+ *	building is drawn.
+ *
+ *	Triangles that cross the near clip plane are left out.
+ */
+void SARDrawOcclusionAddBox(
+	sar_draw_occlusion_struct *o,
+	float x, float y, float z, float heading,
+	float length, float width, float height
+)
+{
+	/* Corner indices of the two triangles of each face */
+	static const int face[12][3] = {
+		{0, 1, 2}, {0, 2, 3},		/* Bottom */
+		{4, 6, 5}, {4, 7, 6},		/* Top */
+		{0, 4, 5}, {0, 5, 1},
+		{1, 5, 6}, {1, 6, 2},
+		{2, 6, 7}, {2, 7, 3},
+		{3, 7, 4}, {3, 4, 0}
+	};
+	int i;
+	float lx, lz, w, c, s;
+	float v[8][3];
+
+	if((o == NULL) || (o->depth == NULL) || (o->width <= 0))
+	    return;
+
+	/* Project the corners, GL coordinates are (x, z, -y) with
+	 * the heading rotated about the GL y axis as SARDraw() does
+	 */
+	c = (float)cos(-heading);
+	s = (float)sin(-heading);
+	for(i = 0; i < 8; i++)
+	{
+	    lx = ((i == 0) || (i == 3) || (i == 4) || (i == 7)) ?
+		(-length / 2.0f) : (length / 2.0f);
+	    lz = -(((i & 3) < 2) ? (-width / 2.0f) : (width / 2.0f));
+	    SARDrawOcclusionProject(
+		o,
+		x + (lx * c) + (lz * s),
+		z + ((i < 4) ? 0.0f : height),
+		-y - (lx * s) + (lz * c),
+		&v[i][0], &v[i][1], &w
+	    );
+	    v[i][2] = (w > o->near_clip) ? (1.0f / w) : 0.0f;
+	}
+
+	for(i = 0; i < 12; i++)
+	{
+	    const float	*v0 = v[face[i][0]],
+			*v1 = v[face[i][1]],
+			*v2 = v[face[i][2]];
+
+	    if((v0[2] <= 0.0f) || (v1[2] <= 0.0f) || (v2[2] <= 0.0f))
+		continue;
+
+	    SARDrawOcclusionTriangle(o, v0, v1, v2);
+	}
+
+	o->total_drawn++;
+}
+
+/*
+ *	Checks if the sphere at the given position with the given
+ *	radius (in meters) may be visible past the occluders.
+ *
+ *	The sphere's screen bounds plus one pixel on each side must
+ *	be entirely covered by occluders nearer than the sphere's
+ *	nearest point for it to be occluded, so that pixels only
+ *	partly covered by the occluders never hide the sphere.
+ *
+ *	Returns non-zero if the sphere may be visible.
+ */
+int SARDrawOcclusionSphereVisible(
+	sar_draw_occlusion_struct *o,
+	float x, float y, float z, float radius
+)
+{
+	int px, py, x_min, x_max, y_min, y_max;
+	float ex, ey, ez, w_near, w_far, iw_near, sx_min, sx_max,
+		sy_min, sy_max;
+	const float *depth, *m;
+
+	if((o == NULL) || (o->depth == NULL) || (o->total_drawn <= 0))
+	    return(1);
+
+	/* Eye coordinates of the center, the nearest point is kept
+	 * a meter closer so that rounding never lets an occluder
+	 * hide itself
+	 */
+	m = o->m;
+	ex = (m[0] * x) + (m[4] * z) + (m[8] * -y) + m[12];
+	ey = (m[1] * x) + (m[5] * z) + (m[9] * -y) + m[13];
+	ez = (m[2] * x) + (m[6] * z) + (m[10] * -y) + m[14];
+	w_near = -ez - radius - 1.0f;
+	if(w_near <= o->near_clip)
+	    return(1);
+	w_far = -ez + radius;
+	iw_near = 1.0f / w_near;
+
+	/* Screen bounds of the box about the sphere */
+	sx_min = MIN((ex - radius) / w_near, (ex - radius) / w_far);
+	sx_max = MAX((ex + radius) / w_near, (ex + radius) / w_far);
+	sy_min = MIN((ey - radius) / w_near, (ey - radius) / w_far);
+	sy_max = MAX((ey + radius) / w_near, (ey + radius) / w_far);
+	sx_min = ((sx_min / o->tx) * 0.5f + 0.5f) * (float)o->width;
+	sx_max = ((sx_max / o->tx) * 0.5f + 0.5f) * (float)o->width;
+	sy_min = ((sy_min / o->ty) * 0.5f + 0.5f) * (float)o->height;
+	sy_max = ((sy_max / o->ty) * 0.5f + 0.5f) * (float)o->height;
+
+	x_min = (int)floor(CLIP(sx_min, -2.0f, (float)o->width + 1.0f)) - 1;
+	x_max = (int)floor(CLIP(sx_max, -2.0f, (float)o->width + 1.0f)) + 1;
+	y_min = (int)floor(CLIP(sy_min, -2.0f, (float)o->height + 1.0f)) - 1;
+	y_max = (int)floor(CLIP(sy_max, -2.0f, (float)o->height + 1.0f)) + 1;
+	x_min = MAX(x_min, 0);
+	x_max = MIN(x_max, o->width - 1);
+	y_min = MAX(y_min, 0);
+	y_max = MIN(y_max, o->height - 1);
+	if((x_min > x_max) || (y_min > y_max))
+	    return(1);
+
+	for(py = y_min; py <= y_max; py++)
+	{
+	    depth = &o->depth[py * o->width];
+	    for(px = x_min; px <= x_max; px++)
+	    {
+		if(depth[px] <= iw_near)
+		    return(1);
+	    }
+	}
+
+	return(0);
+}
+
+/*
+ *	Deletes the occlusion buffer and the occluder candidates.
+ */
+void SARDrawOcclusionClear(sar_draw_occlusion_struct *o)
+{
+	if(o == NULL)
+	    return;
+
+	free(o->depth);
+	o->depth = NULL;
+	o->width = 0;
+	o->height = 0;
+	o->total_drawn = 0;
+
+	free(o->occluder);
+	o->occluder = NULL;
+	o->total_occluders = 0;
+	o->max_occluders = 0;
+}
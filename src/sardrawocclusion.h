@@ -0,0 +1,106 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			SAR Occlusion Culling
+
+	A small software depth buffer that the nearest large
+	occluders (the boxes of premodeled buildings) are rasterized
+	into before the objects of a frame are queued, objects whose
+	bounding sphere is entirely behind the occluders are not
+	drawn.
+
+	All positions and headings are in world coordinates (not GL
+	coordinates).
+ */
+
+#ifndef SARDRAWOCCLUSION_H
+#define SARDRAWOCCLUSION_H
+
+
+/*
+ *	Occluder candidate:
+ */
+typedef struct {
+
+	int		obj_num;	/* Object index */
+	float		distance;	/* Distance from the camera in
+					 * meters */
+
+} sar_draw_occluder_struct;
+#define SAR_DRAW_OCCLUDER(p)	((sar_draw_occluder_struct *)(p))
+
+/*
+ *	Occlusion buffer:
+ */
+typedef struct {
+
+	/* Reciprocal of the eye depth (1 / w) of the nearest
+	 * occluder on each pixel, 0.0 where there is none
+	 */
+	float		*depth;
+	int		width, height;
+
+	/* GL model view matrix of the camera (column major order),
+	 * the slopes of the view's sides, and the near clip distance
+	 * (in meters)
+	 */
+	float		m[16];
+	float		tx, ty;
+	float		near_clip;
+
+	int		total_drawn;	/* Occluders rasterized this frame */
+
+	/* Occluder candidates of the current frame */
+	sar_draw_occluder_struct	*occluder;
+	int		total_occluders,
+			max_occluders;
+
+	/* Statistics of the last frame drawn, the number of
+	 * occluders rasterized and of objects tested and found to
+	 * be occluded
+	 */
+	int		frame_occluders,
+			frame_tested,
+			frame_occluded;
+
+} sar_draw_occlusion_struct;
+#define SAR_DRAW_OCCLUSION(p)	((sar_draw_occlusion_struct *)(p))
+
+
+extern void SARDrawOcclusionReset(
+	sar_draw_occlusion_struct *o,
+	int width, int height,
+	const float *m, float fovz, float aspect, float near_clip
+);
+extern int SARDrawOcclusionAddOccluder(
+	sar_draw_occlusion_struct *o,
+	int obj_num, float distance
+);
+extern void SARDrawOcclusionSortOccluders(sar_draw_occlusion_struct *o);
+extern void SARDrawOcclusionAddBox(
+	sar_draw_occlusion_struct *o,
+	float x, float y, float z, float heading,
+	float length, float width, float height
+);
+extern int SARDrawOcclusionSphereVisible(
+	sar_draw_occlusion_struct *o,
+	float x, float y, float z, float radius
+);
+extern void SARDrawOcclusionClear(sar_draw_occlusion_struct *o);
+
+
+#endif	/* SARDRAWOCCLUSION_H */
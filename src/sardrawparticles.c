@@ -0,0 +1,342 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+
+#include "v3dtex.h"
+#include "stategl.h"
+#include "sardrawparticles.h"
+
+
+static sar_draw_particle_batch_struct *SARDrawParticlesGetBatch(
+	sar_draw_particles_struct *p, v3d_texture_ref_struct *t
+);
+
+void SARDrawParticlesReset(sar_draw_particles_struct *p);
+int SARDrawParticlesAddQuad(
+	sar_draw_particles_struct *p,
+	v3d_texture_ref_struct *t,
+	GLfloat x, GLfloat y, GLfloat z, GLfloat r
+);
+int SARDrawParticlesAddPoint(
+	sar_draw_particles_struct *p,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+);
+void SARDrawParticlesDraw(
+	sar_draw_particles_struct *p, state_gl_struct *state
+);
+void SARDrawParticlesClear(sar_draw_particles_struct *p);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)        (((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
+
+
+/*
+ *	Returns the quad batch for the texture, a new batch is
+ *	appended if there is no batch for the texture yet.
+ *
+ *	Returns NULL on error.
+ */
+static sar_draw_particle_batch_struct *SARDrawParticlesGetBatch(
+	sar_draw_particles_struct *p, v3d_texture_ref_struct *t
+)
+{
+	int i;
+	sar_draw_particle_batch_struct *b;
+
+	for(i = 0; i < p->total_batches; i++)
+	{
+	    b = &p->batch[i];
+	    if(b->texture == t)
+		return(b);
+	}
+
+	b = SAR_DRAW_PARTICLE_BATCH(realloc(
+	    p->batch,
+	    (p->total_batches + 1) * sizeof(sar_draw_particle_batch_struct)
+	));
+	if(b == NULL)
+	    return(NULL);
+
+	p->batch = b;
+	b = &p->batch[p->total_batches];
+	memset(b, 0x00, sizeof(sar_draw_particle_batch_struct));
+	b->texture = t;
+	p->total_batches++;
+
+	return(b);
+}
+
+/*
+ *	Removes all the quads and points, the allocated arrays are
+ *	kept for the next frame.
+ *
+ *	The camera's right and up vectors are taken from the current
+ *	GL modelview matrix, which must only have the camera's
+ *	rotations and translations on it.
+ */
+void SARDrawParticlesReset(sar_draw_particles_struct *p)
+{
+	int i;
+	GLfloat m[16];
+
+	if(p == NULL)
+	    return;
+
+	for(i = 0; i < p->total_batches; i++)
+	    p->batch[i].total_quads = 0;
+	p->total_points = 0;
+
+	/* The rows of the modelview matrix's rotation are the
+	 * camera's axises in world coordinates
+	 */
+	glGetFloatv(GL_MODELVIEW_MATRIX, m);
+	for(i = 0; i < 3; i++)
+	{
+	    p->right[i] = m[(i * 4) + 0];
+	    p->up[i] = m[(i * 4) + 1];
+	}
+}
+
+/*
+ *	Appends a camera facing quad centered at x, y, z with the
+ *	half size r (all in GL world coordinates) to the texture's
+ *	batch, t may be NULL for no texture.
+ *
+ *	Returns non-zero on error.
+ */
+int SARDrawParticlesAddQuad(
+	sar_draw_particles_struct *p,
+	v3d_texture_ref_struct *t,
+	GLfloat x, GLfloat y, GLfloat z, GLfloat r
+)
+{
+	int i;
+	GLfloat rx, ry, rz, ux, uy, uz, *v;
+	sar_draw_particle_batch_struct *b;
+	/* Corners along the right and up vectors and their texture
+	 * coordinates
+	 */
+	static const GLfloat corner[4][4] = {
+	    { -1.0f, -1.0f,	0.0f, 1.0f },
+	    {  1.0f, -1.0f,	1.0f, 1.0f },
+	    {  1.0f,  1.0f,	1.0f, 0.0f },
+	    { -1.0f,  1.0f,	0.0f, 0.0f }
+	};
+
+	if(p == NULL)
+	    return(-2);
+
+	b = SARDrawParticlesGetBatch(p, t);
+	if(b == NULL)
+	    return(-3);
+
+	if(b->total_quads >= b->max_quads)
+	{
+	    int n = MAX(b->max_quads * 2, 64);
+	    v = (GLfloat *)realloc(
+		b->vertex,
+		n * 4 * SAR_DRAW_PARTICLE_QUAD_VERTEX_SIZE * sizeof(GLfloat)
+	    );
+	    if(v == NULL)
+		return(-3);
+
+	    b->vertex = v;
+	    b->max_quads = n;
+	}
+
+	rx = p->right[0] * r;
+	ry = p->right[1] * r;
+	rz = p->right[2] * r;
+	ux = p->up[0] * r;
+	uy = p->up[1] * r;
+	uz = p->up[2] * r;
+
+	v = &b->vertex[
+	    b->total_quads * 4 * SAR_DRAW_PARTICLE_QUAD_VERTEX_SIZE
+	];
+	for(i = 0; i < 4; i++)
+	{
+	    const GLfloat *c = corner[i];
+	    v[0] = c[2];
+	    v[1] = c[3];
+	    v[2] = p->up[0];
+	    v[3] = p->up[1];
+	    v[4] = p->up[2];
+	    v[5] = x + (c[0] * rx) + (c[1] * ux);
+	    v[6] = y + (c[0] * ry) + (c[1] * uy);
+	    v[7] = z + (c[0] * rz) + (c[1] * uz);
+	    v += SAR_DRAW_PARTICLE_QUAD_VERTEX_SIZE;
+	}
+	b->total_quads++;
+
+	return(0);
+}
+
+/*
+ *	Appends a point at x, y, z (in GL world coordinates) with the
+ *	color r, g, b, a.
+ *
+ *	Returns non-zero on error.
+ */
+int SARDrawParticlesAddPoint(
+	sar_draw_particles_struct *p,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+)
+{
+	GLfloat *v;
+
+	if(p == NULL)
+	    return(-2);
+
+	if(p->total_points >= p->max_points)
+	{
+	    int n = MAX(p->max_points * 2, 64);
+	    v = (GLfloat *)realloc(
+		p->point,
+		n * SAR_DRAW_PARTICLE_POINT_SIZE * sizeof(GLfloat)
+	    );
+	    if(v == NULL)
+		return(-3);
+
+	    p->point = v;
+	    p->max_points = n;
+	}
+
+	v = &p->point[p->total_points * SAR_DRAW_PARTICLE_POINT_SIZE];
+	v[0] = r;
+	v[1] = g;
+	v[2] = b;
+	v[3] = a;
+	v[4] = 0.0f;
+	v[5] = 1.0f;
+	v[6] = 0.0f;
+	v[7] = x;
+	v[8] = y;
+	v[9] = z;
+	p->total_points++;
+
+	return(0);
+}
+
+/*
+ *	Draws all the quads, one glDrawArrays() per texture, and then
+ *	all the points with one glDrawArrays().
+ *
+ *	The modelview matrix must be the same as when
+ *	SARDrawParticlesReset() was called. The quads are drawn with
+ *	the current lighting and the points without lighting.
+ */
+void SARDrawParticlesDraw(
+	sar_draw_particles_struct *p, state_gl_struct *state
+)
+{
+	int i;
+	GLenum shade_model_mode;
+	StateGLBoolean lighting;
+	const sar_draw_particle_batch_struct *b;
+
+	if(p == NULL)
+	    return;
+
+	p->frame_quads = 0;
+	p->frame_points = 0;
+	p->frame_draws = 0;
+
+	shade_model_mode = state->shade_model_mode;
+	lighting = state->lighting;
+
+	StateGLShadeModel(state, GL_FLAT);
+	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+
+	/* Quads, one draw per texture */
+	for(i = 0; i < p->total_batches; i++)
+	{
+	    b = &p->batch[i];
+	    if(b->total_quads <= 0)
+		continue;
+
+	    V3DTextureSelect(b->texture);
+	    glInterleavedArrays(GL_T2F_N3F_V3F, 0, b->vertex);
+	    glDrawArrays(GL_QUADS, 0, b->total_quads * 4);
+
+	    p->frame_quads += b->total_quads;
+	    p->frame_draws++;
+	}
+
+	/* Points */
+	if(p->total_points > 0)
+	{
+	    V3DTextureSelect(NULL);
+	    StateGLDisable(state, GL_LIGHTING);
+	    StateGLEnable(state, GL_POINT_SMOOTH);
+	    StateGLPointSize(state, 2.0f);
+
+	    glInterleavedArrays(GL_C4F_N3F_V3F, 0, p->point);
+	    glDrawArrays(GL_POINTS, 0, p->total_points);
+
+	    StateGLDisable(state, GL_POINT_SMOOTH);
+	    StateGLPointSize(state, 1.0f);
+	    if(lighting)
+		StateGLEnable(state, GL_LIGHTING);
+
+	    /* The current color is undefined after drawing with a
+	     * color array
+	     */
+	    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+	    p->frame_points = p->total_points;
+	    p->frame_draws++;
+	}
+
+	glPopClientAttrib();
+
+	/* Restore GL states */
+	StateGLShadeModel(state, shade_model_mode);
+}
+
+/*
+ *	Deletes all the quads, points, and batches.
+ */
+void SARDrawParticlesClear(sar_draw_particles_struct *p)
+{
+	int i;
+
+	if(p == NULL)
+	    return;
+
+	for(i = 0; i < p->total_batches; i++)
+	    free(p->batch[i].vertex);
+	free(p->batch);
+	p->batch = NULL;
+	p->total_batches = 0;
+
+	free(p->point);
+	p->point = NULL;
+	p->total_points = 0;
+	p->max_points = 0;
+}
@@ -0,0 +1,119 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			  SAR Particle Batches
+
+	Camera facing quads of the smoke puffs and the points of
+	the sparks of all the smoke objects drawn on a frame, put
+	into one vertex array per texture so that each texture's
+	quads and all the points are drawn with a single
+	glDrawArrays().
+ */
+
+#ifndef SARDRAWPARTICLES_H
+#define SARDRAWPARTICLES_H
+
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+#include "v3dtex.h"
+#include "stategl.h"
+
+
+/*
+ *	Number of GLfloats per quad vertex, the texture coordinates
+ *	(s, t), normal (x, y, z), and position (x, y, z) as in the
+ *	GL_T2F_N3F_V3F interleaved array format.
+ */
+#define SAR_DRAW_PARTICLE_QUAD_VERTEX_SIZE	8
+
+/*
+ *	Number of GLfloats per point, the color (r, g, b, a), normal
+ *	(x, y, z), and position (x, y, z) as in the GL_C4F_N3F_V3F
+ *	interleaved array format.
+ */
+#define SAR_DRAW_PARTICLE_POINT_SIZE		10
+
+/*
+ *	Particle Batch:
+ *
+ *	The quads drawn with one texture.
+ */
+typedef struct {
+
+	v3d_texture_ref_struct	*texture;	/* Can be NULL */
+
+	/* Four vertices per quad, each
+	 * SAR_DRAW_PARTICLE_QUAD_VERTEX_SIZE GLfloats
+	 */
+	GLfloat		*vertex;
+	int		total_quads,
+			max_quads;
+
+} sar_draw_particle_batch_struct;
+#define SAR_DRAW_PARTICLE_BATCH(p)	((sar_draw_particle_batch_struct *)(p))
+
+/*
+ *	Particles:
+ */
+typedef struct {
+
+	/* Quad batches, one per texture and kept (with no quads)
+	 * from one frame to the next
+	 */
+	sar_draw_particle_batch_struct	*batch;
+	int		total_batches;
+
+	/* Points, each SAR_DRAW_PARTICLE_POINT_SIZE GLfloats */
+	GLfloat		*point;
+	int		total_points,
+			max_points;
+
+	/* Camera right and up unit vectors in GL world coordinates,
+	 * set by SARDrawParticlesReset()
+	 */
+	GLfloat		right[3],
+			up[3];
+
+	/* Statistics of the last frame drawn */
+	int		frame_quads,
+			frame_points,
+			frame_draws;
+
+} sar_draw_particles_struct;
+#define SAR_DRAW_PARTICLES(p)	((sar_draw_particles_struct *)(p))
+
+
+extern void SARDrawParticlesReset(sar_draw_particles_struct *p);
+extern int SARDrawParticlesAddQuad(
+	sar_draw_particles_struct *p,
+	v3d_texture_ref_struct *t,
+	GLfloat x, GLfloat y, GLfloat z, GLfloat r
+);
+extern int SARDrawParticlesAddPoint(
+	sar_draw_particles_struct *p,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat r, GLfloat g, GLfloat b, GLfloat a
+);
+extern void SARDrawParticlesDraw(
+	sar_draw_particles_struct *p, state_gl_struct *state
+);
+extern void SARDrawParticlesClear(sar_draw_particles_struct *p);
+
+
+#endif	/* SARDRAWPARTICLES_H */
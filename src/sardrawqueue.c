@@ -0,0 +1,156 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "sardrawqueue.h"
+
+
+static int SARDrawQueueItemCompare(const void *a, const void *b);
+
+void SARDrawQueueReset(sar_draw_queue_struct *q);
+int SARDrawQueueAdd(
+	sar_draw_queue_struct *q,
+	int obj_num, int pass, int segment,
+	unsigned int state, const void *model, float depth
+);
+void SARDrawQueueSort(sar_draw_queue_struct *q);
+void SARDrawQueueClear(sar_draw_queue_struct *q);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)        (((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
+
+
+/*
+ *	qsort() callback for SARDrawQueueSort().
+ *
+ *	Opaque items are sorted by segment, GL states, visual model,
+ *	and then front to back. Translucent items are sorted back to
+ *	front. Ties are kept in object order.
+ */
+static int SARDrawQueueItemCompare(const void *a, const void *b)
+{
+	const sar_draw_item_struct	*ia = SAR_DRAW_ITEM(a),
+					*ib = SAR_DRAW_ITEM(b);
+
+	if(ia->pass != ib->pass)
+	    return((ia->pass < ib->pass) ? -1 : 1);
+
+	if(ia->pass == SAR_DRAW_PASS_TRANSLUCENT)
+	{
+	    if(ia->depth != ib->depth)
+		return((ia->depth > ib->depth) ? -1 : 1);
+	}
+	else
+	{
+	    if(ia->segment != ib->segment)
+		return((ia->segment < ib->segment) ? -1 : 1);
+	    if(ia->state != ib->state)
+		return((ia->state < ib->state) ? -1 : 1);
+	    if(ia->model != ib->model)
+		return((ia->model < ib->model) ? -1 : 1);
+	    if(ia->depth != ib->depth)
+		return((ia->depth < ib->depth) ? -1 : 1);
+	}
+
+	return((ia->obj_num < ib->obj_num) ? -1 :
+	    ((ia->obj_num > ib->obj_num) ? 1 : 0)
+	);
+}
+
+/*
+ *	Removes all the items from the draw queue, the allocated
+ *	items are kept for the next frame.
+ */
+void SARDrawQueueReset(sar_draw_queue_struct *q)
+{
+	if(q == NULL)
+	    return;
+
+	q->total_items = 0;
+}
+
+/*
+ *	Appends an item to the draw queue.
+ *
+ *	Returns non-zero on error.
+ */
+int SARDrawQueueAdd(
+	sar_draw_queue_struct *q,
+	int obj_num, int pass, int segment,
+	unsigned int state, const void *model, float depth
+)
+{
+	sar_draw_item_struct *item;
+
+	if(q == NULL)
+	    return(-2);
+
+	if(q->total_items >= q->max_items)
+	{
+	    int n = MAX(q->max_items * 2, 64);
+	    item = SAR_DRAW_ITEM(realloc(
+		q->item, n * sizeof(sar_draw_item_struct)
+	    ));
+	    if(item == NULL)
+		return(-3);
+
+	    q->item = item;
+	    q->max_items = n;
+	}
+
+	item = &q->item[q->total_items];
+	item->obj_num = obj_num;
+	item->pass = pass;
+	item->segment = segment;
+	item->state = state;
+	item->model = model;
+	item->depth = depth;
+	q->total_items++;
+
+	return(0);
+}
+
+/*
+ *	Sorts the draw queue into drawing order.
+ */
+void SARDrawQueueSort(sar_draw_queue_struct *q)
+{
+	if(q == NULL)
+	    return;
+
+	if(q->total_items > 1)
+	    qsort(
+		q->item, q->total_items, sizeof(sar_draw_item_struct),
+		SARDrawQueueItemCompare
+	    );
+}
+
+/*
+ *	Deletes all the items on the draw queue.
+ */
+void SARDrawQueueClear(sar_draw_queue_struct *q)
+{
+	if(q == NULL)
+	    return;
+
+	free(q->item);
+	q->item = NULL;
+	q->total_items = 0;
+	q->max_items = 0;
+}
@@ -0,0 +1,95 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			 SAR Draw Queue
+ */
+
+#ifndef SARDRAWQUEUE_H
+#define SARDRAWQUEUE_H
+
+
+/*
+ *	Draw passes, drawn in this order:
+ */
+#define SAR_DRAW_PASS_OPAQUE		0	/* Front to back */
+#define SAR_DRAW_PASS_TRANSLUCENT	1	/* Back to front */
+
+/*
+ *	Draw item state flags, the GL states that SARDraw() sets for
+ *	the object before drawing it:
+ */
+#define SAR_DRAW_STATE_NO_DEPTH_TEST	(1 << 0)
+#define SAR_DRAW_STATE_SHADE_SMOOTH	(1 << 1)
+#define SAR_DRAW_STATE_POLYGON_OFFSET	(1 << 2)
+#define SAR_DRAW_STATE_POLYGON_OFFSET_REVERSE	(1 << 3)
+
+/*
+ *	Draw item:
+ */
+typedef struct {
+
+	int		obj_num;	/* Object index */
+	int		pass;		/* One of SAR_DRAW_PASS_* */
+
+	/* Items on the same pass are only sorted with the other
+	 * items in the same segment, segments are drawn in order
+	 */
+	int		segment;
+
+	unsigned int	state;		/* Any of SAR_DRAW_STATE_* */
+	const void	*model;		/* Visual model, can be NULL */
+	float		depth;		/* Distance from the camera in
+					 * meters */
+
+} sar_draw_item_struct;
+#define SAR_DRAW_ITEM(p)	((sar_draw_item_struct *)(p))
+
+/*
+ *	Draw queue:
+ *
+ *	The objects to draw each frame, sorted to draw objects with
+ *	the same GL states and visual model one after the other.
+ */
+typedef struct {
+
+	sar_draw_item_struct	*item;
+	int		total_items,
+			max_items;
+
+	/* Statistics of the last frame drawn, the number of items
+	 * drawn and how many times the GL states and the visual
+	 * model changed from one item to the next
+	 */
+	int		frame_items,
+			frame_state_switches,
+			frame_model_switches;
+
+} sar_draw_queue_struct;
+#define SAR_DRAW_QUEUE(p)	((sar_draw_queue_struct *)(p))
+
+
+extern void SARDrawQueueReset(sar_draw_queue_struct *q);
+extern int SARDrawQueueAdd(
+	sar_draw_queue_struct *q,
+	int obj_num, int pass, int segment,
+	unsigned int state, const void *model, float depth
+);
+extern void SARDrawQueueSort(sar_draw_queue_struct *q);
+extern void SARDrawQueueClear(sar_draw_queue_struct *q);
+
+
+#endif	/* SARDRAWQUEUE_H */
@@ -23,6 +23,7 @@
 #include <GL/gl.h>
 #include <GL/glu.h>
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "matrixmath.h"
@@ -36,6 +37,21 @@
 #include "config.h"
 
 
+static sar_mesh_struct *SARDrawRunwaySurfaceMesh(
+	sar_dc_struct *dc,
+	sar_object_runway_struct *runway,
+	v3d_texture_ref_struct *t
+);
+static int SARDrawRunwayAddLight(
+	sar_object_runway_struct *runway,
+	GLfloat x, GLfloat y, GLfloat z,
+	const GLfloat *c
+);
+static void SARDrawRunwayLightsUpdate(
+	sar_object_runway_struct *runway,
+	float edge_spacing, int colors
+);
+
 void SARDrawRunway(
 	sar_dc_struct *dc, sar_object_struct *obj_ptr,
 	sar_object_runway_struct *runway,
@@ -48,6 +64,387 @@ void SARDrawRunwayMap(
 );
 
 
+/*
+ *	Runway light colors, the colors that the runway's lights were
+ *	set up with.
+ *
+ *	The NORTH_GREEN and SOUTH_GREEN colors mean that the north or
+ *	south threshold lights are green instead of red.
+ */
+#define SAR_RUNWAY_LIGHT_COLORS_SET		(1 << 0)
+#define SAR_RUNWAY_LIGHT_COLORS_FLIR		(1 << 1)
+#define SAR_RUNWAY_LIGHT_COLORS_NORTH_GREEN	(1 << 2)
+#define SAR_RUNWAY_LIGHT_COLORS_SOUTH_GREEN	(1 << 3)
+
+
+/*
+ *	Builds the mesh of the runway's background, dashes, and
+ *	borders.
+ *
+ *	The visual models of the markings are not put on the mesh,
+ *	they are already meshes (or GL display lists) of their own.
+ *
+ *	Returns the new mesh or NULL on error.
+ */
+static sar_mesh_struct *SARDrawRunwaySurfaceMesh(
+	sar_dc_struct *dc,
+	sar_object_runway_struct *runway,
+	v3d_texture_ref_struct *t
+)
+{
+	gw_display_struct *display = dc->display;
+	sar_mesh_struct *mesh;
+	float	length = runway->length,
+		width = runway->width;
+	float	x_min, x_max,
+		y_min, y_max,
+		yt_min, yt_max;
+
+	/* Calculate bounds */
+	y_max = (float)(length * 0.5);
+	y_min = -y_max;
+	x_max = (float)(width * 0.5);
+	x_min = -x_max;
+
+	/* Calculate threshold bounds */
+	yt_max = y_max - runway->north_displaced_threshold;
+	yt_min = y_min + runway->south_displaced_threshold;
+
+	mesh = SARMeshNew(&display->state_gl);
+	if(mesh == NULL)
+	    return(NULL);
+
+	/* Background, textured if the texture is available */
+	if(t == NULL)
+	    SARMeshSetColor(mesh, 0.5f, 0.5f, 0.5f, 1.0f);
+	else
+	    SARMeshSetColor(mesh, 1.0f, 1.0f, 1.0f, 1.0f);
+	SARMeshSetTexture(mesh, t);
+	SARMeshBegin(mesh, GL_QUADS);
+	SARMeshNormal(mesh, 0.0f, 1.0f, 0.0f);
+	SARMeshTexCoord(mesh, 0.0f, 1.0f - 0.0f);
+	SARMeshVertex(mesh, x_min, 0.0f, -y_max);
+	SARMeshTexCoord(mesh, 0.0f, 1.0f - 1.0f);
+	SARMeshVertex(mesh, x_min, 0.0f, -y_min);
+	SARMeshTexCoord(mesh, 1.0f, 1.0f - 1.0f);
+	SARMeshVertex(mesh, x_max, 0.0f, -y_min);
+	SARMeshTexCoord(mesh, 1.0f, 1.0f - 0.0f);
+	SARMeshVertex(mesh, x_max, 0.0f, -y_max);
+	SARMeshEnd(mesh);
+
+	/* The markings are white and not textured */
+	SARMeshSetTexture(mesh, NULL);
+	SARMeshSetColor(mesh, 1.0f, 1.0f, 1.0f, 1.0f);
+	SARMeshTexCoord(mesh, 0.0f, 0.0f);
+
+	/* Dashes */
+	if(runway->dashes > 0)
+	{
+	    int	dashes = runway->dashes;
+	    float	dash_width_max = (float)(width * 0.025),
+			dash_width_min = -dash_width_max,
+			dash_spacing = (float)MAX(
+			    (yt_max - yt_min) /
+			    ((dashes * 2) + 1),
+			    1.0
+			),
+			dash_cur;
+
+	    SARMeshBegin(mesh, GL_QUADS);
+	    for(dash_cur = yt_min + dash_spacing;
+		(dash_cur + dash_spacing) < yt_max;
+		dash_cur += (float)(dash_spacing * 2)
+	    )
+	    {
+		SARMeshVertex(
+		    mesh, dash_width_min, 0.0f, -(dash_cur + dash_spacing)
+		);
+		SARMeshVertex(
+		    mesh, dash_width_min, 0.0f, -dash_cur
+		);
+		SARMeshVertex(
+		    mesh, dash_width_max, 0.0f, -dash_cur
+		);
+		SARMeshVertex(
+		    mesh, dash_width_max, 0.0f, -(dash_cur + dash_spacing)
+		);
+	    }
+	    SARMeshEnd(mesh);
+	}
+
+	/* Borders */
+	if(runway->flags & SAR_RUNWAY_FLAG_BORDERS)
+	{
+	    SARMeshBegin(mesh, GL_QUADS);
+	    SARMeshVertex(mesh, x_min, 0.0f, -yt_min);
+	    SARMeshVertex(mesh, (GLfloat)(x_min * 0.95), 0.0f, -yt_min);
+	    SARMeshVertex(mesh, (GLfloat)(x_min * 0.95), 0.0f, -yt_max);
+	    SARMeshVertex(mesh, x_min, 0.0f, -yt_max);
+
+	    SARMeshVertex(mesh, (GLfloat)(x_max * 0.95), 0.0f, -yt_min);
+	    SARMeshVertex(mesh, x_max, 0.0f, -yt_min);
+	    SARMeshVertex(mesh, x_max, 0.0f, -yt_max);
+	    SARMeshVertex(mesh, (GLfloat)(x_max * 0.95), 0.0f, -yt_max);
+	    SARMeshEnd(mesh);
+	}
+
+	if(SARMeshFinish(mesh))
+	{
+	    SARMeshDelete(mesh);
+	    return(NULL);
+	}
+
+	return(mesh);
+}
+
+/*
+ *	Appends a light with the position x, y, z (in GL coordinates)
+ *	and the color c (4 GLfloats) to the runway's lights.
+ */
+static int SARDrawRunwayAddLight(
+	sar_object_runway_struct *runway,
+	GLfloat x, GLfloat y, GLfloat z,
+	const GLfloat *c
+)
+{
+	int n = runway->total_lights;
+	GLfloat *v;
+
+	if(n >= runway->max_lights)
+	{
+	    const int max_lights = MAX(runway->max_lights * 2, 64);
+
+	    /* If only light_vertex gets grown then max_lights is left
+	     * as is and the next call tries light_color again
+	     */
+	    v = (GLfloat *)realloc(
+		runway->light_vertex,
+		max_lights * 3 * sizeof(GLfloat)
+	    );
+	    if(v == NULL)
+		return(-1);
+	    runway->light_vertex = v;
+
+	    v = (GLfloat *)realloc(
+		runway->light_color,
+		max_lights * 4 * sizeof(GLfloat)
+	    );
+	    if(v == NULL)
+		return(-1);
+	    runway->light_color = v;
+
+	    runway->max_lights = max_lights;
+	}
+
+	v = &runway->light_vertex[n * 3];
+	v[0] = x;
+	v[1] = y;
+	v[2] = z;
+	memcpy(&runway->light_color[n * 4], c, 4 * sizeof(GLfloat));
+
+	runway->total_lights = n + 1;
+
+	return(0);
+}
+
+/*
+ *	Sets up the runway's edge, alignment, ILS, and threshold
+ *	lights with the given edge light spacing (in meters) and
+ *	colors.
+ */
+static void SARDrawRunwayLightsUpdate(
+	sar_object_runway_struct *runway,
+	float edge_spacing, int colors
+)
+{
+	int i;
+	sar_runway_approach_lighting_flags	n_app_flags =
+		runway->north_approach_lighting_flags,
+						s_app_flags =
+		runway->south_approach_lighting_flags;
+	const GLfloat	white[4] = { 1.0f, 1.0f, 1.0f, 1.0f },
+			red[4] = { 1.0f, 0.0f, 0.0f, 1.0f },
+			green[4] = { 0.0f, 1.0f, 0.0f, 1.0f },
+			grey[4] = { 0.7f, 0.7f, 0.7f, 1.0f };
+	const GLfloat *ils_c, *north_c, *south_c;
+	float	x, y, p,
+		x_spacing, y_spacing,
+		length = runway->length,
+		width = runway->width;
+	float	x_min, x_max,
+		y_min, y_max,
+		yt_min, yt_max;
+
+	/* Calculate bounds */
+	y_max = (float)(length * 0.5);
+	y_min = -y_max;
+	x_max = (float)(width * 0.5);
+	x_min = -x_max;
+
+	/* Calculate threshold bounds */
+	yt_max = y_max - runway->north_displaced_threshold;
+	yt_min = y_min + runway->south_displaced_threshold;
+
+	/* Colors of the ILS and threshold lights */
+	if(colors & SAR_RUNWAY_LIGHT_COLORS_FLIR)
+	{
+	    ils_c = grey;
+	    north_c = white;
+	    south_c = white;
+	}
+	else
+	{
+	    ils_c = red;
+	    north_c = (colors & SAR_RUNWAY_LIGHT_COLORS_NORTH_GREEN) ?
+		green : red;
+	    south_c = (colors & SAR_RUNWAY_LIGHT_COLORS_SOUTH_GREEN) ?
+		green : red;
+	}
+
+	runway->total_lights = 0;
+	runway->light_edge_spacing = edge_spacing;
+	runway->light_colors = colors;
+
+	/* Edge lighting */
+	if(runway->edge_light_spacing > 0.0f)
+	{
+	    float lighting_length = yt_max - yt_min;
+
+	    for(p = 0; p < lighting_length; p += edge_spacing)
+	    {
+		SARDrawRunwayAddLight(
+		    runway, x_min, 0.0f, -(yt_min + p), white
+		);
+		SARDrawRunwayAddLight(
+		    runway, x_max, 0.0f, -(yt_min + p), white
+		);
+	    }
+	    SARDrawRunwayAddLight(runway, x_min, 0.0f, -yt_max, white);
+	    SARDrawRunwayAddLight(runway, x_max, 0.0f, -yt_max, white);
+	}
+	runway->total_edge_lights = runway->total_lights;
+
+	/* North alignment lighting */
+	if(n_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ALIGN)
+	{
+	    x_spacing = 10.0f;
+	    y_spacing = 50.0f;
+
+	    x = 0.0f;
+	    for(i = 0, y = y_max; i < 10; i++, y += y_spacing)
+		SARDrawRunwayAddLight(runway, x, 0.0f, -y, white);
+
+	    y = (float)(y_max + (y_spacing * 5));
+	    for(i = 0, x = (float)-(x_spacing * 5.0 / 2.0);
+		i < 6;
+		i++, x += x_spacing
+	    )
+		SARDrawRunwayAddLight(runway, x, 0.0f, -y, white);
+
+	    x_spacing = 20.0f;
+	    y = (float)(y_max + (y_spacing * 1));
+	    for(i = 0, x = (float)-(x_spacing * 5.0 / 2.0);
+		i < 6;
+		i++, x += x_spacing
+	    )
+		SARDrawRunwayAddLight(runway, x, 0.0f, -y, white);
+	}
+	/* South alignment lighting */
+	if(s_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ALIGN)
+	{
+	    x_spacing = 10.0f;
+	    y_spacing = 50.0f;
+
+	    x = 0.0f;
+	    for(i = 0, y = y_min; i < 10; i++, y -= y_spacing)
+		SARDrawRunwayAddLight(runway, x, 0.0f, -y, white);
+
+	    y = (float)(y_min - (y_spacing * 5));
+	    for(i = 0, x = (float)(x_spacing * 5.0 / 2.0);
+		i < 6;
+		i++, x -= x_spacing
+	    )
+		SARDrawRunwayAddLight(runway, x, 0.0f, -y, white);
+
+	    x_spacing = 20.0f;
+	    y = (float)(y_min - (y_spacing * 1));
+	    for(i = 0, x = (float)(x_spacing * 5.0 / 2.0);
+		i < 6;
+		i++, x -= x_spacing
+	    )
+		SARDrawRunwayAddLight(runway, x, 0.0f, -y, white);
+	}
+
+	/* North ILS lighting */
+	if(n_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ILS_GLIDE)
+	{
+	    x_spacing = 10.0f;
+	    y_spacing = 50.0f;
+
+	    for(i = 0, x = (float)-(x_spacing * 5.0 / 2.0);
+		i < 6;
+		i++, x += x_spacing
+	    )
+	    {
+		SARDrawRunwayAddLight(
+		    runway, x, 0.0f, (float)-(y_max + (y_spacing * 2)), ils_c
+		);
+		SARDrawRunwayAddLight(
+		    runway, x, 0.0f, (float)-(y_max + (y_spacing * 3)), ils_c
+		);
+		SARDrawRunwayAddLight(
+		    runway, x, 0.0f, (float)-(y_max + (y_spacing * 4)), ils_c
+		);
+	    }
+	}
+	/* South ILS lighting */
+	if(s_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ILS_GLIDE)
+	{
+	    x_spacing = 10.0f;
+	    y_spacing = 50.0f;
+
+	    for(i = 0, x = (float)(x_spacing * 5.0 / 2.0);
+		i < 6;
+		i++, x -= x_spacing
+	    )
+	    {
+		SARDrawRunwayAddLight(
+		    runway, x, 0.0f, (float)-(y_min - (y_spacing * 2)), ils_c
+		);
+		SARDrawRunwayAddLight(
+		    runway, x, 0.0f, (float)-(y_min - (y_spacing * 3)), ils_c
+		);
+		SARDrawRunwayAddLight(
+		    runway, x, 0.0f, (float)-(y_min - (y_spacing * 4)), ils_c
+		);
+	    }
+	}
+	runway->total_approach_lights = runway->total_lights -
+	    runway->total_edge_lights;
+
+	/* North threshold lighting */
+	if(n_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_END)
+	{
+	    float spacing = (float)(width / 7);
+
+	    for(p = 0.0f; p <= x_max; p += spacing)
+		SARDrawRunwayAddLight(runway, p, 0.0f, -yt_max, north_c);
+	    for(p = -spacing; p >= x_min; p -= spacing)
+		SARDrawRunwayAddLight(runway, p, 0.0f, -yt_max, north_c);
+	}
+	/* South threshold lighting */
+	if(s_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_END)
+	{
+	    float spacing = (float)(width / 7);
+
+	    for(p = 0.0f; p <= x_max; p += spacing)
+		SARDrawRunwayAddLight(runway, p, 0.0f, -yt_min, south_c);
+	    for(p = -spacing; p >= x_min; p -= spacing)
+		SARDrawRunwayAddLight(runway, p, 0.0f, -yt_min, south_c);
+	}
+}
+
+
 /*
  *      Draws a runway specified by the object obj_ptr.
  *
@@ -174,39 +571,14 @@ void SARDrawRunway(
 	}
 	else
 	{
-	    /* Set texture for runway background if available */
-	    if(t == NULL)
-	    {
-		V3DTextureSelect(NULL);
-		glColor4f(0.5f, 0.5f, 0.5f, 1.0f);
-	    }
-	    else
-	    {
-		V3DTextureSelect(t);
-		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	    }
-
-	    /* Draw background */
-	    glBegin(GL_QUADS);
-	    {
-		glNormal3f(0.0f, 1.0f, 0.0f);
-
-		glTexCoord2f(0.0f, 1.0f - 0.0f);
-		glVertex3f(x_min, 0.0f, -y_max);
-
-		glTexCoord2f(0.0f, 1.0f - 1.0f);
-		glVertex3f(x_min, 0.0f, -y_min);
-
-		glTexCoord2f(1.0f, 1.0f - 1.0f);
-		glVertex3f(x_max, 0.0f, -y_min);
-
-		glTexCoord2f(1.0f, 1.0f - 0.0f);
-		glVertex3f(x_max, 0.0f, -y_max);
-	    }
-	    glEnd();
-
-	    if(t != NULL)
-		V3DTextureSelect(NULL);
+	    /* Draw the background, dashes, and borders from the mesh,
+	     * building it the first time the runway is drawn up close
+	     */
+	    if(runway->surface_mesh == NULL)
+		runway->surface_mesh = SARDrawRunwaySurfaceMesh(
+		    dc, runway, t
+		);
+	    SARMeshDraw(runway->surface_mesh);
 
 	    /* Draw north displaced threshold? */
 	    vmodel = runway->north_displaced_threshold_vmodel;
@@ -242,54 +614,6 @@ void SARDrawRunway(
 		glPopMatrix();
 	    }
 
-	    /* Draw dashes? */
-	    if(runway->dashes > 0)
-	    {
-		int	dashes = runway->dashes;
-		float	dash_width_max = (float)(width * 0.025),
-			dash_width_min = -dash_width_max,
-			dash_spacing = (float)MAX(
-			    (yt_max - yt_min) /
-			    ((dashes * 2) + 1),
-			    1.0
-			),
-			dash_cur;
-
-		/* Draw each dash */
-		glBegin(GL_QUADS);
-		{
-		    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    for(dash_cur = yt_min + dash_spacing;
-			(dash_cur + dash_spacing) < yt_max;
-			dash_cur += (float)(dash_spacing * 2)
-		    )
-		    {
-			glVertex3f(
-			    dash_width_min,
-			    0.0f,
-			    -(dash_cur + dash_spacing)
-			);
-			glVertex3f(
-			    dash_width_min,
-			    0.0f,
-			    -dash_cur
-			);
-			glVertex3f(
-			    dash_width_max,
-			    0.0f,
-			    -dash_cur
-			);
-			glVertex3f(
-			    dash_width_max,
-			    0.0f,
-			    -(dash_cur + dash_spacing)
-			);
-		    }
-		}
-		glEnd();
-	    }
-
 	    /* Draw touchdown markers */
 	    vmodel = runway->td_marker_vmodel;
 	    if(vmodel != NULL && render_mode != GL_SELECT)
@@ -371,58 +695,6 @@ void SARDrawRunway(
 		glPopMatrix();
 	    }
 
-	    /* Draw borders */
-	    if(flags & SAR_RUNWAY_FLAG_BORDERS)
-	    {
-		glBegin(GL_QUADS);
-		{
-		    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    glVertex3f(
-			x_min,
-			0.0f,
-			-yt_min
-		    );
-		    glVertex3f(
-			(GLfloat)(x_min * 0.95),
-			0.0f,
-			-yt_min
-		    );
-		    glVertex3f(
-			(GLfloat)(x_min * 0.95),
-			0.0f,
-			-yt_max
-		    );
-		    glVertex3f(
-			x_min,
-			0.0f,
-			-yt_max
-		    );
-
-		    glVertex3f(
-			(GLfloat)(x_max * 0.95),
-			0.0f,
-			-yt_min
-		    );
-		    glVertex3f(
-			x_max,
-			0.0f,
-			-yt_min
-		    );
-		    glVertex3f(
-			x_max,
-			0.0f,
-			-yt_max
-		    );
-		    glVertex3f(
-			(GLfloat)(x_max * 0.95),
-			0.0f,
-			-yt_max
-		    );
-		}
-		glEnd();
-	    }
-
 	    /* Draw north label? */
 	    vmodel = runway->north_label_vmodel;
 	    if((vmodel != NULL) &&
@@ -489,171 +761,63 @@ void SARDrawRunway(
 	    StateGLDisable(state, GL_POINT_SMOOTH);
 	    StateGLPointSize(state, 1.0f);
 
-	    /* Draw edge lighting? */
-	    if(runway->edge_light_spacing > 0.0f)
+	    /* Draw the edge lighting, the alignment and ILS lighting
+	     * (closer than 8 miles), and the threshold lighting (closer
+	     * than 4 miles) from the lights set up on the runway
+	     */
+	    if(1)
 	    {
-		float lighting_length = yt_max - yt_min;
-		float p, spacing;
+		int n, colors = SAR_RUNWAY_LIGHT_COLORS_SET;
+		float spacing;
 
-		/* Calculate spacing of each light, min 100 meters
+		/* Calculate spacing of each edge light, min 100 meters
 		 * apart.
 		 */
 		spacing = (float)MAX(
 		    POW(2, floor(LOG(distance) / LOG(2.5))),
 		    100.0
 		);
-		glBegin(GL_POINTS);
-		{
-		    if(dc->flir)
-			glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    else
-			glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    for(p = 0; p < lighting_length; p += spacing)
-		    {
-			glVertex3f(x_min, 0.0f, -(yt_min + p));
-			glVertex3f(x_max, 0.0f, -(yt_min + p));
-		    }
-		    glVertex3f(x_min, 0.0f, -yt_max);
-		    glVertex3f(x_max, 0.0f, -yt_max);
-		}
-		glEnd();
-	    }
-
-	    /* North alignment lighting (closer than 8 miles) */
-	    if((n_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ALIGN) &&
-	       (distance <= (float)SFMMilesToMeters(8.0))
-	    )
-	    {
-		int i;
-		float	x, y,
-			x_spacing = 10.0f,
-			y_spacing = 50.0f;
-
-		glBegin(GL_POINTS);
-		{
-		    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    x = 0.0f;
-		    for(i = 0, y = y_max; i < 10; i++, y += y_spacing)
-			glVertex3f(x, 0.0f, -y);
-
-		    y = (float)(y_max + (y_spacing * 5));
-		    for(i = 0, x = (float)-(x_spacing * 5.0 / 2.0);
-			i < 6;
-			i++, x += x_spacing
-		    )
-			glVertex3f(x, 0.0f, -y);
-
-		    x_spacing = 20.0f;
-		    y = (float)(y_max + (y_spacing * 1));
-		    for(i = 0, x = (float)-(x_spacing * 5.0 / 2.0);
-			i < 6;
-			i++, x += x_spacing
-		    )
-			glVertex3f(x, 0.0f, -y);
-		}
-		glEnd();
-	    }
-	    /* South alignment lighting (closer than 8 miles) */
-	    if((s_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ALIGN) &&
-	       (distance <= (float)SFMMilesToMeters(8.0))
-	    )
-	    {
-		int i;
-		float   x, y,
-			x_spacing = 10.0f,
-			y_spacing = 50.0f;
 
-		glBegin(GL_POINTS);
-		{
-		    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    x = 0.0f;
-		    for(i = 0, y = y_min; i < 10; i++, y -= y_spacing)
-			glVertex3f(x, 0.0f, -y);
-
-		    y = (float)(y_min - (y_spacing * 5));
-		    for(i = 0, x = (float)(x_spacing * 5.0 / 2.0);
-			i < 6;
-			i++, x -= x_spacing
-		    )
-			glVertex3f(x, 0.0f, -y);
-
-		    x_spacing = 20.0f;
-		    y = (float)(y_min - (y_spacing * 1));
-		    for(i = 0, x = (float)(x_spacing * 5.0 / 2.0);
-			i < 6;
-			i++, x -= x_spacing
-		    )
-			glVertex3f(x, 0.0f, -y);
-		}
-		glEnd();
-	    }
-
-	    /* North ILS lighting (closer than 8 miles) */
-	    if((n_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ILS_GLIDE) &&
-	       (distance <= (float)SFMMilesToMeters(8.0))
-	    )
-	    {
-		int i;
-		float   x, y[3],
-			x_spacing = 10.0f,
-			y_spacing = 50.0f;
-
-		glBegin(GL_POINTS);
-		{
-		    if(dc->flir)
-			glColor4f(0.7f, 0.7f, 0.7f, 1.0f);
-		    else
-			glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    y[0] = (float)(y_max + (y_spacing * 2));
-		    y[1] = (float)(y_max + (y_spacing * 3));
-		    y[2] = (float)(y_max + (y_spacing * 4));
-		    for(i = 0, x = (float)-(x_spacing * 5.0 / 2.0);
-			i < 6;
-			i++, x += x_spacing
-		    )
-		    {
-			glVertex3f(x, 0.0f, -y[0]);
-			glVertex3f(x, 0.0f, -y[1]);
-			glVertex3f(x, 0.0f, -y[2]);
-		    }
-		}
-		glEnd();
-	    }
-	    /* South ILS lighting (closer than 8 miles) */
-	    if((s_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_ILS_GLIDE) &&
-	       (distance <= (float)SFMMilesToMeters(8.0))
-	    )
-	    {
-		int i;
-		float   x, y[3],
-			x_spacing = 10.0f,
-			y_spacing = 50.0f;
-
-		glBegin(GL_POINTS);
+		/* Threshold lights are green when approaching them from
+		 * outside the runway
+		 */
+		if(dc->flir)
+		    colors |= SAR_RUNWAY_LIGHT_COLORS_FLIR;
+		if(cam_pos_runway.y > yt_max)
+		    colors |= SAR_RUNWAY_LIGHT_COLORS_NORTH_GREEN;
+		if(cam_pos_runway.y < yt_min)
+		    colors |= SAR_RUNWAY_LIGHT_COLORS_SOUTH_GREEN;
+
+		/* Set up the lights again if the edge light spacing or
+		 * the colors changed
+		 */
+		if((runway->light_colors != colors) ||
+		   (runway->light_edge_spacing != spacing)
+		)
+		    SARDrawRunwayLightsUpdate(runway, spacing, colors);
+
+		if(distance <= (float)SFMMilesToMeters(4.0))
+		    n = runway->total_lights;
+		else if(distance <= (float)SFMMilesToMeters(8.0))
+		    n = runway->total_edge_lights +
+			runway->total_approach_lights;
+		else
+		    n = runway->total_edge_lights;
+		n = MIN(n, runway->total_lights);
+
+		if((n > 0) && (runway->light_vertex != NULL) &&
+		   (runway->light_color != NULL)
+		)
 		{
-		    if(dc->flir)
-			glColor4f(0.7f, 0.7f, 0.7f, 1.0f);
-		    else
-			glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
 		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    y[0] = (float)(y_min - (y_spacing * 2));
-		    y[1] = (float)(y_min - (y_spacing * 3));
-		    y[2] = (float)(y_min - (y_spacing * 4));
-		    for(i = 0, x = (float)(x_spacing * 5.0 / 2.0);
-			i < 6;
-			i++, x -= x_spacing
-		    )
-		    {
-			glVertex3f(x, 0.0f, -y[0]);
-			glVertex3f(x, 0.0f, -y[1]);
-			glVertex3f(x, 0.0f, -y[2]);
-		    }
+		    glEnableClientState(GL_VERTEX_ARRAY);
+		    glEnableClientState(GL_COLOR_ARRAY);
+		    glVertexPointer(3, GL_FLOAT, 0, runway->light_vertex);
+		    glColorPointer(4, GL_FLOAT, 0, runway->light_color);
+		    glDrawArrays(GL_POINTS, 0, n);
+		    glDisableClientState(GL_COLOR_ARRAY);
+		    glDisableClientState(GL_VERTEX_ARRAY);
 		}
-		glEnd();
 	    }
 
 	    /* North glide slope (closer than 5 miles)? */
@@ -896,62 +1060,6 @@ void SARDrawRunway(
 		StateGLPointSize(state, 1.0f);
 	    }
 
-	    /* North threshold lighting (closer than 4 miles)? */
-	    if((n_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_END) &&
-	       (distance <= (float)SFMMilesToMeters(4.0))
-	    )
-	    {
-		float p, spacing;
-
-		spacing = (float)(width / 7);
-
-		/* Draw end lighting */
-		glBegin(GL_POINTS);
-		{
-		    /* North end lights */
-		    if(dc->flir)
-			glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    else if(cam_pos_runway.y > yt_max)
-			glColor4f(0.0f, 1.0f, 0.0f, 1.0f);
-		    else
-			glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    for(p = 0.0f; p <= x_max; p += spacing)
-			glVertex3f(p, 0.0f, -yt_max);
-		    for(p = -spacing; p >= x_min; p -= spacing)
-			glVertex3f(p, 0.0f, -yt_max);
-		}
-		glEnd();
-	    }
-	    /* South threshold lighting (closer than 4 miles)? */
-	    if((s_app_flags & SAR_RUNWAY_APPROACH_LIGHTING_END) &&
-	       (distance <= (float)SFMMilesToMeters(4.0))
-	    )
-	    {
-		float p, spacing;
-
-		spacing = (float)(width / 7);
-
-		/* Draw end lighting */
-		glBegin(GL_POINTS);
-		{
-		    /* South end lights */
-		    if(dc->flir)
-			glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		    else if(cam_pos_runway.y < yt_min)
-			glColor4f(0.0f, 1.0f, 0.0f, 1.0f);
-		    else
-			glColor4f(1.0f, 0.0f, 0.0f, 1.0f);
-		    glNormal3f(0.0f, 1.0f, 0.0f);
-		    for(p = 0.0f; p <= x_max; p += spacing)
-			glVertex3f(p, 0.0f, -yt_min);
-		    for(p = -spacing; p >= x_min; p -= spacing)
-			glVertex3f(p, 0.0f, -yt_min);
-
-		}
-		glEnd();
-	    }
-
 /*
 SAR_RUNWAY_APPROACH_LIGHTING_END        (1 << 0)
 SAR_RUNWAY_APPROACH_LIGHTING_TRACER     (1 << 1)
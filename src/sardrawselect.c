@@ -21,6 +21,9 @@
 #endif
 #include <GL/gl.h>
 #include "obj.h"
+#include "objutils.h"
+#include "simutils.h"
+#include "simsurface.h"
 #include "sar.h"
 #include "sardraw.h"
 #include "sardrawselect.h"
@@ -174,13 +177,13 @@ void SARDrawMapObjNameListDelete(
 }
 
 /*
- *	Draws the map in GL_SELECT render mode and processes the hits,
- *	storing the hits on the specified core's Object Names List.
+ *	Gets the list of objects under the specified object (or -1 for
+ *	the player object), these are the objects that would be drawn
+ *	directly below it when looking straight down from its position.
  *
- *	Note: Special numbers have the base offset of (*total) added
- *	to them. So any index that is a special number is:
- *
- *		special_index = i - (*total).
+ *	The objects are found by checking the object's flat contact
+ *	area against the footprints of the objects in the scene (see
+ *	SARSimGetObjectsUnder()), the map is not drawn.
  *
  *	The specified obj_num (or -1 for the player object) will be
  *	excluded from the returned index list.
@@ -195,83 +198,47 @@ int *SARGetGCCHitList(
 	int *hits
 )
 {
-	int i, n, hit_obj_num, *list = NULL;
-	sar_drawmap_objname_struct *name;
+	int n;
+	sar_object_struct *obj_ptr;
 
 	if(hits != NULL)
 	    *hits = 0;
 
 	if((core_ptr == NULL) || (scene == NULL) || (ptr == NULL) ||
-	   (total == NULL)
+	   (total == NULL) || (hits == NULL)
 	)
-	    return(list);
-
-	/* Draw the map with draw_for_gcc set to True, this will draw
-	 * the map with an isolated camera angle looking directly
-	 * downward with respect to the specified object (or -1 for the
-	 * player object)
-	 *
-	 * The core's Object Names List will be cleared and updated
-	 * with the hits list
-	 */
-	SARDrawMap(core_ptr, True, False, obj_num);
-
-	/* Get hits list */
-	for(i = 0; i < core_ptr->total_drawmap_objnames; i++)
-	{
-	    name = core_ptr->drawmap_objname[i];
-	    if(name == NULL)
-		continue;
+	    return(NULL);
 
-	    /* Get the hit object number as the gl name
-	     *
-	     * Note that the hit object number may be >= to
-	     * total_objects in which case it has special meaning
-	     */
-	    hit_obj_num = (int)name->gl_name;
-
-	    /* Skip if the hit object number is the same as given
-	     * object number
-	     */
-	    if(hit_obj_num == obj_num)
-		continue;
-
-	    /* Allocate more hits and append this hit object number to
-	     * the list
-	     */
-	    if(hits != NULL)
-	    {
-		n = MAX(*hits, 0);
-		*hits = n + 1;
-
-		list = (int *)realloc(
-		    list,
-		    (*hits) * sizeof(int)
-		);
-		if(list == NULL)
-		{
-		    *hits = 0;
-		    break;
-		}
-		else
-		{
-		    list[n] = hit_obj_num;
-		}
-	    }
+	/* Get the object (use player object as needed) */
+	n = obj_num;
+	obj_ptr = SARObjGetPtr(*ptr, *total, n);
+	if(obj_ptr == NULL)
+	{
+	    n = SARObjGetFromHandle(scene, *ptr, *total, scene->player_obj_handle);
+	    obj_ptr = SARObjGetPtr(*ptr, *total, n);
 	}
-
-	return(list);
+	if(obj_ptr == NULL)
+	    return(NULL);
+
+	return(SARSimGetObjectsUnder(
+	    scene, *ptr, *total,
+	    obj_ptr->pos.x, obj_ptr->pos.y,
+	    SARSimGetFlatContactRadius(obj_ptr),
+	    n,
+	    hits
+	));
 }
 
 /*
  *      Checks for ground hit contact, relative to the given obj_num.
  *
- *      Checks if there is any object directly under obj_num that is
- *      drawn. If nothing is drawn directly under the object then
- *      got_hit will be set to False, otherwise True.
+ *      Checks if there is any object directly under obj_num that
+ *      would be drawn. If nothing is under the object then got_hit
+ *      will be set to False, otherwise True.
  *
  *      If the scene's base type is water, then over_water will be set
- *      True if (and only if) got_hit is False.
+ *      True if (and only if) got_hit is False (see
+ *      SARSimIsOverWater()), the map is not drawn.
  *
  *      Returns 0 on success or non-zero on error.
  */
@@ -281,6 +248,10 @@ int SARGetGHCOverWater(
 	int obj_num, Boolean *got_hit, Boolean *over_water
 )
 {
+	int n;
+	Boolean water;
+	sar_object_struct *obj_ptr;
+
 	if(got_hit != NULL)
 	    *got_hit = False;
 	if(over_water != NULL)
@@ -291,44 +262,25 @@ int SARGetGHCOverWater(
 	)
 	    return(-1);
 
-	/* Draw the map with draw_for_ghc set to True, this will draw
-	 * the map with an isolated camera angle looking directly
-	 * downward with respect to the specified object (or -1 for the
-	 * player object)
-	 *
-	 * The core's drawmap_ghc_result will be updated
-	 */
-	SARDrawMap(core_ptr, False, True, obj_num);
-
-	/* Got hit? */
-	if(core_ptr->drawmap_ghc_result >= 0.5f)
+	/* Get the object (use player object as needed) */
+	n = obj_num;
+	obj_ptr = SARObjGetPtr(*ptr, *total, n);
+	if(obj_ptr == NULL)
 	{
-	    /* Mark that we got a hit */
-	    if(got_hit != NULL)
-		*got_hit = True;
-
-	    /* Mark that the specified object is not over water */
-	    if(over_water != NULL)
-		*over_water = False;
+	    n = SARObjGetFromHandle(scene, *ptr, *total, scene->player_obj_handle);
+	    obj_ptr = SARObjGetPtr(*ptr, *total, n);
 	}
-	else
-	{
-	    /* Mark that we did not get a hit */
-	    if(got_hit != NULL)
-		*got_hit = False;
+	if(obj_ptr == NULL)
+	    return(-1);
 
-	    /* Scene's base is water? */
-	    if(scene->base_flags & SAR_SCENE_BASE_FLAG_IS_WATER)
-	    {
-		if(over_water != NULL)
-		    *over_water = True;
-	    }
-	    else
-	    {
-		if(over_water != NULL)
-		    *over_water = False;
-	    }
-	}
+	water = SARSimIsOverWater(
+	    scene, *ptr, *total,
+	    obj_ptr->pos.x, obj_ptr->pos.y,
+	    n,
+	    got_hit
+	);
+	if(over_water != NULL)
+	    *over_water = water;
 
 	return(0);
 }
@@ -0,0 +1,339 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+
+#include "v3dtex.h"
+#include "stategl.h"
+#include "obj.h"
+#include "objutils.h"
+#include "sardrawshadows.h"
+
+
+static int SARDrawShadowsAppend(
+	sar_draw_shadow_struct **shadow, int *total, int *max,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+);
+static void SARDrawShadowsCallList(
+	const sar_draw_shadow_struct *shadow, int total
+);
+static void SARDrawShadowsCompileStatic(sar_draw_shadows_struct *s);
+
+void SARDrawShadowsReset(sar_draw_shadows_struct *s);
+int SARDrawShadowsAdd(
+	sar_draw_shadows_struct *s,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+);
+int SARDrawShadowsAddStatic(
+	sar_draw_shadows_struct *s,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+);
+void SARDrawShadowsDraw(
+	sar_draw_shadows_struct *s, state_gl_struct *state,
+	GLfloat polygon_offset_factor
+);
+void SARDrawShadowsClear(sar_draw_shadows_struct *s);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+
+
+/*
+ *	Appends a shadow to the array, growing the array as needed.
+ *
+ *	Returns non-zero on error.
+ */
+static int SARDrawShadowsAppend(
+	sar_draw_shadow_struct **shadow, int *total, int *max,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+)
+{
+	sar_draw_shadow_struct *sh;
+
+	if(*total >= *max)
+	{
+	    int n = MAX((*max) * 2, 32);
+	    sh = SAR_DRAW_SHADOW(realloc(
+		*shadow,
+		n * sizeof(sar_draw_shadow_struct)
+	    ));
+	    if(sh == NULL)
+		return(-3);
+
+	    *shadow = sh;
+	    *max = n;
+	}
+
+	sh = &(*shadow)[*total];
+	sh->vmodel = vmodel;
+	sh->x = x;
+	sh->y = y;
+	sh->z = z;
+	sh->heading = heading;
+	*total = (*total) + 1;
+
+	return(0);
+}
+
+/*
+ *	Calls the visual models of the shadows, each translated and
+ *	rotated to its position and heading.
+ */
+static void SARDrawShadowsCallList(
+	const sar_draw_shadow_struct *shadow, int total
+)
+{
+	int i;
+
+	for(i = 0; i < total; i++, shadow++)
+	{
+	    glPushMatrix();
+	    {
+		glTranslatef(shadow->x, shadow->y, shadow->z);
+		if(shadow->heading != 0.0f)
+		    glRotatef(shadow->heading, 0.0f, 1.0f, 0.0f);
+		SARVisualModelCallList(shadow->vmodel);
+	    }
+	    glPopMatrix();
+	}
+}
+
+/*
+ *	Draws the static shadows, recompiling the static shadows' GL
+ *	display list first if they have changed since it was compiled.
+ *
+ *	The list is compiled and executed at once so that the GL
+ *	states are what the state caches expect after the compile.
+ */
+static void SARDrawShadowsCompileStatic(sar_draw_shadows_struct *s)
+{
+	sar_draw_shadow_struct *shadow;
+	int n;
+
+	/* Static shadows unchanged? */
+	if((s->total_static_shadows == s->total_list_shadows) &&
+	   ((s->total_static_shadows <= 0) ||
+	    ((s->static_list != 0) &&
+	     !memcmp(
+		s->static_shadow, s->list_shadow,
+		s->total_static_shadows * sizeof(sar_draw_shadow_struct)
+	     )
+	    )
+	   )
+	)
+	{
+	    if(s->total_static_shadows > 0)
+	    {
+		glCallList(s->static_list);
+		V3DTextureInvalidate();
+	    }
+	    return;
+	}
+
+	if(s->static_list == 0)
+	    s->static_list = glGenLists(1);
+	if(s->static_list == 0)
+	{
+	    SARDrawShadowsCallList(
+		s->static_shadow, s->total_static_shadows
+	    );
+	    return;
+	}
+
+	glNewList(s->static_list, GL_COMPILE_AND_EXECUTE);
+	SARDrawShadowsCallList(s->static_shadow, s->total_static_shadows);
+	glEndList();
+	V3DTextureInvalidate();
+	s->frame_static_compiles++;
+
+	/* The shadows of this frame are now the ones that the list
+	 * was compiled from, swap the arrays instead of copying them
+	 */
+	shadow = s->list_shadow;
+	s->list_shadow = s->static_shadow;
+	s->static_shadow = shadow;
+	s->total_list_shadows = s->total_static_shadows;
+	n = s->max_list_shadows;
+	s->max_list_shadows = s->max_static_shadows;
+	s->max_static_shadows = n;
+	s->total_static_shadows = 0;
+}
+
+/*
+ *	Removes all the shadows, the allocated arrays and the static
+ *	shadows' GL display list are kept for the next frame.
+ */
+void SARDrawShadowsReset(sar_draw_shadows_struct *s)
+{
+	if(s == NULL)
+	    return;
+
+	s->total_shadows = 0;
+	s->total_static_shadows = 0;
+}
+
+/*
+ *	Appends the shadow visual model vmodel at x, y, z (in GL world
+ *	coordinates, y being the height of the ground) rotated by
+ *	heading (in degrees, about the y axis).
+ *
+ *	Returns non-zero on error.
+ */
+int SARDrawShadowsAdd(
+	sar_draw_shadows_struct *s,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+)
+{
+	if((s == NULL) || (vmodel == NULL))
+	    return(-2);
+
+	return(SARDrawShadowsAppend(
+	    &s->shadow, &s->total_shadows, &s->max_shadows,
+	    vmodel, x, y, z, heading
+	));
+}
+
+/*
+ *	Same as SARDrawShadowsAdd() except that the shadow is of an
+ *	object that never moves and is drawn from the static shadows'
+ *	GL display list.
+ *
+ *	The static shadows must be added in the same order on each
+ *	frame, otherwise the list is recompiled.
+ *
+ *	Returns non-zero on error.
+ */
+int SARDrawShadowsAddStatic(
+	sar_draw_shadows_struct *s,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+)
+{
+	if((s == NULL) || (vmodel == NULL))
+	    return(-2);
+
+	return(SARDrawShadowsAppend(
+	    &s->static_shadow, &s->total_static_shadows,
+	    &s->max_static_shadows,
+	    vmodel, x, y, z, heading
+	));
+}
+
+/*
+ *	Draws all the shadows.
+ *
+ *	The modelview matrix must only have the camera's rotations and
+ *	translations on it. The shadows are drawn translucent black,
+ *	without lighting and without writing to the depth buffer,
+ *	offset by polygon_offset_factor in front of the ground.
+ */
+void SARDrawShadowsDraw(
+	sar_draw_shadows_struct *s, state_gl_struct *state,
+	GLfloat polygon_offset_factor
+)
+{
+	StateGLBoolean lighting;
+	GLboolean depth_mask_flag;
+	GLenum shade_model_mode;
+
+	if(s == NULL)
+	    return;
+
+	s->frame_shadows = s->total_shadows + s->total_static_shadows;
+	s->frame_static_shadows = s->total_static_shadows;
+	s->frame_static_compiles = 0;
+	if(s->frame_shadows <= 0)
+	    return;
+
+	lighting = state->lighting;
+	depth_mask_flag = state->depth_mask_flag;
+	shade_model_mode = state->shade_model_mode;
+
+	/* Set up GL states */
+	V3DTextureSelect(NULL);
+	StateGLDisable(state, GL_LIGHTING);
+	StateGLEnable(state, GL_BLEND);
+	StateGLDisable(state, GL_ALPHA_TEST);
+	StateGLDepthMask(state, GL_FALSE);
+	StateGLEnable(state, GL_POLYGON_OFFSET_FILL);
+	StateGLBlendFunc(state, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	StateGLPolygonOffset(state, polygon_offset_factor, -1.0f);
+	StateGLShadeModel(state, GL_FLAT);
+	glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
+
+	/* Shadows of the objects that never move */
+	SARDrawShadowsCompileStatic(s);
+
+	/* Shadows of all the other objects */
+	SARDrawShadowsCallList(s->shadow, s->total_shadows);
+
+	/* Restore GL states */
+	if(lighting)
+	    StateGLEnable(state, GL_LIGHTING);
+	StateGLDisable(state, GL_POLYGON_OFFSET_FILL);
+	StateGLDisable(state, GL_BLEND);
+	StateGLDepthMask(state, depth_mask_flag);
+	StateGLEnable(state, GL_ALPHA_TEST);
+	StateGLShadeModel(state, shade_model_mode);
+}
+
+/*
+ *	Deletes all the shadows and the static shadows' GL display
+ *	list.
+ */
+void SARDrawShadowsClear(sar_draw_shadows_struct *s)
+{
+	if(s == NULL)
+	    return;
+
+	if(s->static_list != 0)
+	{
+	    glDeleteLists(s->static_list, 1);
+	    s->static_list = 0;
+	}
+
+	free(s->shadow);
+	s->shadow = NULL;
+	s->total_shadows = 0;
+	s->max_shadows = 0;
+
+	free(s->static_shadow);
+	s->static_shadow = NULL;
+	s->total_static_shadows = 0;
+	s->max_static_shadows = 0;
+
+	free(s->list_shadow);
+	s->list_shadow = NULL;
+	s->total_list_shadows = 0;
+	s->max_list_shadows = 0;
+}
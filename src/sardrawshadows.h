@@ -0,0 +1,115 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			    SAR Shadow Batches
+
+	The shadows of all the objects drawn on a frame. Each
+	object's shadow visual model is queued with the object's
+	position, heading, and ground height and all the shadows are
+	drawn after the objects with one set up of the GL states.
+
+	The shadows of the objects that never move are queued
+	separately and merged into one GL display list, which is only
+	recompiled when those shadows change (when such an object comes
+	into or goes out of range or has its pose changed).
+ */
+
+#ifndef SARDRAWSHADOWS_H
+#define SARDRAWSHADOWS_H
+
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+#include "stategl.h"
+#include "obj.h"
+
+
+/*
+ *	Shadow:
+ */
+typedef struct {
+
+	sar_visual_model_struct	*vmodel;	/* Shadow visual model */
+
+	/* Position of the object's center in GL world coordinates,
+	 * y is the height of the ground under the object
+	 */
+	GLfloat		x, y, z;
+
+	GLfloat		heading;	/* Heading in degrees */
+
+} sar_draw_shadow_struct;
+#define SAR_DRAW_SHADOW(p)	((sar_draw_shadow_struct *)(p))
+
+/*
+ *	Shadows:
+ */
+typedef struct {
+
+	/* Shadows of the current frame, the array is kept from one
+	 * frame to the next
+	 */
+	sar_draw_shadow_struct	*shadow;
+	int		total_shadows,
+			max_shadows;
+
+	/* Shadows of the objects that never move of the current
+	 * frame, see SARDrawShadowsAddStatic()
+	 */
+	sar_draw_shadow_struct	*static_shadow;
+	int		total_static_shadows,
+			max_static_shadows;
+
+	/* Static shadows that static_list was compiled from */
+	sar_draw_shadow_struct	*list_shadow;
+	int		total_list_shadows,
+			max_list_shadows;
+
+	GLuint		static_list;	/* GL display list of the static
+					 * shadows or 0 */
+
+	/* Statistics of the last frame drawn */
+	int		frame_shadows,
+			frame_static_shadows,
+			frame_static_compiles;
+
+} sar_draw_shadows_struct;
+#define SAR_DRAW_SHADOWS(p)	((sar_draw_shadows_struct *)(p))
+
+
+extern void SARDrawShadowsReset(sar_draw_shadows_struct *s);
+extern int SARDrawShadowsAdd(
+	sar_draw_shadows_struct *s,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+);
+extern int SARDrawShadowsAddStatic(
+	sar_draw_shadows_struct *s,
+	sar_visual_model_struct *vmodel,
+	GLfloat x, GLfloat y, GLfloat z,
+	GLfloat heading
+);
+extern void SARDrawShadowsDraw(
+	sar_draw_shadows_struct *s, state_gl_struct *state,
+	GLfloat polygon_offset_factor
+);
+extern void SARDrawShadowsClear(sar_draw_shadows_struct *s);
+
+
+#endif	/* SARDRAWSHADOWS_H */
@@ -43,6 +43,16 @@ void SARDrawBoxBaseNS(
 	Boolean draw_base
 );
 
+void SARDrawFrustumUpdate(
+	sar_dc_struct *dc,
+	float fovz, float aspect,
+	float near_clip, float far_clip
+);
+Boolean SARDrawFrustumSphereVisible(
+	const sar_dc_struct *dc,
+	const sar_position_struct *pos, float radius
+);
+
 
 #define SWAP_2F(x,y)	{	\
  float t = x;			\
@@ -277,3 +287,113 @@ void SARDrawBoxBaseNS(
 	    glVertex3f(x_min, z_min, -y_min);
 	}
 }
+
+
+/*
+ *	Updates the view frustum planes on the drawing context from
+ *	the given field of view about the z axis (in radians), view
+ *	aspect, and clip distances (in meters).
+ *
+ *	The camera must already be set on the GL model view matrix,
+ *	the planes are derived in eye coordinates and then moved into
+ *	GL world coordinates with the model view matrix (which is
+ *	fetched from GL once here for the entire frame).
+ */
+void SARDrawFrustumUpdate(
+	sar_dc_struct *dc,
+	float fovz, float aspect,
+	float near_clip, float far_clip
+)
+{
+	int i, j;
+	float ty, tx, ny, nx;
+	GLfloat m[16];
+	GLfloat eye[6][4];
+
+	if(dc == NULL)
+	    return;
+
+	dc->frustum_valid = False;
+	if((fovz <= 0.0f) || (aspect <= 0.0f) || (far_clip <= near_clip))
+	    return;
+
+	/* Slopes of the side planes and their normal lengths */
+	ty = (float)tan(fovz / 2.0f);
+	tx = ty * aspect;
+	ny = (float)sqrt(1.0f + (ty * ty));
+	nx = (float)sqrt(1.0f + (tx * tx));
+
+	/* Planes in eye coordinates, the camera looks down -z */
+	/* Left */
+	eye[0][0] = 1.0f / nx;	eye[0][1] = 0.0f;
+	eye[0][2] = -tx / nx;	eye[0][3] = 0.0f;
+	/* Right */
+	eye[1][0] = -1.0f / nx;	eye[1][1] = 0.0f;
+	eye[1][2] = -tx / nx;	eye[1][3] = 0.0f;
+	/* Bottom */
+	eye[2][0] = 0.0f;	eye[2][1] = 1.0f / ny;
+	eye[2][2] = -ty / ny;	eye[2][3] = 0.0f;
+	/* Top */
+	eye[3][0] = 0.0f;	eye[3][1] = -1.0f / ny;
+	eye[3][2] = -ty / ny;	eye[3][3] = 0.0f;
+	/* Near */
+	eye[4][0] = 0.0f;	eye[4][1] = 0.0f;
+	eye[4][2] = -1.0f;	eye[4][3] = -near_clip;
+	/* Far */
+	eye[5][0] = 0.0f;	eye[5][1] = 0.0f;
+	eye[5][2] = 1.0f;	eye[5][3] = far_clip;
+
+	/* Move the planes into world coordinates, the model view
+	 * matrix only rotates and translates so the normals stay
+	 * unit length (m is in column major order)
+	 */
+	glGetFloatv(GL_MODELVIEW_MATRIX, m);
+	for(i = 0; i < 6; i++)
+	{
+	    for(j = 0; j < 4; j++)
+		dc->frustum[i][j] =
+		    (eye[i][0] * m[(j * 4) + 0]) +
+		    (eye[i][1] * m[(j * 4) + 1]) +
+		    (eye[i][2] * m[(j * 4) + 2]) +
+		    ((j == 3) ? eye[i][3] : 0.0f);
+	}
+
+	dc->frustum_valid = True;
+}
+
+/*
+ *	Checks if the sphere at the given position (in world
+ *	coordinates) with the given radius (in meters) is at least
+ *	partially inside the view frustum.
+ *
+ *	Always returns True if the frustum is not valid.
+ */
+Boolean SARDrawFrustumSphereVisible(
+	const sar_dc_struct *dc,
+	const sar_position_struct *pos, float radius
+)
+{
+	int i;
+	const GLfloat *p;
+	GLfloat gx, gy, gz;
+
+	if((dc == NULL) || (pos == NULL))
+	    return(True);
+
+	if(!dc->frustum_valid)
+	    return(True);
+
+	/* Convert position to GL world coordinates */
+	gx = pos->x;
+	gy = pos->z;
+	gz = -pos->y;
+
+	for(i = 0; i < 6; i++)
+	{
+	    p = dc->frustum[i];
+	    if(((p[0] * gx) + (p[1] * gy) + (p[2] * gz) + p[3]) < -radius)
+		return(False);
+	}
+
+	return(True);
+}
@@ -0,0 +1,565 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			SAR Headless Simulation Runner
+
+	Loads a mission (or a scene and a player aircraft) and runs the
+	simulation in fixed ticks as fast as possible, without a
+	display, sound or game controllers. The player aircraft is
+	flown by a control script and when the mission ends (or the
+	time limit is reached) the number of ticks per second and the
+	mission outcome are printed.
+
+	The control script is a text file with one control change per
+	line:
+
+		<seconds> <control> <value>
+
+	Where control is one of engine (1 to start and 0 to stop the
+	engine), heading, pitch, bank, throttle, air_brakes,
+	wheel_brakes, hoist_up or hoist_down. Each control keeps its
+	value until it is changed. Lines starting with '#' are
+	comments.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "../include/disk.h"
+
+#include "gw.h"
+#include "gctl.h"
+#include "obj.h"
+#include "mission.h"
+#include "sar.h"
+#include "sarreality.h"
+#include "sartime.h"
+#include "human.h"
+#include "weather.h"
+#include "texturelistio.h"
+#include "missionio.h"
+#include "sceneio.h"
+#include "simmanage.h"
+#include "simutils.h"
+#include "config.h"
+
+
+/*
+ *	Control Script Entry:
+ */
+typedef struct {
+	time_t		t;		/* In milliseconds from the start */
+	char		control[80];
+	float		value;
+} sar_headless_control_struct;
+
+
+static sar_headless_control_struct *SARHeadlessLoadControls(
+	const char *filename, int *total
+);
+static void SARHeadlessApplyControls(
+	sar_core_struct *core_ptr,
+	const sar_headless_control_struct *control, int total,
+	int *cur, time_t t
+);
+static void SARHeadlessSetPaths(void);
+static void SARHeadlessPrintUsage(const char *prog_name);
+
+void SARResetTimmersCB(sar_core_struct *core_ptr, time_t t_new);
+int SARLoadProgressCB(void *ptr, long pos, long size);
+
+
+#define MAX(a,b)	(((a) > (b)) ? (a) : (b))
+#define MIN(a,b)	(((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)	(MIN(MAX((a),(l)),(h)))
+
+
+sar_dname_struct dname;
+sar_fname_struct fname;
+sar_next_struct next;
+
+float debug_value;
+
+int runlevel;
+
+time_t	cur_millitime,
+	cur_systime,
+	lapsed_millitime;
+
+float	time_compensation,
+	time_compression;
+
+
+/*
+ *	Loads the control script from file.
+ *
+ *	Returns a list of control changes sorted by time or NULL on
+ *	error, the calling function must delete the returned list.
+ */
+static sar_headless_control_struct *SARHeadlessLoadControls(
+	const char *filename, int *total
+)
+{
+	int n;
+	double t;
+	float value;
+	char buf[256], control[80];
+	FILE *fp;
+	sar_headless_control_struct *list = NULL, *c;
+
+	*total = 0;
+
+	fp = fopen(filename, "rb");
+	if(fp == NULL)
+	{
+	    fprintf(
+		stderr,
+		"%s: Unable to open the control script.\n",
+		filename
+	    );
+	    return(NULL);
+	}
+
+	while(fgets(buf, sizeof(buf), fp) != NULL)
+	{
+	    if((*buf == '#') || (*buf == '\n') || (*buf == '\r'))
+		continue;
+
+	    if(sscanf(buf, "%lf %79s %f", &t, control, &value) != 3)
+	    {
+		fprintf(
+		    stderr,
+		    "%s: Ignoring malformed line: %s",
+		    filename, buf
+		);
+		continue;
+	    }
+
+	    /* Insert sorted by time, after any change at the same
+	     * time so that the script's order is kept
+	     */
+	    n = *total;
+	    *total = n + 1;
+	    list = (sar_headless_control_struct *)realloc(
+		list, (*total) * sizeof(sar_headless_control_struct)
+	    );
+	    if(list == NULL)
+	    {
+		*total = 0;
+		break;
+	    }
+	    while((n > 0) && (list[n - 1].t > (time_t)(t * 1000.0)))
+	    {
+		list[n] = list[n - 1];
+		n--;
+	    }
+	    c = &list[n];
+	    c->t = (time_t)(t * 1000.0);
+	    strncpy(c->control, control, sizeof(c->control));
+	    c->control[sizeof(c->control) - 1] = '\0';
+	    c->value = value;
+	}
+
+	fclose(fp);
+
+	return(list);
+}
+
+/*
+ *	Applies the control changes up to time t (in milliseconds from
+ *	the start) to the game controller values and the player
+ *	aircraft's engine.
+ *
+ *	cur is the index of the next control change to apply.
+ */
+static void SARHeadlessApplyControls(
+	sar_core_struct *core_ptr,
+	const sar_headless_control_struct *control, int total,
+	int *cur, time_t t
+)
+{
+	gctl_struct *gc = core_ptr->gctl;
+	sar_scene_struct *scene = core_ptr->scene;
+	const sar_headless_control_struct *c;
+
+	for(; *cur < total; (*cur)++)
+	{
+	    c = &control[*cur];
+	    if(c->t > t)
+		break;
+
+	    if(!strcasecmp(c->control, "engine"))
+		SARSimOpEngine(
+		    scene,
+		    &core_ptr->object, &core_ptr->total_objects,
+		    scene->player_obj_ptr,
+		    (c->value > 0.0f) ? SAR_ENGINE_ON : SAR_ENGINE_OFF,
+		    NULL, False, False
+		);
+	    else if(!strcasecmp(c->control, "heading"))
+		gc->heading = CLIP(c->value, -1.0f, 1.0f);
+	    else if(!strcasecmp(c->control, "pitch"))
+		gc->pitch = CLIP(c->value, -1.0f, 1.0f);
+	    else if(!strcasecmp(c->control, "bank"))
+		gc->bank = CLIP(c->value, -1.0f, 1.0f);
+	    else if(!strcasecmp(c->control, "throttle"))
+		gc->throttle = CLIP(c->value, 0.0f, 1.0f);
+	    else if(!strcasecmp(c->control, "air_brakes"))
+	    {
+		gc->air_brakes_state = (c->value > 0.0f) ? True : False;
+		gc->air_brakes_coeff = CLIP(c->value, 0.0f, 1.0f);
+	    }
+	    else if(!strcasecmp(c->control, "wheel_brakes"))
+	    {
+		gc->wheel_brakes_state = (int)CLIP(c->value, 0.0f, 2.0f);
+		gc->wheel_brakes_coeff = (c->value > 0.0f) ? 1.0f : 0.0f;
+	    }
+	    else if(!strcasecmp(c->control, "hoist_up"))
+	    {
+		gc->hoist_up_state = (c->value > 0.0f) ? True : False;
+		gc->hoist_up_coeff = CLIP(c->value, 0.0f, 1.0f);
+	    }
+	    else if(!strcasecmp(c->control, "hoist_down"))
+	    {
+		gc->hoist_down_state = (c->value > 0.0f) ? True : False;
+		gc->hoist_down_coeff = CLIP(c->value, 0.0f, 1.0f);
+	    }
+	    else
+		fprintf(
+		    stderr,
+		    "Ignoring unsupported control \"%s\".\n",
+		    c->control
+		);
+	}
+}
+
+/*
+ *	Sets the global data directory and the data file paths the
+ *	same way as SARInit() does, except that nothing is written to
+ *	the local data directory.
+ */
+static void SARHeadlessSetPaths(void)
+{
+	const char *s = getenv(SAR_DEF_ENV_GLOBAL_DIR);
+
+	strncpy(
+	    dname.global_data,
+	    (s != NULL) ? s : SAR_DEF_GLOBAL_DATA_DIR,
+	    PATH_MAX
+	);
+	dname.global_data[PATH_MAX - 1] = '\0';
+
+	s = getenv("HOME");
+	s = PrefixPaths((s != NULL) ? s : ".", SAR_DEF_LOCAL_DATA_DIR);
+	strncpy(
+	    dname.local_data,
+	    (s != NULL) ? s : ".",
+	    PATH_MAX
+	);
+	dname.local_data[PATH_MAX - 1] = '\0';
+
+#define SET_FNAME(_v_,_d_,_f_)	{			\
+ const char *_s_ = PrefixPaths((_d_), (_f_));		\
+ strncpy((_v_), (_s_ != NULL) ? _s_ : (_f_),		\
+  PATH_MAX + NAME_MAX);					\
+ (_v_)[PATH_MAX + NAME_MAX - 1] = '\0';			\
+}
+	SET_FNAME(fname.human, dname.global_data, SAR_DEF_HUMAN_FILE);
+	SET_FNAME(fname.textures, dname.global_data, SAR_DEF_TEXTURES_FILE);
+	SET_FNAME(fname.weather, dname.global_data, SAR_DEF_WEATHER_FILE);
+#undef SET_FNAME
+
+	/* Do not write a mission log */
+	*fname.mission_log = '\0';
+}
+
+/*
+ *	Resets the timmers, see SARResetTimmersCB() in main.c.
+ */
+void SARResetTimmersCB(sar_core_struct *core_ptr, time_t t_new)
+{
+	cur_millitime = t_new;
+	lapsed_millitime = 0l;
+	time_compensation = 1.0f;
+	memset(&next, 0x00, sizeof(sar_next_struct));
+}
+
+/*
+ *	Load progress callback, nothing is displayed.
+ */
+int SARLoadProgressCB(void *ptr, long pos, long size)
+{
+	return(0);
+}
+
+static void SARHeadlessPrintUsage(const char *prog_name)
+{
+	printf(
+"Usage: %s [options] <mission.mis | scene.scn>\n\
+\n\
+    --aircraft <file>      Player aircraft (required for a scene).\n\
+    --controls <file>      Control script for the player aircraft.\n\
+    --seed <n>             Random number seed (default 1).\n\
+    --tick-rate <hz>       Simulation ticks per second (default %i).\n\
+    --time <seconds>       Maximum simulated time (default 3600).\n\
+\n\
+Returns 0 if the mission succeeded or the time limit was reached\n\
+in free flight, 1 if the mission failed and 2 on error.\n",
+	    prog_name, SAR_DEF_SIM_TICK_RATE
+	);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int i, status, tick_rate = SAR_DEF_SIM_TICK_RATE;
+	int total_controls = 0, cur_control = 0;
+	unsigned int seed = 1;
+	long ticks, max_ticks;
+	float max_time = 3600.0f;
+	double wall_sec;
+	clock_t wall_start;
+	time_t tick_ms, t_start;
+	const sar_position_struct *pos;
+	const char *arg, *ext, *file = NULL, *aircraft_file = NULL,
+		*controls_file = NULL, *outcome;
+	sar_headless_control_struct *control = NULL;
+	sar_core_struct *core_ptr;
+	sar_scene_struct *scene;
+	sar_option_struct *opt;
+
+	for(i = 1; i < argc; i++)
+	{
+	    arg = argv[i];
+	    if(!strcmp(arg, "--help") || !strcmp(arg, "-h"))
+	    {
+		SARHeadlessPrintUsage(argv[0]);
+		return(0);
+	    }
+	    else if(!strcmp(arg, "--aircraft") && ((i + 1) < argc))
+		aircraft_file = argv[++i];
+	    else if(!strcmp(arg, "--controls") && ((i + 1) < argc))
+		controls_file = argv[++i];
+	    else if(!strcmp(arg, "--seed") && ((i + 1) < argc))
+		seed = (unsigned int)strtoul(argv[++i], NULL, 0);
+	    else if(!strcmp(arg, "--tick-rate") && ((i + 1) < argc))
+		tick_rate = atoi(argv[++i]);
+	    else if(!strcmp(arg, "--time") && ((i + 1) < argc))
+		max_time = (float)atof(argv[++i]);
+	    else if(*arg != '-')
+		file = arg;
+	    else
+	    {
+		SARHeadlessPrintUsage(argv[0]);
+		return(2);
+	    }
+	}
+	if(file == NULL)
+	{
+	    SARHeadlessPrintUsage(argv[0]);
+	    return(2);
+	}
+	ext = strrchr(file, '.');
+	if((ext != NULL) && !strcasecmp(ext, ".scn") && (aircraft_file == NULL))
+	{
+	    fprintf(stderr, "%s: A scene needs --aircraft.\n", file);
+	    return(2);
+	}
+	if(tick_rate <= 0)
+	    tick_rate = SAR_DEF_SIM_TICK_RATE;
+	tick_ms = (time_t)MAX(1000 / tick_rate, 1);
+	max_ticks = (long)(max_time * 1000.0f / (float)tick_ms);
+
+	SARHeadlessSetPaths();
+
+	/* Create the core without a window, sound or game
+	 * controllers, the display is only passed to the null graphics
+	 * wrapper and the game controller only holds the values set by
+	 * the control script
+	 */
+	core_ptr = SAR_CORE(calloc(1, sizeof(sar_core_struct)));
+	if(core_ptr == NULL)
+	    return(2);
+	core_ptr->cur_menu = -1;
+	core_ptr->display = GW_DISPLAY(calloc(1, sizeof(gw_display_struct)));
+	core_ptr->gctl = GCTL(calloc(1, sizeof(gctl_struct)));
+	core_ptr->scene = SAR_SCENE(calloc(1, sizeof(sar_scene_struct)));
+	if((core_ptr->display == NULL) || (core_ptr->gctl == NULL) ||
+	   (core_ptr->scene == NULL)
+	)
+	    return(2);
+	scene = core_ptr->scene;
+
+	opt = &core_ptr->option;
+	opt->textured_ground = False;
+	opt->textured_objects = False;
+	opt->textured_clouds = False;
+	opt->hoist_contact_expansion_coeff = 1.0f;
+	opt->damage_resistance_coeff = 1.0f;
+	opt->flight_physics_level = FLIGHT_PHYSICS_REALISTIC;
+	opt->wind = True;
+	opt->sim_tick_rate = tick_rate;
+	opt->sim_max_ticks = 1;
+	opt->explosion_frame_int = 100l;
+	opt->splash_frame_int = 80l;
+	opt->crash_explosion_life_span = 40000l;
+	opt->fuel_tank_life_span = 50000l;
+
+	time_compression = 1.0f;
+	cur_systime = time(NULL);
+	SARResetTimmersCB(core_ptr, SARGetCurMilliTime());
+
+	SARTextureListLoadFromFile(
+	    fname.textures,
+	    &core_ptr->texture_list,
+	    &core_ptr->total_texture_list
+	);
+	core_ptr->human_data = SARHumanPresetsInit(core_ptr);
+	SARHumanLoadFromFile(core_ptr->human_data, fname.human);
+	core_ptr->weather_data = SARWeatherPresetsInit(core_ptr);
+	SARWeatherLoadFromFile(core_ptr->weather_data, fname.weather);
+
+	if(controls_file != NULL)
+	{
+	    control = SARHeadlessLoadControls(controls_file, &total_controls);
+	    if(control == NULL)
+		return(2);
+	}
+
+	/* Load the mission or the scene and player aircraft, the same
+	 * seed always gives the same flight
+	 */
+	SARRandomSeed(seed);
+	if((ext != NULL) && !strcasecmp(ext, ".scn"))
+	{
+	    if(SARSceneLoadFromFile(
+		core_ptr, scene, file, NULL,
+		core_ptr, SARLoadProgressCB
+	    ))
+	    {
+		fprintf(stderr, "%s: Unable to load the scene.\n", file);
+		return(2);
+	    }
+	    SARSceneAddPlayerObject(
+		core_ptr, scene, aircraft_file, NULL, NULL
+	    );
+	}
+	else
+	{
+	    core_ptr->mission = SARMissionLoadFromFile(
+		core_ptr, file,
+		core_ptr, SARLoadProgressCB
+	    );
+	    if(core_ptr->mission == NULL)
+	    {
+		fprintf(stderr, "%s: Unable to load the mission.\n", file);
+		return(2);
+	    }
+	}
+	if(scene->player_obj_ptr == NULL)
+	{
+	    fprintf(stderr, "%s: No player aircraft.\n", file);
+	    return(2);
+	}
+
+	/* Run the simulation in fixed ticks of simulated time */
+	SARResetTimmersCB(core_ptr, SARGetCurMilliTime());
+	t_start = cur_millitime;
+	lapsed_millitime = tick_ms;
+	time_compensation = (float)tick_ms / (float)CYCLE_LAPSE_MS;
+
+	status = 0;
+	wall_start = clock();
+	for(ticks = 0; ticks < max_ticks; ticks++)
+	{
+	    cur_millitime += tick_ms;
+	    cur_systime = t_start / 1000l + (cur_millitime - t_start) / 1000l;
+
+	    SARHeadlessApplyControls(
+		core_ptr, control, total_controls,
+		&cur_control, cur_millitime - t_start
+	    );
+
+	    SARSimUpdateScene(core_ptr, scene);
+	    SARSimUpdateSceneObjects(core_ptr, scene);
+
+	    status = SARMissionManage(core_ptr);
+	    if((status == 1) || (status == 2))
+	    {
+		ticks++;
+		break;
+	    }
+	}
+	wall_sec = (double)(clock() - wall_start) / (double)CLOCKS_PER_SEC;
+
+	/* Report */
+	pos = &scene->player_obj_ptr->pos;
+	if(status == 1)
+	    outcome = "success";
+	else if(status == 2)
+	    outcome = "failed";
+	else if(core_ptr->mission != NULL)
+	    outcome = "time limit reached";
+	else
+	    outcome = "free flight";
+	printf(
+"Ticks: %ld (%i Hz)\n\
+Simulated time: %.1f seconds\n\
+CPU time: %.3f seconds\n\
+Ticks per second: %.1f\n\
+Player position: %.1f %.1f %.1f\n\
+Player crashed: %s\n\
+Outcome: %s\n",
+	    ticks, tick_rate,
+	    (float)(ticks * tick_ms) / 1000.0f,
+	    wall_sec,
+	    (wall_sec > 0.0) ? ((double)ticks / wall_sec) : 0.0,
+	    pos->x, pos->y, pos->z,
+	    scene->player_has_crashed ? "yes" : "no",
+	    outcome
+	);
+
+	/* Shutdown */
+	SARMissionDelete(core_ptr->mission);
+	core_ptr->mission = NULL;
+	SARSceneDestroy(
+	    core_ptr, scene,
+	    &core_ptr->object, &core_ptr->total_objects
+	);
+	free(core_ptr->scene);
+	SARHumanPresetsShutdown(core_ptr->human_data);
+	SARWeatherPresetsShutdown(core_ptr->weather_data);
+	SARTextureListDeleteAll(
+	    &core_ptr->texture_list,
+	    &core_ptr->total_texture_list
+	);
+	free(core_ptr->gctl);
+	free(core_ptr->display);
+	SARDrawQueueClear(&core_ptr->draw_queue);
+	SARDrawParticlesClear(&core_ptr->draw_particles);
+	SARDrawLightsClear(&core_ptr->draw_lights);
+	SARDrawShadowsClear(&core_ptr->draw_shadows);
+	SARDrawOcclusionClear(&core_ptr->draw_occlusion);
+	free(core_ptr);
+	free(control);
+
+	return((status == 2) ? 1 : 0);
+}
@@ -132,7 +132,10 @@ static void SARKeyCameraRefCockpit(SAR_KEY_FUNC_PROTOTYPE)
 
 	prev_camera_ref = scene->camera_ref;
 	scene->camera_ref = SAR_CAMERA_REF_COCKPIT;
-	scene->camera_target = scene->player_obj_num;
+	scene->camera_target = SARObjGetFromHandle(
+	    scene, core_ptr->object, core_ptr->total_objects,
+	    scene->player_obj_handle
+	);
 
 	if(prev_camera_ref != scene->camera_ref)
 	    SARCameraRefTitleSet(scene, "Cockpit");
@@ -150,7 +153,10 @@ static void SARKeyCameraRefHoist(SAR_KEY_FUNC_PROTOTYPE)
 
 	prev_camera_ref = scene->camera_ref;
 	scene->camera_ref = SAR_CAMERA_REF_HOIST;
-	scene->camera_target = scene->player_obj_num;
+	scene->camera_target = SARObjGetFromHandle(
+	    scene, core_ptr->object, core_ptr->total_objects,
+	    scene->player_obj_handle
+	);
 
 	if(prev_camera_ref != scene->camera_ref)
 	    SARCameraRefTitleSet(scene, "Hoist");
@@ -288,7 +294,10 @@ static void SARKeyCameraRefSpot(SAR_KEY_FUNC_PROTOTYPE)
 	     * set to spot and target the player object.
 	     */
 	    scene->camera_ref = SAR_CAMERA_REF_SPOT;
-	    scene->camera_target = obj_num = scene->player_obj_num;
+	    scene->camera_target = obj_num = SARObjGetFromHandle(
+	        scene, core_ptr->object, core_ptr->total_objects,
+	        scene->player_obj_handle
+	    );
 	}
 
 	/* At this point obj_num should now be the matched object or -1
@@ -327,7 +336,10 @@ static void SARKeyCameraRefTower(SAR_KEY_FUNC_PROTOTYPE)
 
 	prev_camera_ref = scene->camera_ref;
 	scene->camera_ref = SAR_CAMERA_REF_TOWER;
-	scene->camera_target = scene->player_obj_num;
+	scene->camera_target = SARObjGetFromHandle(
+	    scene, core_ptr->object, core_ptr->total_objects,
+	    scene->player_obj_handle
+	);
 
 	SARSimSetFlyByPosition(
 	    scene,
@@ -1862,7 +1874,10 @@ static void SARKeyDropPassengers(SAR_KEY_FUNC_PROTOTYPE)
 		list = SARGetGCCHitList(
 		    core_ptr, scene,
 		    &core_ptr->object, &core_ptr->total_objects,
-		    scene->player_obj_num,
+		    SARObjGetFromHandle(
+			scene, core_ptr->object, core_ptr->total_objects,
+			scene->player_obj_handle
+		    ),
 		    &list_total
 		);
 		/* Iterate through objects at this object's location
@@ -2008,7 +2023,10 @@ static int SARKeyRestart(SAR_KEY_FUNC_PROTOTYPE)
 	    GCtlResetValues(core_ptr->gctl);
 
 	    /* Get references to player objects */
-	    obj_num = scene->player_obj_num;
+	    obj_num = SARObjGetFromHandle(
+	        scene, core_ptr->object, core_ptr->total_objects,
+	        scene->player_obj_handle
+	    );
 	    obj_ptr = scene->player_obj_ptr;
 	    if(obj_ptr != NULL)
 	    {
@@ -2096,7 +2114,10 @@ static void SARKeyRefuelRepair(SAR_KEY_FUNC_PROTOTYPE)
 		list = SARGetGCCHitList(
 		    core_ptr, scene,
 		    &core_ptr->object, &core_ptr->total_objects,
-		    scene->player_obj_num,
+		    SARObjGetFromHandle(
+			scene, core_ptr->object, core_ptr->total_objects,
+			scene->player_obj_handle
+		    ),
 		    &list_total
 		);
 		/* Iterate through objects at this object's location
@@ -2198,7 +2219,10 @@ static void SARKeyFuel(SAR_KEY_FUNC_PROTOTYPE)
 	if((scene == NULL) || !state)
 	    return;
 
-	obj_num = scene->player_obj_num;
+	obj_num = SARObjGetFromHandle(
+	    scene, core_ptr->object, core_ptr->total_objects,
+	    scene->player_obj_handle
+	);
 	obj_ptr = scene->player_obj_ptr;
 	if(obj_ptr != NULL)
 	{
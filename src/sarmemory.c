@@ -153,12 +153,11 @@ void SARMemoryStat(
 	    m += scene->total_ground_objects * sizeof(sar_object_struct *);
 	    m += scene->total_human_need_rescue_objects * sizeof(sar_object_struct *);
 
-	    for(i = 0; i < horizon->total_textures; i++)
-		stat_buf->texture += SARMemoryStatTexture(
-		    horizon->texture[i]
-		);
-	    stat_buf->ntextures += horizon->total_textures;
-	    m += horizon->total_textures * sizeof(v3d_texture_ref_struct *);
+	    if(horizon->texture != NULL)
+	    {
+		stat_buf->texture += SARMemoryStatTexture(horizon->texture);
+		stat_buf->ntextures++;
+	    }
 
 	    for(i = 0; i < scene->total_cloud_layers; i++)
 	    {
@@ -247,7 +246,7 @@ void SARMemoryStat(
 		    if(obj_aircraft->hoist != NULL)
 		    {
 			const sar_obj_hoist_struct *hoist = obj_aircraft->hoist;
-			m += hoist->total_occupants * sizeof(int);
+			m += hoist->total_occupants * sizeof(sar_obj_handle);
 			m += sizeof(sar_obj_hoist_struct);
 		    }
 
@@ -0,0 +1,837 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			  SAR Flight Replays
+
+	The simulation only takes input from the frame timings (the
+	current time in milliseconds passed to SARManage()), the
+	game controller positions from GCtlUpdate(), the key events
+	and the random numbers from SARRandom(). Recording all of them
+	and the random seed of each scene is enough to fly the scene
+	again exactly as it was flown.
+
+	A replay file starts with the SAR_REPLAY_MAGIC and the
+	SAR_REPLAY_VERSION (32 bits), followed by records that each
+	start with an 8 bit record type (one of SAR_REPLAY_REC_*):
+
+	SAR_REPLAY_REC_BEGIN		seed (32), name length (16), name
+	SAR_REPLAY_REC_END
+	SAR_REPLAY_REC_TIME		current time in ms (32)
+	SAR_REPLAY_REC_LAPSE		ms since the last time record (16)
+	SAR_REPLAY_REC_GCTL		packed GCtlUpdate() results
+	SAR_REPLAY_REC_GCTL_SAME
+	SAR_REPLAY_REC_KEY		key (32), flags (8), time stamp (32)
+
+	All values are little endian and floats are stored as their
+	IEEE 754 bits, so a replay plays back the same on any host.
+	Each frame of a scene is one time (or lapse) record followed
+	by one GCtlUpdate() record, the key events received between two
+	frames are recorded in between and played back before the
+	next frame.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/types.h>
+
+#include "gw.h"
+#include "gctl.h"
+#include "sarreplay.h"
+
+
+#define SAR_REPLAY_MAGIC	"SAR2RPLY"
+#define SAR_REPLAY_MAGIC_LEN	8
+#define SAR_REPLAY_VERSION	1
+
+#define SAR_REPLAY_NAME_MAX	256
+
+/* Key record flags */
+#define SAR_REPLAY_KEY_STATE	(1 << 0)
+#define SAR_REPLAY_KEY_ALT	(1 << 1)
+#define SAR_REPLAY_KEY_CTRL	(1 << 2)
+#define SAR_REPLAY_KEY_SHIFT	(1 << 3)
+
+/*
+ *	Replay record, as read from the replay file:
+ */
+typedef struct {
+
+	int		type;		/* One of SAR_REPLAY_REC_* */
+
+	/* Seed, time or lapse */
+	u_int32_t	value;
+
+	char		name[SAR_REPLAY_NAME_MAX];
+
+	u_int8_t	gctl[SAR_REPLAY_GCTL_SIZE];
+
+	int		key;
+	u_int8_t	key_flags;
+	u_int32_t	key_t;
+
+} sar_replay_rec_struct;
+
+
+static void SARReplayPutU8(FILE *fp, u_int8_t v);
+static void SARReplayPutU16(FILE *fp, u_int16_t v);
+static void SARReplayPutU32(FILE *fp, u_int32_t v);
+static int SARReplayGetU8(FILE *fp, u_int8_t *v);
+static int SARReplayGetU16(FILE *fp, u_int16_t *v);
+static int SARReplayGetU32(FILE *fp, u_int32_t *v);
+static void SARReplayPackFloat(u_int8_t *buf, float f);
+static float SARReplayUnpackFloat(const u_int8_t *buf);
+static void SARReplayPackGCtl(const gctl_struct *gc, u_int8_t *buf);
+static void SARReplayUnpackGCtl(const u_int8_t *buf, gctl_struct *gc);
+
+static void SARReplayStop(sar_replay_struct *replay, const char *reason);
+static int SARReplayRead(
+	sar_replay_struct *replay, sar_replay_rec_struct *rec
+);
+static void SARReplayDispatchKey(
+	sar_replay_struct *replay, const sar_replay_rec_struct *rec
+);
+static int SARReplayNext(
+	sar_replay_struct *replay, sar_replay_rec_struct *rec
+);
+
+sar_replay_struct *SARReplayNew(
+	const char *filename, int mode,
+	gw_display_struct *display,
+	void (*key_cb)(void *, int, Boolean, unsigned long),
+	void *key_data
+);
+void SARReplayDelete(sar_replay_struct *replay);
+
+unsigned int SARReplaySceneBegin(
+	sar_replay_struct *replay,
+	const char *name, unsigned int seed
+);
+void SARReplaySceneEnd(sar_replay_struct *replay);
+
+time_t SARReplayTime(sar_replay_struct *replay, time_t t);
+void SARReplayGCtl(sar_replay_struct *replay, gctl_struct *gc);
+Boolean SARReplayKey(
+	sar_replay_struct *replay,
+	int c, Boolean state, unsigned long t
+);
+
+
+#define MAX(a,b)	(((a) > (b)) ? (a) : (b))
+#define MIN(a,b)	(((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)	(MIN(MAX((a),(l)),(h)))
+#define STRDUP(s)	(((s) != NULL) ? strdup(s) : NULL)
+
+
+/*
+ *	Writes the value to the replay file in little endian.
+ */
+static void SARReplayPutU8(FILE *fp, u_int8_t v)
+{
+	fputc((int)v, fp);
+}
+
+static void SARReplayPutU16(FILE *fp, u_int16_t v)
+{
+	fputc((int)(v & 0xff), fp);
+	fputc((int)((v >> 8) & 0xff), fp);
+}
+
+static void SARReplayPutU32(FILE *fp, u_int32_t v)
+{
+	fputc((int)(v & 0xff), fp);
+	fputc((int)((v >> 8) & 0xff), fp);
+	fputc((int)((v >> 16) & 0xff), fp);
+	fputc((int)((v >> 24) & 0xff), fp);
+}
+
+/*
+ *	Reads the little endian value from the replay file.
+ *
+ *	Returns non-zero at the end of the file.
+ */
+static int SARReplayGetU8(FILE *fp, u_int8_t *v)
+{
+	int c = fgetc(fp);
+	if(c == EOF)
+	    return(-1);
+
+	*v = (u_int8_t)c;
+	return(0);
+}
+
+static int SARReplayGetU16(FILE *fp, u_int16_t *v)
+{
+	u_int8_t b[2];
+	if(fread(b, sizeof(u_int8_t), 2, fp) != 2)
+	    return(-1);
+
+	*v = (u_int16_t)(b[0] | (b[1] << 8));
+	return(0);
+}
+
+static int SARReplayGetU32(FILE *fp, u_int32_t *v)
+{
+	u_int8_t b[4];
+	if(fread(b, sizeof(u_int8_t), 4, fp) != 4)
+	    return(-1);
+
+	*v = (u_int32_t)b[0] | ((u_int32_t)b[1] << 8) |
+	    ((u_int32_t)b[2] << 16) | ((u_int32_t)b[3] << 24);
+	return(0);
+}
+
+/*
+ *	Packs or unpacks the float's IEEE 754 bits in little endian.
+ */
+static void SARReplayPackFloat(u_int8_t *buf, float f)
+{
+	u_int32_t v;
+
+	memcpy(&v, &f, sizeof(u_int32_t));
+	buf[0] = (u_int8_t)(v & 0xff);
+	buf[1] = (u_int8_t)((v >> 8) & 0xff);
+	buf[2] = (u_int8_t)((v >> 16) & 0xff);
+	buf[3] = (u_int8_t)((v >> 24) & 0xff);
+}
+
+static float SARReplayUnpackFloat(const u_int8_t *buf)
+{
+	float f;
+	u_int32_t v = (u_int32_t)buf[0] | ((u_int32_t)buf[1] << 8) |
+	    ((u_int32_t)buf[2] << 16) | ((u_int32_t)buf[3] << 24);
+
+	memcpy(&f, &v, sizeof(float));
+	return(f);
+}
+
+/*
+ *	Packs the GCtlUpdate() results into buf, which must be
+ *	SAR_REPLAY_GCTL_SIZE bytes.
+ */
+static void SARReplayPackGCtl(const gctl_struct *gc, u_int8_t *buf)
+{
+	u_int8_t flags = 0;
+
+	SARReplayPackFloat(&buf[0], gc->heading);
+	SARReplayPackFloat(&buf[4], gc->pitch);
+	SARReplayPackFloat(&buf[8], gc->bank);
+	SARReplayPackFloat(&buf[12], gc->throttle);
+	SARReplayPackFloat(&buf[16], gc->hat_x);
+	SARReplayPackFloat(&buf[20], gc->hat_y);
+	SARReplayPackFloat(&buf[24], gc->zoom_in_coeff);
+	SARReplayPackFloat(&buf[28], gc->zoom_out_coeff);
+	SARReplayPackFloat(&buf[32], gc->hoist_up_coeff);
+	SARReplayPackFloat(&buf[36], gc->hoist_down_coeff);
+	SARReplayPackFloat(&buf[40], gc->air_brakes_coeff);
+	SARReplayPackFloat(&buf[44], gc->wheel_brakes_coeff);
+
+	if(gc->zoom_in_state)
+	    flags |= (1 << 0);
+	if(gc->zoom_out_state)
+	    flags |= (1 << 1);
+	if(gc->hoist_up_state)
+	    flags |= (1 << 2);
+	if(gc->hoist_down_state)
+	    flags |= (1 << 3);
+	if(gc->alt_state)
+	    flags |= (1 << 4);
+	if(gc->ctrl_state)
+	    flags |= (1 << 5);
+	if(gc->shift_state)
+	    flags |= (1 << 6);
+	if(gc->air_brakes_state)
+	    flags |= (1 << 7);
+	buf[48] = flags;
+	buf[49] = (u_int8_t)gc->wheel_brakes_state;
+}
+
+/*
+ *	Sets the GCtlUpdate() results from the packed buf.
+ */
+static void SARReplayUnpackGCtl(const u_int8_t *buf, gctl_struct *gc)
+{
+	const u_int8_t flags = buf[48];
+
+	gc->heading = SARReplayUnpackFloat(&buf[0]);
+	gc->pitch = SARReplayUnpackFloat(&buf[4]);
+	gc->bank = SARReplayUnpackFloat(&buf[8]);
+	gc->throttle = SARReplayUnpackFloat(&buf[12]);
+	gc->hat_x = SARReplayUnpackFloat(&buf[16]);
+	gc->hat_y = SARReplayUnpackFloat(&buf[20]);
+	gc->zoom_in_coeff = SARReplayUnpackFloat(&buf[24]);
+	gc->zoom_out_coeff = SARReplayUnpackFloat(&buf[28]);
+	gc->hoist_up_coeff = SARReplayUnpackFloat(&buf[32]);
+	gc->hoist_down_coeff = SARReplayUnpackFloat(&buf[36]);
+	gc->air_brakes_coeff = SARReplayUnpackFloat(&buf[40]);
+	gc->wheel_brakes_coeff = SARReplayUnpackFloat(&buf[44]);
+
+	gc->zoom_in_state = (flags & (1 << 0)) ? True : False;
+	gc->zoom_out_state = (flags & (1 << 1)) ? True : False;
+	gc->hoist_up_state = (flags & (1 << 2)) ? True : False;
+	gc->hoist_down_state = (flags & (1 << 3)) ? True : False;
+	gc->alt_state = (flags & (1 << 4)) ? True : False;
+	gc->ctrl_state = (flags & (1 << 5)) ? True : False;
+	gc->shift_state = (flags & (1 << 6)) ? True : False;
+	gc->air_brakes_state = (flags & (1 << 7)) ? True : False;
+	gc->wheel_brakes_state = (int)buf[49];
+}
+
+
+/*
+ *	Stops recording or playing back, the game continues with the
+ *	live frame timings and game controller.
+ */
+static void SARReplayStop(sar_replay_struct *replay, const char *reason)
+{
+	if(replay->mode == SAR_REPLAY_MODE_NONE)
+	    return;
+
+	fprintf(
+	    stderr,
+	    "%s: %s, replay stopped after %lu frames.\n",
+	    replay->filename, reason, replay->frames
+	);
+
+	replay->mode = SAR_REPLAY_MODE_NONE;
+	replay->active = False;
+}
+
+/*
+ *	Reads the next record from the replay file.
+ *
+ *	Returns non-zero at the end of the file or on a truncated
+ *	record.
+ */
+static int SARReplayRead(
+	sar_replay_struct *replay, sar_replay_rec_struct *rec
+)
+{
+	u_int8_t type;
+	u_int16_t len, v16;
+	FILE *fp = replay->fp;
+
+	if(SARReplayGetU8(fp, &type))
+	    return(-1);
+
+	rec->type = (int)type;
+	switch(rec->type)
+	{
+	  case SAR_REPLAY_REC_BEGIN:
+	    if(SARReplayGetU32(fp, &rec->value) ||
+	       SARReplayGetU16(fp, &len)
+	    )
+		return(-1);
+	    if(len >= SAR_REPLAY_NAME_MAX)
+		return(-1);
+	    if(fread(rec->name, sizeof(char), len, fp) != len)
+		return(-1);
+	    rec->name[len] = '\0';
+	    break;
+
+	  case SAR_REPLAY_REC_END:
+	  case SAR_REPLAY_REC_GCTL_SAME:
+	    break;
+
+	  case SAR_REPLAY_REC_TIME:
+	    if(SARReplayGetU32(fp, &rec->value))
+		return(-1);
+	    break;
+
+	  case SAR_REPLAY_REC_LAPSE:
+	    if(SARReplayGetU16(fp, &v16))
+		return(-1);
+	    rec->value = (u_int32_t)v16;
+	    break;
+
+	  case SAR_REPLAY_REC_GCTL:
+	    if(fread(
+		rec->gctl, sizeof(u_int8_t), SAR_REPLAY_GCTL_SIZE, fp
+	    ) != SAR_REPLAY_GCTL_SIZE)
+		return(-1);
+	    break;
+
+	  case SAR_REPLAY_REC_KEY:
+	    if(SARReplayGetU32(fp, &rec->value) ||
+	       SARReplayGetU8(fp, &rec->key_flags) ||
+	       SARReplayGetU32(fp, &rec->key_t)
+	    )
+		return(-1);
+	    rec->key = (int)(int32_t)rec->value;
+	    break;
+
+	  default:
+	    /* Unsupported record type, the rest of the file can not
+	     * be parsed
+	     */
+	    return(-1);
+	    break;
+	}
+
+	return(0);
+}
+
+/*
+ *	Plays back the recorded key event with the recorded alt, ctrl
+ *	and shift key states.
+ */
+static void SARReplayDispatchKey(
+	sar_replay_struct *replay, const sar_replay_rec_struct *rec
+)
+{
+	gw_display_struct *display = replay->display;
+	Boolean alt_key_state = False,
+		ctrl_key_state = False,
+		shift_key_state = False;
+
+	if(replay->key_cb == NULL)
+	    return;
+
+	if(display != NULL)
+	{
+	    alt_key_state = display->alt_key_state;
+	    ctrl_key_state = display->ctrl_key_state;
+	    shift_key_state = display->shift_key_state;
+	    display->alt_key_state =
+		(rec->key_flags & SAR_REPLAY_KEY_ALT) ? True : False;
+	    display->ctrl_key_state =
+		(rec->key_flags & SAR_REPLAY_KEY_CTRL) ? True : False;
+	    display->shift_key_state =
+		(rec->key_flags & SAR_REPLAY_KEY_SHIFT) ? True : False;
+	}
+
+	replay->dispatching = True;
+	replay->key_cb(
+	    replay->key_data,
+	    rec->key,
+	    (rec->key_flags & SAR_REPLAY_KEY_STATE) ? True : False,
+	    (unsigned long)rec->key_t
+	);
+	replay->dispatching = False;
+
+	if(display != NULL)
+	{
+	    display->alt_key_state = alt_key_state;
+	    display->ctrl_key_state = ctrl_key_state;
+	    display->shift_key_state = shift_key_state;
+	}
+}
+
+/*
+ *	Plays back the key events up to the next record and reads it.
+ *
+ *	Returns 0 if a record was read, 1 if a played back key event
+ *	ended the scene or -1 if the replay was stopped.
+ */
+static int SARReplayNext(
+	sar_replay_struct *replay, sar_replay_rec_struct *rec
+)
+{
+	while(True)
+	{
+	    if(SARReplayRead(replay, rec))
+	    {
+		SARReplayStop(replay, "End of replay");
+		return(-1);
+	    }
+
+	    if(rec->type != SAR_REPLAY_REC_KEY)
+		return(0);
+
+	    SARReplayDispatchKey(replay, rec);
+	    if(!replay->active)
+		return(1);
+	}
+}
+
+
+/*
+ *	Opens the replay file for recording or playing back (mode is
+ *	one of SAR_REPLAY_MODE_*).
+ *
+ *	Key events are played back by calling key_cb, which is normally
+ *	the keyboard callback that calls SARReplayKey().
+ *
+ *	Returns NULL on error.
+ */
+sar_replay_struct *SARReplayNew(
+	const char *filename, int mode,
+	gw_display_struct *display,
+	void (*key_cb)(void *, int, Boolean, unsigned long),
+	void *key_data
+)
+{
+	FILE *fp;
+	sar_replay_struct *replay;
+
+	if(filename == NULL)
+	    return(NULL);
+
+	if(mode == SAR_REPLAY_MODE_RECORD)
+	{
+	    fp = fopen(filename, "wb");
+	    if(fp == NULL)
+	    {
+		fprintf(
+		    stderr,
+		    "%s: Unable to open the replay file for writing.\n",
+		    filename
+		);
+		return(NULL);
+	    }
+
+	    fwrite(SAR_REPLAY_MAGIC, sizeof(char), SAR_REPLAY_MAGIC_LEN, fp);
+	    SARReplayPutU32(fp, SAR_REPLAY_VERSION);
+	}
+	else if(mode == SAR_REPLAY_MODE_PLAY)
+	{
+	    char magic[SAR_REPLAY_MAGIC_LEN];
+	    u_int32_t version = 0;
+
+	    fp = fopen(filename, "rb");
+	    if(fp == NULL)
+	    {
+		fprintf(
+		    stderr,
+		    "%s: Unable to open the replay file for reading.\n",
+		    filename
+		);
+		return(NULL);
+	    }
+
+	    if((fread(
+		magic, sizeof(char), SAR_REPLAY_MAGIC_LEN, fp
+	       ) != SAR_REPLAY_MAGIC_LEN) ||
+	       memcmp(magic, SAR_REPLAY_MAGIC, SAR_REPLAY_MAGIC_LEN) ||
+	       SARReplayGetU32(fp, &version) ||
+	       (version != SAR_REPLAY_VERSION)
+	    )
+	    {
+		fprintf(
+		    stderr,
+		    "%s: Not a version %i replay file.\n",
+		    filename, SAR_REPLAY_VERSION
+		);
+		fclose(fp);
+		return(NULL);
+	    }
+	}
+	else
+	{
+	    return(NULL);
+	}
+
+	replay = SAR_REPLAY(calloc(1, sizeof(sar_replay_struct)));
+	if(replay == NULL)
+	{
+	    fclose(fp);
+	    return(NULL);
+	}
+
+	replay->mode = mode;
+	replay->filename = STRDUP(filename);
+	replay->fp = fp;
+	replay->active = False;
+	replay->dispatching = False;
+	replay->last_time = -1;
+	replay->frames = 0l;
+	replay->display = display;
+	replay->key_data = key_data;
+	replay->key_cb = key_cb;
+
+	return(replay);
+}
+
+/*
+ *	Closes the replay file and deletes the replay.
+ */
+void SARReplayDelete(sar_replay_struct *replay)
+{
+	if(replay == NULL)
+	    return;
+
+	if(replay->fp != NULL)
+	{
+	    if(replay->mode == SAR_REPLAY_MODE_RECORD)
+		SARReplaySceneEnd(replay);
+	    fclose(replay->fp);
+	}
+	free(replay->filename);
+	free(replay);
+}
+
+
+/*
+ *	Begins recording or playing back a scene, this should be called
+ *	before the scene is loaded.
+ *
+ *	The name identifies the mission or scene. When recording, the
+ *	given seed is recorded. When playing back, the next recorded
+ *	scene must have the same name.
+ *
+ *	Returns the seed to pass to SARRandomSeed().
+ */
+unsigned int SARReplaySceneBegin(
+	sar_replay_struct *replay,
+	const char *name, unsigned int seed
+)
+{
+	sar_replay_rec_struct rec;
+
+	if(replay == NULL)
+	    return(seed);
+
+	if(name == NULL)
+	    name = "";
+
+	replay->active = False;
+	replay->last_time = -1;
+	replay->frames = 0l;
+
+	switch(replay->mode)
+	{
+	  case SAR_REPLAY_MODE_RECORD:
+	    {
+		const int len = MIN((int)strlen(name), SAR_REPLAY_NAME_MAX - 1);
+
+		SARReplayPutU8(replay->fp, SAR_REPLAY_REC_BEGIN);
+		SARReplayPutU32(replay->fp, (u_int32_t)seed);
+		SARReplayPutU16(replay->fp, (u_int16_t)len);
+		fwrite(name, sizeof(char), len, replay->fp);
+		replay->active = True;
+	    }
+	    break;
+
+	  case SAR_REPLAY_MODE_PLAY:
+	    /* Skip the rest of the last recorded scene, if any */
+	    while(True)
+	    {
+		if(SARReplayRead(replay, &rec))
+		{
+		    SARReplayStop(replay, "End of replay");
+		    return(seed);
+		}
+		if(rec.type == SAR_REPLAY_REC_BEGIN)
+		    break;
+	    }
+
+	    if(strncmp(name, rec.name, SAR_REPLAY_NAME_MAX - 1))
+	    {
+		fprintf(
+		    stderr,
+		    "%s: Replay was recorded for `%s' but `%s' was started.\n",
+		    replay->filename, rec.name, name
+		);
+		SARReplayStop(replay, "Wrong scene");
+		return(seed);
+	    }
+
+	    replay->active = True;
+	    seed = (unsigned int)rec.value;
+	    break;
+	}
+
+	return(seed);
+}
+
+/*
+ *	Ends recording or playing back the scene.
+ */
+void SARReplaySceneEnd(sar_replay_struct *replay)
+{
+	if(replay == NULL)
+	    return;
+
+	if(!replay->active)
+	    return;
+
+	if(replay->mode == SAR_REPLAY_MODE_RECORD)
+	{
+	    SARReplayPutU8(replay->fp, SAR_REPLAY_REC_END);
+	    fflush(replay->fp);
+	    if(ferror(replay->fp))
+		SARReplayStop(replay, "Error writing replay file");
+	}
+
+	replay->active = False;
+}
+
+
+/*
+ *	Records the current time in milliseconds t when recording or
+ *	returns the recorded one when playing back, the key events
+ *	recorded before it are played back first.
+ *
+ *	This should be called once per frame in place of
+ *	SARGetCurMilliTime() and when the timers are reset.
+ */
+time_t SARReplayTime(sar_replay_struct *replay, time_t t)
+{
+	sar_replay_rec_struct rec;
+
+	if(replay == NULL)
+	    return(t);
+
+	if(!replay->active)
+	    return(t);
+
+	switch(replay->mode)
+	{
+	  case SAR_REPLAY_MODE_RECORD:
+	    if((replay->last_time >= 0l) &&
+	       (t >= replay->last_time) &&
+	       ((t - replay->last_time) <= 0xffff)
+	    )
+	    {
+		SARReplayPutU8(replay->fp, SAR_REPLAY_REC_LAPSE);
+		SARReplayPutU16(
+		    replay->fp, (u_int16_t)(t - replay->last_time)
+		);
+	    }
+	    else
+	    {
+		SARReplayPutU8(replay->fp, SAR_REPLAY_REC_TIME);
+		SARReplayPutU32(replay->fp, (u_int32_t)t);
+	    }
+	    replay->last_time = t;
+	    break;
+
+	  case SAR_REPLAY_MODE_PLAY:
+	    if(SARReplayNext(replay, &rec))
+		return(t);
+
+	    if(rec.type == SAR_REPLAY_REC_TIME)
+		replay->last_time = (time_t)rec.value;
+	    else if((rec.type == SAR_REPLAY_REC_LAPSE) &&
+		    (replay->last_time >= 0l)
+	    )
+		replay->last_time += (time_t)rec.value;
+	    else
+	    {
+		SARReplayStop(replay, "Replay out of sync");
+		return(t);
+	    }
+	    t = replay->last_time;
+	    break;
+	}
+
+	return(t);
+}
+
+/*
+ *	Records the results of GCtlUpdate() when recording or sets the
+ *	recorded ones when playing back.
+ *
+ *	This should be called right after GCtlUpdate().
+ */
+void SARReplayGCtl(sar_replay_struct *replay, gctl_struct *gc)
+{
+	sar_replay_rec_struct rec;
+	u_int8_t buf[SAR_REPLAY_GCTL_SIZE];
+
+	if((replay == NULL) || (gc == NULL))
+	    return;
+
+	if(!replay->active)
+	    return;
+
+	switch(replay->mode)
+	{
+	  case SAR_REPLAY_MODE_RECORD:
+	    SARReplayPackGCtl(gc, buf);
+	    if((replay->frames > 0l) &&
+	       !memcmp(buf, replay->last_gctl, SAR_REPLAY_GCTL_SIZE)
+	    )
+	    {
+		SARReplayPutU8(replay->fp, SAR_REPLAY_REC_GCTL_SAME);
+	    }
+	    else
+	    {
+		SARReplayPutU8(replay->fp, SAR_REPLAY_REC_GCTL);
+		fwrite(buf, sizeof(u_int8_t), SAR_REPLAY_GCTL_SIZE, replay->fp);
+		memcpy(replay->last_gctl, buf, SAR_REPLAY_GCTL_SIZE);
+	    }
+	    replay->frames++;
+	    break;
+
+	  case SAR_REPLAY_MODE_PLAY:
+	    if(SARReplayNext(replay, &rec))
+		return;
+
+	    if(rec.type == SAR_REPLAY_REC_GCTL)
+		memcpy(replay->last_gctl, rec.gctl, SAR_REPLAY_GCTL_SIZE);
+	    else if((rec.type != SAR_REPLAY_REC_GCTL_SAME) ||
+		    (replay->frames == 0l)
+	    )
+	    {
+		SARReplayStop(replay, "Replay out of sync");
+		return;
+	    }
+	    SARReplayUnpackGCtl(replay->last_gctl, gc);
+	    replay->frames++;
+	    break;
+	}
+}
+
+/*
+ *	Records the key event when recording.
+ *
+ *	Returns True if the key event should be ignored, which is when
+ *	playing back and the key event did not come from the replay.
+ */
+Boolean SARReplayKey(
+	sar_replay_struct *replay,
+	int c, Boolean state, unsigned long t
+)
+{
+	gw_display_struct *display;
+	u_int8_t flags = 0;
+
+	if(replay == NULL)
+	    return(False);
+
+	if(!replay->active)
+	    return(False);
+
+	switch(replay->mode)
+	{
+	  case SAR_REPLAY_MODE_RECORD:
+	    display = replay->display;
+	    if(state)
+		flags |= SAR_REPLAY_KEY_STATE;
+	    if(display != NULL)
+	    {
+		if(display->alt_key_state)
+		    flags |= SAR_REPLAY_KEY_ALT;
+		if(display->ctrl_key_state)
+		    flags |= SAR_REPLAY_KEY_CTRL;
+		if(display->shift_key_state)
+		    flags |= SAR_REPLAY_KEY_SHIFT;
+	    }
+	    SARReplayPutU8(replay->fp, SAR_REPLAY_REC_KEY);
+	    SARReplayPutU32(replay->fp, (u_int32_t)c);
+	    SARReplayPutU8(replay->fp, flags);
+	    SARReplayPutU32(replay->fp, (u_int32_t)t);
+	    break;
+
+	  case SAR_REPLAY_MODE_PLAY:
+	    return(replay->dispatching ? False : True);
+	    break;
+	}
+
+	return(False);
+}
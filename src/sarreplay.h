@@ -0,0 +1,125 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+			  SAR Flight Replays
+ */
+
+#ifndef SARREPLAY_H
+#define SARREPLAY_H
+
+#include <stdio.h>
+#include <sys/types.h>
+#include "gw.h"
+#include "gctl.h"
+
+
+/*
+ *	Replay modes:
+ */
+#define SAR_REPLAY_MODE_NONE		0	/* Replay finished */
+#define SAR_REPLAY_MODE_RECORD		1
+#define SAR_REPLAY_MODE_PLAY		2
+
+/*
+ *	Replay file record types:
+ */
+#define SAR_REPLAY_REC_BEGIN		1	/* Scene begin, random seed
+						 * and scene name
+						 */
+#define SAR_REPLAY_REC_END		2	/* Scene end */
+#define SAR_REPLAY_REC_TIME		3	/* Current time in ms */
+#define SAR_REPLAY_REC_LAPSE		4	/* Lapsed time in ms since
+						 * the last time record
+						 */
+#define SAR_REPLAY_REC_GCTL		5	/* GCtlUpdate() results */
+#define SAR_REPLAY_REC_GCTL_SAME	6	/* GCtlUpdate() results same
+						 * as the last ones
+						 */
+#define SAR_REPLAY_REC_KEY		7	/* Key event */
+
+/* Size of the packed GCtlUpdate() results in bytes */
+#define SAR_REPLAY_GCTL_SIZE		(12 * 4 + 2)
+
+
+/*
+ *	Replay:
+ *
+ *	Records the game controller positions, key events, frame
+ *	timings and the random seed of each scene to a file or plays
+ *	them back from one, so that a flight can be simulated again
+ *	exactly as it was flown.
+ */
+typedef struct {
+
+	int		mode;		/* One of SAR_REPLAY_MODE_* */
+	char		*filename;
+	FILE		*fp;
+
+	/* True between SARReplaySceneBegin() and SARReplaySceneEnd(),
+	 * nothing is recorded or played back while in the menus
+	 */
+	Boolean		active;
+
+	/* True while a key event is being played back */
+	Boolean		dispatching;
+
+	/* Last time record and the last packed GCtlUpdate() results */
+	time_t		last_time;
+	u_int8_t	last_gctl[SAR_REPLAY_GCTL_SIZE];
+
+	unsigned long	frames;
+
+	/* Key events are played back by passing them to key_cb with
+	 * display's alt, ctrl and shift key states set as they were
+	 * when recorded
+	 */
+	gw_display_struct	*display;
+	void		*key_data;
+	void		(*key_cb)(
+		void *,			/* Data */
+		int,			/* Key */
+		Boolean,		/* State */
+		unsigned long		/* Time stamp */
+	);
+
+} sar_replay_struct;
+#define SAR_REPLAY(p)	((sar_replay_struct *)(p))
+
+
+extern sar_replay_struct *SARReplayNew(
+	const char *filename, int mode,
+	gw_display_struct *display,
+	void (*key_cb)(void *, int, Boolean, unsigned long),
+	void *key_data
+);
+extern void SARReplayDelete(sar_replay_struct *replay);
+
+extern unsigned int SARReplaySceneBegin(
+	sar_replay_struct *replay,
+	const char *name, unsigned int seed
+);
+extern void SARReplaySceneEnd(sar_replay_struct *replay);
+
+extern time_t SARReplayTime(sar_replay_struct *replay, time_t t);
+extern void SARReplayGCtl(sar_replay_struct *replay, gctl_struct *gc);
+extern Boolean SARReplayKey(
+	sar_replay_struct *replay,
+	int c, Boolean state, unsigned long t
+);
+
+
+#endif	/* SARREPLAY_H */
@@ -34,6 +34,7 @@
 #include "mission.h"
 #include "sar.h"
 #include "sartime.h"
+#include "sarreplay.h"
 #include "sarmusic.h"
 #include "scenesound.h"
 #include "objio.h"
@@ -145,6 +146,13 @@ int SARSimBeginMission(
 
 	core_ptr->stop_count = 0;
 
+	/* Seed the random numbers for this scene, the seed is recorded
+	 * to or taken from the replay (if any)
+	 */
+	SARRandomSeed(SARReplaySceneBegin(
+	    core_ptr->replay, mission_file, (unsigned int)time(NULL)
+	));
+
 	/* Allocate scene structure as needed */
 	if(core_ptr->scene == NULL)
 	{
@@ -286,7 +294,9 @@ int SARSimBeginMission(
 	 * long amount of time and if the lapsed_millitime is too long
 	 * simulations and other timings can get out of sync
 	 */
-	SARResetTimmersCB(core_ptr, SARGetCurMilliTime());
+	SARResetTimmersCB(
+	    core_ptr, SARReplayTime(core_ptr->replay, SARGetCurMilliTime())
+	);
 
 	/* Reset option values before starting simulation */
 	SARSimBeginResetOptions(core_ptr);
@@ -375,6 +385,13 @@ int SARSimBeginFreeFlight(
 
 	core_ptr->stop_count = 0;
 
+	/* Seed the random numbers for this scene, the seed is recorded
+	 * to or taken from the replay (if any)
+	 */
+	SARRandomSeed(SARReplaySceneBegin(
+	    core_ptr->replay, scene_file, (unsigned int)time(NULL)
+	));
+
 	/* Allocate scene structure as needed. */
 	if(core_ptr->scene == NULL)
 	{
@@ -494,7 +511,9 @@ int SARSimBeginFreeFlight(
 	 * long amount of time and if the lapsed_millitime is too long
 	 * simulations and other timings can get out of sync
 	 */
-	SARResetTimmersCB(core_ptr, SARGetCurMilliTime());
+	SARResetTimmersCB(
+	    core_ptr, SARReplayTime(core_ptr->replay, SARGetCurMilliTime())
+	);
 
 	/* Reset option values before starting simulation */
 	SARSimBeginResetOptions(core_ptr);
@@ -36,6 +36,7 @@
 #include "sarmenuop.h"
 #include "sarmenucodes.h"
 #include "sarsimend.h"
+#include "sarreplay.h"
 #include "config.h"
 
 
@@ -65,13 +66,11 @@ static void SARSimEndMissionTabulate(
 	sar_player_stat_struct *pstat;
 	sar_menu_struct *m;
 	sar_scene_struct *scene = core_ptr->scene;
-	int player_obj_num;
 	sar_object_struct *player_obj_ptr;
 	if(scene == NULL)
 	    return;
 
 	/* Get player object */
-	player_obj_num = scene->player_obj_num;
 	player_obj_ptr = scene->player_obj_ptr;
 	pstat = SARPlayerStatCurrent(core_ptr, NULL);
 
@@ -199,6 +198,9 @@ void SARSimEnd(sar_core_struct *core_ptr)
 	if(opt->runtime_debug)
 	    printf("SARSimEnd(): Ending simulation...\n");
 
+	/* End recording or playing back the scene */
+	SARReplaySceneEnd(core_ptr->replay);
+
 	/* Check if a mission structure is defined which implies the
 	 * simulation involved a mission (and possibly a campaign)
 	 */
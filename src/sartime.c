@@ -32,6 +32,7 @@
 #include "sartime.h"
 
 time_t SARGetCurMilliTime(void);
+void SARRandomSeed(unsigned int seed);
 unsigned int SARRandom(unsigned int seed_offset);
 float SARRandomCoeff(unsigned int seed_offset);
 
@@ -83,47 +84,53 @@ time_t SARGetCurMilliTime(void)
 #endif
 }
 
+/*
+ *	Random number generator state, see SARRandomSeed().
+ */
+static u_int32_t sar_random_state = 1234145;
+
+
+/*
+ *	Seeds the random number generator used by SARRandom() and
+ *	SARRandomCoeff().
+ *
+ *	This is called at the start of each scene so that the sequence
+ *	of random numbers is the same each time the scene is simulated
+ *	with the same seed (see sarreplay.c).
+ */
+void SARRandomSeed(unsigned int seed)
+{
+	/* A xorshift state may not be 0 */
+	sar_random_state = (seed != 0) ? (u_int32_t)seed : 1234145;
+}
+
 /*
  *      Returns a random number in the range of 0 to 0xffffffff.
  *
- *      If you call this function more than once per cycle then you
- *      should pass seed_offset as a unique value each time to better
- *      obtain a more random number.
+ *	The seed_offset is no longer used, the numbers come from a
+ *	single xorshift stream that is seeded by SARRandomSeed() so
+ *	that they do not depend on the C library rand().
  */
 unsigned int SARRandom(unsigned int seed_offset)
 {
-#if defined(RAND_MAX)
-/*	srand((unsigned int)cur_millitime + seed_offset); */
-	return(rand());
-#else
-	static u_int32_t gSeed = 1234145;
-#ifdef __MSW__
-	long result = gSeed * (long)1103515245 + 12345;
-#else
-	int64_t result = gSeed * (int64_t)1103515245 + 12345;
-#endif
-	gSeed = (u_int32_t)result;
+	u_int32_t x = sar_random_state;
 
-	return((u_int32_t)(result >> 16));
-#endif
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	sar_random_state = x;
+
+	return((unsigned int)x);
 }
 
 /*
- *      Returns a random coefficient from 0.0 to 1.0, setting the seed
- *      as the current time in milliseconds plus the given seed_offset.
+ *      Returns a random coefficient from 0.0 to 1.0.
  *
- *      If you call this function more than once per cycle then you
- *      should pass seed_offset as a unique value each time to better
- *      obtain a more random number.
+ *	See SARRandom() for the seed_offset.
  */
 float SARRandomCoeff(unsigned int seed_offset)
 {
-#if defined(RAND_MAX)
-/*	srand((unsigned int)cur_millitime + seed_offset); */
-	return((float)rand() / (float)RAND_MAX);
-#else
-	return((float)SARRandom(seed_offset) / (float)0xffffffff);
-#endif
+	return((float)((double)SARRandom(seed_offset) / (double)0xffffffff));
 }
 
 
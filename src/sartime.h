@@ -21,6 +21,7 @@
 
 extern time_t SARGetCurMilliTime(void);
 
+extern void SARRandomSeed(unsigned int seed);
 extern unsigned int SARRandom(unsigned int seed_offset);
 extern float SARRandomCoeff(unsigned int seed_offset);
 
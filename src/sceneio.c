@@ -160,11 +160,8 @@ void SARSceneDestroy(
 
 	    /* Horizon */
 	    horizon_ptr = &scene->horizon;
-	    for(i = 0; i < horizon_ptr->total_textures; i++)
-		V3DTextureDestroy(horizon_ptr->texture[i]);
-	    free(horizon_ptr->texture);
+	    V3DTextureDestroy(horizon_ptr->texture);
 	    horizon_ptr->texture = NULL;
-	    horizon_ptr->total_textures = 0;
 
 
 	    /* Ground objects list, delete only the pointer array and
@@ -179,6 +176,31 @@ void SARSceneDestroy(
 	    scene->human_need_rescue_object = NULL;
 	    scene->total_human_need_rescue_objects = 0;
 
+	    /* Object grids */
+	    SARGridDelete(scene->crash_grid);
+	    scene->crash_grid = NULL;
+	    SARGridDelete(scene->support_grid);
+	    scene->support_grid = NULL;
+	    SARGridDelete(scene->rescue_grid);
+	    scene->rescue_grid = NULL;
+
+	    /* Object slots and the structures of deleted objects kept
+	     * for reuse
+	     */
+	    if(scene->object_slot_storage != NULL)
+	    {
+		for(i = 0; i < scene->total_object_slots; i++)
+		    free(scene->object_slot_storage[i]);
+		free(scene->object_slot_storage);
+		scene->object_slot_storage = NULL;
+	    }
+	    free(scene->object_slot_generation);
+	    scene->object_slot_generation = NULL;
+	    free(scene->free_object_slot);
+	    scene->free_object_slot = NULL;
+	    scene->total_free_object_slots = 0;
+	    scene->total_object_slots = 0;
+
 	    /* Visual models, all visual models should have been
 	     * unref'ed by now. So here we actually delete
 	     * and destroy the GL lists
@@ -378,7 +400,9 @@ int SARSceneAddPlayerObject(
 	 * so that SARObjLoadFromFile() can tell this is the player
 	 * object
 	 */
-	scene->player_obj_num = obj_num;
+	scene->player_obj_handle = SARObjGetHandle(
+	    scene, core_ptr->object, core_ptr->total_objects, obj_num
+	);
 	scene->player_obj_ptr = obj_ptr;
 
 	/* Load player object model file */
@@ -635,7 +659,7 @@ int SARSceneLoadFromFile(
 	scene->moon_visibility_hint = 0;
 	scene->rain_density_coeff = 0.0f;
 
-	scene->player_obj_num = -1;
+	scene->player_obj_handle = SAR_OBJ_HANDLE_NONE;
 	scene->player_obj_ptr = NULL;
 	scene->player_has_crashed = False;
 
@@ -1001,9 +1025,8 @@ int SARSceneLoadFromFile(
 
 	/* Create the Horizon */
 	horizon_ptr = &scene->horizon;
-	horizon_ptr->last_tod = -1;	/* Reset to -1 so horizon gets updated */
+	horizon_ptr->regenerate = True;	/* So horizon gets generated */
 	horizon_ptr->texture = NULL;
-	horizon_ptr->total_textures = 0;
 
 
 	/* Generate weather settings from the specified Weather Data
@@ -1214,6 +1237,7 @@ int SARSceneLoadFromFile(
 			    (*vmodel)->load_state = SAR_VISUAL_MODEL_LOADING;
 
 			    /* Begin recording new list */
+			    V3DTextureInvalidate();
 			    glNewList(list, GL_COMPILE);
 			    {
 				/* Select tiled ground texture if defined, if
@@ -1231,6 +1255,7 @@ int SARSceneLoadFromFile(
 				);
 			    }
 			    glEndList();
+			    V3DTextureInvalidate();
 
 			    /* Mark visual model as done loading */
 			    (*vmodel)->load_state = SAR_VISUAL_MODEL_LOADED;
@@ -1603,7 +1628,8 @@ int SARSceneLoadFromFile(
 		    if(!strcasecmp(ref_name, "player"))
 		    {
 			/* Set special intercept code to intercept the player */
-			obj_human_ptr->intercepting_object = -2;
+			obj_human_ptr->intercepting_object =
+			    SAR_HUMAN_INTERCEPT_PLAYER;
 		    }
 		    else
 		    {
@@ -1612,7 +1638,9 @@ int SARSceneLoadFromFile(
 			    scene, *ptr, *total,
 			    ref_name, &human_ref_obj_num
 			);
-			obj_human_ptr->intercepting_object = human_ref_obj_num;
+			obj_human_ptr->intercepting_object = SARObjGetHandle(
+			    scene, *ptr, *total, human_ref_obj_num
+			);
 		    }
 		}
 		break;
@@ -1630,6 +1658,11 @@ int SARSceneLoadFromFile(
 	/* Delete loaded parms */
 	SARParmDeleteAll(&parm, &total_parms);
 
+	/* Index all the loaded objects in the scene's crash grid and
+	 * support grid now that they have been positioned
+	 */
+	SARObjUpdateGridsAll(scene, *ptr, *total);
+
 #undef DO_RESET_SUBSTRUCTURE_PTRS
 
 	return(0);
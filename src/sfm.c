@@ -17,16 +17,64 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#ifndef __MSW__
+# include <unistd.h>
+# include <pthread.h>
+#endif
 
 #include "sfm.h"
 #include "sarreality.h"
 
+
+#ifndef __MSW__
+/*
+ *	FDM Integration Workers:
+ *
+ *	Threads that SFMUpdateRealm() integrates the FDMs on, the
+ *	calling thread integrates FDMs too.
+ */
+typedef struct {
+
+	SFMRealmStruct	*realm;
+
+	pthread_mutex_t	mutex;
+	pthread_cond_t	start_cv,	/* Signaled when generation changes */
+			done_cv;	/* Signaled when busy reaches 0 */
+
+	int		generation,	/* Incremented for each update */
+			next_model,	/* Next FDM to integrate */
+			total_models,
+			busy;		/* Threads still integrating */
+	SFMBoolean	stop;
+
+	pthread_t	*thread;
+	int		total_threads;
+
+} SFMWorkers;
+#define SFM_WORKERS(p)	((SFMWorkers *)(p))
+#endif
+
+
 SFMRealmStruct *SFMInit(int argc, char **argv);
 void SFMShutdown(SFMRealmStruct *realm);
 
 void SFMSetTiming(SFMRealmStruct *realm, SFMTime lapsed_ms);
 void SFMSetTimeCompression(SFMRealmStruct *realm, double compression);
+
+static void SFMIntegrateModel(SFMRealmStruct *realm, SFMModelStruct *model);
+#ifndef __MSW__
+static void SFMWorkersIntegrate(SFMWorkers *w);
+static void *SFMWorkersThread(void *arg);
+static SFMWorkers *SFMWorkersNew(SFMRealmStruct *realm, int total_threads);
+static void SFMWorkersDelete(SFMWorkers *w);
+#endif
 void SFMUpdateRealm(SFMRealmStruct *realm, SFMTime lapsed_ms);
+int SFMResolveModel(SFMRealmStruct *realm, SFMModelStruct *model);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)        (((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
 
 
 /*
@@ -62,6 +110,20 @@ SFMRealmStruct *SFMInit(int argc, char **argv)
 	realm->model = NULL;
 	realm->total_models = 0;
 
+	/* Integrate the FDMs on as many threads as there are
+	 * processors, the worker threads are created on the first
+	 * update that needs them
+	 */
+#if defined(__MSW__) || !defined(_SC_NPROCESSORS_ONLN)
+	realm->total_threads = 1;
+#else
+	realm->total_threads = CLIP(
+	    (int)sysconf(_SC_NPROCESSORS_ONLN), 1, SFMMaxThreads
+	);
+#endif
+	realm->workers = NULL;
+	realm->defer_cb = False;
+
 	return(realm);
 }
 
@@ -88,6 +150,12 @@ void SFMShutdown(SFMRealmStruct *realm)
 	    SFMModelDelete(realm, realm->model[0]);
 	}
 
+#ifndef __MSW__
+	/* Stop and delete the worker threads */
+	SFMWorkersDelete(SFM_WORKERS(realm->workers));
+	realm->workers = NULL;
+#endif
+
 	free(realm);
 }
 
@@ -127,7 +195,175 @@ void SFMSetTimeCompression(SFMRealmStruct *realm, double compression)
 }
 
 /*
- *	Updates the FDM Realm's FDMs and timing.
+ *	Integrates the FDM, calling SFMForceApplyArtificial(),
+ *	SFMForceApplyNatural(), SFMForceApplyControl() and
+ *	SFMSetAirspeed() the same way SARSimUpdateSceneObjects() did.
+ *
+ *	The FDM must not be used by any other thread and the realm's
+ *	callbacks must be deferred.
+ */
+static void SFMIntegrateModel(SFMRealmStruct *realm, SFMModelStruct *model)
+{
+	int status = 0;
+
+	model->pending_cb = SFMPendingIntegrated;
+
+	/* Natural forces are calculated after artificial forces, this
+	 * gives a more accurate center to ground height
+	 */
+	if(SFMForceApplyArtificial(realm, model))
+	    status = 1;
+	else if(SFMForceApplyNatural(realm, model))
+	    status = 1;
+	else if(SFMForceApplyControl(realm, model))
+	    status = 1;
+	else
+	    SFMSetAirspeed(realm, model);
+
+	model->pending_status = status;
+}
+
+#ifndef __MSW__
+/*
+ *	Integrates FDMs until there are none left in this update.
+ *
+ *	The workers' mutex must be locked, it is unlocked while each
+ *	FDM is integrated.
+ */
+static void SFMWorkersIntegrate(SFMWorkers *w)
+{
+	int i;
+	SFMModelStruct *model;
+
+	while(w->next_model < w->total_models)
+	{
+	    i = w->next_model;
+	    w->next_model++;
+
+	    pthread_mutex_unlock(&w->mutex);
+	    model = w->realm->model[i];
+	    if(model != NULL)
+		SFMIntegrateModel(w->realm, model);
+	    pthread_mutex_lock(&w->mutex);
+	}
+}
+
+/*
+ *	Worker thread, waits for each update and integrates FDMs.
+ */
+static void *SFMWorkersThread(void *arg)
+{
+	int generation = 0;	/* Workers are created before the first
+				 * update
+				 */
+	SFMWorkers *w = SFM_WORKERS(arg);
+
+	pthread_mutex_lock(&w->mutex);
+	while(True)
+	{
+	    while(!w->stop && (w->generation == generation))
+		pthread_cond_wait(&w->start_cv, &w->mutex);
+	    if(w->stop)
+		break;
+
+	    generation = w->generation;
+
+	    SFMWorkersIntegrate(w);
+
+	    w->busy--;
+	    if(w->busy <= 0)
+		pthread_cond_signal(&w->done_cv);
+	}
+	pthread_mutex_unlock(&w->mutex);
+
+	return(NULL);
+}
+
+/*
+ *	Creates the worker threads, total_threads includes the calling
+ *	thread.
+ *
+ *	Returns NULL if no worker thread could be created.
+ */
+static SFMWorkers *SFMWorkersNew(SFMRealmStruct *realm, int total_threads)
+{
+	int i;
+	SFMWorkers *w;
+
+	if(total_threads < 2)
+	    return(NULL);
+
+	w = SFM_WORKERS(calloc(1, sizeof(SFMWorkers)));
+	if(w == NULL)
+	    return(NULL);
+
+	w->thread = (pthread_t *)calloc(
+	    total_threads - 1, sizeof(pthread_t)
+	);
+	if(w->thread == NULL)
+	{
+	    free(w);
+	    return(NULL);
+	}
+
+	w->realm = realm;
+	pthread_mutex_init(&w->mutex, NULL);
+	pthread_cond_init(&w->start_cv, NULL);
+	pthread_cond_init(&w->done_cv, NULL);
+
+	for(i = 0; i < (total_threads - 1); i++)
+	{
+	    if(pthread_create(&w->thread[i], NULL, SFMWorkersThread, w))
+		break;
+	    w->total_threads++;
+	}
+	if(w->total_threads == 0)
+	{
+	    SFMWorkersDelete(w);
+	    return(NULL);
+	}
+
+	return(w);
+}
+
+/*
+ *	Stops the worker threads and deletes them.
+ */
+static void SFMWorkersDelete(SFMWorkers *w)
+{
+	int i;
+
+	if(w == NULL)
+	    return;
+
+	pthread_mutex_lock(&w->mutex);
+	w->stop = True;
+	pthread_cond_broadcast(&w->start_cv);
+	pthread_mutex_unlock(&w->mutex);
+
+	for(i = 0; i < w->total_threads; i++)
+	    pthread_join(w->thread[i], NULL);
+
+	pthread_cond_destroy(&w->done_cv);
+	pthread_cond_destroy(&w->start_cv);
+	pthread_mutex_destroy(&w->mutex);
+	free(w->thread);
+	free(w);
+}
+#endif	/* !__MSW__ */
+
+/*
+ *	Updates the FDM Realm's timing and integrates all of its FDMs.
+ *
+ *	Each FDM only depends on its own values and the realm's, so
+ *	when there are enough FDMs they are integrated in parallel on
+ *	the realm's worker threads. The airborne, touch down, parked
+ *	and overspeed callbacks are not called during the update,
+ *	they are queued on each FDM and SFMResolveModel() must be
+ *	called on each FDM afterwards (in a deterministic order, from
+ *	a single thread) to call them.
+ *
+ *	No FDM may be added or removed during the update.
  */
 void SFMUpdateRealm(SFMRealmStruct *realm, SFMTime lapsed_ms)
 {
@@ -139,14 +375,126 @@ void SFMUpdateRealm(SFMRealmStruct *realm, SFMTime lapsed_ms)
 
 	SFMSetTiming(realm, lapsed_ms);
 
-	/* Update each FDM */
+	realm->defer_cb = True;
+
+#ifndef __MSW__
+	/* Integrate in parallel? */
+	if((realm->total_threads > 1) &&
+	   (realm->total_models >= SFMParallelMinModels)
+	)
+	{
+	    SFMWorkers *w = SFM_WORKERS(realm->workers);
+	    if(w == NULL)
+		realm->workers = w = SFMWorkersNew(
+		    realm, realm->total_threads
+		);
+	    if(w != NULL)
+	    {
+		pthread_mutex_lock(&w->mutex);
+		w->next_model = 0;
+		w->total_models = realm->total_models;
+		w->busy = w->total_threads;
+		w->generation++;
+		pthread_cond_broadcast(&w->start_cv);
+
+		/* Integrate FDMs on this thread too and then wait
+		 * for the worker threads to finish theirs
+		 */
+		SFMWorkersIntegrate(w);
+		while(w->busy > 0)
+		    pthread_cond_wait(&w->done_cv, &w->mutex);
+		pthread_mutex_unlock(&w->mutex);
+
+		realm->defer_cb = False;
+		return;
+	    }
+	}
+#endif
+
+	/* Integrate each FDM on this thread */
 	for(m_num = 0; m_num < realm->total_models; m_num++)
 	{
 	    m = realm->model[m_num];
 	    if(m == NULL)
 		continue;
 
-/* TODO */
+	    SFMIntegrateModel(realm, m);
+	}
+
+	realm->defer_cb = False;
+}
+
+/*
+ *	Calls the callbacks queued on the FDM by SFMUpdateRealm(), in
+ *	the order that they would have been called in during the
+ *	integration.
+ *
+ *	Returns 0 if the FDM was integrated and is still valid, 1 if
+ *	the integration stopped or a callback deleted the FDM, or -1
+ *	if the FDM was not integrated by the last SFMUpdateRealm().
+ */
+int SFMResolveModel(SFMRealmStruct *realm, SFMModelStruct *model)
+{
+	unsigned int pending;
+
+	if((realm == NULL) || (model == NULL))
+	    return(-1);
+
+	pending = model->pending_cb;
+	model->pending_cb = 0;
+	if(!(pending & SFMPendingIntegrated))
+	    return(-1);
+
+	if((pending & SFMPendingOverspeed) &&
+	   (realm->overspeed_cb != NULL)
+	)
+	{
+	    realm->overspeed_cb(
+		realm,
+		model,
+		realm->overspeed_cb_client_data,
+		model->pending_overspeed_speed,
+		model->overspeed_expected,
+		model->overspeed
+	    );
+	    if(SFMModelInRealm(realm, model) < 0)
+		return(1);
+	}
+
+	if((pending & SFMPendingTouchDown) &&
+	   (realm->touch_down_cb != NULL)
+	)
+	{
+	    realm->touch_down_cb(
+		realm, model,
+		realm->touch_down_cb_client_data,
+		model->pending_touch_down_coeff
+	    );
+	    if(SFMModelInRealm(realm, model) < 0)
+		return(1);
+	}
 
+	if((pending & SFMPendingAirborne) &&
+	   (realm->airborne_cb != NULL)
+	)
+	{
+	    realm->airborne_cb(
+		realm,
+		model,
+		realm->airborne_cb_client_data
+	    );
+	    if(SFMModelInRealm(realm, model) < 0)
+		return(1);
 	}
+
+	if((pending & SFMPendingParked) &&
+	   (realm->parked_cb != NULL)
+	)
+	{
+	    realm->parked_cb(model, realm->parked_cb_client_data);
+	    if(SFMModelInRealm(realm, model) < 0)
+		return(1);
+	}
+
+	return(model->pending_status);
 }
@@ -54,6 +54,14 @@
 #define SFMTFStart 2.57 // 5 knots
 #define SFMTFEnd 12.86  // 25 knots
 
+/*
+ *	Maximum number of threads that SFMUpdateRealm() integrates
+ *	the FDMs on (including the calling thread) and the least
+ *	number of FDMs for which it is worth using more than one.
+ */
+#define SFMMaxThreads		8
+#define SFMParallelMinModels	4
+
 /*
  *	Core structure:
  */
@@ -130,6 +138,19 @@ typedef struct {
 	SFMModelStruct	**model;
 	int		total_models;
 
+	/* Number of threads that SFMUpdateRealm() integrates the FDMs
+	 * on, including the calling thread
+	 */
+	int		total_threads;
+	void		*workers;	/* Internal */
+
+	/* Internal, set while SFMUpdateRealm() integrates the FDMs,
+	 * the airborne, touch down, parked and overspeed callbacks
+	 * are queued on each FDM instead of being called and
+	 * SFMResolveModel() calls them
+	 */
+	SFMBoolean	defer_cb;
+
 } SFMRealmStruct;
 
 #define SFM_REALM(p)	((SFMRealmStruct *)(p))
@@ -142,6 +163,7 @@ extern void SFMShutdown(SFMRealmStruct *realm);
 extern void SFMSetTiming(SFMRealmStruct *realm, SFMTime lapsed_ms);
 extern void SFMSetTimeCompression(SFMRealmStruct *realm, double compression);
 extern void SFMUpdateRealm(SFMRealmStruct *realm, SFMTime lapsed_ms);
+extern int SFMResolveModel(SFMRealmStruct *realm, SFMModelStruct *model);
 
 
 /* In sfmmath.c */
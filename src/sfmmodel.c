@@ -78,6 +78,9 @@ SFMModelStruct *SFMModelAllocate(void)
 	if(m == NULL)
 	    return(NULL);
 
+	m->owner = NULL;
+	m->owner_index = -1;
+
 	return(m);
 }
 
@@ -151,6 +154,7 @@ int SFMModelAdd(SFMRealmStruct *realm, SFMModelStruct *model)
 void SFMModelDelete(SFMRealmStruct *realm, SFMModelStruct *model)
 {
 	int i, n;
+	SFMBoolean in_realm;
 
 	if((realm == NULL) || (model == NULL))
 	    return;
@@ -163,13 +167,9 @@ void SFMModelDelete(SFMRealmStruct *realm, SFMModelStruct *model)
 	}
 
 	/* Specified FDM exists? */
-	if(i < realm->total_models)
+	in_realm = (i < realm->total_models) ? True : False;
+	if(in_realm)
 	{
-	    /* Delete the FDM */
-
-	    free(model);
-
-
 	    /* Reallocate pointers */
 	    realm->total_models--;
 	    for(n = i; n < realm->total_models; n++)
@@ -182,10 +182,7 @@ void SFMModelDelete(SFMRealmStruct *realm, SFMModelStruct *model)
 		    realm->total_models * sizeof(SFMModelStruct *)
 		);
 		if(realm->model == NULL)
-		{
 		    realm->total_models = 0;
-		    return;
-		}
 	    }
 	    else
 	    {
@@ -196,13 +193,19 @@ void SFMModelDelete(SFMRealmStruct *realm, SFMModelStruct *model)
 	    }
 	}
 
-	/* Report the FDM being destroyed */
+	/* Report the FDM being destroyed, it is no longer in the realm
+	 * but it is still allocated so its owner can be looked up
+	 */
 	if(realm->destroy_model_cb != NULL)
 	    realm->destroy_model_cb(
 		realm, 
-		model,		/* model is invalid, use only as reference */
+		model,
 		realm->destroy_model_cb_client_data
 	    );
+
+	/* Delete the FDM */
+	if(in_realm)
+	    free(model);
 }
 
 
@@ -113,6 +113,19 @@
 
 
 
+/*
+ *	Queued callbacks, see SFMUpdateRealm():
+ */
+#define SFMPendingIntegrated		(1 << 0)	/* Not a callback, set
+							 * when the FDM was
+							 * integrated
+							 */
+#define SFMPendingOverspeed		(1 << 1)
+#define SFMPendingTouchDown		(1 << 2)
+#define SFMPendingAirborne		(1 << 3)
+#define SFMPendingParked		(1 << 4)
+
+
 /*
  *	Flight Dynamics Model structure:
  *
@@ -191,6 +204,21 @@ typedef struct {
 	double			touch_down_crash_resistance;	/* Meters/cycle. */
 	double			collision_crash_resistance;	/* Meters/cycle. */
 
+	/* Internal, callbacks queued by SFMUpdateRealm() and the
+	 * values to call them with
+	 */
+	unsigned int		pending_cb;	/* Any of SFMPending*. */
+	int			pending_status;	/* Integration status. */
+	double			pending_overspeed_speed;	/* Meters/cycle. */
+	double			pending_touch_down_coeff;
+
+	/* Reference to the object that owns this FDM and that
+	 * object's index, these are set by the owner and never used
+	 * by the SFM (owner_index is -1 if not set)
+	 */
+	void			*owner;
+	int			owner_index;
+
 } SFMModelStruct;
 
 
@@ -118,7 +118,12 @@ static SFMBoolean SFMForceTouchDownCheck(
 	}
 
 	/* Report FDM touch down */
-	if(realm->touch_down_cb != NULL)
+	if(realm->defer_cb)
+	{
+	    model->pending_cb |= SFMPendingTouchDown;
+	    model->pending_touch_down_coeff = impact_force_coeff;
+	}
+	else if(realm->touch_down_cb != NULL)
 	    realm->touch_down_cb(
 		realm, model,
 		realm->touch_down_cb_client_data,
@@ -1331,7 +1336,12 @@ int SFMForceApplyArtificial(
 	    /* Current speed greater than expected overspeed? */
 	    if(airspeed_3d > model->overspeed_expected)
 	    {
-		if(realm->overspeed_cb != NULL)
+		if(realm->defer_cb)
+		{
+		    model->pending_cb |= SFMPendingOverspeed;
+		    model->pending_overspeed_speed = airspeed_3d;
+		}
+		else if(realm->overspeed_cb != NULL)
 		    realm->overspeed_cb(
 			realm,
 			model,
@@ -1822,7 +1832,12 @@ int SFMForceApplyArtificial(
 			 * So just call touch down callback with a impact
 			 * force of 0.0.
 			 */
-			if(realm->touch_down_cb != NULL)
+			if(realm->defer_cb)
+			{
+			    model->pending_cb |= SFMPendingTouchDown;
+			    model->pending_touch_down_coeff = 0.0;
+			}
+			else if(realm->touch_down_cb != NULL)
 			    realm->touch_down_cb(
 				realm, model,
 				realm->touch_down_cb_client_data,
@@ -1851,7 +1866,9 @@ int SFMForceApplyArtificial(
 			model->landed_state = False;
 
 			/* Call airborne callback */
-			if(realm->airborne_cb != NULL)
+			if(realm->defer_cb)
+			    model->pending_cb |= SFMPendingAirborne;
+			else if(realm->airborne_cb != NULL)
 			    realm->airborne_cb(
 				realm,
 				model,
@@ -1917,7 +1934,9 @@ int SFMForceApplyArtificial(
 			   So we just do it when we stop.
 			*/
 
-			if(realm->parked_cb != NULL)
+			if(realm->defer_cb)
+			    model->pending_cb |= SFMPendingParked;
+			else if(realm->parked_cb != NULL)
 			    realm->parked_cb(model, realm->parked_cb_client_data);
 		    }
 		} else {
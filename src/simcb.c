@@ -142,7 +142,6 @@ void SARSimDestroyModelCB(
     void *client_data
     )
 {
-    int i;
     sar_object_struct *obj_ptr;
     sar_object_aircraft_struct *obj_aircraft_ptr;
     SFMRealmStruct *realm = SFM_REALM(realm_ptr);
@@ -150,44 +149,17 @@ void SARSimDestroyModelCB(
     if((realm == NULL) || (model == NULL) || (core_ptr == NULL))
         return;
 
-    /* Iterate through objects and unset FDM references to the
-     * specified FDM
-     */
-    for(i = 0; i < core_ptr->total_objects; i++)
-    {
-        obj_ptr = core_ptr->object[i];
-        if(obj_ptr == NULL)
-            continue;
-
-        switch(obj_ptr->type)
-        {
-            case SAR_OBJ_TYPE_GARBAGE:
-            case SAR_OBJ_TYPE_STATIC:
-            case SAR_OBJ_TYPE_AUTOMOBILE:
-            case SAR_OBJ_TYPE_WATERCRAFT:
-		break;
-
-            case SAR_OBJ_TYPE_AIRCRAFT:
-		obj_aircraft_ptr = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
-		if(obj_aircraft_ptr == NULL)
-		    break;
-		if(obj_aircraft_ptr->fdm == model)
-		    obj_aircraft_ptr->fdm = NULL;
-		break;
+    /* Match object from FDM and unset its reference to the FDM */
+    obj_ptr = SARSimMatchObjectFromFDM(
+        core_ptr->object, core_ptr->total_objects,
+        model, NULL
+	);
+    if(obj_ptr == NULL)
+        return;
 
-            case SAR_OBJ_TYPE_GROUND:
-            case SAR_OBJ_TYPE_RUNWAY:
-            case SAR_OBJ_TYPE_HELIPAD:
-            case SAR_OBJ_TYPE_HUMAN:
-            case SAR_OBJ_TYPE_SMOKE:
-            case SAR_OBJ_TYPE_FIRE:
-            case SAR_OBJ_TYPE_EXPLOSION:
-            case SAR_OBJ_TYPE_CHEMICAL_SPRAY:
-            case SAR_OBJ_TYPE_FUELTANK:
-            case SAR_OBJ_TYPE_PREMODELED:
-		break;
-        }
-    }
+    obj_aircraft_ptr = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
+    if(obj_aircraft_ptr != NULL)
+        obj_aircraft_ptr->fdm = NULL;
 }
 
 
@@ -806,7 +778,10 @@ void SARSimTouchDownCB(
             {
                 /* Set spot camera position */
                 scene->camera_ref = SAR_CAMERA_REF_SPOT;
-                scene->camera_target = scene->player_obj_num;
+                scene->camera_target = SARObjGetFromHandle(
+                    scene, core_ptr->object, core_ptr->total_objects,
+                    scene->player_obj_handle
+                );
             }
         }
         /* Was out of control? */
@@ -852,7 +827,10 @@ void SARSimTouchDownCB(
             {
                 /* Set spot camera position */
                 scene->camera_ref = SAR_CAMERA_REF_SPOT;
-                scene->camera_target = scene->player_obj_num;
+                scene->camera_target = SARObjGetFromHandle(
+                    scene, core_ptr->object, core_ptr->total_objects,
+                    scene->player_obj_handle
+                );
             }
         }
 
@@ -1005,7 +983,6 @@ void SARSimParkedCB(
         return;
 
     /* Get list of objects at this object's position */
-    /* EXPENSIVE */
     gcc_list = SARGetGCCHitList(
         core_ptr, scene,
         &core_ptr->object, &core_ptr->total_objects,
@@ -1145,7 +1122,10 @@ void SARSimOverspeedCB(
 #endif
                                 /* Set spot camera position */
                                 scene->camera_ref = SAR_CAMERA_REF_SPOT;
-                                scene->camera_target = scene->player_obj_num;
+                                scene->camera_target = SARObjGetFromHandle(
+                                    scene, core_ptr->object, core_ptr->total_objects,
+                                    scene->player_obj_handle
+                                );
 			}
 
 		    }
@@ -1474,6 +1454,10 @@ void SARSimObjectCollisionCB(
 	/* Is this the player object? */
 	if(scene->player_obj_ptr == obj_ptr)
 	{         
+	    const int player_obj_num = SARObjGetFromHandle(
+		scene, core_ptr->object, core_ptr->total_objects,
+		scene->player_obj_handle
+	    );
 	    char text[128];
 
 	    /* Mark player object as has crashed */
@@ -1483,10 +1467,10 @@ void SARSimObjectCollisionCB(
 	     * then set camera reference type to tower.
 	     */
 	    if(((scene->camera_ref == SAR_CAMERA_REF_TOWER) ?
-		(scene->camera_target != scene->player_obj_num) : 1
+		(scene->camera_target != player_obj_num) : 1
                    ) &&
 	       ((scene->camera_ref == SAR_CAMERA_REF_SPOT) ?
-		(scene->camera_target != scene->player_obj_num) : 1
+		(scene->camera_target != player_obj_num) : 1
                    )
                 )
 	    {
@@ -1496,7 +1480,7 @@ void SARSimObjectCollisionCB(
 		scene->camera_tower_pos.z = obj_ptr->pos.z + tower_offset_z;
 
 		scene->camera_ref = SAR_CAMERA_REF_TOWER;
-		scene->camera_target = scene->player_obj_num;
+		scene->camera_target = player_obj_num;
 	    }
 
 	    /* Set scene banner to indicate collision and type */
@@ -56,7 +56,7 @@ int SARSimCrashContactCheck(
 	sar_core_struct *core_ptr, sar_object_struct *obj_ptr
 )
 {
-	int i;
+	int i, k, total_candidates, *candidate;
 	float dr, z, d;
 	float z1_min, z1_max, z2_min, z2_max;
 	sar_object_struct *obj_ptr2;
@@ -71,14 +71,30 @@ int SARSimCrashContactCheck(
 	if(cb_src == NULL)
 	    return(-1);
 
+	/* Get the objects near the source object from the crash grid,
+	 * if there is no crash grid then all the objects need to be
+	 * checked
+	 */
+	total_candidates = SARGridQuery(
+	    (core_ptr->scene != NULL) ? core_ptr->scene->crash_grid : NULL,
+	    pos_src->x, pos_src->y,
+	    SARObjContactBoundsFlatRadius(cb_src),
+	    &candidate
+	);
+	if(candidate == NULL)
+	    total_candidates = core_ptr->total_objects;
+
 	/* Handle by source contact shape */
 	switch(cb_src->contact_shape)
 	{
 	  case SAR_CONTACT_SHAPE_SPHERICAL:
-	    /* Iterate through objects */
-	    for(i = 0; i < core_ptr->total_objects; i++)
+	    /* Iterate through candidate objects */
+	    for(k = 0; k < total_candidates; k++)
 	    {
-		obj_ptr2 = core_ptr->object[i];
+		i = (candidate != NULL) ? candidate[k] : k;
+		obj_ptr2 = SARObjGetPtr(
+		    core_ptr->object, core_ptr->total_objects, i
+		);
 		if(obj_ptr2 == NULL)
 		    continue;
 
@@ -208,10 +224,13 @@ int SARSimCrashContactCheck(
 	    break;
 
 	  case SAR_CONTACT_SHAPE_CYLENDRICAL:
-	    /* Iterate through objects */
-	    for(i = 0; i < core_ptr->total_objects; i++)
+	    /* Iterate through candidate objects */
+	    for(k = 0; k < total_candidates; k++)
 	    {
-		obj_ptr2 = core_ptr->object[i];
+		i = (candidate != NULL) ? candidate[k] : k;
+		obj_ptr2 = SARObjGetPtr(
+		    core_ptr->object, core_ptr->total_objects, i
+		);
 		if(obj_ptr2 == NULL)
 		    continue;
 
@@ -342,10 +361,13 @@ int SARSimCrashContactCheck(
 	    break;
 
 	  case SAR_CONTACT_SHAPE_RECTANGULAR:
-	    /* Iterate through objects */
-	    for(i = 0; i < core_ptr->total_objects; i++)
+	    /* Iterate through candidate objects */
+	    for(k = 0; k < total_candidates; k++)
 	    {
-		obj_ptr2 = core_ptr->object[i];
+		i = (candidate != NULL) ? candidate[k] : k;
+		obj_ptr2 = SARObjGetPtr(
+		    core_ptr->object, core_ptr->total_objects, i
+		);
 		if(obj_ptr2 == NULL)
 		    continue;
 
@@ -500,7 +522,8 @@ int SARSimHoistDeploymentContactCheck(
 )
 {
 	Boolean need_break;
-	int tar_obj_num, matched_obj_num = -1;
+	int k, tar_obj_num, matched_obj_num = -1;
+	int total_candidates, *candidate;
 	float d, contact_radius;
 	sar_object_struct *tar_obj_ptr;
 	sar_object_human_struct *human_ptr;
@@ -533,12 +556,34 @@ int SARSimHoistDeploymentContactCheck(
 	pos_src = &hoist->pos;	/* Hoist deployment's position */
 
 
-	/* Iterate through objects, looking for one that can be picked
-	 * up by the hoist's deployment
+	/* Put objects that were created since the rescue grid was
+	 * last synchronized into it
+	 */
+	if((scene->rescue_grid != NULL) && scene->rescue_grid->need_sync)
+	    SARObjUpdateGridsAll(
+		scene, core_ptr->object, core_ptr->total_objects
+	    );
+
+	/* Get the objects that can be picked up near the hoist's
+	 * deployment from the rescue grid, if there is no rescue grid
+	 * then all the objects need to be checked
+	 */
+	total_candidates = SARGridQuery(
+	    scene->rescue_grid, pos_src->x, pos_src->y, contact_radius,
+	    &candidate
+	);
+	if(candidate == NULL)
+	    total_candidates = core_ptr->total_objects;
+
+	/* Iterate through candidate objects, looking for one that can
+	 * be picked up by the hoist's deployment
 	 */
-	for(tar_obj_num = 0; tar_obj_num < core_ptr->total_objects; tar_obj_num++)
+	for(k = 0; k < total_candidates; k++)
 	{
-	    tar_obj_ptr = core_ptr->object[tar_obj_num];
+	    tar_obj_num = (candidate != NULL) ? candidate[k] : k;
+	    tar_obj_ptr = SARObjGetPtr(
+		core_ptr->object, core_ptr->total_objects, tar_obj_num
+	    );
 	    if(tar_obj_ptr == NULL)
 		continue;
 
@@ -672,7 +717,11 @@ int SARSimHoistDeploymentContactCheck(
 		 * possible) and update the human object to mark it
 		 * as no longer needing rescue
 		 */
-		if(SARSimDoPickUpHuman(scene, obj_ptr, human_ptr, tar_obj_num) > 0)
+		if(SARSimDoPickUpHuman(
+		    scene,
+		    core_ptr->object, core_ptr->total_objects,
+		    obj_ptr, human_ptr, tar_obj_num
+		) > 0)
 		{
 		    matched_obj_num = tar_obj_num;
 		    return(matched_obj_num);
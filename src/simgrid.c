@@ -0,0 +1,585 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "simgrid.h"
+
+
+static unsigned int SARGridHash(
+	const sar_grid_struct *grid, int cx, int cy
+);
+static int SARGridBucketAppend(sar_grid_bucket_struct *b, int obj_num);
+static void SARGridBucketRemove(sar_grid_bucket_struct *b, int obj_num);
+static void SARGridUnlink(sar_grid_struct *grid, int obj_num);
+static int SARGridResultAppend(sar_grid_struct *grid, int obj_num);
+static int SARGridCompareObjNum(const void *a, const void *b);
+
+sar_grid_struct *SARGridNew(float cell_size, int total_buckets);
+void SARGridDelete(sar_grid_struct *grid);
+int SARGridSet(
+	sar_grid_struct *grid, int obj_num,
+	float x, float y, float radius
+);
+void SARGridRemove(sar_grid_struct *grid, int obj_num);
+void SARGridClear(sar_grid_struct *grid);
+int SARGridQuery(
+	sar_grid_struct *grid,
+	float x, float y, float radius,
+	int **list
+);
+int SARGridQueryCached(
+	sar_grid_struct *grid,
+	float x, float y,
+	sar_grid_cache_struct *cache,
+	int **list
+);
+void SARGridCacheReset(sar_grid_cache_struct *cache);
+
+
+#define MAX(a,b)        (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)        (((a) < (b)) ? (a) : (b))
+#define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
+
+
+/*
+ *	Maximum number of cells an object may cover before it is put
+ *	into the oversize bucket instead.
+ */
+#define SAR_GRID_MAX_CELLS_PER_OBJECT	64
+
+/*
+ *	Converts a coordinate in meters to a cell index.
+ */
+#define SAR_GRID_CELL(g,v)	((int)floor((v) / (g)->cell_size))
+
+/*
+ *	Increments the grid's generation, skipping 0 since that marks
+ *	a query cache that was never made.
+ */
+#define SAR_GRID_CHANGED(g)	{			\
+ (g)->generation++;					\
+ if((g)->generation == 0)				\
+  (g)->generation = 1;					\
+}
+
+
+/*
+ *	Returns the bucket index for the cell at cx, cy.
+ */
+static unsigned int SARGridHash(
+	const sar_grid_struct *grid, int cx, int cy
+)
+{
+	return((((unsigned int)cx * 73856093u) ^
+	    ((unsigned int)cy * 19349663u)) &
+	    (unsigned int)(grid->total_buckets - 1)
+	);
+}
+
+/*
+ *	Appends the object number to the bucket.
+ *
+ *	Returns non-zero on error.
+ */
+static int SARGridBucketAppend(sar_grid_bucket_struct *b, int obj_num)
+{
+	if(b->total >= b->max)
+	{
+	    int max = MAX(b->max * 2, 4);
+	    int *list = (int *)realloc(
+		b->obj_num, max * sizeof(int)
+	    );
+	    if(list == NULL)
+		return(-1);
+
+	    b->obj_num = list;
+	    b->max = max;
+	}
+
+	b->obj_num[b->total] = obj_num;
+	b->total++;
+
+	return(0);
+}
+
+/*
+ *	Removes the object number from the bucket (if it is in there).
+ *
+ *	The order of the bucket is not kept, queries sort their
+ *	results.
+ */
+static void SARGridBucketRemove(sar_grid_bucket_struct *b, int obj_num)
+{
+	int i;
+
+	for(i = 0; i < b->total; i++)
+	{
+	    if(b->obj_num[i] == obj_num)
+	    {
+		b->total--;
+		b->obj_num[i] = b->obj_num[b->total];
+		return;
+	    }
+	}
+}
+
+/*
+ *	Removes the object from all the buckets that it is in, the
+ *	object's entry is marked as no longer in the grid.
+ */
+static void SARGridUnlink(sar_grid_struct *grid, int obj_num)
+{
+	int cx, cy;
+	unsigned int h, last_h = (unsigned int)-1;
+	sar_grid_entry_struct *e;
+
+	if((obj_num < 0) || (obj_num >= grid->total_entries))
+	    return;
+
+	e = &grid->entry[obj_num];
+	if(!e->in_grid)
+	    return;
+
+	if(e->oversize)
+	{
+	    SARGridBucketRemove(&grid->oversize, obj_num);
+	}
+	else
+	{
+	    for(cy = e->cy_min; cy <= e->cy_max; cy++)
+	    {
+		for(cx = e->cx_min; cx <= e->cx_max; cx++)
+		{
+		    /* Neighbouring cells may hash to the same bucket,
+		     * the object was only added once to it
+		     */
+		    h = SARGridHash(grid, cx, cy);
+		    if(h == last_h)
+			continue;
+		    SARGridBucketRemove(&grid->bucket[h], obj_num);
+		    last_h = h;
+		}
+	    }
+	}
+
+	e->in_grid = 0;
+	e->oversize = 0;
+	SAR_GRID_CHANGED(grid);
+}
+
+/*
+ *	Appends the object number to the grid's query results.
+ */
+static int SARGridResultAppend(sar_grid_struct *grid, int obj_num)
+{
+	if(grid->total_results >= grid->max_results)
+	{
+	    int max = MAX(grid->max_results * 2, 16);
+	    int *list = (int *)realloc(
+		grid->result, max * sizeof(int)
+	    );
+	    if(list == NULL)
+		return(-1);
+
+	    grid->result = list;
+	    grid->max_results = max;
+	}
+
+	grid->result[grid->total_results] = obj_num;
+	grid->total_results++;
+
+	return(0);
+}
+
+/*
+ *	Object number sort callback.
+ */
+static int SARGridCompareObjNum(const void *a, const void *b)
+{
+	const int	n1 = *(const int *)a,
+			n2 = *(const int *)b;
+
+	return((n1 > n2) - (n1 < n2));
+}
+
+
+/*
+ *	Creates a new grid.
+ *
+ *	The cell_size is in meters and total_buckets will be rounded
+ *	up to the next power of 2.
+ */
+sar_grid_struct *SARGridNew(float cell_size, int total_buckets)
+{
+	int n;
+	sar_grid_struct *grid = SAR_GRID(calloc(
+	    1, sizeof(sar_grid_struct)
+	));
+	if(grid == NULL)
+	    return(NULL);
+
+	for(n = 1; n < total_buckets; n <<= 1);
+
+	grid->cell_size = (cell_size > 0.0f) ? cell_size : 1.0f;
+	grid->generation = 1;
+	grid->total_buckets = n;
+	grid->bucket = SAR_GRID_BUCKET(calloc(
+	    grid->total_buckets, sizeof(sar_grid_bucket_struct)
+	));
+	/* Always keep the results list allocated so that queries
+	 * never return a NULL list for a valid grid
+	 */
+	grid->max_results = 16;
+	grid->result = (int *)malloc(grid->max_results * sizeof(int));
+	if((grid->bucket == NULL) || (grid->result == NULL))
+	{
+	    free(grid->bucket);
+	    free(grid->result);
+	    free(grid);
+	    return(NULL);
+	}
+
+	return(grid);
+}
+
+/*
+ *	Deletes the grid and all its resources.
+ */
+void SARGridDelete(sar_grid_struct *grid)
+{
+	int i;
+
+	if(grid == NULL)
+	    return;
+
+	for(i = 0; i < grid->total_buckets; i++)
+	    free(grid->bucket[i].obj_num);
+	free(grid->bucket);
+	free(grid->oversize.obj_num);
+	free(grid->entry);
+	free(grid->result);
+	free(grid);
+}
+
+/*
+ *	Puts the object into the grid or moves it to the cells
+ *	covered by the given position and flat radius (in meters).
+ *
+ *	If the object already covers the same cells then nothing is
+ *	done, so it is cheap to call this for objects that have not
+ *	moved.
+ *
+ *	Returns non-zero on error.
+ */
+int SARGridSet(
+	sar_grid_struct *grid, int obj_num,
+	float x, float y, float radius
+)
+{
+	int cx, cy, cx_min, cx_max, cy_min, cy_max;
+	unsigned int h, last_h;
+	sar_grid_entry_struct *e;
+
+	if((grid == NULL) || (obj_num < 0))
+	    return(-1);
+
+	/* Allocate more entries as needed */
+	if(obj_num >= grid->total_entries)
+	{
+	    int total = MAX(obj_num + 1, grid->total_entries * 2);
+	    e = SAR_GRID_ENTRY(realloc(
+		grid->entry, total * sizeof(sar_grid_entry_struct)
+	    ));
+	    if(e == NULL)
+		return(-1);
+
+	    memset(
+		&e[grid->total_entries], 0x00,
+		(total - grid->total_entries) *
+		    sizeof(sar_grid_entry_struct)
+	    );
+	    grid->entry = e;
+	    grid->total_entries = total;
+	}
+
+	if(radius < 0.0f)
+	    radius = 0.0f;
+
+	cx_min = SAR_GRID_CELL(grid, x - radius);
+	cx_max = SAR_GRID_CELL(grid, x + radius);
+	cy_min = SAR_GRID_CELL(grid, y - radius);
+	cy_max = SAR_GRID_CELL(grid, y + radius);
+
+	/* Same cells as before? */
+	e = &grid->entry[obj_num];
+	if(e->in_grid &&
+	   (e->cx_min == cx_min) && (e->cx_max == cx_max) &&
+	   (e->cy_min == cy_min) && (e->cy_max == cy_max)
+	)
+	    return(0);
+
+	SARGridUnlink(grid, obj_num);
+
+	e->cx_min = cx_min;
+	e->cx_max = cx_max;
+	e->cy_min = cy_min;
+	e->cy_max = cy_max;
+	e->in_grid = 1;
+	SAR_GRID_CHANGED(grid);
+
+	/* Covers too many cells? */
+	if(((double)(cx_max - cx_min + 1) * (double)(cy_max - cy_min + 1)) >
+	    SAR_GRID_MAX_CELLS_PER_OBJECT
+	)
+	{
+	    e->oversize = 1;
+	    return(SARGridBucketAppend(&grid->oversize, obj_num));
+	}
+
+	e->oversize = 0;
+	last_h = (unsigned int)-1;
+	for(cy = cy_min; cy <= cy_max; cy++)
+	{
+	    for(cx = cx_min; cx <= cx_max; cx++)
+	    {
+		h = SARGridHash(grid, cx, cy);
+		if(h == last_h)
+		    continue;
+
+		if(SARGridBucketAppend(&grid->bucket[h], obj_num))
+		    return(-1);
+		last_h = h;
+	    }
+	}
+
+	return(0);
+}
+
+/*
+ *	Removes the object from the grid.
+ */
+void SARGridRemove(sar_grid_struct *grid, int obj_num)
+{
+	if(grid == NULL)
+	    return;
+
+	SARGridUnlink(grid, obj_num);
+}
+
+/*
+ *	Removes all the objects from the grid.
+ */
+void SARGridClear(sar_grid_struct *grid)
+{
+	int i;
+
+	if(grid == NULL)
+	    return;
+
+	for(i = 0; i < grid->total_buckets; i++)
+	    grid->bucket[i].total = 0;
+	grid->oversize.total = 0;
+
+	for(i = 0; i < grid->total_entries; i++)
+	{
+	    grid->entry[i].in_grid = 0;
+	    grid->entry[i].oversize = 0;
+	}
+
+	SAR_GRID_CHANGED(grid);
+}
+
+/*
+ *	Gets the list of objects whose cells overlap the given
+ *	position and flat radius (in meters).
+ *
+ *	The list is sorted by object number and each object appears
+ *	only once. The list belongs to the grid and is only valid
+ *	until the next query.
+ *
+ *	Returns the number of objects in the list. If the grid is
+ *	NULL then *list is set to NULL and 0 is returned, the calling
+ *	function should then check all objects.
+ */
+int SARGridQuery(
+	sar_grid_struct *grid,
+	float x, float y, float radius,
+	int **list
+)
+{
+	int i, cx, cy, cx_min, cx_max, cy_min, cy_max;
+	unsigned int stamp;
+	sar_grid_bucket_struct *b;
+
+	if(list != NULL)
+	    *list = NULL;
+	if(grid == NULL)
+	    return(0);
+
+	/* Update stamp, clearing all entry stamps when it wraps
+	 * around
+	 */
+	grid->stamp++;
+	if(grid->stamp == 0)
+	{
+	    for(i = 0; i < grid->total_entries; i++)
+		grid->entry[i].stamp = 0;
+	    grid->stamp = 1;
+	}
+	stamp = grid->stamp;
+	grid->total_results = 0;
+
+/* Adds the bucket's objects that have not been added yet */
+#define ADD_BUCKET(_b_)	{				\
+ int _k_, _n_;						\
+ for(_k_ = 0; _k_ < (_b_)->total; _k_++) {		\
+  _n_ = (_b_)->obj_num[_k_];				\
+  if(grid->entry[_n_].stamp == stamp)			\
+   continue;						\
+  grid->entry[_n_].stamp = stamp;			\
+  SARGridResultAppend(grid, _n_);			\
+ }							\
+}
+
+	ADD_BUCKET(&grid->oversize);
+
+	if(radius < 0.0f)
+	    radius = 0.0f;
+
+	cx_min = SAR_GRID_CELL(grid, x - radius);
+	cx_max = SAR_GRID_CELL(grid, x + radius);
+	cy_min = SAR_GRID_CELL(grid, y - radius);
+	cy_max = SAR_GRID_CELL(grid, y + radius);
+
+	/* If the query covers more cells than there are buckets then
+	 * just go through each bucket once
+	 */
+	if(((double)(cx_max - cx_min + 1) * (double)(cy_max - cy_min + 1)) >
+	    grid->total_buckets
+	)
+	{
+	    for(i = 0; i < grid->total_buckets; i++)
+	    {
+		b = &grid->bucket[i];
+		ADD_BUCKET(b);
+	    }
+	}
+	else
+	{
+	    for(cy = cy_min; cy <= cy_max; cy++)
+	    {
+		for(cx = cx_min; cx <= cx_max; cx++)
+		{
+		    b = &grid->bucket[SARGridHash(grid, cx, cy)];
+		    ADD_BUCKET(b);
+		}
+	    }
+	}
+#undef ADD_BUCKET
+
+	/* Sort by object number so that callers check objects in
+	 * the same order as they appear in the scene
+	 */
+	if(grid->total_results > 1)
+	    qsort(
+		grid->result, grid->total_results, sizeof(int),
+		SARGridCompareObjNum
+	    );
+
+	if(list != NULL)
+	    *list = grid->result;
+
+	return(grid->total_results);
+}
+
+/*
+ *	Same as SARGridQuery() with a radius of 0 except that the
+ *	results are kept in the given cache, as long as the position
+ *	stays in the same cell and the grid has not changed the cached
+ *	list is returned without going through the grid.
+ *
+ *	The list belongs to the cache.
+ */
+int SARGridQueryCached(
+	sar_grid_struct *grid,
+	float x, float y,
+	sar_grid_cache_struct *cache,
+	int **list
+)
+{
+	int n, cx, cy, *result;
+
+	if(cache == NULL)
+	    return(SARGridQuery(grid, x, y, 0.0f, list));
+
+	if(list != NULL)
+	    *list = NULL;
+	if(grid == NULL)
+	    return(0);
+
+	cx = SAR_GRID_CELL(grid, x);
+	cy = SAR_GRID_CELL(grid, y);
+	if((cache->generation != grid->generation) ||
+	   (cache->cx != cx) || (cache->cy != cy)
+	)
+	{
+	    cache->generation = 0;
+
+	    n = SARGridQuery(grid, x, y, 0.0f, &result);
+	    if(n > cache->max)
+	    {
+		int *list2 = (int *)realloc(
+		    cache->obj_num, n * sizeof(int)
+		);
+		if(list2 == NULL)
+		{
+		    /* Return the uncached results */
+		    if(list != NULL)
+			*list = result;
+		    return(n);
+		}
+		cache->obj_num = list2;
+		cache->max = n;
+	    }
+	    if(n > 0)
+		memcpy(cache->obj_num, result, n * sizeof(int));
+	    cache->total = n;
+	    cache->cx = cx;
+	    cache->cy = cy;
+	    cache->generation = grid->generation;
+	}
+
+	if(list != NULL)
+	    *list = (cache->obj_num != NULL) ? cache->obj_num : grid->result;
+
+	return(cache->total);
+}
+
+/*
+ *	Deletes the cache's list and marks it as not made.
+ */
+void SARGridCacheReset(sar_grid_cache_struct *cache)
+{
+	if(cache == NULL)
+	    return;
+
+	free(cache->obj_num);
+	memset(cache, 0x00, sizeof(sar_grid_cache_struct));
+}
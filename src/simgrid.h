@@ -0,0 +1,167 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+		SAR Simulation Spatial Grid
+
+	Uniform 2D grid on the XY plane that indexes object numbers
+	by the cells that their flat bounding radius overlaps, used as
+	a broadphase so that contact checks only need to look at
+	objects near the source position instead of every object in
+	the scene.
+
+	The grid only knows about object numbers, the calling
+	function decides which objects go into it and with what
+	radius.
+ */
+
+#ifndef SIMGRID_H
+#define SIMGRID_H
+
+
+/*
+ *	Grid Bucket:
+ *
+ *	Object numbers whose cell range hashes to this bucket.
+ */
+typedef struct {
+
+	int		*obj_num;
+	int		total,
+			max;
+
+} sar_grid_bucket_struct;
+#define SAR_GRID_BUCKET(p)	((sar_grid_bucket_struct *)(p))
+
+/*
+ *	Grid Entry:
+ *
+ *	Per object record, indexed by object number.
+ */
+typedef struct {
+
+	/* 1 if this object is currently in the grid */
+	char		in_grid;
+
+	/* 1 if this object is in the oversize bucket instead of
+	 * the cell buckets
+	 */
+	char		oversize;
+
+	/* Cell range covered by this object */
+	int		cx_min, cx_max,
+			cy_min, cy_max;
+
+	/* Query stamp, used to return each object only once per
+	 * query when it covers more than one cell
+	 */
+	unsigned int	stamp;
+
+} sar_grid_entry_struct;
+#define SAR_GRID_ENTRY(p)	((sar_grid_entry_struct *)(p))
+
+/*
+ *	Grid Query Cache:
+ *
+ *	Records the objects found in one cell so that repeated point
+ *	queries from the same cell do not need to go through the
+ *	grid again, see SARGridQueryCached().
+ */
+typedef struct {
+
+	/* Cell that the list was made for */
+	int		cx, cy;
+
+	/* Grid generation that the list was made for, 0 if the list
+	 * was never made
+	 */
+	unsigned int	generation;
+
+	int		*obj_num;
+	int		total,
+			max;
+
+} sar_grid_cache_struct;
+#define SAR_GRID_CACHE(p)	((sar_grid_cache_struct *)(p))
+
+/*
+ *	Grid:
+ */
+typedef struct {
+
+	/* Size of each cell, in meters */
+	float		cell_size;
+
+	/* Cell buckets, total_buckets is always a power of 2 */
+	sar_grid_bucket_struct	*bucket;
+	int		total_buckets;
+
+	/* Objects that cover too many cells to be put into the cell
+	 * buckets, these are returned by every query
+	 */
+	sar_grid_bucket_struct	oversize;
+
+	/* Per object entries, indexed by object number */
+	sar_grid_entry_struct	*entry;
+	int		total_entries;
+
+	/* Current query stamp */
+	unsigned int	stamp;
+
+	/* Incremented each time an object is put into, moved to
+	 * other cells in, or removed from the grid
+	 */
+	unsigned int	generation;
+
+	/* Results of the last query, sorted by object number */
+	int		*result;
+	int		total_results,
+			max_results;
+
+	/* Set when objects have been created that have not been
+	 * positioned in the grid yet, the owner of the grid should
+	 * update all its objects and then clear this
+	 */
+	char		need_sync;
+
+} sar_grid_struct;
+#define SAR_GRID(p)	((sar_grid_struct *)(p))
+
+
+extern sar_grid_struct *SARGridNew(float cell_size, int total_buckets);
+extern void SARGridDelete(sar_grid_struct *grid);
+
+extern int SARGridSet(
+	sar_grid_struct *grid, int obj_num,
+	float x, float y, float radius
+);
+extern void SARGridRemove(sar_grid_struct *grid, int obj_num);
+extern void SARGridClear(sar_grid_struct *grid);
+
+extern int SARGridQuery(
+	sar_grid_struct *grid,
+	float x, float y, float radius,
+	int **list
+);
+extern int SARGridQueryCached(
+	sar_grid_struct *grid,
+	float x, float y,
+	sar_grid_cache_struct *cache,
+	int **list
+);
+extern void SARGridCacheReset(sar_grid_cache_struct *cache);
+
+#endif	/* SIMGRID_H */
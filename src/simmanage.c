@@ -51,6 +51,11 @@ int SARSimUpdateSceneObjects(
 	sar_core_struct *core_ptr, sar_scene_struct *scene
 );
 
+void SARSimUpdatePrevious(sar_core_struct *core_ptr);
+static float SARSimInterpolateRadians(float a, float b, float coeff);
+void SARSimInterpolateBegin(sar_core_struct *core_ptr, float coeff);
+void SARSimInterpolateEnd(sar_core_struct *core_ptr);
+
 
 #define POW(x,y)        (((x) > 0.0f) ? pow(x,y) : 0.0f)
 
@@ -146,15 +151,15 @@ static void SARSimGenerateLighteningPoints(
  *	Time of day will be updated on the scene, then along with the
  *	primary light position light_pos and color light_color.
  *
- *	Horizon texture will be (re)generated as need per a given interval
- *	(every 5 minutes).
+ *	Horizon texture will be (re)generated when the scene's sky colors
+ *	change.
  *
  *	Returns 0 on success and non-zero on error or memory pointer
  *	change.
  */
 int SARSimUpdateScene(sar_core_struct *core_ptr, sar_scene_struct *scene)
 {
-	float scene_lumination_coeff, horizon_sat_max_coeff;
+	float scene_lumination_coeff;
 	int prev_tod_code, new_tod_code;
 	sar_position_struct *pos;
 	sar_color_struct *c;
@@ -204,10 +209,6 @@ int SARSimUpdateScene(sar_core_struct *core_ptr, sar_scene_struct *scene)
 	/* Calculate global scene lumination coeff for time 4:00 to
 	 * 20:00, where 0.0 is darkest and 1.0 is brightest. Darkest
 	 * occures at 4:00 and 20:00, brightest is at 12:00
-	 *
-	 * Also calculate horizon saturation extreme coefficient, the
-	 * coefficient to determine the amount of dawn/dusk saturation
-	 * on the horizon
 	 */
 
 	/* First calculate from -1.0 to 1.0 linearly where -1.0 is
@@ -216,21 +217,10 @@ int SARSimUpdateScene(sar_core_struct *core_ptr, sar_scene_struct *scene)
 	scene_lumination_coeff = (float)((scene->tod - HTOS(12.0)) / HTOS(8.0));
 	if(scene_lumination_coeff < 0.0f)
 	{
-	    /* Before 12:00 */
-	    float pow_coeff = (float)POW(-scene_lumination_coeff, 2);
-
-	    /* Horizon saturation coefficient, calculate from
-	     * scene lumination so far (with power of 2)
-	     */
-	    horizon_sat_max_coeff = (float)CLIP(
-		1.0 - pow_coeff,
-		0.0, 1.0
-	    );
-
-	    /* Scene lumination; flip, change sign, and apply non-linear
-	     * curvature (power of 5)
+	    /* Before 12:00, scene lumination; flip, change sign,
+	     * and apply non-linear curvature (power of 5)
 	     */
-	    pow_coeff = (float)POW(-scene_lumination_coeff, 5);
+	    float pow_coeff = (float)POW(-scene_lumination_coeff, 5);
 	    scene_lumination_coeff = (float)CLIP(
 		1.0 - pow_coeff,
 		0.0, 1.0
@@ -238,20 +228,10 @@ int SARSimUpdateScene(sar_core_struct *core_ptr, sar_scene_struct *scene)
 	}
 	else
 	{
-	    /* 12:00 or later */
-	    float pow_coeff = (float)POW(scene_lumination_coeff, 2);
-
-	    /* Horizon saturation coefficient, calculate from
-	     * scene lumination so far (with power of 2)
-	     */
-	    horizon_sat_max_coeff = (float)CLIP(
-		1.0 - pow_coeff, 0.0, 1.0
-	    );
-
-	    /* Scene lumination; flip and apply non-linear
-	     * curvature (power of 5)
+	    /* 12:00 or later, scene lumination; flip and apply
+	     * non-linear curvature (power of 5)
 	     */
-	    pow_coeff = (float)POW(scene_lumination_coeff, 5);
+	    float pow_coeff = (float)POW(scene_lumination_coeff, 5);
 	    scene_lumination_coeff = (float)CLIP(
 		1.0 - pow_coeff, 0.0, 1.0
 	    );
@@ -416,116 +396,24 @@ int SARSimUpdateScene(sar_core_struct *core_ptr, sar_scene_struct *scene)
 
 	/* Horizon */
 
-	/* Regenerate the Horizon every 5 minutes */
+	/* Regenerate the Horizon's texture when the scene's sky colors
+	 * change, the texture has the gradients for every time of day
+	 * so it is not changed as the time of day passes
+	 */
 	horizon = &scene->horizon;
-	if(horizon->last_tod != (int)(scene->tod / (5 * 60)))
+	if(horizon->regenerate)
 	{
-	    int i, total, tex_num;
-	    float rc, gc, bc;		/* Coefficient color change */
-	    float darken_coeff, midpoint = 0.88f;
-	    sar_color_struct start_color, end_color;
-
-
 	    if(opt->runtime_debug)
 		printf(
- "SARSimUpdateScene(): Updating horizon textures.\n"
+ "SARSimUpdateScene(): Updating horizon texture.\n"
 		);
 
-	    /* Update last tod on the Horizon to the current time in
-	     * 5 minute units so we know when to update the Horizon
-	     * again
-	     */
-	    horizon->last_tod = (int)(scene->tod / (5 * 60));
-
-/* Creates a new horizon texture on the horizon */
-#define DO_CREATE_TEXTURE	{			\
- tex_num = MAX(horizon->total_textures, 0);		\
- horizon->total_textures = tex_num + 1;			\
- horizon->texture = (v3d_texture_ref_struct **)realloc(	\
-  horizon->texture,					\
-  horizon->total_textures * sizeof(v3d_texture_ref_struct *) \
- );							\
- if(horizon->texture == NULL)				\
- {							\
-  horizon->total_textures = 0;				\
- }							\
- else							\
- {							\
-  horizon->texture[tex_num] = SARCreateHorizonTexture(	\
-   NULL,	/* No name */				\
-   &start_color, &end_color,				\
-   32, midpoint						\
-  );							\
- }							\
-}
-
-	    /* Adjust gradient horizon textures by recreating them.
-	     * Do not add lumination/gamma to them, the light color
-	     * will be multiplied during drawing
-	     */
-
-	    for(i = 0; i < horizon->total_textures; i++)
-		V3DTextureDestroy(horizon->texture[i]);
-	    free(horizon->texture);
-	    horizon->texture = NULL;
-	    horizon->total_textures = 0;
-
-
-	    /* Create textures, starting with most brightest */
-	    memcpy(
-		&start_color, &scene->sky_nominal_color,
-		sizeof(sar_color_struct)
+	    V3DTextureDestroy(horizon->texture);
+	    horizon->texture = SARCreateHorizonTexture(
+		NULL,		/* No name */
+		scene
 	    );
-
-	    /* Create 7 horizon textures from order of brightest to
-	     * to darkest
-	     */
-	    total = 7;
-	    for(i = 0; i < total; i++)
-	    {
-		/* Calculate darken coefficient based on index of
-		 * the current horizon texture
-		 */
-		darken_coeff = (float)i / (float)(total - 1);
-
-		/* Calculate rgb blend values from 1.0 to 2.0 */
-		rc = (float)MIN(
-		    (scene->sky_brighten_color.r * (1.0 - darken_coeff)) +
-		    (scene->sky_darken_color.r * darken_coeff),
-		    1.0
-		);
-		gc = (float)MIN(
-		    (scene->sky_brighten_color.g * (1.0 - darken_coeff)) +
-		    (scene->sky_darken_color.g * darken_coeff),
-		    1.0
-		);
-		bc = (float)MIN(
-		    (scene->sky_brighten_color.b * (1.0 - darken_coeff)) +
-		    (scene->sky_darken_color.b * darken_coeff),
-		    1.0
-		);
-
-		/* Calculate end color */
-		end_color.a = 1.0f;
-		end_color.r = (float)MIN(
-		    (1.0 * horizon_sat_max_coeff) +
-			(rc * (1.0 - horizon_sat_max_coeff)),
-		    1.0
-		);
-		end_color.g = (float)MIN(
-		    (1.0 * horizon_sat_max_coeff) +
-			(gc * (1.0 - horizon_sat_max_coeff)), 
-		    1.0
-		);
-		end_color.b = (float)MIN(
-		    (1.0 * horizon_sat_max_coeff) +
-			(bc * (1.0 - horizon_sat_max_coeff)),
-		    1.0
-		);
-
-		DO_CREATE_TEXTURE
-	    }
-#undef DO_CREATE_TEXTURE
+	    horizon->regenerate = False;
 	}
 
 
@@ -672,12 +560,70 @@ int SARSimUpdateSceneObjects(
 	{
 	    SFMSetTiming(scene->realm, lapsed_millitime);
 	    SFMSetTimeCompression(scene->realm, time_compression);
+	    scene->realm->wind_enabled = core_ptr->option.wind;
+	    scene->realm->flight_physics_level = (SFMFlightPhysicsLevel)(core_ptr->option.flight_physics_level);
 	}
 
 
 	/* Begin handling each object on core structure */
 	obj_pa = &core_ptr->object;
 	obj_total = &core_ptr->total_objects;
+
+	/* Put objects that were created since the last cycle into
+	 * the grids now that their positions and contact bounds have
+	 * been set up
+	 */
+	if(((scene->crash_grid != NULL) && scene->crash_grid->need_sync) ||
+	   ((scene->support_grid != NULL) && scene->support_grid->need_sync) ||
+	   ((scene->rescue_grid != NULL) && scene->rescue_grid->need_sync)
+	)
+	    SARObjUpdateGridsAll(scene, *obj_pa, *obj_total);
+
+	/* SFM realm structure allocated? */
+	if(scene->realm != NULL)
+	{
+	    /* Set the object values and the player's control positions
+	     * on each aircraft's SFM
+	     */
+	    for(i = 0; i < (*obj_total); i++)
+	    {
+		obj_ptr = (*obj_pa)[i];
+		if(obj_ptr == NULL)
+		    continue;
+
+		obj_aircraft_ptr = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
+		if(obj_aircraft_ptr == NULL)
+		    continue;
+
+		fdm = obj_aircraft_ptr->fdm;
+		if(fdm == NULL)
+		    continue;
+
+		/* Set object values to SFM structure */
+		SARSimSetSFMValues(core_ptr, scene, obj_ptr);
+
+		/* If this is the player object then apply control
+		 * positions
+		 */
+		if(obj_ptr == scene->player_obj_ptr)
+		{
+		    /* Apply player control */
+		    SARSimApplyGCTL(core_ptr, obj_ptr);
+		}
+		else
+		{
+		    /* Apply AI */
+/* TODO */
+		}
+	    }
+
+	    /* Integrate all the SFMs, this may be done in parallel
+	     * and the SFM callbacks are queued on each SFM and called
+	     * below in object order
+	     */
+	    SFMUpdateRealm(scene->realm, lapsed_millitime);
+	}
+
 	for(i = 0; i < (*obj_total); i++)
 	{
 	    obj_ptr = (*obj_pa)[i];
@@ -689,9 +635,6 @@ int SARSimUpdateSceneObjects(
 	    /* SFM realm structure allocated? */
 	    if(scene->realm != NULL)
 	    {
-		scene->realm->wind_enabled = core_ptr->option.wind;
-		scene->realm->flight_physics_level = (SFMFlightPhysicsLevel)(core_ptr->option.flight_physics_level);
-
 		/* Handle by object type */
 		switch(obj_ptr->type)
 		{
@@ -710,43 +653,27 @@ int SARSimUpdateSceneObjects(
 		    if(fdm == NULL)
 			break;
 
-		    /* Set object values to SFM structure */
-		    SARSimSetSFMValues(core_ptr, scene, obj_ptr);
-
-		    /* If this is the player object then apply control
-		     * positions
+		    /* Call the SFM callbacks queued during the
+		     * integration, skip SFMs that were created after
+		     * it
 		     */
-		    if(obj_ptr == scene->player_obj_ptr)
-		    {
-			/* Apply player control */
-			SARSimApplyGCTL(core_ptr, obj_ptr);
-		    }
-		    else
+		    status = SFMResolveModel(scene->realm, fdm);
+		    if(status < 0)
 		    {
-			/* Apply AI */
-/* TODO */
+			status = 0;
+			break;
 		    }
 
+		    /* Get new object values from the updated SFM if
+		     * it is still valid
+		     */
+		    if(status == 0)
+			SARSimGetSFMValues(scene, obj_ptr);
+
 		    /* Set status to 1, noting that the SFM structure
-		     * was handled (which we will actually do so just
-		     * below)
+		     * was handled
 		     */
 		    status = 1;
-
-		    /* Begin SFM updating */
-		    if(SFMForceApplyArtificial(scene->realm, fdm))
-			break;
-/* Swapped, calculating natural forces after artifical gives us
- * more accurate center to ground height.
- */
-		    if(SFMForceApplyNatural(scene->realm, fdm))
-			break;
-		    if(SFMForceApplyControl(scene->realm, fdm))
-			break;
-
-		    SFMSetAirspeed(scene->realm, fdm);
-		    /* Get new object values from the updated SFM */
-		    SARSimGetSFMValues(scene, obj_ptr);
 		    break;
 
 		  case SAR_OBJ_TYPE_GROUND:
@@ -785,6 +712,9 @@ int SARSimUpdateSceneObjects(
 		continue;
 
 
+	    /* Move this object in the grids to its new position */
+	    SARObjUpdateGrids(scene, obj_ptr, i);
+
 	    /* Get pointer to object's contact bounds structure (which
 	     * may be NULL)
 	     */
@@ -846,3 +776,125 @@ int SARSimUpdateSceneObjects(
 
 	return(0);
 }
+
+
+/*
+ *	Records the current position and direction of each object as
+ *	its previous position and direction, this should be called
+ *	just before each simulation tick.
+ */
+void SARSimUpdatePrevious(sar_core_struct *core_ptr)
+{
+	int i;
+	sar_object_struct *obj_ptr;
+
+	if(core_ptr == NULL)
+	    return;
+
+	for(i = 0; i < core_ptr->total_objects; i++)
+	{
+	    obj_ptr = core_ptr->object[i];
+	    if(obj_ptr == NULL)
+		continue;
+
+	    memcpy(&obj_ptr->prev_pos, &obj_ptr->pos, sizeof(sar_position_struct));
+	    memcpy(&obj_ptr->prev_dir, &obj_ptr->dir, sizeof(sar_direction_struct));
+	    obj_ptr->has_prev = 1;
+	}
+}
+
+/*
+ *	Returns the angle coeff of the way from a to b in radians,
+ *	going the short way around.
+ */
+static float SARSimInterpolateRadians(float a, float b, float coeff)
+{
+	double d = b - a;
+
+	while(d > PI)
+	    d -= 2.0 * PI;
+	while(d < -PI)
+	    d += 2.0 * PI;
+
+	return((float)SFMSanitizeRadians(a + (d * coeff)));
+}
+
+/*
+ *	Moves each object to coeff of the way from its previous
+ *	position and direction to its current position and direction,
+ *	so that objects move smoothly when they are drawn more often
+ *	than they are simulated.
+ *
+ *	The current (simulated) position and direction are kept and
+ *	must be restored by calling SARSimInterpolateEnd() after
+ *	drawing and before the next simulation tick.
+ *
+ *	Objects that have not been through a simulation tick yet are
+ *	not moved.
+ */
+void SARSimInterpolateBegin(sar_core_struct *core_ptr, float coeff)
+{
+	int i;
+	sar_object_struct *obj_ptr;
+	sar_position_struct *pos, *prev_pos;
+	sar_direction_struct *dir, *prev_dir;
+
+	if(core_ptr == NULL)
+	    return;
+
+	coeff = CLIP(coeff, 0.0f, 1.0f);
+
+	for(i = 0; i < core_ptr->total_objects; i++)
+	{
+	    obj_ptr = core_ptr->object[i];
+	    if(obj_ptr == NULL)
+		continue;
+
+	    pos = &obj_ptr->pos;
+	    dir = &obj_ptr->dir;
+	    memcpy(&obj_ptr->sim_pos, pos, sizeof(sar_position_struct));
+	    memcpy(&obj_ptr->sim_dir, dir, sizeof(sar_direction_struct));
+
+	    if(!obj_ptr->has_prev || (coeff >= 1.0f))
+		continue;
+
+	    prev_pos = &obj_ptr->prev_pos;
+	    pos->x = prev_pos->x + ((pos->x - prev_pos->x) * coeff);
+	    pos->y = prev_pos->y + ((pos->y - prev_pos->y) * coeff);
+	    pos->z = prev_pos->z + ((pos->z - prev_pos->z) * coeff);
+
+	    prev_dir = &obj_ptr->prev_dir;
+	    dir->heading = SARSimInterpolateRadians(
+		prev_dir->heading, dir->heading, coeff
+	    );
+	    dir->pitch = SARSimInterpolateRadians(
+		prev_dir->pitch, dir->pitch, coeff
+	    );
+	    dir->bank = SARSimInterpolateRadians(
+		prev_dir->bank, dir->bank, coeff
+	    );
+	}
+}
+
+/*
+ *	Restores the simulated position and direction of each object
+ *	that were kept by SARSimInterpolateBegin().
+ */
+void SARSimInterpolateEnd(sar_core_struct *core_ptr)
+{
+	int i;
+	sar_object_struct *obj_ptr;
+
+	if(core_ptr == NULL)
+	    return;
+
+	for(i = 0; i < core_ptr->total_objects; i++)
+	{
+	    obj_ptr = core_ptr->object[i];
+	    if(obj_ptr == NULL)
+		continue;
+
+	    memcpy(&obj_ptr->pos, &obj_ptr->sim_pos, sizeof(sar_position_struct));
+	    memcpy(&obj_ptr->dir, &obj_ptr->sim_dir, sizeof(sar_direction_struct));
+	}
+}
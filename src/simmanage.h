@@ -38,5 +38,9 @@ extern int SARSimUpdateSceneObjects(
 	sar_scene_struct *scene
 );
 
+extern void SARSimUpdatePrevious(sar_core_struct *core_ptr);
+extern void SARSimInterpolateBegin(sar_core_struct *core_ptr, float coeff);
+extern void SARSimInterpolateEnd(sar_core_struct *core_ptr);
+
 
 #endif	/* SIMMANAGE_H */
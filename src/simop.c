@@ -54,11 +54,22 @@ static float SARSimHoistDragCoeff(
 	const sar_obj_hoist_struct *hoist
 );
 
+static float SARSimFindGroundIterate(
+	sar_object_struct **ptr, int total,
+	const int *list, int total_list,
+	const sar_position_struct *pos
+);
 float SARSimFindGround(
 	sar_scene_struct *scene,
 	sar_object_struct **ptr, int total,
 	const sar_position_struct *pos
 );
+float SARSimFindGroundCached(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	const sar_position_struct *pos,
+	sar_grid_cache_struct *cache
+);
 
 int SARSimDoMortality(
 	sar_core_struct *core_ptr, sar_object_struct *obj_ptr
@@ -208,39 +219,30 @@ static float SARSimHoistDragCoeff(
 
 
 /*
- *      Returns the elevation of (not to) the solid ground with respect
- *      to the given position pos.
- *
- *      Only objects of type ground will be checked, becareful not
- *      to check the given pos if it came from a ground object or
- *      else it would return its own elevation.
- *
- *      So this function should only be used to check landable/walkable
- *      ground for objects that need it (ie aircraft and humans).
- *      Also note that pos passed to this function should not come from
- *      an object who's contact bounds specify the crash flag
- *      SAR_CRASH_FLAG_SUPPORT_SURFACE or else they will keep being
- *      supported on themselves.
+ *	Returns the highest ground elevation at the position pos from
+ *	the objects in the given list of object numbers, if list is
+ *	NULL then all the objects are checked.
  */
-float SARSimFindGround(
-	sar_scene_struct *scene,
+static float SARSimFindGroundIterate(
 	sar_object_struct **ptr, int total,
-	const sar_position_struct *pos 
+	const int *list, int total_list,
+	const sar_position_struct *pos
 )
-{ 
-	int i;
+{
+	int i, k;
 	sar_object_struct *tar_obj_ptr;
 	float new_height, cur_height = 0.0f;
 	const sar_contact_bounds_struct *cb_tar;
 	const sar_position_struct *pos_src = pos;
 
-	if((scene == NULL) || (pos_src == NULL))
-	    return(cur_height);
+	if(list == NULL)
+	    total_list = total;
 
 	/* Iterate from last object to first */
-	for(i = total - 1; i >= 0; i--)
+	for(k = total_list - 1; k >= 0; k--)
 	{
-	    tar_obj_ptr = ptr[i];
+	    i = (list != NULL) ? list[k] : k;
+	    tar_obj_ptr = SARObjGetPtr(ptr, total, i);
 	    if(tar_obj_ptr == NULL)
 		continue;
  
@@ -280,6 +282,76 @@ float SARSimFindGround(
 	return(cur_height);
 }
 
+/*
+ *      Returns the elevation of (not to) the solid ground with respect
+ *      to the given position pos.
+ *
+ *      Only objects of type ground will be checked, becareful not
+ *      to check the given pos if it came from a ground object or
+ *      else it would return its own elevation.
+ *
+ *      So this function should only be used to check landable/walkable
+ *      ground for objects that need it (ie aircraft and humans).
+ *      Also note that pos passed to this function should not come from
+ *      an object who's contact bounds specify the crash flag
+ *      SAR_CRASH_FLAG_SUPPORT_SURFACE or else they will keep being
+ *      supported on themselves.
+ *
+ *	Only the objects in the scene's support grid cell at pos are
+ *	checked, objects created since the support grid was last
+ *	synchronized are put into it first.
+ */
+float SARSimFindGround(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	const sar_position_struct *pos 
+)
+{
+	return(SARSimFindGroundCached(scene, ptr, total, pos, NULL));
+}
+
+/*
+ *	Same as SARSimFindGround() except that the support grid's
+ *	objects at pos are kept in the given cache, which should be
+ *	the ground_cache of the object that pos came from.
+ *
+ *	While the object stays in the same support grid cell and no
+ *	ground or support surface objects have moved to other cells
+ *	the cached objects are checked without going through the
+ *	support grid again.
+ */
+float SARSimFindGroundCached(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	const sar_position_struct *pos,
+	sar_grid_cache_struct *cache
+)
+{
+	int total_list, *list;
+	sar_grid_struct *grid;
+
+	if((scene == NULL) || (pos == NULL))
+	    return(0.0f);
+
+	/* Put objects that were created since the support grid was
+	 * last synchronized into it
+	 */
+	grid = scene->support_grid;
+	if((grid != NULL) && grid->need_sync)
+	    SARObjUpdateGridsAll(scene, ptr, total);
+
+	/* Get the objects at the position, if there is no support
+	 * grid then list will be NULL and all the objects are checked
+	 */
+	total_list = SARGridQueryCached(
+	    grid, pos->x, pos->y, cache, &list
+	);
+
+	return(SARSimFindGroundIterate(
+	    ptr, total, list, total_list, pos
+	));
+}
+
 
 /*
  *      Checks if the life span of the given object has been exceeded,
@@ -366,7 +438,9 @@ int SARSimRestart(
 	pos = &obj_ptr->pos;
 
 	/* Check if this is the player object on the scene structure */
-	if((obj_num == scene->player_obj_num) ||
+	if((obj_num == SARObjGetFromHandle(
+		scene, *ptr, *total, scene->player_obj_handle
+	    )) ||
 	   (obj_ptr == scene->player_obj_ptr)
 	)
 	{
@@ -405,7 +479,9 @@ int SARSimRestart(
 	    /* Skip if helipad is referencing this object */
 	    if(obj_helipad_ptr->flags & SAR_HELIPAD_FLAG_REF_OBJECT)
 	    {
-		if((obj_helipad_ptr->ref_object == obj_num) &&
+		if((SARObjGetFromHandle(
+			scene, *ptr, *total, obj_helipad_ptr->ref_object
+		    ) == obj_num) &&
 		   (obj_num > -1)
 		)
 		    continue;
@@ -635,7 +711,7 @@ int SARSimDeleteEffects(
 	unsigned int filter_flags       /* Any of SARSIM_DELETE_EFFECTS_* */
 )
 {
-	int i, objects_deleted = 0;
+	int i, ref_obj_num, objects_deleted = 0;
 	Boolean delete_this_object;
 	sar_object_struct *effects_obj_ptr;
 	sar_object_smoke_struct *smoke;
@@ -680,12 +756,15 @@ int SARSimDeleteEffects(
 		smoke = SAR_OBJ_GET_SMOKE(effects_obj_ptr);
 		if(smoke != NULL)
 		{
+		    ref_obj_num = SARObjGetFromHandle(
+			scene, *ptr, *total, smoke->ref_object
+		    );
 		    if(obj_num > -1)
 		    {
 			/* Does the effect object reference the given
 			 * object?
 			 */
-			if(smoke->ref_object == obj_num)
+			if(ref_obj_num == obj_num)
 			    delete_this_object = True;
 		    }
 		    else
@@ -693,7 +772,7 @@ int SARSimDeleteEffects(
 			/* No object given as input, so treat criteria
 			 * as delete all non-errant effects objects
 			 */
-			if(smoke->ref_object > -1)
+			if(ref_obj_num > -1)
 			    delete_this_object = True;
 		    }
 		}
@@ -703,12 +782,15 @@ int SARSimDeleteEffects(
 		fire = SAR_OBJ_GET_FIRE(effects_obj_ptr);
 		if(fire != NULL)
 		{
+		    ref_obj_num = SARObjGetFromHandle(
+			scene, *ptr, *total, fire->ref_object
+		    );
 		    if(obj_num > -1)
 		    {
 			/* Does the effect object reference the given
 			 * object?
 			 */
-			if(fire->ref_object == obj_num)
+			if(ref_obj_num == obj_num)
 			    delete_this_object = True;
 		    }
 		    else
@@ -716,7 +798,7 @@ int SARSimDeleteEffects(
 			/* No object given as input, so treat criteria
 			 * as delete all non-errant effects objects
 			 */
-			if(fire->ref_object > -1)
+			if(ref_obj_num > -1)
 			    delete_this_object = True;
 		    }
 		}
@@ -726,12 +808,15 @@ int SARSimDeleteEffects(
 		explosion = SAR_OBJ_GET_EXPLOSION(effects_obj_ptr);
 		if(explosion != NULL)
 		{
+		    ref_obj_num = SARObjGetFromHandle(
+			scene, *ptr, *total, explosion->ref_object
+		    );
 		    if(obj_num > -1)
 		    {
 			/* Does the effect object reference the given 
 			 * object?
 			 */
-			if(explosion->ref_object == obj_num)
+			if(ref_obj_num == obj_num)
 			    delete_this_object = True;
 		    }
 		    else
@@ -739,7 +824,7 @@ int SARSimDeleteEffects(
 			/* No object given as input, so treat criteria
 			 * as delete all non-errant effects objects
 			 */
-			if(explosion->ref_object > -1)
+			if(ref_obj_num > -1)
 			    delete_this_object = True;
 		    }
 		}
@@ -756,7 +841,9 @@ int SARSimDeleteEffects(
 			/* Does the effect object reference the given
 			 * object? 
 			 */
-			if(spray->owner == obj_num)
+			if(SARObjGetFromHandle(
+			    scene, *ptr, *total, spray->owner
+			) == obj_num)
 			    delete_this_object = True;
 		    }
 		    else
@@ -764,7 +851,9 @@ int SARSimDeleteEffects(
 			/* No object given as input, so treat criteria
 			 * as delete all non-errant effects objects
 			 */     
-			if(spray->owner > -1)
+			if(SARObjGetFromHandle(
+			    scene, *ptr, *total, spray->owner
+			) > -1)
 			    delete_this_object = True;
 		    }
 #endif
@@ -871,8 +960,10 @@ void SARSimSetAircraftCrashed(
 	  /* Iterate through occupants in hoist */
 	  for(i = 0; i < hoist_ptr->total_occupants; i++)
 	  {
-	    occupant_obj_num = hoist_ptr->occupant[i];
-	    if(SARObjIsAllocated(*ptr, *total, occupant_obj_num))
+	    occupant_obj_num = SARObjGetFromHandle(
+		scene, *ptr, *total, hoist_ptr->occupant[i]
+	    );
+	    if(occupant_obj_num > -1)
 		occupant_obj_ptr = (*ptr)[occupant_obj_num];
 	    else
 		continue;
@@ -939,7 +1030,7 @@ void SARSimSetAircraftCrashed(
 	    occupant_obj_ptr->dir.bank = (float)(0.0 * PI);
 
 	    /* Mark this occupant as no longer in the list */
-	    hoist_ptr->occupant[i] = -1;
+	    hoist_ptr->occupant[i] = SAR_OBJ_HANDLE_NONE;
 	  }
 
 	  /* Clear hoist list */
@@ -1438,10 +1529,15 @@ int SARSimApplyNaturalForce(
 	    /* Helipad follows a reference object? */
 	    if(helipad->flags & SAR_HELIPAD_FLAG_FOLLOW_REF_OBJECT)
 	    {
-		sar_object_struct *ref_obj_ptr = SARObjGetPtr(
+		const int ref_obj_num = SARObjGetFromHandle(
+		    scene,
 		    core_ptr->object, core_ptr->total_objects,
 		    helipad->ref_object
 		);
+		sar_object_struct *ref_obj_ptr = SARObjGetPtr(
+		    core_ptr->object, core_ptr->total_objects,
+		    ref_obj_num
+		);
 		if(ref_obj_ptr != NULL)
 		{
 		    /* Check the type of the reference object, only
@@ -1459,7 +1555,7 @@ int SARSimApplyNaturalForce(
 			SARSimWarpObjectRelative(
 			    scene, obj_ptr,
 			    core_ptr->object, core_ptr->total_objects,
-			    helipad->ref_object,
+			    ref_obj_num,
 			    &helipad->ref_offset,
 			    &helipad->ref_dir
 			);
@@ -1554,10 +1650,12 @@ int SARSimApplyNaturalForce(
 	    /* Get smoke trail's reference object, that's the object
 	     * it is following
 	     */
-	    tar_obj_num = smoke->ref_object;
-	    if(SARObjIsAllocated(
-		core_ptr->object, core_ptr->total_objects, tar_obj_num
-	    ))
+	    tar_obj_num = SARObjGetFromHandle(
+		scene,
+		core_ptr->object, core_ptr->total_objects,
+		smoke->ref_object
+	    );
+	    if(tar_obj_num > -1)
 	    {
 		sar_object_struct *tar_obj_ptr = core_ptr->object[tar_obj_num];
 
@@ -1701,11 +1799,12 @@ int SARSimApplyNaturalForce(
 	    /* Get explosion's reference object, that's the object it
 	     * is following
 	     */
-	    tar_obj_num = explosion->ref_object;
-	    if(SARObjIsAllocated(
+	    tar_obj_num = SARObjGetFromHandle(
+		scene,
 		core_ptr->object, core_ptr->total_objects,
-		tar_obj_num
-	    ))
+		explosion->ref_object
+	    );
+	    if(tar_obj_num > -1)
 	    {
 		float ground_elevation_msl;
 		sar_object_struct *tar_obj_ptr = core_ptr->object[tar_obj_num];
@@ -2029,10 +2128,11 @@ int SARSimApplyArtificialForce(
 		 * "solid" ground while objects with contact bounds will
 		 * be "hollow".
 		 */
-		ground_elevation += SARSimFindGround(
+		ground_elevation += SARSimFindGroundCached(
 		    scene,
 		    core_ptr->object, core_ptr->total_objects,
-		    pos			/* Position of our object */
+		    pos,		/* Position of our object */
+		    &obj_ptr->ground_cache
 		);
 	    }
 	}
@@ -2278,11 +2378,12 @@ int SARSimApplyArtificialForce(
 		 */
 		for(i = 0; i < hoist->total_occupants; i++)
 		{
-		    tar_obj_num = hoist->occupant[i];
-		    if(SARObjIsAllocated(
+		    tar_obj_num = SARObjGetFromHandle(
+			scene,
 			core_ptr->object, core_ptr->total_objects,
-			tar_obj_num
-		    ))   
+			hoist->occupant[i]
+		    );
+		    if(tar_obj_num > -1)
 			tar_obj_ptr = core_ptr->object[tar_obj_num];
 		    else
 			continue;
@@ -2406,18 +2507,24 @@ int SARSimApplyArtificialForce(
 		/* Check if human is running towards or away from an
 		 * object
 		 */
-		int ref_obj_num = human->intercepting_object;
+		sar_obj_handle ref_obj_handle = human->intercepting_object;
+		int ref_obj_num;
 		sar_object_struct *ref_obj_ptr = NULL;
 
-		/* Check cases where intercepting object number would be
+		/* Check cases where intercepting object handle would be
 		 * a special value
 		 */
-		switch(ref_obj_num)
+		switch(ref_obj_handle)
 		{
-		  case -2:	/* Player object */
-		    ref_obj_num = scene->player_obj_num;
+		  case SAR_HUMAN_INTERCEPT_PLAYER:
+		    ref_obj_handle = scene->player_obj_handle;
 		    break;
 		}
+		ref_obj_num = SARObjGetFromHandle(
+		    scene,
+		    core_ptr->object, core_ptr->total_objects,
+		    ref_obj_handle
+		);
 
 		/* Match intercept object */
 		ref_obj_ptr = SARObjGetPtr(
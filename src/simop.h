@@ -32,6 +32,12 @@ extern float SARSimFindGround(
 	sar_object_struct **ptr, int total,
 	const sar_position_struct *pos  
 );
+extern float SARSimFindGroundCached(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	const sar_position_struct *pos,
+	sar_grid_cache_struct *cache
+);
 
 extern int SARSimDoMortality(
 	sar_core_struct *core_ptr, sar_object_struct *obj_ptr
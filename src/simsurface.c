@@ -16,6 +16,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <sys/types.h>
 
@@ -23,6 +24,7 @@
 
 #include "sfm.h"
 #include "obj.h"
+#include "objutils.h"
 #include "simutils.h"
 #include "simsurface.h"
 #include "sar.h"
@@ -39,6 +41,38 @@ float SARSimHFGetGroundHeight(
 	const sar_position_struct *pos
 );
 
+static Boolean SARSimIsOverRectangle(
+	float dx, float dy, float radius,
+	float cos_heading, float sin_heading,
+	float x_min, float x_max, float y_min, float y_max
+);
+static Boolean SARSimIsOverObject(
+	sar_object_struct *obj_ptr,
+	float x, float y, float radius,
+	Boolean land_only
+);
+static int SARSimGetObjectsUnderIterate(
+	sar_object_struct **ptr, int total,
+	const int *list, int total_list,
+	float x, float y, float radius,
+	Boolean land_only, int exclude_obj_num,
+	int **hit, int *total_hits
+);
+int *SARSimGetObjectsUnder(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	float x, float y, float radius,
+	int exclude_obj_num,
+	int *total_hits
+);
+Boolean SARSimIsOverWater(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	float x, float y,
+	int exclude_obj_num,
+	Boolean *got_hit
+);
+
 
 #define MAX(a,b)        (((a) > (b)) ? (a) : (b))
 #define MIN(a,b)        (((a) < (b)) ? (a) : (b))
@@ -260,3 +294,397 @@ float SARSimHFGetGroundHeight(
 
 	return(cur_z_height);
 }
+
+
+/*
+ *	Checks if the flat circle at dx and dy (relative to the center
+ *	of a rectangle) with the given radius overlaps the rectangle.
+ *
+ *	cos_heading and sin_heading are of the rectangle's inversed
+ *	heading, same as the values on the contact bounds.
+ */
+static Boolean SARSimIsOverRectangle(
+	float dx, float dy, float radius,
+	float cos_heading, float sin_heading,
+	float x_min, float x_max, float y_min, float y_max
+)
+{
+	/* Rotate dx and dy about the center of the rectangle
+	 * inversly incase the rectangle has a rotated heading
+	 */
+	const float	dx2 = (cos_heading * dx) + (sin_heading * dy),
+			dy2 = (cos_heading * dy) - (sin_heading * dx);
+
+	/* Get the distance from the rotated position to the nearest
+	 * point on the rectangle, which is 0 if it is inside
+	 */
+	const float	ex = dx2 - CLIP(dx2, x_min, x_max),
+			ey = dy2 - CLIP(dy2, y_min, y_max);
+
+	return((((ex * ex) + (ey * ey)) <= (radius * radius)) ?
+	    True : False
+	);
+}
+
+/*
+ *	Checks if the flat circle at x and y with the given radius is
+ *	over the object as it would be seen from directly above.
+ *
+ *	Helipads and runways are checked against their landable area,
+ *	ground objects against their heightfield area and contact
+ *	radius and all other drawn ground level object types against
+ *	their contact bounds. Objects of any other type (aircraft,
+ *	humans, effects, etc) are never under any position.
+ *
+ *	If land_only is True then the heightfield area of a ground
+ *	object only counts where it is higher than the ground object's
+ *	base, since the areas at its base are usually the water
+ *	around an island.
+ */
+static Boolean SARSimIsOverObject(
+	sar_object_struct *obj_ptr,
+	float x, float y, float radius,
+	Boolean land_only
+)
+{
+	float dx, dy, r;
+	const sar_position_struct *pos = &obj_ptr->pos;
+	const sar_contact_bounds_struct *cb = obj_ptr->contact_bounds;
+	sar_object_ground_struct *ground;
+	sar_object_helipad_struct *helipad;
+	sar_object_runway_struct *runway;
+
+	/* Handle by object type */
+	switch(obj_ptr->type)
+	{
+	  case SAR_OBJ_TYPE_GROUND:
+	    ground = SAR_OBJ_GET_GROUND(obj_ptr);
+	    if(ground == NULL)
+		return(False);
+
+	    /* The contact radius and heightfield are both centered
+	     * at the translated position
+	     */
+	    dx = x - (pos->x + ground->x_trans);
+	    dy = y - (pos->y + ground->y_trans);
+
+	    /* Over the cylendrical solid surface? */
+	    r = SARSimGetFlatContactRadius(obj_ptr);
+	    if((r > 0.0f) && (SFMHypot2(dx, dy) <= (r + radius)))
+		return(True);
+
+	    /* Over the heightfield? */
+	    if((ground->z_point_value != NULL) &&
+	       (ground->x_len > 0.0f) && (ground->y_len > 0.0f)
+	    )
+	    {
+		const float heading = obj_ptr->dir.heading;
+		if(!SARSimIsOverRectangle(
+		    dx, dy, radius,
+		    (float)cos(-heading), (float)sin(-heading),
+		    -(ground->x_len / 2.0f), (ground->x_len / 2.0f),
+		    -(ground->y_len / 2.0f), (ground->y_len / 2.0f)
+		))
+		    return(False);
+
+		if(land_only)
+		{
+		    sar_position_struct hf_pos;
+		    hf_pos.x = x;
+		    hf_pos.y = y;
+		    hf_pos.z = 0.0f;
+		    return((SARSimHFGetGroundHeight(obj_ptr, &hf_pos) >
+			(pos->z + ground->z_trans)) ? True : False
+		    );
+		}
+		return(True);
+	    }
+	    return(False);
+
+	  case SAR_OBJ_TYPE_HELIPAD:
+	    helipad = SAR_OBJ_GET_HELIPAD(obj_ptr);
+	    if(helipad == NULL)
+		return(False);
+	    return(SARSimIsOverRectangle(
+		x - pos->x, y - pos->y, radius,
+		(float)cos(-obj_ptr->dir.heading),
+		(float)sin(-obj_ptr->dir.heading),
+		-(helipad->width / 2.0f), (helipad->width / 2.0f),
+		-(helipad->length / 2.0f), (helipad->length / 2.0f)
+	    ));
+
+	  case SAR_OBJ_TYPE_RUNWAY:
+	    runway = SAR_OBJ_GET_RUNWAY(obj_ptr);
+	    if(runway == NULL)
+		return(False);
+	    return(SARSimIsOverRectangle(
+		x - pos->x, y - pos->y, radius,
+		(float)cos(-obj_ptr->dir.heading),
+		(float)sin(-obj_ptr->dir.heading),
+		-(runway->width / 2.0f), (runway->width / 2.0f),
+		-(runway->length / 2.0f), (runway->length / 2.0f)
+	    ));
+
+	  case SAR_OBJ_TYPE_STATIC:
+	  case SAR_OBJ_TYPE_AUTOMOBILE:
+	  case SAR_OBJ_TYPE_WATERCRAFT:
+	  case SAR_OBJ_TYPE_PREMODELED:
+	    if(cb == NULL)
+		return(False);
+	    dx = x - pos->x;
+	    dy = y - pos->y;
+	    switch(cb->contact_shape)
+	    {
+	      case SAR_CONTACT_SHAPE_SPHERICAL:
+	      case SAR_CONTACT_SHAPE_CYLENDRICAL:
+		if(cb->contact_radius <= 0.0f)
+		    return(False);
+		return((SFMHypot2(dx, dy) <= (cb->contact_radius + radius)) ?
+		    True : False
+		);
+	      case SAR_CONTACT_SHAPE_RECTANGULAR:
+		return(SARSimIsOverRectangle(
+		    dx, dy, radius,
+		    cb->cos_heading, cb->sin_heading,
+		    cb->contact_x_min, cb->contact_x_max,
+		    cb->contact_y_min, cb->contact_y_max
+		));
+	    }
+	    break;
+
+	  case SAR_OBJ_TYPE_GARBAGE:
+	  case SAR_OBJ_TYPE_AIRCRAFT:
+	  case SAR_OBJ_TYPE_HUMAN:
+	  case SAR_OBJ_TYPE_SMOKE:
+	  case SAR_OBJ_TYPE_FIRE:
+	  case SAR_OBJ_TYPE_EXPLOSION:
+	  case SAR_OBJ_TYPE_CHEMICAL_SPRAY:
+	  case SAR_OBJ_TYPE_FUELTANK:
+	    break;
+	}
+
+	return(False);
+}
+
+/*
+ *	Appends each object in list (or all the objects if list is
+ *	NULL) that is under x and y to hit, skipping exclude_obj_num
+ *	and any object already in hit.
+ *
+ *	If hit is NULL then it stops at the first object found.
+ *
+ *	Returns the number of objects found.
+ */
+static int SARSimGetObjectsUnderIterate(
+	sar_object_struct **ptr, int total,
+	const int *list, int total_list,
+	float x, float y, float radius,
+	Boolean land_only, int exclude_obj_num,
+	int **hit, int *total_hits
+)
+{
+	int i, k, n, found = 0;
+	sar_object_struct *obj_ptr;
+
+	if(list == NULL)
+	    total_list = total;
+
+	for(k = 0; k < total_list; k++)
+	{
+	    i = (list != NULL) ? list[k] : k;
+	    if(i == exclude_obj_num)
+		continue;
+
+	    obj_ptr = SARObjGetPtr(ptr, total, i);
+	    if(obj_ptr == NULL)
+		continue;
+
+	    if(!SARSimIsOverObject(obj_ptr, x, y, radius, land_only))
+		continue;
+
+	    found++;
+	    if(hit == NULL)
+		break;
+
+	    /* Already found in the other grid? */
+	    for(n = 0; n < *total_hits; n++)
+	    {
+		if((*hit)[n] == i)
+		    break;
+	    }
+	    if(n < *total_hits)
+		continue;
+
+	    n = MAX(*total_hits, 0);
+	    *total_hits = n + 1;
+	    *hit = (int *)realloc(*hit, (*total_hits) * sizeof(int));
+	    if(*hit == NULL)
+	    {
+		*total_hits = 0;
+		break;
+	    }
+	    (*hit)[n] = i;
+	}
+
+	return(found);
+}
+
+/*
+ *	Returns a list of object numbers of the objects that are under
+ *	the flat circle at x and y with the given radius, this is the
+ *	list of objects that would be drawn directly below that
+ *	position (see SARSimIsOverObject() for the objects that are
+ *	checked).
+ *
+ *	The exclude_obj_num (which can be -1) will not be in the
+ *	returned list.
+ *
+ *	Only the objects in the scene's support and crash grids at the
+ *	position are checked, so this does not need a GL context.
+ *
+ *	Returns NULL if there are no objects under the position, the
+ *	calling function must delete the returned list.
+ */
+int *SARSimGetObjectsUnder(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	float x, float y, float radius,
+	int exclude_obj_num,
+	int *total_hits
+)
+{
+	int total_list, *list, *hit = NULL;
+	sar_grid_struct *support_grid, *crash_grid;
+
+	if(total_hits != NULL)
+	    *total_hits = 0;
+
+	if((scene == NULL) || (total_hits == NULL))
+	    return(NULL);
+
+	if(radius < 0.0f)
+	    radius = 0.0f;
+
+	/* Put objects that were created since the grids were last
+	 * synchronized into them
+	 */
+	support_grid = scene->support_grid;
+	crash_grid = scene->crash_grid;
+	if(((support_grid != NULL) && support_grid->need_sync) ||
+	   ((crash_grid != NULL) && crash_grid->need_sync)
+	)
+	    SARObjUpdateGridsAll(scene, ptr, total);
+
+	/* No grids? Then check all the objects */
+	if((support_grid == NULL) || (crash_grid == NULL))
+	{
+	    SARSimGetObjectsUnderIterate(
+		ptr, total, NULL, 0,
+		x, y, radius,
+		False, exclude_obj_num,
+		&hit, total_hits
+	    );
+	    return(hit);
+	}
+
+	/* Ground objects, helipads and runways are in the support
+	 * grid, everything else that can be under a position is in
+	 * the crash grid
+	 */
+	total_list = SARGridQuery(support_grid, x, y, radius, &list);
+	SARSimGetObjectsUnderIterate(
+	    ptr, total, list, total_list,
+	    x, y, radius,
+	    False, exclude_obj_num,
+	    &hit, total_hits
+	);
+	total_list = SARGridQuery(crash_grid, x, y, radius, &list);
+	SARSimGetObjectsUnderIterate(
+	    ptr, total, list, total_list,
+	    x, y, radius,
+	    False, exclude_obj_num,
+	    &hit, total_hits
+	);
+
+	return(hit);
+}
+
+/*
+ *	Checks if the position at x and y is over water.
+ *
+ *	The position is over land if any object that would be drawn
+ *	directly below it is found, except that the heightfield of a
+ *	ground object only counts where it is higher than its base.
+ *	If nothing is found then the position is over water if the
+ *	scene's base is water.
+ *
+ *	The exclude_obj_num (which can be -1) is never checked.
+ *
+ *	If got_hit is not NULL then it will be set to True if an
+ *	object was found.
+ */
+Boolean SARSimIsOverWater(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	float x, float y,
+	int exclude_obj_num,
+	Boolean *got_hit
+)
+{
+	int found, total_list, *list;
+	sar_grid_struct *support_grid, *crash_grid;
+
+	if(got_hit != NULL)
+	    *got_hit = False;
+
+	if(scene == NULL)
+	    return(False);
+
+	support_grid = scene->support_grid;
+	crash_grid = scene->crash_grid;
+	if(((support_grid != NULL) && support_grid->need_sync) ||
+	   ((crash_grid != NULL) && crash_grid->need_sync)
+	)
+	    SARObjUpdateGridsAll(scene, ptr, total);
+
+	if((support_grid == NULL) || (crash_grid == NULL))
+	{
+	    found = SARSimGetObjectsUnderIterate(
+		ptr, total, NULL, 0,
+		x, y, 0.0f,
+		True, exclude_obj_num,
+		NULL, NULL
+	    );
+	}
+	else
+	{
+	    total_list = SARGridQuery(support_grid, x, y, 0.0f, &list);
+	    found = SARSimGetObjectsUnderIterate(
+		ptr, total, list, total_list,
+		x, y, 0.0f,
+		True, exclude_obj_num,
+		NULL, NULL
+	    );
+	    if(found == 0)
+	    {
+		total_list = SARGridQuery(crash_grid, x, y, 0.0f, &list);
+		found = SARSimGetObjectsUnderIterate(
+		    ptr, total, list, total_list,
+		    x, y, 0.0f,
+		    True, exclude_obj_num,
+		    NULL, NULL
+		);
+	    }
+	}
+
+	if(found > 0)
+	{
+	    if(got_hit != NULL)
+		*got_hit = True;
+	    return(False);
+	}
+
+	return((scene->base_flags & SAR_SCENE_BASE_FLAG_IS_WATER) ?
+	    True : False
+	);
+}
@@ -34,4 +34,19 @@ extern float SARSimHFGetGroundHeight(
 	const sar_position_struct *pos
 );
 
+extern int *SARSimGetObjectsUnder(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	float x, float y, float radius,
+	int exclude_obj_num,
+	int *total_hits
+);
+extern Boolean SARSimIsOverWater(
+	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
+	float x, float y,
+	int exclude_obj_num,
+	Boolean *got_hit
+);
+
 #endif	/* SIMSURFACE_H */
@@ -155,6 +155,7 @@ void SARSimSetSlew(
 );
 int SARSimDoPickUpHuman(
 	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
 	sar_object_struct *obj_ptr,
 	sar_object_human_struct *obj_human_ptr,
 	int human_obj_num
@@ -229,6 +230,10 @@ float SARSimGetFlatContactRadius(sar_object_struct *obj_ptr)
  *
  *      If index is not NULL then the index to the object number on
  *      the objects list will be set or -1 on failed match.
+ *
+ *	The object is found from the FDM's owner reference, which is
+ *	only trusted if the object at the owner index is still the
+ *	owner and still has this FDM.
  */
 sar_object_struct *SARSimMatchObjectFromFDM(
 	sar_object_struct **list, int total,
@@ -245,47 +250,24 @@ sar_object_struct *SARSimMatchObjectFromFDM(
 	if((list == NULL) || (fdm == NULL))
 	    return(NULL);
 
-	/* Iterate through all objects */  
-	for(i = 0; i < total; i++)
-	{
-	    obj_ptr = list[i]; 
-	    if(obj_ptr == NULL)
-		continue;
+	i = fdm->owner_index;
+	if((i < 0) || (i >= total))
+	    return(NULL);
 
-	    switch(obj_ptr->type)
-	    {
-	      case SAR_OBJ_TYPE_GARBAGE:
-	      case SAR_OBJ_TYPE_STATIC:
-	      case SAR_OBJ_TYPE_AUTOMOBILE:
-	      case SAR_OBJ_TYPE_WATERCRAFT:
-		break;
-	      case SAR_OBJ_TYPE_AIRCRAFT:
-		obj_aircraft_ptr = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
-		if(obj_aircraft_ptr != NULL)
-		{
-		    if(obj_aircraft_ptr->fdm == fdm)
-		    {
-			if(index != NULL)
-			    *index = i;
-			return(obj_ptr);
-		    }
-		}
-		break;
-	      case SAR_OBJ_TYPE_GROUND:
-	      case SAR_OBJ_TYPE_RUNWAY:
-	      case SAR_OBJ_TYPE_HELIPAD:
-	      case SAR_OBJ_TYPE_HUMAN:
-	      case SAR_OBJ_TYPE_SMOKE:
-	      case SAR_OBJ_TYPE_FIRE:
-	      case SAR_OBJ_TYPE_EXPLOSION:
-	      case SAR_OBJ_TYPE_CHEMICAL_SPRAY:
-	      case SAR_OBJ_TYPE_FUELTANK:
-	      case SAR_OBJ_TYPE_PREMODELED:
-		break;
-	    }
-	}
+	obj_ptr = list[i];
+	if((obj_ptr == NULL) || (obj_ptr != fdm->owner))
+	    return(NULL);
+
+	obj_aircraft_ptr = SAR_OBJ_GET_AIRCRAFT(obj_ptr);
+	if(obj_aircraft_ptr == NULL)
+	    return(NULL);
+	if(obj_aircraft_ptr->fdm != fdm)
+	    return(NULL);
 
-	return(NULL);
+	if(index != NULL)
+	    *index = i;
+
+	return(obj_ptr);
 }
 
 
@@ -2152,7 +2134,9 @@ int SARSimOpDropFuelTankNext(
 		    obj_fueltank_ptr->fuel = eft_ptr->fuel;
 		    obj_fueltank_ptr->fuel_max = eft_ptr->fuel_max;
 
-		    obj_fueltank_ptr->ref_object = obj_num;
+		    obj_fueltank_ptr->ref_object = SARObjGetHandle(
+			scene, *ptr, *total, obj_num
+		    );
 
 
 		    /* Maximum vertical velocity in meters per cycle */
@@ -2264,9 +2248,9 @@ void SARSimSmokeSpawn(
 		 */
 		memcpy(&u->pos, &obj_ptr->pos, sizeof(sar_position_struct));
 		pos = &u->vel;
-		pos->x = 2 * (rand()/(float)(RAND_MAX) - 0.5);
-		pos->y = 2 * (rand()/(float)(RAND_MAX) - 0.5);
-		pos->z = 2 * rand()/(float)(RAND_MAX) + 3;
+		pos->x = 2 * (SARRandomCoeff(0) - 0.5);
+		pos->y = 2 * (SARRandomCoeff(1) - 0.5);
+		pos->z = 2 * SARRandomCoeff(2) + 3;
 
 		/* Apply offset to initial position */
 		pos = &u->pos;
@@ -2454,6 +2438,7 @@ void SARSimSetSlew(
  */
 int SARSimDoPickUpHuman(
 	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
 	sar_object_struct *obj_ptr,
 	sar_object_human_struct *obj_human_ptr,	/* Not data structure of obj_ptr */
 	int human_obj_num
@@ -2531,9 +2516,9 @@ int SARSimDoPickUpHuman(
 	 */
 	n = MAX(hoist->total_occupants, 0);
 	hoist->total_occupants = n + 1;
-	hoist->occupant = (int *)realloc(
+	hoist->occupant = (sar_obj_handle *)realloc(
 	    hoist->occupant,
-	    hoist->total_occupants * sizeof(int)
+	    hoist->total_occupants * sizeof(sar_obj_handle)
 	);
 	if(hoist->occupant == NULL)
 	{
@@ -2542,12 +2527,19 @@ int SARSimDoPickUpHuman(
 	}
 	else
 	{
-	    hoist->occupant[n] = human_obj_num;
+	    hoist->occupant[n] = SARObjGetHandle(
+		scene, ptr, total, human_obj_num
+	    );
 	}
 
 	/* Update hoist's occupants mass (in kg) */
 	hoist->occupants_mass += obj_human_ptr->mass;
 
+	/* The human no longer needs rescue, so it can not be picked
+	 * up again
+	 */
+	SARGridRemove(scene->rescue_grid, human_obj_num);
+
 	/* Update nessesary flags on human object by what is on
 	 * the end of the hoist rope
 	 */
@@ -2650,12 +2642,13 @@ int SARSimDoHoistIn(
 	/* Delete all objects in hoist's deployment */
 	for(i = 0; i < hoist->total_occupants; i++)
 	{
-	    passenger_obj_num = hoist->occupant[i];
-	    if(SARObjIsAllocated(
+	    passenger_obj_num = SARObjGetFromHandle(
+		scene,
 		core_ptr->object,
 		core_ptr->total_objects,
-		passenger_obj_num
-	    ))
+		hoist->occupant[i]
+	    );
+	    if(passenger_obj_num > -1)
 		passenger_obj_ptr = core_ptr->object[passenger_obj_num];
 	    else
 		continue;
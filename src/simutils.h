@@ -155,6 +155,7 @@ extern void SARSimSetSlew(
 /* Hoist & Passenger Operations */
 extern int SARSimDoPickUpHuman(
 	sar_scene_struct *scene,
+	sar_object_struct **ptr, int total,
         sar_object_struct *obj_ptr,
 	sar_object_human_struct *obj_human_ptr,
 	int human_obj_num
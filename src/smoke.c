@@ -174,7 +174,9 @@ int SmokeCreate(
 	    scene, tex_name
 	);
 
-	smoke->ref_object = ref_object;
+	smoke->ref_object = SARObjGetHandle(
+	    scene, *ptr, *total, ref_object
+	);
 
 	smoke->total_units = total_units;
 	if(smoke->total_units > 0)
@@ -0,0 +1,106 @@
+/**********************************************************************
+*   This file is part of Search and Rescue II (SaR2).                 *
+*                                                                     *
+*   SaR2 is free software: you can redistribute it and/or modify      *
+*   it under the terms of the GNU General Public License v.2 as       *
+*   published by the Free Software Foundation.                        *
+*                                                                     *
+*   SaR2 is distributed in the hope that it will be useful, but       *
+*   WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See          *
+*   the GNU General Public License for more details.                  *
+*                                                                     *
+*   You should have received a copy of the GNU General Public License *
+*   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
+***********************************************************************/
+
+/*
+	Sound Server IO without a sound server, used by the headless
+	simulation runner (see sarheadless.c) in place of sound.c.
+
+	There is never a recorder so only the functions that the
+	simulation, scene and mission modules call are provided and
+	they all do nothing.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+
+#include "sound.h"
+
+
+snd_play_struct *SoundStartPlay(
+	snd_recorder_struct *recorder,
+	const char *object,
+	float volume_left, float volume_right,
+	float sample_rate,
+	snd_flags_t options
+);
+void SoundStartPlayVoid(
+	snd_recorder_struct *recorder,
+	const char *object,
+	float volume_left, float volume_right,
+	float sample_rate,
+	snd_flags_t options
+);
+void SoundChangePlayVolume(
+	snd_recorder_struct *recorder, snd_play_struct *snd_play,
+	float volume_left, float volume_right
+);
+void SoundChangePlaySampleRate(
+	snd_recorder_struct *recorder, snd_play_struct *snd_play,
+	float sample_rate
+);
+void SoundStopPlay(
+	snd_recorder_struct *recorder, snd_play_struct *snd_play
+);
+
+
+/*
+ *	Returns NULL, nothing is played.
+ */
+snd_play_struct *SoundStartPlay(
+	snd_recorder_struct *recorder,
+	const char *object,
+	float volume_left, float volume_right,
+	float sample_rate,
+	snd_flags_t options
+)
+{
+	return(NULL);
+}
+
+void SoundStartPlayVoid(
+	snd_recorder_struct *recorder,
+	const char *object,
+	float volume_left, float volume_right,
+	float sample_rate,
+	snd_flags_t options
+)
+{
+
+}
+
+void SoundChangePlayVolume(
+	snd_recorder_struct *recorder, snd_play_struct *snd_play,
+	float volume_left, float volume_right
+)
+{
+
+}
+
+void SoundChangePlaySampleRate(
+	snd_recorder_struct *recorder, snd_play_struct *snd_play,
+	float sample_rate
+)
+{
+
+}
+
+void SoundStopPlay(
+	snd_recorder_struct *recorder, snd_play_struct *snd_play
+)
+{
+
+}
@@ -78,6 +78,17 @@ void StateGLTexEnvI(
 	GLenum target, GLenum pname, GLint param
 );
 
+static int StateGLTextureTargetIndex(GLenum target);
+void StateGLBindTexture(
+	state_gl_struct *s,
+	GLenum target, GLuint texture
+);
+void StateGLInvalidateTextureBindings(state_gl_struct *s);
+
+StateGLBoolean StateGLVersionAtLeast(
+	state_gl_struct *s, int major, int minor
+);
+
 void StateGLResetAll(state_gl_struct *s);
 
 
@@ -903,6 +914,121 @@ void StateGLTexEnvI(
 }
 
 
+/*
+ *	Returns the index in the texture_binding members for the
+ *	specified texture target or -1 if the target is not tracked.
+ */
+static int StateGLTextureTargetIndex(GLenum target)
+{
+	switch(target)
+	{
+	  case GL_TEXTURE_1D:
+	    return(0);
+	  case GL_TEXTURE_2D:
+	    return(1);
+#ifdef GL_TEXTURE_3D
+	  case GL_TEXTURE_3D:
+	    return(2);
+#endif
+	}
+	return(-1);
+}
+
+/*
+ *	Binds the texture to the target as needed
+ *
+ *	If s is NULL then the texture will be bound explicitly
+ */
+void StateGLBindTexture(
+	state_gl_struct *s,
+	GLenum target, GLuint texture
+)
+{
+	if(s != NULL)
+	{
+	    const int i = StateGLTextureTargetIndex(target);
+	    if(i > -1)
+	    {
+		if(s->texture_binding_valid[i] &&
+		   (s->texture_binding[i] == texture)
+		)
+		{
+		    s->texture_binds_saved++;
+		    return;
+		}
+		s->texture_binding[i] = texture;
+		s->texture_binding_valid[i] = True;
+	    }
+	    s->texture_binds++;
+	}
+	glBindTexture(target, texture);
+}
+
+/*
+ *	Marks the texture bindings as unknown so that the next
+ *	StateGLBindTexture() for each target binds the texture.
+ *
+ *	This must be called after anything that binds textures
+ *	without StateGLBindTexture(), such as calling a GL list, and
+ *	around recording a GL list (the recorded binds are not made
+ *	until the list is called).
+ *
+ *	If s is NULL then no operation will be performed.
+ */
+void StateGLInvalidateTextureBindings(state_gl_struct *s)
+{
+	int i;
+
+	if(s == NULL)
+	    return;
+
+	for(i = 0; i < 3; i++)
+	    s->texture_binding_valid[i] = False;
+}
+
+/*
+ *	Checks if the version of the current GL context is at least
+ *	major.minor.
+ *
+ *	The version is only queried once and kept on s until the
+ *	states are reset with StateGLResetAll(). If s is NULL then
+ *	the version is queried on each call.
+ *
+ *	Returns False if there is no current GL context.
+ */
+StateGLBoolean StateGLVersionAtLeast(
+	state_gl_struct *s, int major, int minor
+)
+{
+	int cur_major = 0, cur_minor = 0;
+
+	if((s != NULL) ? s->version_valid : False)
+	{
+	    cur_major = s->version_major;
+	    cur_minor = s->version_minor;
+	}
+	else
+	{
+	    const char *v = (const char *)glGetString(GL_VERSION);
+	    if(v == NULL)
+		return(False);
+	    if(sscanf(v, "%d.%d", &cur_major, &cur_minor) < 1)
+		return(False);
+
+	    if(s != NULL)
+	    {
+		s->version_major = cur_major;
+		s->version_minor = cur_minor;
+		s->version_valid = True;
+	    }
+	}
+
+	return(((cur_major > major) ||
+		((cur_major == major) && (cur_minor >= minor))
+	) ? True : False);
+}
+
+
 /*
  *	Resets all states (supported in the state_gl_struct)
  *	for the current OpenGL context to be disabled.
@@ -1052,4 +1178,10 @@ void StateGLResetAll(state_gl_struct *s)
 	s->tex_env_param = GL_MODULATE;
 	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
+	StateGLInvalidateTextureBindings(s);
+	s->texture_binds = 0;
+	s->texture_binds_saved = 0;
+
+	/* The GL context may have changed */
+	s->version_valid = False;
 }
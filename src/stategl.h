@@ -39,6 +39,27 @@
 #define StateGLBoolean	unsigned char
 
 
+/*
+ *	GL versions whose functions may be called, on MSW the GL
+ *	library only has GL 1.1 so none of the newer functions are
+ *	used there.
+ *
+ *	The version of the current GL context must still be checked
+ *	with StateGLVersionAtLeast() before calling them.
+ */
+#if !defined(__MSW__)
+# if defined(GL_VERSION_1_4)
+#  define STATE_GL_VERSION_1_4
+# endif
+# if defined(GL_VERSION_1_5)
+#  define STATE_GL_VERSION_1_5
+# endif
+# if defined(GL_VERSION_3_0)
+#  define STATE_GL_VERSION_3_0
+# endif
+#endif
+
+
 /*
  *	GL state record struct:
  *
@@ -134,6 +155,25 @@ typedef struct {
 	GLenum		tex_env_target, tex_env_pname;
 	GLint		tex_env_param;
 
+	/* Texture bound to GL_TEXTURE_1D, GL_TEXTURE_2D, and
+	 * GL_TEXTURE_3D, each is only valid while its
+	 * texture_binding_valid is True
+	 */
+	GLuint		texture_binding[3];
+	StateGLBoolean	texture_binding_valid[3];
+
+	/* Number of textures bound and number of binds that were
+	 * not needed since the counts were last reset
+	 */
+	unsigned long	texture_binds,
+			texture_binds_saved;
+
+	/* Version of the GL context, only valid while version_valid
+	 * is True
+	 */
+	int		version_major,
+			version_minor;
+	StateGLBoolean	version_valid;
 
 } state_gl_struct;
 #define STATE_GL(p)	((state_gl_struct *)(p))
@@ -191,6 +231,16 @@ extern void StateGLTexEnvI(
 	GLenum target, GLenum pname, GLint param
 );
 
+extern void StateGLBindTexture(
+	state_gl_struct *s,
+	GLenum target, GLuint texture
+);
+extern void StateGLInvalidateTextureBindings(state_gl_struct *s);
+
+extern StateGLBoolean StateGLVersionAtLeast(
+	state_gl_struct *s, int major, int minor
+);
+
 extern void StateGLResetAll(state_gl_struct *s);
 
 
@@ -14,8 +14,14 @@
 *   along with SaR2.  If not, see <http://www.gnu.org/licenses/>.     *
 ***********************************************************************/
 
+/* Buffer object functions are only declared with the prototypes
+ * from glext.h
+ */
+#define GL_GLEXT_PROTOTYPES
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <math.h>
@@ -36,6 +42,12 @@
 #endif
 
 
+static void V3DHFGetOptions(
+	const v3d_hf_options_struct *hfopt,
+	int *winding, int *set_normal, int *set_texcoord,
+	float *tex_offset_x, float *tex_offset_y,
+	float *tex_width, float *tex_height
+);
 static void V3DHFNormalByCrossGridVectors(
 	float v1i, float v1k,
 	float v2j, float v2k
@@ -58,6 +70,38 @@ int V3DHFLoadFromFile(
 	v3d_hf_options_struct *hfopt
 );
 
+static double V3DHFTerrainZ(
+	const double *data, int width, int height,
+	int x, int y
+);
+static void V3DHFTerrainLODCell(
+	int i, int n, int step,
+	int *i0, int *i1
+);
+static double V3DHFTerrainLODZ(
+	const double *data, int width, int height,
+	int gx, int gy, int nx, int ny,
+	int step, int i, int j
+);
+static void V3DHFTerrainChunkError(
+	v3d_hf_chunk_struct *chunk,
+	const double *data, int width, int height,
+	int gx, int gy, int nx, int ny
+);
+static int V3DHFTerrainAddIndex(
+	v3d_hf_terrain_struct *terrain, int *max_indices, GLuint i
+);
+v3d_hf_terrain_struct *V3DHFTerrainNew(
+	const double *data,
+	int width, int height,
+	double x_len, double y_len,
+	GLfloat x, GLfloat y, GLfloat z,
+	v3d_hf_options_struct *hfopt,
+	state_gl_struct *state_gl
+);
+void V3DHFTerrainDelete(v3d_hf_terrain_struct *terrain);
+void V3DHFTerrainDraw(v3d_hf_terrain_struct *terrain);
+
 double V3DHFGetHeightFromWorldPosition(
 	double x, double y,	/* The world position. */
 	double hf_x, double hf_y, double hf_z,	/* HF's world position. */
@@ -78,6 +122,41 @@ double V3DHFGetHeightFromWorldPosition(
 #define RADTODEG(r)     ((r) * 180 / PI)
 
 
+/*
+ *	Gets the values of the options set on hfopt, values of options
+ *	that are not set are left unchanged.
+ */
+static void V3DHFGetOptions(
+	const v3d_hf_options_struct *hfopt,
+	int *winding, int *set_normal, int *set_texcoord,
+	float *tex_offset_x, float *tex_offset_y,
+	float *tex_width, float *tex_height
+)
+{
+	unsigned int flags;
+
+	if(hfopt == NULL)
+	    return;
+
+	flags = hfopt->flags;
+	if(flags & V3D_HF_OPT_FLAG_WINDING)
+	    *winding = hfopt->winding;
+	if(flags & V3D_HF_OPT_FLAG_SET_NORMAL)
+	    *set_normal = hfopt->set_normal;
+	if(flags & V3D_HF_OPT_FLAG_SET_TEXCOORD)
+	    *set_texcoord = hfopt->set_texcoord;
+	if(flags & V3D_HF_OPT_FLAG_TEX_OFFSET)
+	{
+	    *tex_offset_x = (float)hfopt->tex_offset_x;
+	    *tex_offset_y = (float)hfopt->tex_offset_y;
+	}
+	if(flags & V3D_HF_OPT_FLAG_TEX_SIZE)
+	{
+	    *tex_width = (float)hfopt->tex_width;
+	    *tex_height = (float)hfopt->tex_height;
+	}
+}
+
 /*
  *	Sets normal given the vectors along the grid (left hand rule).
  *
@@ -188,27 +267,12 @@ int V3DHFLoadFromFile(
 	    (*y_spacing_rtn) = 0.0;
 
 	/* Update heightfield options. */
-	if(hfopt != NULL)
-	{
-	    unsigned int flags = hfopt->flags;
-
-	    if(flags & V3D_HF_OPT_FLAG_WINDING)
-		winding = hfopt->winding;
-	    if(flags & V3D_HF_OPT_FLAG_SET_NORMAL)
-		set_normal = hfopt->set_normal;
-	    if(flags & V3D_HF_OPT_FLAG_SET_TEXCOORD)
-		set_texcoord = hfopt->set_texcoord;
-	    if(flags & V3D_HF_OPT_FLAG_TEX_OFFSET)
-	    {
-		tex_offset_x = (float)hfopt->tex_offset_x;
-		tex_offset_y = (float)hfopt->tex_offset_y;
-	    }
-	    if(flags & V3D_HF_OPT_FLAG_TEX_SIZE)
-	    {
-		tex_width = (float)hfopt->tex_width;
-		tex_height = (float)hfopt->tex_height;
-	    }
-	}
+	V3DHFGetOptions(
+	    hfopt,
+	    &winding, &set_normal, &set_texcoord,
+	    &tex_offset_x, &tex_offset_y,
+	    &tex_width, &tex_height
+	);
 
 
 	/* Path to heightfield image file must be valid. */
@@ -321,6 +385,18 @@ int V3DHFLoadFromFile(
 	}
 
 
+	/* Set grid spacing returns if possable. */
+	if(td.width > 0)
+	{
+	    if(x_spacing_rtn != NULL)
+		(*x_spacing_rtn) = (float)x_len / (float)td.width;
+	}
+	if(td.height > 0)
+	{
+	    if(y_spacing_rtn != NULL)
+		(*y_spacing_rtn) = (float)y_len / (float)td.height;
+	}
+
 	/* Begin setting z points to the return buffer. */
 	if(total_z_points > 0)
 	{
@@ -371,12 +447,6 @@ int V3DHFLoadFromFile(
 	    else
 		y_sp = 0.0f;
 
-	    /* Set grid spacing returns if possable. */
-	    if(x_spacing_rtn != NULL)
-		(*x_spacing_rtn) = x_sp;
-	    if(y_spacing_rtn != NULL)
-		(*y_spacing_rtn) = y_sp;
-
 
 	    /* Begin issuing gl commands for recording into the gl list. */
 
@@ -662,6 +732,721 @@ int V3DHFLoadFromFile(
 	return(0);
 }
 
+/*
+ *	Returns the z value of grid point x, y on the z points data,
+ *	points past the last column and row use the last pixel the same
+ *	way that V3DHFLoadFromFile() does.
+ */
+static double V3DHFTerrainZ(
+	const double *data, int width, int height,
+	int x, int y
+)
+{
+	x = MIN(x, width - 1);
+	y = MIN(y, height - 1);
+	return(data[(y * width) + x]);
+}
+
+/*
+ *	Gets the grid points i0 and i1 of the cell that grid point i
+ *	is in, on a chunk n grids wide drawn using every step grid
+ *	points.
+ */
+static void V3DHFTerrainLODCell(
+	int i, int n, int step,
+	int *i0, int *i1
+)
+{
+	if(i >= n)
+	{
+	    *i0 = ((n - 1) / step) * step;
+	    *i1 = n;
+	}
+	else
+	{
+	    *i0 = (i / step) * step;
+	    *i1 = MIN(*i0 + step, n);
+	}
+}
+
+/*
+ *	Returns the z value at grid point i, j on the chunk at gx, gy
+ *	as it is drawn when using every step grid points.
+ *
+ *	Each cell has an upper right and a lower left triangle, the
+ *	same as V3DHFLoadFromFile() draws each grid.
+ */
+static double V3DHFTerrainLODZ(
+	const double *data, int width, int height,
+	int gx, int gy, int nx, int ny,
+	int step, int i, int j
+)
+{
+	int i0, i1, j0, j1;
+	double u, v, z1, z2, z3, z4;
+
+	V3DHFTerrainLODCell(i, nx, step, &i0, &i1);
+	V3DHFTerrainLODCell(j, ny, step, &j0, &j1);
+
+	u = (double)(i - i0) / (double)(i1 - i0);
+	v = (double)(j - j0) / (double)(j1 - j0);
+
+	z1 = V3DHFTerrainZ(data, width, height, gx + i0, gy + j0);
+	z2 = V3DHFTerrainZ(data, width, height, gx + i1, gy + j0);
+	z3 = V3DHFTerrainZ(data, width, height, gx + i0, gy + j1);
+	z4 = V3DHFTerrainZ(data, width, height, gx + i1, gy + j1);
+
+	if(u >= v)
+	    return(z1 + (u * (z2 - z1)) + (v * (z4 - z2)));
+	else
+	    return(z1 + (v * (z3 - z1)) + (u * (z4 - z3)));
+}
+
+/*
+ *	Sets the number of levels of detail of the chunk at gx, gy
+ *	and the largest height error of each one.
+ */
+static void V3DHFTerrainChunkError(
+	v3d_hf_chunk_struct *chunk,
+	const double *data, int width, int height,
+	int gx, int gy, int nx, int ny
+)
+{
+	int i, j, k, step;
+	double error;
+
+	for(k = 1; k < V3D_HF_CHUNK_LODS; k++)
+	{
+	    if((1 << k) > MAX(nx, ny))
+		break;
+	}
+	chunk->total_lods = k;
+
+	chunk->lod_error[0] = 0.0f;
+	for(k = 1; k < chunk->total_lods; k++)
+	{
+	    step = 1 << k;
+	    error = 0.0;
+	    for(j = 0; j <= ny; j++)
+	    {
+		for(i = 0; i <= nx; i++)
+		    error = MAX(
+			error,
+			fabs(V3DHFTerrainZ(
+			    data, width, height, gx + i, gy + j
+			) - V3DHFTerrainLODZ(
+			    data, width, height, gx, gy, nx, ny,
+			    step, i, j
+			))
+		    );
+	    }
+
+	    /* A coarser level never has less error than a finer one */
+	    chunk->lod_error[k] = MAX((float)error, chunk->lod_error[k - 1]);
+	}
+}
+
+/*
+ *	Appends index i to the terrain's indices.
+ */
+static int V3DHFTerrainAddIndex(
+	v3d_hf_terrain_struct *terrain, int *max_indices, GLuint i
+)
+{
+	if(terrain->total_indices >= *max_indices)
+	{
+	    const int new_max_indices = MAX(*max_indices * 2, 1024);
+	    GLuint *index = (GLuint *)realloc(
+		terrain->index,
+		new_max_indices * sizeof(GLuint)
+	    );
+	    if(index == NULL)
+		return(-1);
+
+	    terrain->index = index;
+	    *max_indices = new_max_indices;
+	}
+
+	terrain->index[terrain->total_indices] = i;
+	terrain->total_indices++;
+
+	return(0);
+}
+
+/*
+ *	Creates a new terrain from the z points data returned by
+ *	V3DHFLoadFromFile() of a heightfield width by height grids
+ *	(pixels) in size.
+ *
+ *	The heightfield is split into chunks of V3D_HF_CHUNK_GRIDS by
+ *	V3D_HF_CHUNK_GRIDS grids, each with its levels of detail and a
+ *	skirt hanging down from its edges that hides the cracks between
+ *	chunks drawn at different levels of detail. The vertices and
+ *	indices are put into GL buffer objects if the GL context that
+ *	state_gl records has them.
+ *
+ *	The terrain is drawn the same as V3DHFLoadFromFile() would
+ *	record it into a GL list translated by x, y, z, except that the
+ *	normals are averaged at each grid point.
+ *
+ *	Returns NULL on error.
+ */
+v3d_hf_terrain_struct *V3DHFTerrainNew(
+	const double *data,
+	int width, int height,
+	double x_len, double y_len,
+	GLfloat x, GLfloat y, GLfloat z,
+	v3d_hf_options_struct *hfopt,
+	state_gl_struct *state_gl
+)
+{
+	int winding = V3D_HF_WIND_CCW;
+	int set_normal = V3D_HF_SET_NORMAL_AVERAGED;
+	int set_texcoord = V3D_HF_SET_TEXCOORD_ALWAYS;
+	float tex_offset_x = 0.0f, tex_offset_y = 0.0f;
+	float tex_width = (float)x_len, tex_height = (float)y_len;
+
+	int i, j, k, n, cx, cy, gx, gy, nx, ny, step,
+	    chunks_x, chunks_y, max_indices = 0,
+	    xs[V3D_HF_CHUNK_GRIDS + 1], total_xs,
+	    ys[V3D_HF_CHUNK_GRIDS + 1], total_ys;
+	GLuint base, skirt_top, skirt_bottom, skirt_left, skirt_right;
+	float x_sp, y_sp, x_len_half, y_len_half, skirt_depth = 0.0f;
+	GLfloat *v, min[3], max[3];
+	v3d_hf_chunk_struct *chunk;
+	v3d_hf_terrain_struct *terrain;
+
+	if((data == NULL) || (width < 1) || (height < 1) ||
+	   (x_len <= 0.0) || (y_len <= 0.0)
+	)
+	    return(NULL);
+
+	V3DHFGetOptions(
+	    hfopt,
+	    &winding, &set_normal, &set_texcoord,
+	    &tex_offset_x, &tex_offset_y,
+	    &tex_width, &tex_height
+	);
+	if((tex_width <= 0.0f) || (tex_height <= 0.0f))
+	    return(NULL);
+
+	x_sp = (float)x_len / (float)width;
+	y_sp = (float)y_len / (float)height;
+	x_len_half = (float)(x_len / 2);
+	y_len_half = (float)(y_len / 2);
+
+	chunks_x = (width + V3D_HF_CHUNK_GRIDS - 1) / V3D_HF_CHUNK_GRIDS;
+	chunks_y = (height + V3D_HF_CHUNK_GRIDS - 1) / V3D_HF_CHUNK_GRIDS;
+
+	terrain = (v3d_hf_terrain_struct *)calloc(
+	    1, sizeof(v3d_hf_terrain_struct)
+	);
+	if(terrain == NULL)
+	    return(NULL);
+
+	terrain->x = x;
+	terrain->y = y;
+	terrain->z = z;
+	terrain->set_normal = (set_normal != V3D_HF_SET_NORMAL_NEVER) ? 1 : 0;
+	terrain->set_texcoord = (set_texcoord != V3D_HF_SET_TEXCOORD_NEVER) ?
+	    1 : 0;
+
+	/* Allocate the chunks and the vertices, each chunk has its own
+	 * grid points plus a skirt point for each point on its edges
+	 */
+	terrain->total_chunks = chunks_x * chunks_y;
+	terrain->chunk = (v3d_hf_chunk_struct *)calloc(
+	    terrain->total_chunks, sizeof(v3d_hf_chunk_struct)
+	);
+	for(cy = 0; cy < chunks_y; cy++)
+	{
+	    ny = MIN(height - (cy * V3D_HF_CHUNK_GRIDS), V3D_HF_CHUNK_GRIDS);
+	    for(cx = 0; cx < chunks_x; cx++)
+	    {
+		nx = MIN(width - (cx * V3D_HF_CHUNK_GRIDS), V3D_HF_CHUNK_GRIDS);
+		terrain->total_vertices += ((nx + 1) * (ny + 1)) +
+		    (2 * (nx + 1)) + (2 * (ny + 1));
+	    }
+	}
+	terrain->vertex = (GLfloat *)malloc(
+	    terrain->total_vertices * 8 * sizeof(GLfloat)
+	);
+	if((terrain->chunk == NULL) || (terrain->vertex == NULL))
+	{
+	    V3DHFTerrainDelete(terrain);
+	    return(NULL);
+	}
+
+	/* Calculate the height error of each chunk's levels of detail,
+	 * the skirts are made deep enough to cover the largest error
+	 * on both sides of any edge
+	 */
+	for(cy = 0; cy < chunks_y; cy++)
+	{
+	    gy = cy * V3D_HF_CHUNK_GRIDS;
+	    ny = MIN(height - gy, V3D_HF_CHUNK_GRIDS);
+	    for(cx = 0; cx < chunks_x; cx++)
+	    {
+		gx = cx * V3D_HF_CHUNK_GRIDS;
+		nx = MIN(width - gx, V3D_HF_CHUNK_GRIDS);
+		chunk = &terrain->chunk[(cy * chunks_x) + cx];
+		V3DHFTerrainChunkError(
+		    chunk, data, width, height, gx, gy, nx, ny
+		);
+		skirt_depth = MAX(
+		    skirt_depth, chunk->lod_error[chunk->total_lods - 1]
+		);
+	    }
+	}
+	skirt_depth = (2.0f * skirt_depth) + 1.0f;
+
+	/* Set each chunk's vertices and indices */
+	v = terrain->vertex;
+	base = 0;
+	for(cy = 0; cy < chunks_y; cy++)
+	{
+	    gy = cy * V3D_HF_CHUNK_GRIDS;
+	    ny = MIN(height - gy, V3D_HF_CHUNK_GRIDS);
+	    for(cx = 0; cx < chunks_x; cx++)
+	    {
+		gx = cx * V3D_HF_CHUNK_GRIDS;
+		nx = MIN(width - gx, V3D_HF_CHUNK_GRIDS);
+		chunk = &terrain->chunk[(cy * chunks_x) + cx];
+
+		skirt_top = base + ((nx + 1) * (ny + 1));
+		skirt_bottom = skirt_top + (nx + 1);
+		skirt_left = skirt_bottom + (nx + 1);
+		skirt_right = skirt_left + (ny + 1);
+
+		/* Grid points, the normal is averaged from the slope
+		 * to the neighboring points
+		 */
+		for(j = 0; j <= ny; j++)
+		{
+		    for(i = 0; i <= nx; i++)
+		    {
+			int	il = MAX(gx + i - 1, 0),
+				ir = MIN(gx + i + 1, width),
+				jt = MAX(gy + j - 1, 0),
+				jb = MIN(gy + j + 1, height);
+			float	dzx = (float)(
+			    V3DHFTerrainZ(data, width, height, ir, gy + j) -
+			    V3DHFTerrainZ(data, width, height, il, gy + j)
+				) / ((ir - il) * x_sp),
+				dzy = (float)(
+			    V3DHFTerrainZ(data, width, height, gx + i, jb) -
+			    V3DHFTerrainZ(data, width, height, gx + i, jt)
+				) / ((jb - jt) * y_sp),
+				m = (float)sqrt(
+			    (dzx * dzx) + 1.0f + (dzy * dzy)
+				);
+
+			v[0] = ((gx + i) * x_sp) - x_len_half;
+			v[1] = (GLfloat)V3DHFTerrainZ(
+			    data, width, height, gx + i, gy + j
+			);
+			v[2] = ((gy + j) * y_sp) - y_len_half;
+			v[3] = -dzx / m;
+			v[4] = 1.0f / m;
+			v[5] = -dzy / m;
+			v[6] = ((gx + i) * x_sp / tex_width) - tex_offset_x;
+			v[7] = ((gy + j) * y_sp / tex_height) + tex_offset_y;
+			v += 8;
+		    }
+		}
+
+		/* Skirt points, below the grid points on the top,
+		 * bottom, left, and right edges
+		 */
+#define COPY_SKIRT_VERTEX(_i_,_j_)	{			\
+ memcpy(							\
+  v,								\
+  &terrain->vertex[(base + ((_j_) * (nx + 1)) + (_i_)) * 8],	\
+  8 * sizeof(GLfloat)						\
+ );								\
+ v[1] -= skirt_depth;						\
+ v += 8;							\
+}
+		for(i = 0; i <= nx; i++)
+		    COPY_SKIRT_VERTEX(i, 0);
+		for(i = 0; i <= nx; i++)
+		    COPY_SKIRT_VERTEX(i, ny);
+		for(j = 0; j <= ny; j++)
+		    COPY_SKIRT_VERTEX(0, j);
+		for(j = 0; j <= ny; j++)
+		    COPY_SKIRT_VERTEX(nx, j);
+#undef COPY_SKIRT_VERTEX
+
+		/* Bounding sphere */
+		for(k = 0; k < 3; k++)
+		{
+		    min[k] = terrain->vertex[(base * 8) + k];
+		    max[k] = min[k];
+		}
+		for(n = base; n <= (int)skirt_right + ny; n++)
+		{
+		    const GLfloat *pv = &terrain->vertex[n * 8];
+		    for(k = 0; k < 3; k++)
+		    {
+			min[k] = MIN(min[k], pv[k]);
+			max[k] = MAX(max[k], pv[k]);
+		    }
+		}
+		for(k = 0; k < 3; k++)
+		    chunk->center[k] = (min[k] + max[k]) / 2.0f;
+		chunk->radius = (GLfloat)sqrt(
+		    ((max[0] - min[0]) * (max[0] - min[0])) +
+		    ((max[1] - min[1]) * (max[1] - min[1])) +
+		    ((max[2] - min[2]) * (max[2] - min[2]))
+		) / 2.0f;
+
+		/* Indices of each level of detail, triangles are
+		 * given counter clockwise and reversed if the winding
+		 * is clockwise
+		 */
+#define GRID(_i_,_j_)	(base + ((_j_) * (nx + 1)) + (_i_))
+#define ADD_TRI(_a_,_b_,_c_)	{				\
+ V3DHFTerrainAddIndex(terrain, &max_indices, (_a_));		\
+ if(winding == V3D_HF_WIND_CCW) {				\
+  V3DHFTerrainAddIndex(terrain, &max_indices, (_b_));		\
+  V3DHFTerrainAddIndex(terrain, &max_indices, (_c_));		\
+ } else {							\
+  V3DHFTerrainAddIndex(terrain, &max_indices, (_c_));		\
+  V3DHFTerrainAddIndex(terrain, &max_indices, (_b_));		\
+ }								\
+}
+		for(k = 0; k < chunk->total_lods; k++)
+		{
+		    step = 1 << k;
+		    chunk->lod_first[k] = terrain->total_indices;
+
+		    total_xs = 0;
+		    for(i = 0; i < nx; i += step)
+			xs[total_xs++] = i;
+		    xs[total_xs++] = nx;
+		    total_ys = 0;
+		    for(j = 0; j < ny; j += step)
+			ys[total_ys++] = j;
+		    ys[total_ys++] = ny;
+
+		    /* Upper right and lower left triangle of each cell:
+		     *
+		     *   v1---v2
+		     *   | \   |
+		     *   |   \ |
+		     *   v3---v4
+		     */
+		    for(j = 0; j < (total_ys - 1); j++)
+		    {
+			for(i = 0; i < (total_xs - 1); i++)
+			{
+			    GLuint	v1 = GRID(xs[i], ys[j]),
+					v2 = GRID(xs[i + 1], ys[j]),
+					v3 = GRID(xs[i], ys[j + 1]),
+					v4 = GRID(xs[i + 1], ys[j + 1]);
+			    ADD_TRI(v1, v4, v2);
+			    ADD_TRI(v1, v3, v4);
+			}
+		    }
+
+		    /* Skirts, facing out from each edge */
+		    for(i = 0; i < (total_xs - 1); i++)
+		    {
+			ADD_TRI(
+			    skirt_top + xs[i], GRID(xs[i], 0),
+			    GRID(xs[i + 1], 0)
+			);
+			ADD_TRI(
+			    skirt_top + xs[i], GRID(xs[i + 1], 0),
+			    skirt_top + xs[i + 1]
+			);
+			ADD_TRI(
+			    skirt_bottom + xs[i + 1], GRID(xs[i + 1], ny),
+			    GRID(xs[i], ny)
+			);
+			ADD_TRI(
+			    skirt_bottom + xs[i + 1], GRID(xs[i], ny),
+			    skirt_bottom + xs[i]
+			);
+		    }
+		    for(j = 0; j < (total_ys - 1); j++)
+		    {
+			ADD_TRI(
+			    skirt_left + ys[j + 1], GRID(0, ys[j + 1]),
+			    GRID(0, ys[j])
+			);
+			ADD_TRI(
+			    skirt_left + ys[j + 1], GRID(0, ys[j]),
+			    skirt_left + ys[j]
+			);
+			ADD_TRI(
+			    skirt_right + ys[j], GRID(nx, ys[j]),
+			    GRID(nx, ys[j + 1])
+			);
+			ADD_TRI(
+			    skirt_right + ys[j], GRID(nx, ys[j + 1]),
+			    skirt_right + ys[j + 1]
+			);
+		    }
+
+		    chunk->lod_count[k] = terrain->total_indices -
+			chunk->lod_first[k];
+		}
+#undef ADD_TRI
+#undef GRID
+
+		base = skirt_right + (ny + 1);
+	    }
+	}
+
+	if(terrain->index == NULL)
+	{
+	    V3DHFTerrainDelete(terrain);
+	    return(NULL);
+	}
+
+#ifdef STATE_GL_VERSION_1_5
+	/* Put the vertices and indices into GL buffer objects */
+	if(StateGLVersionAtLeast(state_gl, 1, 5))
+	{
+	    glGenBuffers(1, &terrain->vertex_buffer);
+	    glGenBuffers(1, &terrain->index_buffer);
+	    if((terrain->vertex_buffer != 0) && (terrain->index_buffer != 0))
+	    {
+		glBindBuffer(GL_ARRAY_BUFFER, terrain->vertex_buffer);
+		glBufferData(
+		    GL_ARRAY_BUFFER,
+		    terrain->total_vertices * 8 * sizeof(GLfloat),
+		    terrain->vertex,
+		    GL_STATIC_DRAW
+		);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, terrain->index_buffer);
+		glBufferData(
+		    GL_ELEMENT_ARRAY_BUFFER,
+		    terrain->total_indices * sizeof(GLuint),
+		    terrain->index,
+		    GL_STATIC_DRAW
+		);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		free(terrain->vertex);
+		terrain->vertex = NULL;
+		free(terrain->index);
+		terrain->index = NULL;
+	    }
+	    else
+	    {
+		if(terrain->vertex_buffer != 0)
+		    glDeleteBuffers(1, &terrain->vertex_buffer);
+		if(terrain->index_buffer != 0)
+		    glDeleteBuffers(1, &terrain->index_buffer);
+		terrain->vertex_buffer = terrain->index_buffer = 0;
+	    }
+	}
+#endif
+
+	return(terrain);
+}
+
+/*
+ *	Deletes the terrain and its GL buffer objects.
+ */
+void V3DHFTerrainDelete(v3d_hf_terrain_struct *terrain)
+{
+	if(terrain == NULL)
+	    return;
+
+#ifdef STATE_GL_VERSION_1_5
+	if(terrain->vertex_buffer != 0)
+	    glDeleteBuffers(1, &terrain->vertex_buffer);
+	if(terrain->index_buffer != 0)
+	    glDeleteBuffers(1, &terrain->index_buffer);
+#endif
+
+	free(terrain->vertex);
+	free(terrain->index);
+	free(terrain->chunk);
+	free(terrain);
+}
+
+/*
+ *	Draws the terrain.
+ *
+ *	The view frustum and the camera position are taken from the
+ *	current GL projection and modelview matrices, the modelview
+ *	matrix is assumed to have no scaling. Chunks outside of the
+ *	view frustum are not drawn and every other chunk is drawn at
+ *	the coarsest level of detail whose height error is less than
+ *	V3D_HF_LOD_PIXEL_ERROR pixels on the screen.
+ */
+void V3DHFTerrainDraw(v3d_hf_terrain_struct *terrain)
+{
+	int i, j, k;
+	GLint viewport[4];
+	GLfloat mv[16], pm[16], clip[16], plane[6][4], cam[3];
+	float lod_scale, d;
+	const GLsizei stride = 8 * sizeof(GLfloat);
+	const char *vertex_base, *index_base;
+	const v3d_hf_chunk_struct *chunk;
+
+	if(terrain == NULL)
+	    return;
+
+#ifdef STATE_GL_VERSION_1_5
+	if(terrain->vertex_buffer != 0)
+	{
+	    vertex_base = NULL;
+	    index_base = NULL;
+	}
+	else
+#endif
+	{
+	    if((terrain->vertex == NULL) || (terrain->index == NULL))
+		return;
+	    vertex_base = (const char *)terrain->vertex;
+	    index_base = (const char *)terrain->index;
+	}
+
+	terrain->drawn_chunks = 0;
+	terrain->drawn_triangles = 0;
+
+	glPushMatrix();
+	glTranslatef(terrain->x, terrain->y, terrain->z);
+
+	glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+	glGetFloatv(GL_PROJECTION_MATRIX, pm);
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	/* Camera position in the terrain's coordinates */
+	for(i = 0; i < 3; i++)
+	    cam[i] = -((mv[(i * 4) + 0] * mv[12]) +
+		       (mv[(i * 4) + 1] * mv[13]) +
+		       (mv[(i * 4) + 2] * mv[14]));
+
+	/* Frustum planes from the rows of the projection times the
+	 * modelview matrix, in the terrain's coordinates
+	 */
+	for(j = 0; j < 4; j++)
+	{
+	    for(i = 0; i < 4; i++)
+		clip[(j * 4) + i] =
+		    (pm[(0 * 4) + i] * mv[(j * 4) + 0]) +
+		    (pm[(1 * 4) + i] * mv[(j * 4) + 1]) +
+		    (pm[(2 * 4) + i] * mv[(j * 4) + 2]) +
+		    (pm[(3 * 4) + i] * mv[(j * 4) + 3]);
+	}
+	for(j = 0; j < 4; j++)
+	{
+	    const GLfloat *c = &clip[j * 4];
+	    plane[0][j] = c[3] + c[0];		/* Left */
+	    plane[1][j] = c[3] - c[0];		/* Right */
+	    plane[2][j] = c[3] + c[1];		/* Bottom */
+	    plane[3][j] = c[3] - c[1];		/* Top */
+	    plane[4][j] = c[3] + c[2];		/* Near */
+	    plane[5][j] = c[3] - c[2];		/* Far */
+	}
+	for(i = 0; i < 6; i++)
+	{
+	    float m = (float)sqrt(
+		(plane[i][0] * plane[i][0]) +
+		(plane[i][1] * plane[i][1]) +
+		(plane[i][2] * plane[i][2])
+	    );
+	    if(m > 0.0f)
+	    {
+		for(j = 0; j < 4; j++)
+		    plane[i][j] /= m;
+	    }
+	}
+
+	/* Distance per meter of height error at which the error is
+	 * V3D_HF_LOD_PIXEL_ERROR pixels on the screen
+	 */
+	lod_scale = pm[5] * (float)viewport[3] / 2.0f /
+	    V3D_HF_LOD_PIXEL_ERROR;
+
+#ifdef STATE_GL_VERSION_1_5
+	if(terrain->vertex_buffer != 0)
+	{
+	    glBindBuffer(GL_ARRAY_BUFFER, terrain->vertex_buffer);
+	    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, terrain->index_buffer);
+	}
+#endif
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, stride, vertex_base);
+	if(terrain->set_normal)
+	{
+	    glEnableClientState(GL_NORMAL_ARRAY);
+	    glNormalPointer(
+		GL_FLOAT, stride, vertex_base + (3 * sizeof(GLfloat))
+	    );
+	}
+	if(terrain->set_texcoord)
+	{
+	    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	    glTexCoordPointer(
+		2, GL_FLOAT, stride, vertex_base + (6 * sizeof(GLfloat))
+	    );
+	}
+
+	for(i = 0; i < terrain->total_chunks; i++)
+	{
+	    chunk = &terrain->chunk[i];
+
+	    /* Outside of the view frustum? */
+	    for(j = 0; j < 6; j++)
+	    {
+		if(((plane[j][0] * chunk->center[0]) +
+		    (plane[j][1] * chunk->center[1]) +
+		    (plane[j][2] * chunk->center[2]) +
+		    plane[j][3]) < -chunk->radius
+		)
+		    break;
+	    }
+	    if(j < 6)
+		continue;
+
+	    /* Select the level of detail by the distance to the
+	     * nearest point of the chunk's bounding sphere
+	     */
+	    d = (float)sqrt(
+		((chunk->center[0] - cam[0]) * (chunk->center[0] - cam[0])) +
+		((chunk->center[1] - cam[1]) * (chunk->center[1] - cam[1])) +
+		((chunk->center[2] - cam[2]) * (chunk->center[2] - cam[2]))
+	    ) - chunk->radius;
+	    d = MAX(d, 0.0f);
+	    for(k = chunk->total_lods - 1; k > 0; k--)
+	    {
+		if((chunk->lod_error[k] * lod_scale) <= d)
+		    break;
+	    }
+
+	    glDrawElements(
+		GL_TRIANGLES, chunk->lod_count[k], GL_UNSIGNED_INT,
+		index_base + (chunk->lod_first[k] * sizeof(GLuint))
+	    );
+	    terrain->drawn_chunks++;
+	    terrain->drawn_triangles += chunk->lod_count[k] / 3;
+	}
+
+	if(terrain->set_texcoord)
+	    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	if(terrain->set_normal)
+	    glDisableClientState(GL_NORMAL_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+#ifdef STATE_GL_VERSION_1_5
+	if(terrain->vertex_buffer != 0)
+	{
+	    glBindBuffer(GL_ARRAY_BUFFER, 0);
+	    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+#endif
+
+	glPopMatrix();
+}
+
 /*
  *	Returns the z value of the heightfield point + hf_z that the
  *	given x and y position in world coordinates is over.
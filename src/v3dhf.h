@@ -23,6 +23,7 @@
 
 #include <sys/types.h>
 #include <GL/gl.h>
+#include "stategl.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -67,6 +68,83 @@ typedef struct {
 } v3d_hf_options_struct;
 
 
+/*
+ *	Terrain chunk sizes:
+ *
+ *	Each chunk is V3D_HF_CHUNK_GRIDS grids (pixels) on a side and
+ *	has up to V3D_HF_CHUNK_LODS levels of detail, level n using
+ *	every (1 << n)th grid point.
+ */
+#define V3D_HF_CHUNK_GRIDS	32
+#define V3D_HF_CHUNK_LODS	6
+
+/*
+ *	Largest height error of a chunk's level of detail on the screen
+ *	(in pixels) before the next finer level is drawn.
+ */
+#define V3D_HF_LOD_PIXEL_ERROR	3.0f
+
+/*
+ *	HF terrain chunk:
+ */
+typedef struct {
+
+	/* Indices of each level of detail (including skirts) */
+	int		lod_first[V3D_HF_CHUNK_LODS],
+			lod_count[V3D_HF_CHUNK_LODS];
+
+	/* Largest height difference in meters between each level of
+	 * detail and the heightfield points
+	 */
+	float		lod_error[V3D_HF_CHUNK_LODS];
+
+	int		total_lods;
+
+	/* Bounding sphere in GL coordinates */
+	GLfloat		center[3],
+			radius;
+
+} v3d_hf_chunk_struct;
+
+/*
+ *	HF terrain:
+ *
+ *	A heightfield split into chunks that are drawn from vertex
+ *	arrays with a level of detail chosen by the distance to the
+ *	camera each time it is drawn, chunks outside of the view
+ *	frustum are not drawn.
+ */
+typedef struct {
+
+	/* Translation of the heightfield's center in GL coordinates */
+	GLfloat		x, y, z;
+
+	char		set_normal,
+			set_texcoord;
+
+	/* Vertices, each is the position (x, y, z), normal (x, y, z)
+	 * and texture coordinates (s, t) all in GL coordinates
+	 */
+	GLfloat		*vertex;
+	int		total_vertices;
+
+	GLuint		*index;
+	int		total_indices;
+
+	/* GL buffer objects, 0 if the arrays above are used */
+	GLuint		vertex_buffer,
+			index_buffer;
+
+	v3d_hf_chunk_struct	*chunk;
+	int		total_chunks;
+
+	/* Chunks and triangles drawn by the last V3DHFTerrainDraw() */
+	int		drawn_chunks,
+			drawn_triangles;
+
+} v3d_hf_terrain_struct;
+
+
 extern int V3DHFLoadFromFile(
 	const char *path,	/* Heightfield image file. */
 	double x_len, double y_len, double z_len,	/* Size in meters. */
@@ -80,6 +158,17 @@ extern int V3DHFLoadFromFile(
 	v3d_hf_options_struct *hfopt
 );
 
+extern v3d_hf_terrain_struct *V3DHFTerrainNew(
+	const double *data,	/* Z points from V3DHFLoadFromFile(). */
+	int width, int height,	/* Num grids (pixels). */
+	double x_len, double y_len,	/* Size in meters. */
+	GLfloat x, GLfloat y, GLfloat z,	/* Translation in GL coordinates. */
+	v3d_hf_options_struct *hfopt,
+	state_gl_struct *state_gl	/* Can be NULL. */
+);
+extern void V3DHFTerrainDelete(v3d_hf_terrain_struct *terrain);
+extern void V3DHFTerrainDraw(v3d_hf_terrain_struct *terrain);
+
 extern double V3DHFGetHeightFromWorldPosition(
 	double x, double y,     /* The world position. */
 	double hf_x, double hf_y, double hf_z,  /* HF's world position. */
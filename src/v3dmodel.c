@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
 #include <sys/types.h>
 
 #include "v3dmp.h"
@@ -27,6 +28,19 @@
 #endif
 
 
+/*
+ *	Vertex cluster used by V3DModelSimplify().
+ */
+typedef struct {
+
+	long	ix, iy, iz;	/* Cell index */
+	int	frame;		/* Translate/rotate frame */
+	double	x, y, z;	/* Sum of the vertices in the cell */
+	int	count;		/* Vertices in the cell, 0 if unused */
+
+} v3d_model_cell_struct;
+
+
 v3d_model_struct *V3DModelCreate(int type, const char *name);
 v3d_model_struct *V3DModelDup(const v3d_model_struct *m);
 void V3DModelDestroy(v3d_model_struct *m);
@@ -43,6 +57,12 @@ void V3DModelListDeleteAll(v3d_model_struct ***list, int *total);
 
 int V3DModelGetType(v3d_model_struct *m);
 
+static v3d_model_cell_struct *V3DModelSimplifyCell(
+	v3d_model_cell_struct *cell, int total_cells,
+	const mp_vertex_struct *v, int frame, double cell_size
+);
+int V3DModelSimplify(v3d_model_struct *m, double cell_size);
+
 
 #define ATOI(s)         (((s) != NULL) ? atoi(s) : 0)
 #define ATOL(s)         (((s) != NULL) ? atol(s) : 0)
@@ -328,3 +348,184 @@ int V3DModelGetType(v3d_model_struct *m)
 	    return(m->type);
 }
 
+/*
+ *	Returns the vertex cluster on the cell hash table that the
+ *	vertex v belongs to, adding it as needed.
+ *
+ *	The table must have at least one unused entry.
+ */
+static v3d_model_cell_struct *V3DModelSimplifyCell(
+	v3d_model_cell_struct *cell, int total_cells,
+	const mp_vertex_struct *v, int frame, double cell_size
+)
+{
+	const long	ix = (long)floor(v->x / cell_size),
+			iy = (long)floor(v->y / cell_size),
+			iz = (long)floor(v->z / cell_size);
+	unsigned long h = ((unsigned long)ix * 73856093ul) ^
+	    ((unsigned long)iy * 19349663ul) ^
+	    ((unsigned long)iz * 83492791ul) ^
+	    ((unsigned long)frame * 2654435761ul);
+	int i = (int)(h % (unsigned long)total_cells);
+	v3d_model_cell_struct *c;
+
+	while(1)
+	{
+	    c = &cell[i];
+	    if(c->count == 0)
+	    {
+		c->ix = ix;
+		c->iy = iy;
+		c->iz = iz;
+		c->frame = frame;
+		return(c);
+	    }
+	    if((c->ix == ix) && (c->iy == iy) && (c->iz == iz) &&
+	       (c->frame == frame)
+	    )
+		return(c);
+	    i = (i + 1) % total_cells;
+	}
+}
+
+/*
+ *	Simplifies the model's primitives by vertex clustering, the
+ *	vertices are grouped by the cube of size cell_size (in
+ *	meters) that they are in and each vertex is moved to the
+ *	average of its group. Triangles, quads, and polygons that
+ *	are left with less than three distinct vertices are deleted.
+ *
+ *	Vertices after a translate or rotate primitive are never
+ *	grouped with the vertices before it.
+ *
+ *	Returns the number of primitives deleted or -1 on error.
+ */
+int V3DModelSimplify(v3d_model_struct *m, double cell_size)
+{
+	int i, j, k, pass, type, frame, total, distinct,
+	    total_vertices, total_cells, deleted;
+	void *p;
+	mp_vertex_struct *v, *v2;
+	v3d_model_cell_struct *c, *cell;
+
+	if((m == NULL) || (cell_size <= 0.0))
+	    return(-1);
+
+	/* Count the vertices */
+	total_vertices = 0;
+	for(i = 0; i < m->total_primitives; i++)
+	{
+	    type = V3DMPGetType(m->primitive[i]);
+	    if((type >= V3DMP_TYPE_POINT) && (type <= V3DMP_TYPE_POLYGON))
+		total_vertices += V3DMPGetTotal(m->primitive[i]);
+	}
+	if(total_vertices <= 0)
+	    return(0);
+
+	/* Allocate the cell hash table, at most half full */
+	total_cells = (total_vertices * 2) + 1;
+	cell = (v3d_model_cell_struct *)calloc(
+	    total_cells, sizeof(v3d_model_cell_struct)
+	);
+	if(cell == NULL)
+	    return(-1);
+
+	/* Sum the vertices of each cell on the first pass and move
+	 * each vertex to its cell's average on the second pass
+	 */
+	for(pass = 0; pass < 2; pass++)
+	{
+	    frame = 0;
+	    for(i = 0; i < m->total_primitives; i++)
+	    {
+		p = m->primitive[i];
+		type = V3DMPGetType(p);
+		switch(type)
+		{
+		  case V3DMP_TYPE_TRANSLATE:
+		  case V3DMP_TYPE_UNTRANSLATE:
+		  case V3DMP_TYPE_ROTATE:
+		  case V3DMP_TYPE_UNROTATE:
+		    frame++;
+		    break;
+		}
+		if((type < V3DMP_TYPE_POINT) || (type > V3DMP_TYPE_POLYGON))
+		    continue;
+
+		total = V3DMPGetTotal(p);
+		for(j = 0; j < total; j++)
+		{
+		    v = V3DMPGetVertex(p, j);
+		    if(v == NULL)
+			continue;
+
+		    c = V3DModelSimplifyCell(
+			cell, total_cells, v, frame, cell_size
+		    );
+		    if(pass == 0)
+		    {
+			c->x += v->x;
+			c->y += v->y;
+			c->z += v->z;
+			c->count++;
+		    }
+		    else
+		    {
+			v->x = c->x / (double)c->count;
+			v->y = c->y / (double)c->count;
+			v->z = c->z / (double)c->count;
+		    }
+		}
+	    }
+	}
+	free(cell);
+
+	/* Delete the triangles, quads, and polygons that have
+	 * collapsed and close up the list
+	 */
+	deleted = 0;
+	for(i = 0, k = 0; i < m->total_primitives; i++)
+	{
+	    p = m->primitive[i];
+	    type = V3DMPGetType(p);
+	    if((type == V3DMP_TYPE_TRIANGLE) ||
+	       (type == V3DMP_TYPE_QUAD) ||
+	       (type == V3DMP_TYPE_POLYGON)
+	    )
+	    {
+		total = V3DMPGetTotal(p);
+		distinct = 0;
+		for(j = 0; j < total; j++)
+		{
+		    int n;
+
+		    v = V3DMPGetVertex(p, j);
+		    if(v == NULL)
+			continue;
+
+		    for(n = 0; n < j; n++)
+		    {
+			v2 = V3DMPGetVertex(p, n);
+			if((v2 != NULL) &&
+			   (v2->x == v->x) && (v2->y == v->y) &&
+			   (v2->z == v->z)
+			)
+			    break;
+		    }
+		    if(n >= j)
+			distinct++;
+		}
+		if(distinct < 3)
+		{
+		    V3DMPDestroy(p);
+		    deleted++;
+		    continue;
+		}
+	    }
+	    m->primitive[k] = p;
+	    k++;
+	}
+	m->total_primitives = k;
+
+	return(deleted);
+}
@@ -81,6 +81,8 @@ extern void V3DModelListDeleteAll(v3d_model_struct ***list, int *total);
 
 extern int V3DModelGetType(v3d_model_struct *m);
 
+extern int V3DModelSimplify(v3d_model_struct *m, double cell_size);
+
 
 #ifdef __cplusplus
 }  
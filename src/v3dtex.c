@@ -32,6 +32,7 @@
 #include "../include/string.h"
 #include "../include/tga.h"
 
+#include "stategl.h"
 #include "v3dtex.h"
 
 #ifdef MEMWATCH
@@ -39,6 +40,7 @@
 #endif
 
 
+static int V3DTextureHaveContext(void);
 static int V3DTextureIsPowerOf2(int num);
 static void V3DTextureRescaleImage(
 	const u_int8_t *in_pixels,
@@ -47,6 +49,8 @@ static void V3DTextureRescaleImage(
 	u_int8_t **out_pixels,
 	int *out_width, int *out_height
 );
+void V3DTextureSetStateGL(state_gl_struct *s);
+void V3DTextureInvalidate(void);
 void V3DTextureSelectFrame(v3d_texture_ref_struct *t, int frame_num);
 void V3DTextureSelect(v3d_texture_ref_struct *t);
 v3d_texture_ref_struct *V3DTextureLoadFromFile2D(
@@ -77,6 +81,13 @@ void V3DTextureDestroy(v3d_texture_ref_struct *t);
 #define ATOF(s)         (((s) != NULL) ? atof(s) : 0.0f)
 #define STRDUP(s)       (((s) != NULL) ? strdup(s) : NULL)
 
+
+/*
+ *	GL states that the texture bindings are recorded on, NULL to
+ *	always bind the textures.
+ */
+static state_gl_struct	*v3d_texture_state_gl = NULL;
+
 #define MAX(a,b)        (((a) > (b)) ? (a) : (b))
 #define MIN(a,b)        (((a) < (b)) ? (a) : (b))
 #define CLIP(a,l,h)     (MIN(MAX((a),(l)),(h)))
@@ -119,6 +130,17 @@ void V3DTextureDestroy(v3d_texture_ref_struct *t);
 
 
 
+/*
+ *	Checks if there is a current GL context to create textures on.
+ *
+ *	Without one (ie when running headless) the GL and GLU texture
+ *	functions are not safe to call.
+ */
+static int V3DTextureHaveContext(void)
+{
+	return((glGetString(GL_VERSION) != NULL) ? 1 : 0);
+}
+
 /*
  *	Checks if the the number is a power of 2.
  *
@@ -255,6 +277,29 @@ static void V3DTextureRescaleImage(
 }
 
 
+/*
+ *	Sets the GL states that the texture bindings are to be
+ *	recorded on, so that selecting the texture that is already
+ *	selected does not bind it again.
+ *
+ *	If s is NULL then textures are always bound.
+ */
+void V3DTextureSetStateGL(state_gl_struct *s)
+{
+	v3d_texture_state_gl = s;
+}
+
+/*
+ *	Marks the selected textures as unknown, this must be called
+ *	after GL commands that select textures other than through the
+ *	V3DTexture*() functions, such as glCallList(), and before and
+ *	after recording a GL list.
+ */
+void V3DTextureInvalidate(void)
+{
+	StateGLInvalidateTextureBindings(v3d_texture_state_gl);
+}
+
 /*
  *	Sets pointed to texture reference's specified texture frame
  *	number into current context.
@@ -271,10 +316,10 @@ void V3DTextureSelectFrame(v3d_texture_ref_struct *t, int frame_num)
 	if((t == NULL) || (frame_num < 0))
 	{
 	    /* Unselect texture */
-	    glBindTexture(GL_TEXTURE_1D, 0);
-	    glBindTexture(GL_TEXTURE_2D, 0);
+	    StateGLBindTexture(v3d_texture_state_gl, GL_TEXTURE_1D, 0);
+	    StateGLBindTexture(v3d_texture_state_gl, GL_TEXTURE_2D, 0);
 #ifdef GL_TEXTURE_3D
-	    glBindTexture(GL_TEXTURE_3D, 0);
+	    StateGLBindTexture(v3d_texture_state_gl, GL_TEXTURE_3D, 0);
 #endif
 	    return;
 	}
@@ -294,19 +339,25 @@ void V3DTextureSelectFrame(v3d_texture_ref_struct *t, int frame_num)
 	{
 	  case 3:
 #ifdef GL_TEXTURE_3D
-	    glBindTexture(GL_TEXTURE_3D, gl_texture_id);
+	    StateGLBindTexture(
+		v3d_texture_state_gl, GL_TEXTURE_3D, gl_texture_id
+	    );
 #endif
 	    break;
 
 	  case 2:
 #ifdef GL_TEXTURE_2D
-	    glBindTexture(GL_TEXTURE_2D, gl_texture_id);
+	    StateGLBindTexture(
+		v3d_texture_state_gl, GL_TEXTURE_2D, gl_texture_id
+	    );
 #endif
 	    break;
 
 	  case 1:
 #ifdef GL_TEXTURE_1D
-	    glBindTexture(GL_TEXTURE_1D, gl_texture_id);
+	    StateGLBindTexture(
+		v3d_texture_state_gl, GL_TEXTURE_1D, gl_texture_id
+	    );
 #endif
 	    break;
 	}
@@ -361,6 +412,8 @@ v3d_texture_ref_struct *V3DTextureLoadFromFile2D(
 
 	if(path == NULL)
 	    return(NULL);
+	if(!V3DTextureHaveContext())
+	    return(NULL);
 
 #ifndef __MSW__
 	if(stat(path, &stat_buf))
@@ -606,7 +659,9 @@ v3d_texture_ref_struct *V3DTextureLoadFromFile2D(
 	    /* Actually generate texture and make texture active
 	     * (selected)
 	     */
-	    glBindTexture(GL_TEXTURE_2D, gl_texture_id);
+	    StateGLBindTexture(
+		v3d_texture_state_gl, GL_TEXTURE_2D, gl_texture_id
+	    );
 
 	    /* Set parameters of selected texture */
 	    TEXTUREIO_TEX_OPTIONS_2D
@@ -725,6 +780,8 @@ v3d_texture_ref_struct *V3DTextureLoadFromFile2DPreempt(
 
 	if(path == NULL)
 	    return(NULL);
+	if(!V3DTextureHaveContext())
+	    return(NULL);
 
 #ifndef __MSW__
 	if(stat(path, &stat_buf))
@@ -930,7 +987,9 @@ v3d_texture_ref_struct *V3DTextureLoadFromFile2DPreempt(
 	    /* Actually generate texture and make texture active
 	     * (selected).
 	     */
-	    glBindTexture(GL_TEXTURE_2D, gl_texture_id);
+	    StateGLBindTexture(
+		v3d_texture_state_gl, GL_TEXTURE_2D, gl_texture_id
+	    );
 
 	    /* Set parameters of selected texture */
 	    TEXTUREIO_TEX_OPTIONS_2D
@@ -1047,6 +1106,8 @@ v3d_texture_ref_struct *V3DTextureLoadFromData1D(
 
 	if(data == NULL)
 	    return(NULL);
+	if(!V3DTextureHaveContext())
+	    return(NULL);
 
 	/* Check if size is big enough */
 	if(width < 2)
@@ -1096,7 +1157,9 @@ v3d_texture_ref_struct *V3DTextureLoadFromData1D(
 	    /* Actually generate texture and make texture active
 	     * (selected)
 	     */
-	    glBindTexture(GL_TEXTURE_1D, gl_texture_id);
+	    StateGLBindTexture(
+		v3d_texture_state_gl, GL_TEXTURE_1D, gl_texture_id
+	    );
 		    
 	    /* Set parameters of selected texture */
 	    TEXTUREIO_TEX_OPTIONS_1D
@@ -1218,6 +1281,8 @@ v3d_texture_ref_struct *V3DTextureLoadFromData2D(
 
 	if(data == NULL) 
 	    return(NULL);
+	if(!V3DTextureHaveContext())
+	    return(NULL);
 
 	/* Check if size is big enough */
 	if(width < 2)
@@ -1340,7 +1405,9 @@ v3d_texture_ref_struct *V3DTextureLoadFromData2D(
 	    /* Actually generate texture and make texture active
 	     * (selected).
 	     */
-	    glBindTexture(GL_TEXTURE_2D, gl_texture_id);
+	    StateGLBindTexture(
+		v3d_texture_state_gl, GL_TEXTURE_2D, gl_texture_id
+	    );
 
 	    /* Set parameters of selected texture */
 	    TEXTUREIO_TEX_OPTIONS_2D
@@ -1497,6 +1564,9 @@ void V3DTextureDestroy(v3d_texture_ref_struct *t)
 		&gl_texture_id
 	    );
 	}
+
+	/* Deleting a bound texture binds 0 in its place */
+	V3DTextureInvalidate();
 	free(t->data);
 
 	/* Free reference name and file name */
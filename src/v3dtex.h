@@ -21,6 +21,12 @@
 #ifndef V3DTEX_H
 #define V3DTEX_H
 
+#ifdef __MSW__
+# include <windows.h>
+#endif
+#include <GL/gl.h>
+#include "stategl.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -58,6 +64,8 @@ typedef struct {
 
 } v3d_texture_ref_struct;
 
+extern void V3DTextureSetStateGL(state_gl_struct *s);
+extern void V3DTextureInvalidate(void);
 extern void V3DTextureSelectFrame(v3d_texture_ref_struct *t, int frame_num);
 extern void V3DTextureSelect(v3d_texture_ref_struct *t);
 extern v3d_texture_ref_struct *V3DTextureLoadFromFile2D(
@@ -203,11 +203,11 @@ void SARWeatherSetScenePreset(
 	/* No rain */
 	scene->rain_density_coeff = 0.0f;
 
-	/* Reset horizon's last update time to -1 so that
-	 * SARSimUpdateScene() will update the horizon
+	/* Mark the horizon to be regenerated with the new sky colors
+	 * by SARSimUpdateScene()
 	 */
 	horizon_ptr = &scene->horizon;
-	horizon_ptr->last_tod = -1;
+	horizon_ptr->regenerate = True;
 
 	/* Delete any existing cloud layers on scene structure */
 	for(i = 0; i < scene->total_cloud_layers; i++)